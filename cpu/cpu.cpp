@@ -1,21 +1,20 @@
 #include "cpu.hpp"
+#include "cpu_bus_device.hpp"
+#include "cpu_logger.hpp"
+#include "cpu_profiler.hpp"
+#include "cpu_trace_file.hpp"
+#include "cpu_trace_recorder.hpp"
 #include "ram/ram.hpp"
 #include "flags/cpu_b_flags.hpp"
+#include "jit/cpu_jit.hpp"
 
 #include "instructions/cpu_instruction_base.hpp"
 #include "instructions/cpu_instruction_op_adc.hpp"
 #include "instructions/cpu_instruction_op_and.hpp"
 #include "instructions/cpu_instruction_op_asl.hpp"
-#include "instructions/cpu_instruction_op_bcc.hpp"
-#include "instructions/cpu_instruction_op_bcs.hpp"
-#include "instructions/cpu_instruction_op_beq.hpp"
 #include "instructions/cpu_instruction_op_bit.hpp"
-#include "instructions/cpu_instruction_op_bmi.hpp"
-#include "instructions/cpu_instruction_op_bne.hpp"
-#include "instructions/cpu_instruction_op_bpl.hpp"
+#include "instructions/cpu_instruction_op_branch.hpp"
 #include "instructions/cpu_instruction_op_brk.hpp"
-#include "instructions/cpu_instruction_op_bvc.hpp"
-#include "instructions/cpu_instruction_op_bvs.hpp"
 #include "instructions/cpu_instruction_op_clc.hpp"
 #include "instructions/cpu_instruction_op_cld.hpp"
 #include "instructions/cpu_instruction_op_cli.hpp"
@@ -60,21 +59,38 @@
 #include "instructions/cpu_instruction_op_txs.hpp"
 #include "instructions/cpu_instruction_op_tya.hpp"
 
-#include <iostream>
+#include <algorithm>	// std::min / std::max
+#include <limits>	// std::numeric_limits
+#include <ostream>
+
+namespace
+{
+	// Single constant instance of every instruction handler, referenced by the
+	// shared instruction table
+	template <typename Instruction>
+	const Instruction INSTRUCTION{};
+}
 
 nes::CPU::CPU(RAM& ramRef) :
+	ZeroResult(0),
+	NegativeResult(0),
 	PC(0),
 	RamRef(ramRef),
-	CurrentCycle(0)
+	CurrentCycle(0),
+	DecodeCache(ramRef),
+	PendingInterrupts(0),
+	NmiLine(false),
+	CurrentOperand(0),
+	BreakpointCount(0),
+	TraceDumpStream(nullptr),
+	TraceWriter(nullptr),
+	BusDevice(nullptr),
+	JitEnabled(false)
 {
 	SetDefaultState();
-	AllocateInstructionTable();
 }
 
-nes::CPU::~CPU()
-{
-	DeallocateInstructionTable();
-}
+nes::CPU::~CPU() = default;
 
 void nes::CPU::SetProgramCounterToResetVector()
 {
@@ -90,28 +106,146 @@ void nes::CPU::SetProgramCounterToAddress(std::uint16_t address)
 
 void nes::CPU::ExecuteInstruction()
 {
-	Byte opCode = RamRef.ReadByte(PC);
+	// Entering an interrupt takes the place of an instruction, it is neither
+	// traced nor profiled
+	if (PendingInterrupts != 0 && IsInterruptDue())
+	{
+		EnterPendingInterrupt();
+		return;
+	}
+
+	std::uint16_t address = PC;
+	std::uint64_t startCycle = CurrentCycle;
+
+#if defined(NES_CPU_BACKEND_SWITCH)
+	DecodedInstruction instruction = DecodeCache.Fetch(PC);
+
+	if (ShouldTrace())
+	{
+		RecordTrace(instruction);
+	}
+
+	bool executed = (RunInterpreter(1, std::numeric_limits<std::uint64_t>::max()) != StopReason::Jammed);
+#else
+	DecodedInstruction instruction = DecodeCache.Fetch(PC);
+	CurrentOperand = instruction.Operand;
+
+	if (ShouldTrace())
+	{
+		RecordTrace(instruction);
+	}
+
+	Byte opCode;
+	opCode.value = instruction.OpCode;
 	ProcessOpCode(opCode);
+
+	bool executed = (InstructionTable[instruction.OpCode] != nullptr);
+#endif
+
+	if (Profiler != nullptr && executed)
+	{
+		Profiler->Record(address, instruction.OpCode, CurrentCycle - startCycle);
+	}
 }
 
-void nes::CPU::MoveProgramCounter(std::int32_t offset)
+nes::CPU::StopReason nes::CPU::ExecuteTableInstruction()
 {
-	PC += offset;
+	if (PendingInterrupts != 0 && IsInterruptDue())
+	{
+		EnterPendingInterrupt();
+		return StopReason::CycleBudget;
+	}
+
+	DecodedInstruction decoded = DecodeCache.Fetch(PC);
+
+	if (ShouldTrace())
+	{
+		RecordTrace(decoded);
+	}
+
+	const CpuInstructionBase* instruction = InstructionTable[decoded.OpCode];
+
+	// Unknown op-codes do not move the CPU forward at all
+	if (instruction == nullptr)
+	{
+		return StopReason::Jammed;
+	}
+
+	CurrentOperand = decoded.Operand;
+	instruction->Execute(*this);
+
+	return StopReason::CycleBudget;
 }
 
-void nes::CPU::UpdateCurrentCycle(std::uint8_t offset)
+void nes::CPU::SetNmiLine(bool asserted)
 {
-	CurrentCycle += offset;
+	// Only the transition to asserted latches an NMI
+	if (asserted && !NmiLine)
+	{
+		PendingInterrupts |= NMI_PENDING;
+	}
+
+	NmiLine = asserted;
 }
 
-nes::Byte nes::CPU::ReadRamValueAtAddress(std::uint16_t address) const
+void nes::CPU::SetIrqLine(IrqSource source, bool asserted)
 {
-	return RamRef.ReadByte(address);
+	if (asserted)
+	{
+		PendingInterrupts |= static_cast<std::uint16_t>(source);
+	}
+	else
+	{
+		PendingInterrupts &= ~static_cast<std::uint16_t>(source);
+	}
+}
+
+bool nes::CPU::IsIrqLineAsserted() const
+{
+	return ((PendingInterrupts & 0x00FF) != 0);
 }
 
-void nes::CPU::WriteRamValueAtAddress(std::uint16_t address, Byte value) const
+void nes::CPU::WriteState(std::uint8_t* destination) const
 {
-	RamRef.WriteByte(address, value);
+	// [0-4] A, X, Y, P and SP, [5] NMI line, [6-7] PC, [8-9] pending
+	// interrupts, [10-15] reserved, [16-23] current cycle
+	destination[0] = A.value;
+	destination[1] = X.value;
+	destination[2] = Y.value;
+	destination[3] = GetStatusRegister().value;
+	destination[4] = SP.value;
+	destination[5] = NmiLine ? 1 : 0;
+	WriteLittleEndian(destination + 6, PC, 2);
+	WriteLittleEndian(destination + 8, PendingInterrupts, 2);
+	WriteLittleEndian(destination + 10, 0, 6);
+	WriteLittleEndian(destination + 16, CurrentCycle, 8);
+}
+
+void nes::CPU::ReadState(const std::uint8_t* source)
+{
+	A.value = source[0];
+	X.value = source[1];
+	Y.value = source[2];
+
+	Byte status;
+	status.value = source[3];
+	SetStatusRegister(status);
+
+	SP.value = source[4];
+	NmiLine = (source[5] != 0);
+	PC = static_cast<std::uint16_t>(ReadLittleEndian(source + 6, 2));
+	PendingInterrupts = static_cast<std::uint16_t>(ReadLittleEndian(source + 8, 2));
+	CurrentCycle = ReadLittleEndian(source + 16, 8);
+}
+
+void nes::CPU::MoveProgramCounter(std::int32_t offset)
+{
+	PC += offset;
+}
+
+void nes::CPU::UpdateCurrentCycle(std::uint8_t offset)
+{
+	CurrentCycle += offset;
 }
 
 std::uint16_t nes::CPU::GetProgramCounter() const
@@ -140,7 +274,7 @@ nes::Byte nes::CPU::GetRegister(RegisterType type) const
 			value = Y;
 			break;
 		case nes::CPU::RegisterType::P:
-			value = P;
+			value = GetStatusRegister();
 			break;
 		case nes::CPU::RegisterType::SP:
 			value = SP;
@@ -157,418 +291,753 @@ std::uint64_t nes::CPU::GetCurrentCycle() const
 	return CurrentCycle;
 }
 
-bool nes::CPU::DidProgramCounterCrossPageBoundary(std::uint16_t before, std::uint16_t after) const
+nes::CPU::StopReason nes::CPU::RunCycles(std::uint64_t cycleCount)
 {
-	// Detect if the lower byte wrapped around
-	std::uint16_t lowerBefore = (before & 0xFF);
-	std::uint16_t lowerAfter = (after & 0xFF);
+	std::uint64_t targetCycle = GetTargetCycle(cycleCount);
+
+	// Translated blocks cannot stop halfway through, access memory without the
+	// watchpoint checks and do not record a trace or a profile, so breakpoints,
+	// watchpoints, tracing, profiling and bus devices force the interpreter
+	if (!JitEnabled || BreakpointCount != 0 || !Watchpoints.IsEmpty() || ShouldTrace() || Profiler != nullptr || BusDevice != nullptr)
+	{
+		return FinishRun(RunSynchronized(std::numeric_limits<std::uint64_t>::max(), targetCycle));
+	}
 
-	// If the newer value is less than the value before incrementing the address,
-	// a page boundary was crossed
-	return (lowerAfter < lowerBefore);
+	while (CurrentCycle < targetCycle)
+	{
+		// Blocks do not look at interrupts, so anything pending, even an IRQ
+		// that is masked for now, is left to the interpreter
+		std::uint64_t instructionCount = 1;
+		if (PendingInterrupts == 0 && Jit->ExecuteBlock(targetCycle, instructionCount))
+		{
+			continue;
+		}
+
+		StopReason reason = RunBatch(instructionCount, targetCycle);
+		if (reason != StopReason::CycleBudget)
+		{
+			return FinishRun(reason);
+		}
+	}
+
+	return StopReason::CycleBudget;
 }
 
-void nes::CPU::SetDefaultState()
+void nes::CPU::SetBreakpoint(std::uint16_t address)
 {
-	A.value = 0;
-	X.value = 0;
-	Y.value = 0;
+	if (!Breakpoints[address])
+	{
+		Breakpoints[address] = true;
+		++BreakpointCount;
+	}
+}
 
-	// https://wiki.nesdev.com/w/index.php/CPU_power_up_state
-	P.value = 0x24;
-	SP.value = 0xFD;
+void nes::CPU::RemoveBreakpoint(std::uint16_t address)
+{
+	if (Breakpoints[address])
+	{
+		Breakpoints[address] = false;
+		--BreakpointCount;
+	}
+}
 
-	// http://forum.6502.org/viewtopic.php?f=4&t=5704#:~:text=On%20the%206502%2C%20the%20reset,all%20interrupts)%20takes%207%20cycles.
-	CurrentCycle = 7;
+void nes::CPU::ClearBreakpoints()
+{
+	Breakpoints.reset();
+	BreakpointCount = 0;
 }
 
-std::uint16_t nes::CPU::GetTargetAddress(AddressingMode mode) const
+bool nes::CPU::HasBreakpoint(std::uint16_t address) const
 {
-	switch (mode)
-	{
-		case nes::AddressingMode::Immediate:
-			{
-				return PC + 1;
-			}
-			break;
-		case nes::AddressingMode::Absolute:
-			{
-				return ConstructAddressFromBytes(RamRef.ReadByte(PC + 2), RamRef.ReadByte(PC + 1));
-			}
-			break;
-		case nes::AddressingMode::AbsoluteX:
-			{
-				std::uint16_t address = ConstructAddressFromBytes(RamRef.ReadByte(PC + 2), RamRef.ReadByte(PC + 1));
-				return (address + X.value);
-			}
-			break;
-		case nes::AddressingMode::AbsoluteY:
-			{
-				std::uint16_t address = ConstructAddressFromBytes(RamRef.ReadByte(PC + 2), RamRef.ReadByte(PC + 1));
-				return (address + Y.value);
-			}
-			break;
-		case nes::AddressingMode::Indirect:
-			{
-				std::uint16_t address = ConstructAddressFromBytes(RamRef.ReadByte(PC + 2), RamRef.ReadByte(PC + 1));
+	return Breakpoints[address];
+}
 
-				Byte targetLsb = RamRef.ReadByte(address);
-				Byte targetMsb = RamRef.ReadByte(address + 1);
-				std::uint16_t targetAddress = ConstructAddressFromBytes(targetMsb, targetLsb);
-				return targetAddress;
-			}
-			break;
-		case nes::AddressingMode::IndirectX:
-			{
-				Byte zeroPageAddress = RamRef.ReadByte(PC + 1);
-				zeroPageAddress.value += X.value;	// May wrap around
+void nes::CPU::SetWatchpoint(CpuWatchpoints::Access type, std::uint16_t firstAddress, std::uint16_t lastAddress)
+{
+	Watchpoints.Set({ type, std::min(firstAddress, lastAddress), std::max(firstAddress, lastAddress), false, 0 });
+}
 
-				Byte lsb = RamRef.ReadByte(zeroPageAddress.value);
-				Byte msb = RamRef.ReadByte(zeroPageAddress.value + 1);
-				std::uint16_t address = ConstructAddressFromBytes(msb, lsb);
-				return address;
-			}
-			break;
-		case nes::AddressingMode::IndirectY:
-			{
-				Byte zeroPageAddress = RamRef.ReadByte(PC + 1);
-				std::uint16_t address = RamRef.ReadByte(zeroPageAddress.value).value;
-				return (address + Y.value);
-			}
-			break;
-		case nes::AddressingMode::ZeroPage:
-			{
-				std::uint8_t zeroPageAddress = RamRef.ReadByte(PC + 1).value;
-				return zeroPageAddress;
-			}
-			break;
-		case nes::AddressingMode::ZeroPageX:
-			{
-				std::uint8_t zeroPageAddress = RamRef.ReadByte(PC + 1).value;
-				zeroPageAddress += X.value;	// May wrap around
+void nes::CPU::SetWatchpoint(CpuWatchpoints::Access type, std::uint16_t firstAddress, std::uint16_t lastAddress, std::uint8_t value)
+{
+	Watchpoints.Set({ type, std::min(firstAddress, lastAddress), std::max(firstAddress, lastAddress), true, value });
+}
 
-				return zeroPageAddress;
-			}
-			break;
-		case nes::AddressingMode::ZeroPageY:
-			{
-				std::uint8_t zeroPageAddress = RamRef.ReadByte(PC + 1).value;
-				zeroPageAddress += Y.value;	// May wrap around
+void nes::CPU::RemoveWatchpoint(CpuWatchpoints::Access type, std::uint16_t firstAddress, std::uint16_t lastAddress)
+{
+	Watchpoints.Remove(type, std::min(firstAddress, lastAddress), std::max(firstAddress, lastAddress));
+}
 
-				return zeroPageAddress;
-			}
-			break;
-		default:
-			std::cerr << "Invalid addressing mode." << std::endl;
-			break;
+void nes::CPU::ClearWatchpoints()
+{
+	Watchpoints.Clear();
+}
+
+const nes::CpuWatchpoints::Hit& nes::CPU::GetLastWatchpointHit() const
+{
+	return Watchpoints.GetLastHit();
+}
+
+void nes::CPU::EnableTracing(std::size_t recordCount, std::ostream* dumpStream)
+{
+	TraceRecorder = std::make_unique<CpuTraceRecorder>(recordCount);
+	TraceDumpStream = dumpStream;
+}
+
+void nes::CPU::DisableTracing()
+{
+	TraceRecorder.reset();
+	TraceDumpStream = nullptr;
+}
+
+bool nes::CPU::IsTracingEnabled() const
+{
+	return (TraceRecorder != nullptr);
+}
+
+void nes::CPU::EnableProfiling()
+{
+	Profiler = std::make_unique<CpuProfiler>();
+}
+
+void nes::CPU::DisableProfiling()
+{
+	Profiler.reset();
+}
+
+bool nes::CPU::IsProfilingEnabled() const
+{
+	return (Profiler != nullptr);
+}
+
+nes::CpuProfiler* nes::CPU::GetProfiler()
+{
+	return Profiler.get();
+}
+
+const nes::CpuProfiler* nes::CPU::GetProfiler() const
+{
+	return Profiler.get();
+}
+
+void nes::CPU::SetBusDevice(CpuBusDevice* device)
+{
+	BusDevice = device;
+}
+
+void nes::CPU::SetTraceWriter(CpuTraceWriter* writer)
+{
+	TraceWriter = writer;
+}
+
+std::string_view nes::CPU::GetOpCodeName(std::uint8_t opCode) const
+{
+	const CpuInstructionBase* instruction = InstructionTable[opCode];
+	return (instruction != nullptr) ? instruction->GetName() : "???";
+}
+
+std::uint8_t nes::CPU::GetOpCodeSize(std::uint8_t opCode) const
+{
+	// Unknown op-codes are shown as a single byte
+	const CpuInstructionBase* instruction = InstructionTable[opCode];
+	return (instruction != nullptr) ? instruction->GetSize() : 1;
+}
+
+void nes::CPU::DumpTrace(std::ostream& stream) const
+{
+	if (TraceRecorder == nullptr)
+	{
+		return;
 	}
 
-	// Only ever returned when the addressing mode is invalid
-	return 0;
+	for (std::size_t i = 0; i < TraceRecorder->GetRecordCount(); ++i)
+	{
+		const CpuTraceRecord& record = TraceRecorder->GetRecord(i);
+		stream << CpuLogger::ConstructStreamFromRecord(record, GetOpCodeName(record.OpCode), GetOpCodeSize(record.OpCode)).str() << '\n';
+	}
+
+	stream.flush();
 }
 
-void nes::CPU::AllocateInstructionTable()
+bool nes::CPU::SetJitEnabled(bool enabled)
 {
-	// Set all pointers to nullptr to ensure that we have no garbage values
-	for (std::size_t i = 0; i < InstructionTable.size(); ++i)
+	if (enabled && Jit == nullptr)
 	{
-		InstructionTable[i] = nullptr;
+		Jit = std::make_unique<CpuJit>(*this, RamRef);
 	}
 
+	JitEnabled = (enabled && Jit->IsAvailable());
+	return JitEnabled;
+}
+
+bool nes::CPU::IsJitEnabled() const
+{
+	return JitEnabled;
+}
+
+bool nes::CPU::DidProgramCounterCrossPageBoundary(std::uint16_t before, std::uint16_t after) const
+{
+	return ((before ^ after) & 0xFF00) != 0;
+}
+
+void nes::CPU::SetDefaultState()
+{
+	A.value = 0;
+	X.value = 0;
+	Y.value = 0;
+
+	// https://wiki.nesdev.com/w/index.php/CPU_power_up_state
+	P.value = 0x24;
+	SetStatusRegister(P);
+	SP.value = 0xFD;
+
+	// http://forum.6502.org/viewtopic.php?f=4&t=5704#:~:text=On%20the%206502%2C%20the%20reset,all%20interrupts)%20takes%207%20cycles.
+	CurrentCycle = 7;
+}
+
+constexpr std::array<const nes::CpuInstructionBase*, 256> nes::CPU::BuildInstructionTable()
+{
+	std::array<const CpuInstructionBase*, 256> table {};
+
 	// ADC
-	InstructionTable[0x61] = new CpuInstructionOpADC(*this, AddressingMode::IndirectX);
-	InstructionTable[0x65] = new CpuInstructionOpADC(*this, AddressingMode::ZeroPage);
-	InstructionTable[0x69] = new CpuInstructionOpADC(*this, AddressingMode::Immediate);
-	InstructionTable[0x6D] = new CpuInstructionOpADC(*this, AddressingMode::Absolute);
-	InstructionTable[0x71] = new CpuInstructionOpADC(*this, AddressingMode::IndirectY);
-	InstructionTable[0x75] = new CpuInstructionOpADC(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0x79] = new CpuInstructionOpADC(*this, AddressingMode::AbsoluteY);
-	InstructionTable[0x7D] = new CpuInstructionOpADC(*this, AddressingMode::AbsoluteX);
+	table[0x61] = &INSTRUCTION<CpuInstructionOpADC<AddressingMode::IndirectX>>;
+	table[0x65] = &INSTRUCTION<CpuInstructionOpADC<AddressingMode::ZeroPage>>;
+	table[0x69] = &INSTRUCTION<CpuInstructionOpADC<AddressingMode::Immediate>>;
+	table[0x6D] = &INSTRUCTION<CpuInstructionOpADC<AddressingMode::Absolute>>;
+	table[0x71] = &INSTRUCTION<CpuInstructionOpADC<AddressingMode::IndirectY>>;
+	table[0x75] = &INSTRUCTION<CpuInstructionOpADC<AddressingMode::ZeroPageX>>;
+	table[0x79] = &INSTRUCTION<CpuInstructionOpADC<AddressingMode::AbsoluteY>>;
+	table[0x7D] = &INSTRUCTION<CpuInstructionOpADC<AddressingMode::AbsoluteX>>;
 
 	// AND
-	InstructionTable[0x21] = new CpuInstructionOpAND(*this, AddressingMode::IndirectX);
-	InstructionTable[0x25] = new CpuInstructionOpAND(*this, AddressingMode::ZeroPage);
-	InstructionTable[0x29] = new CpuInstructionOpAND(*this, AddressingMode::Immediate);
-	InstructionTable[0x2D] = new CpuInstructionOpAND(*this, AddressingMode::Absolute);
-	InstructionTable[0x31] = new CpuInstructionOpAND(*this, AddressingMode::IndirectY);
-	InstructionTable[0x35] = new CpuInstructionOpAND(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0x39] = new CpuInstructionOpAND(*this, AddressingMode::AbsoluteY);
-	InstructionTable[0x3D] = new CpuInstructionOpAND(*this, AddressingMode::AbsoluteX);
+	table[0x21] = &INSTRUCTION<CpuInstructionOpAND<AddressingMode::IndirectX>>;
+	table[0x25] = &INSTRUCTION<CpuInstructionOpAND<AddressingMode::ZeroPage>>;
+	table[0x29] = &INSTRUCTION<CpuInstructionOpAND<AddressingMode::Immediate>>;
+	table[0x2D] = &INSTRUCTION<CpuInstructionOpAND<AddressingMode::Absolute>>;
+	table[0x31] = &INSTRUCTION<CpuInstructionOpAND<AddressingMode::IndirectY>>;
+	table[0x35] = &INSTRUCTION<CpuInstructionOpAND<AddressingMode::ZeroPageX>>;
+	table[0x39] = &INSTRUCTION<CpuInstructionOpAND<AddressingMode::AbsoluteY>>;
+	table[0x3D] = &INSTRUCTION<CpuInstructionOpAND<AddressingMode::AbsoluteX>>;
 
 	// ASL
-	InstructionTable[0x06] = new CpuInstructionOpASL(*this, AddressingMode::ZeroPage);
-	InstructionTable[0x0A] = new CpuInstructionOpASL(*this, AddressingMode::Accumulator);
-	InstructionTable[0x0E] = new CpuInstructionOpASL(*this, AddressingMode::Absolute);
-	InstructionTable[0x16] = new CpuInstructionOpASL(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0x1E] = new CpuInstructionOpASL(*this, AddressingMode::AbsoluteX);
+	table[0x06] = &INSTRUCTION<CpuInstructionOpASL<AddressingMode::ZeroPage>>;
+	table[0x0A] = &INSTRUCTION<CpuInstructionOpASL<AddressingMode::Accumulator>>;
+	table[0x0E] = &INSTRUCTION<CpuInstructionOpASL<AddressingMode::Absolute>>;
+	table[0x16] = &INSTRUCTION<CpuInstructionOpASL<AddressingMode::ZeroPageX>>;
+	table[0x1E] = &INSTRUCTION<CpuInstructionOpASL<AddressingMode::AbsoluteX>>;
 
 	// BCC
-	InstructionTable[0x90] = new CpuInstructionOpBCC(*this, AddressingMode::Relative);
+	table[0x90] = &INSTRUCTION<CpuInstructionOpBCC>;
 
 	// BCS
-	InstructionTable[0xB0] = new CpuInstructionOpBCS(*this, AddressingMode::Relative);
+	table[0xB0] = &INSTRUCTION<CpuInstructionOpBCS>;
 
 	// BEQ
-	InstructionTable[0xF0] = new CpuInstructionOpBEQ(*this, AddressingMode::Relative);
+	table[0xF0] = &INSTRUCTION<CpuInstructionOpBEQ>;
 
 	// BIT
-	InstructionTable[0x24] = new CpuInstructionOpBIT(*this, AddressingMode::ZeroPage);
-	InstructionTable[0x2C] = new CpuInstructionOpBIT(*this, AddressingMode::Absolute);
+	table[0x24] = &INSTRUCTION<CpuInstructionOpBIT<AddressingMode::ZeroPage>>;
+	table[0x2C] = &INSTRUCTION<CpuInstructionOpBIT<AddressingMode::Absolute>>;
 
 	// BMI
-	InstructionTable[0x30] = new CpuInstructionOpBMI(*this, AddressingMode::Relative);
+	table[0x30] = &INSTRUCTION<CpuInstructionOpBMI>;
 
 	// BNE
-	InstructionTable[0xD0] = new CpuInstructionOpBNE(*this, AddressingMode::Relative);
+	table[0xD0] = &INSTRUCTION<CpuInstructionOpBNE>;
 
 	// BPL
-	InstructionTable[0x10] = new CpuInstructionOpBPL(*this, AddressingMode::Relative);
+	table[0x10] = &INSTRUCTION<CpuInstructionOpBPL>;
 
 	// BRK
-	InstructionTable[0x00] = new CpuInstructionOpBRK(*this, AddressingMode::Implicit);
+	table[0x00] = &INSTRUCTION<CpuInstructionOpBRK>;
 
 	// BVC
-	InstructionTable[0x50] = new CpuInstructionOpBVC(*this, AddressingMode::Relative);
+	table[0x50] = &INSTRUCTION<CpuInstructionOpBVC>;
 
 	// BVS
-	InstructionTable[0x70] = new CpuInstructionOpBVS(*this, AddressingMode::Relative);
+	table[0x70] = &INSTRUCTION<CpuInstructionOpBVS>;
 
 	// CLC
-	InstructionTable[0x18] = new CpuInstructionOpCLC(*this, AddressingMode::Implicit);
+	table[0x18] = &INSTRUCTION<CpuInstructionOpCLC>;
 
 	// CLD
-	InstructionTable[0xD8] = new CpuInstructionOpCLD(*this, AddressingMode::Implicit);
+	table[0xD8] = &INSTRUCTION<CpuInstructionOpCLD>;
 
 	// CLI
-	InstructionTable[0x58] = new CpuInstructionOpCLI(*this, AddressingMode::Implicit);
+	table[0x58] = &INSTRUCTION<CpuInstructionOpCLI>;
 
 	// CLV
-	InstructionTable[0xB8] = new CpuInstructionOpCLV(*this, AddressingMode::Implicit);
+	table[0xB8] = &INSTRUCTION<CpuInstructionOpCLV>;
 
 	// CMP
-	InstructionTable[0xC1] = new CpuInstructionOpCMP(*this, AddressingMode::IndirectX);
-	InstructionTable[0xC5] = new CpuInstructionOpCMP(*this, AddressingMode::ZeroPage);
-	InstructionTable[0xC9] = new CpuInstructionOpCMP(*this, AddressingMode::Immediate);
-	InstructionTable[0xCD] = new CpuInstructionOpCMP(*this, AddressingMode::Absolute);
-	InstructionTable[0xD1] = new CpuInstructionOpCMP(*this, AddressingMode::IndirectY);
-	InstructionTable[0xD5] = new CpuInstructionOpCMP(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0xD9] = new CpuInstructionOpCMP(*this, AddressingMode::AbsoluteY);
-	InstructionTable[0xDD] = new CpuInstructionOpCMP(*this, AddressingMode::AbsoluteX);
+	table[0xC1] = &INSTRUCTION<CpuInstructionOpCMP<AddressingMode::IndirectX>>;
+	table[0xC5] = &INSTRUCTION<CpuInstructionOpCMP<AddressingMode::ZeroPage>>;
+	table[0xC9] = &INSTRUCTION<CpuInstructionOpCMP<AddressingMode::Immediate>>;
+	table[0xCD] = &INSTRUCTION<CpuInstructionOpCMP<AddressingMode::Absolute>>;
+	table[0xD1] = &INSTRUCTION<CpuInstructionOpCMP<AddressingMode::IndirectY>>;
+	table[0xD5] = &INSTRUCTION<CpuInstructionOpCMP<AddressingMode::ZeroPageX>>;
+	table[0xD9] = &INSTRUCTION<CpuInstructionOpCMP<AddressingMode::AbsoluteY>>;
+	table[0xDD] = &INSTRUCTION<CpuInstructionOpCMP<AddressingMode::AbsoluteX>>;
 
 	// CPX
-	InstructionTable[0xE0] = new CpuInstructionOpCPX(*this, AddressingMode::Immediate);
-	InstructionTable[0xE4] = new CpuInstructionOpCPX(*this, AddressingMode::ZeroPage);
-	InstructionTable[0xEC] = new CpuInstructionOpCPX(*this, AddressingMode::Absolute);
+	table[0xE0] = &INSTRUCTION<CpuInstructionOpCPX<AddressingMode::Immediate>>;
+	table[0xE4] = &INSTRUCTION<CpuInstructionOpCPX<AddressingMode::ZeroPage>>;
+	table[0xEC] = &INSTRUCTION<CpuInstructionOpCPX<AddressingMode::Absolute>>;
 
 	// CPY
-	InstructionTable[0xC0] = new CpuInstructionOpCPY(*this, AddressingMode::Immediate);
-	InstructionTable[0xC4] = new CpuInstructionOpCPY(*this, AddressingMode::ZeroPage);
-	InstructionTable[0xCC] = new CpuInstructionOpCPY(*this, AddressingMode::Absolute);
+	table[0xC0] = &INSTRUCTION<CpuInstructionOpCPY<AddressingMode::Immediate>>;
+	table[0xC4] = &INSTRUCTION<CpuInstructionOpCPY<AddressingMode::ZeroPage>>;
+	table[0xCC] = &INSTRUCTION<CpuInstructionOpCPY<AddressingMode::Absolute>>;
 
 	// DEC
-	InstructionTable[0xC6] = new CpuInstructionOpDEC(*this, AddressingMode::ZeroPage);
-	InstructionTable[0xD6] = new CpuInstructionOpDEC(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0xCE] = new CpuInstructionOpDEC(*this, AddressingMode::Absolute);
-	InstructionTable[0xDE] = new CpuInstructionOpDEC(*this, AddressingMode::AbsoluteX);
+	table[0xC6] = &INSTRUCTION<CpuInstructionOpDEC<AddressingMode::ZeroPage>>;
+	table[0xD6] = &INSTRUCTION<CpuInstructionOpDEC<AddressingMode::ZeroPageX>>;
+	table[0xCE] = &INSTRUCTION<CpuInstructionOpDEC<AddressingMode::Absolute>>;
+	table[0xDE] = &INSTRUCTION<CpuInstructionOpDEC<AddressingMode::AbsoluteX>>;
 
 	// DEX
-	InstructionTable[0xCA] = new CpuInstructionOpDEX(*this, AddressingMode::Implicit);
+	table[0xCA] = &INSTRUCTION<CpuInstructionOpDEX>;
 
 	// DEY
-	InstructionTable[0x88] = new CpuInstructionOpDEY(*this, AddressingMode::Implicit);
+	table[0x88] = &INSTRUCTION<CpuInstructionOpDEY>;
 
 	// EOR
-	InstructionTable[0x41] = new CpuInstructionOpEOR(*this, AddressingMode::IndirectX);
-	InstructionTable[0x45] = new CpuInstructionOpEOR(*this, AddressingMode::ZeroPage);
-	InstructionTable[0x49] = new CpuInstructionOpEOR(*this, AddressingMode::Immediate);
-	InstructionTable[0x4D] = new CpuInstructionOpEOR(*this, AddressingMode::Absolute);
-	InstructionTable[0x51] = new CpuInstructionOpEOR(*this, AddressingMode::IndirectY);
-	InstructionTable[0x55] = new CpuInstructionOpEOR(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0x59] = new CpuInstructionOpEOR(*this, AddressingMode::AbsoluteY);
-	InstructionTable[0x5D] = new CpuInstructionOpEOR(*this, AddressingMode::AbsoluteX);
+	table[0x41] = &INSTRUCTION<CpuInstructionOpEOR<AddressingMode::IndirectX>>;
+	table[0x45] = &INSTRUCTION<CpuInstructionOpEOR<AddressingMode::ZeroPage>>;
+	table[0x49] = &INSTRUCTION<CpuInstructionOpEOR<AddressingMode::Immediate>>;
+	table[0x4D] = &INSTRUCTION<CpuInstructionOpEOR<AddressingMode::Absolute>>;
+	table[0x51] = &INSTRUCTION<CpuInstructionOpEOR<AddressingMode::IndirectY>>;
+	table[0x55] = &INSTRUCTION<CpuInstructionOpEOR<AddressingMode::ZeroPageX>>;
+	table[0x59] = &INSTRUCTION<CpuInstructionOpEOR<AddressingMode::AbsoluteY>>;
+	table[0x5D] = &INSTRUCTION<CpuInstructionOpEOR<AddressingMode::AbsoluteX>>;
 
 	// INC
-	InstructionTable[0xE6] = new CpuInstructionOpINC(*this, AddressingMode::ZeroPage);
-	InstructionTable[0xF6] = new CpuInstructionOpINC(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0xEE] = new CpuInstructionOpINC(*this, AddressingMode::Absolute);
-	InstructionTable[0xFE] = new CpuInstructionOpINC(*this, AddressingMode::AbsoluteX);
+	table[0xE6] = &INSTRUCTION<CpuInstructionOpINC<AddressingMode::ZeroPage>>;
+	table[0xF6] = &INSTRUCTION<CpuInstructionOpINC<AddressingMode::ZeroPageX>>;
+	table[0xEE] = &INSTRUCTION<CpuInstructionOpINC<AddressingMode::Absolute>>;
+	table[0xFE] = &INSTRUCTION<CpuInstructionOpINC<AddressingMode::AbsoluteX>>;
 
 	// INX
-	InstructionTable[0xE8] = new CpuInstructionOpINX(*this, AddressingMode::Implicit);
+	table[0xE8] = &INSTRUCTION<CpuInstructionOpINX>;
 
 	// INY
-	InstructionTable[0xC8] = new CpuInstructionOpINY(*this, AddressingMode::Implicit);
+	table[0xC8] = &INSTRUCTION<CpuInstructionOpINY>;
 
 	// JMP
-	InstructionTable[0x4C] = new CpuInstructionOpJMP(*this, AddressingMode::Absolute);
-	InstructionTable[0x6C] = new CpuInstructionOpJMP(*this, AddressingMode::Indirect);
+	table[0x4C] = &INSTRUCTION<CpuInstructionOpJMP<AddressingMode::Absolute>>;
+	table[0x6C] = &INSTRUCTION<CpuInstructionOpJMP<AddressingMode::Indirect>>;
 
 	// JSR
-	InstructionTable[0x20] = new CpuInstructionOpJSR(*this, AddressingMode::Absolute);
+	table[0x20] = &INSTRUCTION<CpuInstructionOpJSR>;
 
 	// LDA
-	InstructionTable[0xA1] = new CpuInstructionOpLDA(*this, AddressingMode::IndirectX);
-	InstructionTable[0xA5] = new CpuInstructionOpLDA(*this, AddressingMode::ZeroPage);
-	InstructionTable[0xA9] = new CpuInstructionOpLDA(*this, AddressingMode::Immediate);
-	InstructionTable[0xAD] = new CpuInstructionOpLDA(*this, AddressingMode::Absolute);
-	InstructionTable[0xB1] = new CpuInstructionOpLDA(*this, AddressingMode::IndirectY);
-	InstructionTable[0xB5] = new CpuInstructionOpLDA(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0xB9] = new CpuInstructionOpLDA(*this, AddressingMode::AbsoluteY);
-	InstructionTable[0xBD] = new CpuInstructionOpLDA(*this, AddressingMode::AbsoluteX);
+	table[0xA1] = &INSTRUCTION<CpuInstructionOpLDA<AddressingMode::IndirectX>>;
+	table[0xA5] = &INSTRUCTION<CpuInstructionOpLDA<AddressingMode::ZeroPage>>;
+	table[0xA9] = &INSTRUCTION<CpuInstructionOpLDA<AddressingMode::Immediate>>;
+	table[0xAD] = &INSTRUCTION<CpuInstructionOpLDA<AddressingMode::Absolute>>;
+	table[0xB1] = &INSTRUCTION<CpuInstructionOpLDA<AddressingMode::IndirectY>>;
+	table[0xB5] = &INSTRUCTION<CpuInstructionOpLDA<AddressingMode::ZeroPageX>>;
+	table[0xB9] = &INSTRUCTION<CpuInstructionOpLDA<AddressingMode::AbsoluteY>>;
+	table[0xBD] = &INSTRUCTION<CpuInstructionOpLDA<AddressingMode::AbsoluteX>>;
 
 	// LDX
-	InstructionTable[0xA2] = new CpuInstructionOpLDX(*this, AddressingMode::Immediate);
-	InstructionTable[0xA6] = new CpuInstructionOpLDX(*this, AddressingMode::ZeroPage);
-	InstructionTable[0xAE] = new CpuInstructionOpLDX(*this, AddressingMode::Absolute);
-	InstructionTable[0xB6] = new CpuInstructionOpLDX(*this, AddressingMode::ZeroPageY);
-	InstructionTable[0xBE] = new CpuInstructionOpLDX(*this, AddressingMode::AbsoluteY);
+	table[0xA2] = &INSTRUCTION<CpuInstructionOpLDX<AddressingMode::Immediate>>;
+	table[0xA6] = &INSTRUCTION<CpuInstructionOpLDX<AddressingMode::ZeroPage>>;
+	table[0xAE] = &INSTRUCTION<CpuInstructionOpLDX<AddressingMode::Absolute>>;
+	table[0xB6] = &INSTRUCTION<CpuInstructionOpLDX<AddressingMode::ZeroPageY>>;
+	table[0xBE] = &INSTRUCTION<CpuInstructionOpLDX<AddressingMode::AbsoluteY>>;
 
 	// LDY
-	InstructionTable[0xA0] = new CpuInstructionOpLDY(*this, AddressingMode::Immediate);
-	InstructionTable[0xA4] = new CpuInstructionOpLDY(*this, AddressingMode::ZeroPage);
-	InstructionTable[0xAC] = new CpuInstructionOpLDY(*this, AddressingMode::Absolute);
-	InstructionTable[0xB4] = new CpuInstructionOpLDY(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0xBC] = new CpuInstructionOpLDY(*this, AddressingMode::AbsoluteX);
+	table[0xA0] = &INSTRUCTION<CpuInstructionOpLDY<AddressingMode::Immediate>>;
+	table[0xA4] = &INSTRUCTION<CpuInstructionOpLDY<AddressingMode::ZeroPage>>;
+	table[0xAC] = &INSTRUCTION<CpuInstructionOpLDY<AddressingMode::Absolute>>;
+	table[0xB4] = &INSTRUCTION<CpuInstructionOpLDY<AddressingMode::ZeroPageX>>;
+	table[0xBC] = &INSTRUCTION<CpuInstructionOpLDY<AddressingMode::AbsoluteX>>;
 
 	// LSR
-	InstructionTable[0x46] = new CpuInstructionOpLSR(*this, AddressingMode::ZeroPage);
-	InstructionTable[0x4A] = new CpuInstructionOpLSR(*this, AddressingMode::Accumulator);
-	InstructionTable[0x4E] = new CpuInstructionOpLSR(*this, AddressingMode::Absolute);
-	InstructionTable[0x56] = new CpuInstructionOpLSR(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0x5E] = new CpuInstructionOpLSR(*this, AddressingMode::AbsoluteX);
+	table[0x46] = &INSTRUCTION<CpuInstructionOpLSR<AddressingMode::ZeroPage>>;
+	table[0x4A] = &INSTRUCTION<CpuInstructionOpLSR<AddressingMode::Accumulator>>;
+	table[0x4E] = &INSTRUCTION<CpuInstructionOpLSR<AddressingMode::Absolute>>;
+	table[0x56] = &INSTRUCTION<CpuInstructionOpLSR<AddressingMode::ZeroPageX>>;
+	table[0x5E] = &INSTRUCTION<CpuInstructionOpLSR<AddressingMode::AbsoluteX>>;
 
 	// NOP
-	InstructionTable[0xEA] = new CpuInstructionOpNOP(*this, AddressingMode::Implicit);
+	table[0xEA] = &INSTRUCTION<CpuInstructionOpNOP>;
 
 	// ORA
-	InstructionTable[0x01] = new CpuInstructionOpORA(*this, AddressingMode::IndirectX);
-	InstructionTable[0x05] = new CpuInstructionOpORA(*this, AddressingMode::ZeroPage);
-	InstructionTable[0x09] = new CpuInstructionOpORA(*this, AddressingMode::Immediate);
-	InstructionTable[0x0D] = new CpuInstructionOpORA(*this, AddressingMode::Absolute);
-	InstructionTable[0x11] = new CpuInstructionOpORA(*this, AddressingMode::IndirectY);
-	InstructionTable[0x15] = new CpuInstructionOpORA(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0x19] = new CpuInstructionOpORA(*this, AddressingMode::AbsoluteY);
-	InstructionTable[0x1D] = new CpuInstructionOpORA(*this, AddressingMode::AbsoluteX);
+	table[0x01] = &INSTRUCTION<CpuInstructionOpORA<AddressingMode::IndirectX>>;
+	table[0x05] = &INSTRUCTION<CpuInstructionOpORA<AddressingMode::ZeroPage>>;
+	table[0x09] = &INSTRUCTION<CpuInstructionOpORA<AddressingMode::Immediate>>;
+	table[0x0D] = &INSTRUCTION<CpuInstructionOpORA<AddressingMode::Absolute>>;
+	table[0x11] = &INSTRUCTION<CpuInstructionOpORA<AddressingMode::IndirectY>>;
+	table[0x15] = &INSTRUCTION<CpuInstructionOpORA<AddressingMode::ZeroPageX>>;
+	table[0x19] = &INSTRUCTION<CpuInstructionOpORA<AddressingMode::AbsoluteY>>;
+	table[0x1D] = &INSTRUCTION<CpuInstructionOpORA<AddressingMode::AbsoluteX>>;
 
 	// PHA
-	InstructionTable[0x48] = new CpuInstructionOpPHA(*this, AddressingMode::Implicit);
+	table[0x48] = &INSTRUCTION<CpuInstructionOpPHA>;
 
 	// PHP
-	InstructionTable[0x08] = new CpuInstructionOpPHP(*this, AddressingMode::Implicit);
+	table[0x08] = &INSTRUCTION<CpuInstructionOpPHP>;
 
 	// PLA
-	InstructionTable[0x68] = new CpuInstructionOpPLA(*this, AddressingMode::Implicit);
+	table[0x68] = &INSTRUCTION<CpuInstructionOpPLA>;
 
 	// PLP
-	InstructionTable[0x28] = new CpuInstructionOpPLP(*this, AddressingMode::Implicit);
+	table[0x28] = &INSTRUCTION<CpuInstructionOpPLP>;
 
 	// ROL
-	InstructionTable[0x26] = new CpuInstructionOpROL(*this, AddressingMode::ZeroPage);
-	InstructionTable[0x2A] = new CpuInstructionOpROL(*this, AddressingMode::Accumulator);
-	InstructionTable[0x2E] = new CpuInstructionOpROL(*this, AddressingMode::Absolute);
-	InstructionTable[0x36] = new CpuInstructionOpROL(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0x3E] = new CpuInstructionOpROL(*this, AddressingMode::AbsoluteX);
+	table[0x26] = &INSTRUCTION<CpuInstructionOpROL<AddressingMode::ZeroPage>>;
+	table[0x2A] = &INSTRUCTION<CpuInstructionOpROL<AddressingMode::Accumulator>>;
+	table[0x2E] = &INSTRUCTION<CpuInstructionOpROL<AddressingMode::Absolute>>;
+	table[0x36] = &INSTRUCTION<CpuInstructionOpROL<AddressingMode::ZeroPageX>>;
+	table[0x3E] = &INSTRUCTION<CpuInstructionOpROL<AddressingMode::AbsoluteX>>;
 
 	// ROR
-	InstructionTable[0x66] = new CpuInstructionOpROR(*this, AddressingMode::ZeroPage);
-	InstructionTable[0x6A] = new CpuInstructionOpROR(*this, AddressingMode::Accumulator);
-	InstructionTable[0x6E] = new CpuInstructionOpROR(*this, AddressingMode::Absolute);
-	InstructionTable[0x76] = new CpuInstructionOpROR(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0x7E] = new CpuInstructionOpROR(*this, AddressingMode::AbsoluteX);
+	table[0x66] = &INSTRUCTION<CpuInstructionOpROR<AddressingMode::ZeroPage>>;
+	table[0x6A] = &INSTRUCTION<CpuInstructionOpROR<AddressingMode::Accumulator>>;
+	table[0x6E] = &INSTRUCTION<CpuInstructionOpROR<AddressingMode::Absolute>>;
+	table[0x76] = &INSTRUCTION<CpuInstructionOpROR<AddressingMode::ZeroPageX>>;
+	table[0x7E] = &INSTRUCTION<CpuInstructionOpROR<AddressingMode::AbsoluteX>>;
 
 	// RTI
-	InstructionTable[0x40] = new CpuInstructionOpRTI(*this, AddressingMode::Implicit);
+	table[0x40] = &INSTRUCTION<CpuInstructionOpRTI>;
 
 	// RTS
-	InstructionTable[0x60] = new CpuInstructionOpRTS(*this, AddressingMode::Implicit);
+	table[0x60] = &INSTRUCTION<CpuInstructionOpRTS>;
 
 	// SBC
-	InstructionTable[0xE1] = new CpuInstructionOpSBC(*this, AddressingMode::IndirectX);
-	InstructionTable[0xE5] = new CpuInstructionOpSBC(*this, AddressingMode::ZeroPage);
-	InstructionTable[0xE9] = new CpuInstructionOpSBC(*this, AddressingMode::Immediate);
-	InstructionTable[0xED] = new CpuInstructionOpSBC(*this, AddressingMode::Absolute);
-	InstructionTable[0xF1] = new CpuInstructionOpSBC(*this, AddressingMode::IndirectY);
-	InstructionTable[0xF5] = new CpuInstructionOpSBC(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0xFD] = new CpuInstructionOpSBC(*this, AddressingMode::AbsoluteX);
-	InstructionTable[0xF9] = new CpuInstructionOpSBC(*this, AddressingMode::AbsoluteY);
+	table[0xE1] = &INSTRUCTION<CpuInstructionOpSBC<AddressingMode::IndirectX>>;
+	table[0xE5] = &INSTRUCTION<CpuInstructionOpSBC<AddressingMode::ZeroPage>>;
+	table[0xE9] = &INSTRUCTION<CpuInstructionOpSBC<AddressingMode::Immediate>>;
+	table[0xED] = &INSTRUCTION<CpuInstructionOpSBC<AddressingMode::Absolute>>;
+	table[0xF1] = &INSTRUCTION<CpuInstructionOpSBC<AddressingMode::IndirectY>>;
+	table[0xF5] = &INSTRUCTION<CpuInstructionOpSBC<AddressingMode::ZeroPageX>>;
+	table[0xFD] = &INSTRUCTION<CpuInstructionOpSBC<AddressingMode::AbsoluteX>>;
+	table[0xF9] = &INSTRUCTION<CpuInstructionOpSBC<AddressingMode::AbsoluteY>>;
 
 	// SEC
-	InstructionTable[0x38] = new CpuInstructionOpSEC(*this, AddressingMode::Implicit);
+	table[0x38] = &INSTRUCTION<CpuInstructionOpSEC>;
 
 	// SED
-	InstructionTable[0xF8] = new CpuInstructionOpSED(*this, AddressingMode::Implicit);
+	table[0xF8] = &INSTRUCTION<CpuInstructionOpSED>;
 
 	// SEI
-	InstructionTable[0x78] = new CpuInstructionOpSEI(*this, AddressingMode::Implicit);
+	table[0x78] = &INSTRUCTION<CpuInstructionOpSEI>;
 
 	// STA
-	InstructionTable[0x81] = new CpuInstructionOpSTA(*this, AddressingMode::IndirectX);
-	InstructionTable[0x85] = new CpuInstructionOpSTA(*this, AddressingMode::ZeroPage);
-	InstructionTable[0x8D] = new CpuInstructionOpSTA(*this, AddressingMode::Absolute);
-	InstructionTable[0x91] = new CpuInstructionOpSTA(*this, AddressingMode::IndirectY);
-	InstructionTable[0x95] = new CpuInstructionOpSTA(*this, AddressingMode::ZeroPageX);
-	InstructionTable[0x99] = new CpuInstructionOpSTA(*this, AddressingMode::AbsoluteY);
-	InstructionTable[0x9D] = new CpuInstructionOpSTA(*this, AddressingMode::AbsoluteX);
+	table[0x81] = &INSTRUCTION<CpuInstructionOpSTA<AddressingMode::IndirectX>>;
+	table[0x85] = &INSTRUCTION<CpuInstructionOpSTA<AddressingMode::ZeroPage>>;
+	table[0x8D] = &INSTRUCTION<CpuInstructionOpSTA<AddressingMode::Absolute>>;
+	table[0x91] = &INSTRUCTION<CpuInstructionOpSTA<AddressingMode::IndirectY>>;
+	table[0x95] = &INSTRUCTION<CpuInstructionOpSTA<AddressingMode::ZeroPageX>>;
+	table[0x99] = &INSTRUCTION<CpuInstructionOpSTA<AddressingMode::AbsoluteY>>;
+	table[0x9D] = &INSTRUCTION<CpuInstructionOpSTA<AddressingMode::AbsoluteX>>;
 
 	// STX
-	InstructionTable[0x86] = new CpuInstructionOpSTX(*this, AddressingMode::ZeroPage);
-	InstructionTable[0x8E] = new CpuInstructionOpSTX(*this, AddressingMode::Absolute);
-	InstructionTable[0x96] = new CpuInstructionOpSTX(*this, AddressingMode::ZeroPageY);
+	table[0x86] = &INSTRUCTION<CpuInstructionOpSTX<AddressingMode::ZeroPage>>;
+	table[0x8E] = &INSTRUCTION<CpuInstructionOpSTX<AddressingMode::Absolute>>;
+	table[0x96] = &INSTRUCTION<CpuInstructionOpSTX<AddressingMode::ZeroPageY>>;
 
 	// STY
-	InstructionTable[0x84] = new CpuInstructionOpSTY(*this, AddressingMode::ZeroPage);
-	InstructionTable[0x8C] = new CpuInstructionOpSTY(*this, AddressingMode::Absolute);
-	InstructionTable[0x94] = new CpuInstructionOpSTY(*this, AddressingMode::ZeroPageX);
+	table[0x84] = &INSTRUCTION<CpuInstructionOpSTY<AddressingMode::ZeroPage>>;
+	table[0x8C] = &INSTRUCTION<CpuInstructionOpSTY<AddressingMode::Absolute>>;
+	table[0x94] = &INSTRUCTION<CpuInstructionOpSTY<AddressingMode::ZeroPageX>>;
 
 	// TAX
-	InstructionTable[0xAA] = new CpuInstructionOpTAX(*this, AddressingMode::Implicit);
+	table[0xAA] = &INSTRUCTION<CpuInstructionOpTAX>;
 
 	// TAY
-	InstructionTable[0xA8] = new CpuInstructionOpTAY(*this, AddressingMode::Implicit);
+	table[0xA8] = &INSTRUCTION<CpuInstructionOpTAY>;
 
 	// TSX
-	InstructionTable[0xBA] = new CpuInstructionOpTSX(*this, AddressingMode::Implicit);
+	table[0xBA] = &INSTRUCTION<CpuInstructionOpTSX>;
 
 	// TXA
-	InstructionTable[0x8A] = new CpuInstructionOpTXA(*this, AddressingMode::Implicit);
+	table[0x8A] = &INSTRUCTION<CpuInstructionOpTXA>;
 
 	// TXS
-	InstructionTable[0x9A] = new CpuInstructionOpTXS(*this, AddressingMode::Implicit);
+	table[0x9A] = &INSTRUCTION<CpuInstructionOpTXS>;
 
 	// TYA
-	InstructionTable[0x98] = new CpuInstructionOpTYA(*this, AddressingMode::Implicit);
+	table[0x98] = &INSTRUCTION<CpuInstructionOpTYA>;
+
+	return table;
 }
 
-void nes::CPU::DeallocateInstructionTable()
+// Only holds the addresses of the handlers, so it is initialized at compile time
+const std::array<const nes::CpuInstructionBase*, 256> nes::CPU::InstructionTable = nes::CPU::BuildInstructionTable();
+
+bool nes::CPU::ShouldTrace() const
 {
-	for (const auto& instruction : InstructionTable)
+	return (TraceRecorder != nullptr || TraceWriter != nullptr);
+}
+
+void nes::CPU::RecordTrace(const DecodedInstruction& instruction)
+{
+	CpuTraceRecord record;
+	record.Cycle = CurrentCycle;
+	record.PC = PC;
+	record.Operand = instruction.Operand;
+	record.OpCode = instruction.OpCode;
+	record.A = A.value;
+	record.X = X.value;
+	record.Y = Y.value;
+	record.P = GetStatusRegister().value;
+	record.SP = SP.value;
+
+	if (TraceRecorder != nullptr)
+	{
+		TraceRecorder->Record(record);
+	}
+
+	if (TraceWriter != nullptr)
 	{
-		if (instruction.second)
+		TraceWriter->Write(record);
+	}
+}
+
+bool nes::CPU::CheckWatchpoints(std::uint16_t programCounter, std::uint64_t cycle)
+{
+	if (Watchpoints.IsWatched(programCounter, CpuWatchpoints::Access::Execute))
+	{
+		Watchpoints.Check(CpuWatchpoints::Access::Execute, programCounter, DecodeCache.Fetch(programCounter).OpCode, programCounter, cycle);
+	}
+
+	return Watchpoints.TakeHit();
+}
+
+nes::CPU::StopReason nes::CPU::FinishRun(StopReason reason)
+{
+	bool stoppedUnexpectedly = (reason == StopReason::Breakpoint || reason == StopReason::Watchpoint || reason == StopReason::Jammed);
+
+	if (stoppedUnexpectedly && TraceRecorder != nullptr && TraceDumpStream != nullptr)
+	{
+		DumpTrace(*TraceDumpStream);
+	}
+
+	return reason;
+}
+
+std::uint64_t nes::CPU::GetTargetCycle(std::uint64_t cycleCount) const
+{
+	std::uint64_t maxCycle = std::numeric_limits<std::uint64_t>::max();
+	return (cycleCount > maxCycle - CurrentCycle) ? maxCycle : (CurrentCycle + cycleCount);
+}
+
+nes::CPU::StopReason nes::CPU::RunBatch(std::uint64_t instructionCount, std::uint64_t cycleLimit)
+{
+#if defined(NES_CPU_BACKEND_SWITCH)
+	if (!ShouldTrace() && Profiler == nullptr)
+	{
+		return RunInterpreter(instructionCount, cycleLimit);
+	}
+
+	// Every instruction is recorded before it executes and profiled after it
+	// executed, so step one at a time
+	StopReason reason = StopReason::CycleBudget;
+
+	for (; instructionCount > 0 && CurrentCycle < cycleLimit && reason == StopReason::CycleBudget; --instructionCount)
+	{
+		if (PendingInterrupts != 0 && IsInterruptDue())
+		{
+			reason = RunInterpreter(1, cycleLimit);
+			continue;
+		}
+
+		DecodedInstruction decoded = DecodeCache.Fetch(PC);
+		std::uint16_t address = PC;
+		std::uint64_t startCycle = CurrentCycle;
+
+		if (ShouldTrace())
 		{
-			delete instruction.second;
+			RecordTrace(decoded);
+		}
+
+		reason = RunInterpreter(1, cycleLimit);
+
+		if (Profiler != nullptr && reason != StopReason::Jammed)
+		{
+			Profiler->Record(address, decoded.OpCode, CurrentCycle - startCycle);
 		}
 	}
 
-	InstructionTable.clear();
+	return reason;
+#else
+	const bool checkWatchpoints = !Watchpoints.IsEmpty();
+
+	for (; instructionCount > 0 && CurrentCycle < cycleLimit; --instructionCount)
+	{
+		// A single test per instruction as long as nothing is pending
+		if (PendingInterrupts != 0 && IsInterruptDue())
+		{
+			EnterPendingInterrupt();
+
+			if (checkWatchpoints && CheckWatchpoints(PC, CurrentCycle))
+			{
+				return StopReason::Watchpoint;
+			}
+
+			if (BreakpointCount != 0 && Breakpoints[PC])
+			{
+				return StopReason::Breakpoint;
+			}
+
+			continue;
+		}
+
+		DecodedInstruction decoded = DecodeCache.Fetch(PC);
+
+		if (ShouldTrace())
+		{
+			RecordTrace(decoded);
+		}
+
+		const CpuInstructionBase* instruction = InstructionTable[decoded.OpCode];
+
+		// Unknown op-codes do not move the CPU forward at all
+		if (instruction == nullptr)
+		{
+			return StopReason::Jammed;
+		}
+
+		std::uint16_t address = PC;
+		std::uint64_t startCycle = CurrentCycle;
+
+		CurrentOperand = decoded.Operand;
+		instruction->Execute(*this);
+
+		if (Profiler != nullptr)
+		{
+			Profiler->Record(address, decoded.OpCode, CurrentCycle - startCycle);
+		}
+
+		if (checkWatchpoints && CheckWatchpoints(PC, CurrentCycle))
+		{
+			return StopReason::Watchpoint;
+		}
+
+		if (BreakpointCount != 0 && Breakpoints[PC])
+		{
+			return StopReason::Breakpoint;
+		}
+	}
+
+	return StopReason::CycleBudget;
+#endif
+}
+
+nes::CPU::StopReason nes::CPU::RunSynchronized(std::uint64_t instructionCount, std::uint64_t cycleLimit)
+{
+	if (BusDevice == nullptr)
+	{
+		return RunBatch(instructionCount, cycleLimit);
+	}
+
+	// Unbounded runs hand whole batches to the regular backend, bounded runs
+	// have to count their instructions one by one
+	const std::uint64_t unbounded = std::numeric_limits<std::uint64_t>::max();
+	const std::uint64_t batchSize = (instructionCount == unbounded) ? unbounded : 1;
+
+	StopReason reason = StopReason::CycleBudget;
+
+	for (; instructionCount > 0 && CurrentCycle < cycleLimit && reason == StopReason::CycleBudget; --instructionCount)
+	{
+		std::uint64_t startCycle = CurrentCycle;
+		std::uint64_t cyclesUntilSync = BusDevice->GetCyclesUntilSync();
+
+		if (cyclesUntilSync > MAX_INSTRUCTION_CYCLES)
+		{
+			// No instruction that starts before this limit can reach the sync
+			// point, so the device can be caught up in one go afterwards
+			std::uint64_t batchLimit = std::min(cycleLimit, GetTargetCycle(cyclesUntilSync - MAX_INSTRUCTION_CYCLES));
+
+			reason = RunBatch(batchSize, batchLimit);
+			BusDevice->Tick(CurrentCycle - startCycle);
+			continue;
+		}
+
+		if (PendingInterrupts != 0 && IsInterruptDue())
+		{
+			reason = RunCycleStepped(1, cycleLimit);
+			continue;
+		}
+
+		DecodedInstruction decoded = DecodeCache.Fetch(PC);
+		std::uint16_t address = PC;
+
+		if (ShouldTrace())
+		{
+			RecordTrace(decoded);
+		}
+
+		reason = RunCycleStepped(1, cycleLimit);
+
+		if (Profiler != nullptr && reason != StopReason::Jammed)
+		{
+			Profiler->Record(address, decoded.OpCode, CurrentCycle - startCycle);
+		}
+	}
+
+	return reason;
 }
 
 void nes::CPU::ProcessOpCode(Byte opCode)
 {
 	// Execute the instruction
 	// The instruction moves the program counter and updates the current cycle
-	CpuInstructionBase* instruction = InstructionTable[opCode.value];
+	const CpuInstructionBase* instruction = InstructionTable[opCode.value];
 	if (instruction != nullptr)
 	{
-		instruction->PrintDebugInformation();
-		instruction->Execute();
+		instruction->Execute(*this);
 	}
 }
 
+bool nes::CPU::IsInterruptDue() const
+{
+	if ((PendingInterrupts & NMI_PENDING) != 0)
+	{
+		return true;
+	}
+
+	// IRQ is ignored while interrupts are disabled, but stays pending
+	return ((PendingInterrupts & 0x00FF) != 0 && IsStatusFlagClear(StatusFlags::InterruptDisable));
+}
+
+void nes::CPU::EnterPendingInterrupt()
+{
+	std::uint16_t vectorAddress = IRQ_VECTOR_ADDRESS;
+
+	if ((PendingInterrupts & NMI_PENDING) != 0)
+	{
+		PendingInterrupts &= ~NMI_PENDING;
+		vectorAddress = NMI_VECTOR_ADDRESS;
+	}
+
+	// Turn program counter into two bytes so it can be pushed to the stack
+	Byte msb, lsb;
+	lsb.value = (PC & 0x00FF);
+	msb.value = ((PC & 0xFF00) >> 8);
+	PushStack(msb);
+	PushStack(lsb);
+
+	// Same as BRK, except that the break flag is pushed clear
+	Byte status = GetStatusRegister();
+	status.value = (status.value & 0xCF) | static_cast<std::uint8_t>(BFlag::Interrupt);
+	PushStack(status);
+	SetStatusFlag(StatusFlags::InterruptDisable);
+
+	lsb = ReadRamValueAtAddress(vectorAddress);
+	msb = ReadRamValueAtAddress(vectorAddress + 1);
+	PC = ConstructAddressFromBytes(msb, lsb);
+
+	UpdateCurrentCycle(7);
+}
+
 void nes::CPU::PushStack(Byte value)
 {
 	// Stack grows downwards
 	std::uint16_t address = RamRef.STACK_START_ADDRESS - SP.value;
-	RamRef.WriteByte(address, value);
+	WriteRamValueAtAddress(address, value);
 
 	// Move stack pointer
 	--SP.value;
@@ -581,7 +1050,7 @@ nes::Byte nes::CPU::PopStack()
 
 	// Stack grows downwards
 	std::uint16_t address = RamRef.STACK_START_ADDRESS - SP.value;
-	Byte value = RamRef.ReadByte(address);
+	Byte value = ReadRamValueAtAddress(address);
 
 	// Clear value from stack
 	RamRef.ClearByte(address);
@@ -591,30 +1060,79 @@ nes::Byte nes::CPU::PopStack()
 
 void nes::CPU::SetStatusFlag(StatusFlags flag)
 {
-	P.value |= static_cast<std::uint8_t>(flag);
+	switch (flag)
+	{
+		case StatusFlags::Zero:
+			ZeroResult = 0;
+			break;
+		case StatusFlags::Negative:
+			NegativeResult = 0x80;
+			break;
+		default:
+			P.value |= static_cast<std::uint8_t>(flag);
+			break;
+	}
 }
 
 void nes::CPU::ClearStatusFlag(StatusFlags flag)
 {
-	P.value &= ~static_cast<std::uint8_t>(flag);
+	switch (flag)
+	{
+		case StatusFlags::Zero:
+			ZeroResult = 1;
+			break;
+		case StatusFlags::Negative:
+			NegativeResult = 0;
+			break;
+		default:
+			P.value &= ~static_cast<std::uint8_t>(flag);
+			break;
+	}
 }
 
 bool nes::CPU::IsStatusFlagSet(StatusFlags flag) const
 {
-	return ((P.value & static_cast<std::uint8_t>(flag)) != 0);
+	switch (flag)
+	{
+		case StatusFlags::Zero:
+			return (ZeroResult == 0);
+		case StatusFlags::Negative:
+			return IsNthBitSet(NegativeResult, 7);
+		default:
+			return ((P.value & static_cast<std::uint8_t>(flag)) != 0);
+	}
 }
 
 bool nes::CPU::IsStatusFlagClear(StatusFlags flag) const
 {
-	return ((P.value & static_cast<std::uint8_t>(flag)) == 0);
+	return !IsStatusFlagSet(flag);
 }
 
 void nes::CPU::UpdateZeroStatusFlag(Byte byte)
 {
-	P.bit1 = (byte.value == 0) ? 1 : 0;
+	// Only remember the result, the flag is derived when it is observed
+	ZeroResult = byte.value;
 }
 
 void nes::CPU::UpdateNegativeStatusFlag(Byte byte)
 {
-	P.bit7 = IsNthBitSet(byte, 7) ? 1 : 0;
+	NegativeResult = byte.value;
+}
+
+nes::Byte nes::CPU::GetStatusRegister() const
+{
+	Byte status = P;
+	status.bit1 = (ZeroResult == 0) ? 1 : 0;
+	status.bit7 = IsNthBitSet(NegativeResult, 7) ? 1 : 0;
+	return status;
+}
+
+void nes::CPU::SetStatusRegister(Byte value)
+{
+	ZeroResult = (value.bit1 == 1) ? 0 : 1;
+	NegativeResult = value.value & 0x80;
+
+	P = value;
+	P.bit1 = 0;
+	P.bit7 = 0;
 }
@@ -1,17 +1,29 @@
 #ifndef NES_CPU_HPP
 #define NES_CPU_HPP
 
+#include "cpu_decode_cache.hpp"
+#include "cpu_watchpoints.hpp"
 #include "flags/cpu_status_flags.hpp"
 #include "instructions/cpu_instruction_addressing_mode.hpp"
+#include "ram/ram.hpp"
 #include "utility/bit_tools.hpp"
 
+#include <array>
+#include <bitset>
+#include <cstddef>
 #include <cstdint>
+#include <iosfwd>
+#include <memory>
 #include <string_view>
-#include <unordered_map>
 
 namespace nes
 {
-    class RAM;
+    class CpuBusDevice;
+    class CpuInstructionBase;
+    class CpuJit;
+    class CpuProfiler;
+    class CpuTraceRecorder;
+    class CpuTraceWriter;
 
     /**
      * Emulates a MOS Technology 6502 microprocessor as seen in the NES
@@ -31,6 +43,33 @@ namespace nes
             SP  // Stack pointer
         };
 
+        /**
+         * Reasons for a batched run to return
+         */
+        enum class StopReason
+        {
+            CycleBudget,    // The requested number of cycles has passed
+            Breakpoint,     // The program counter reached a breakpoint
+            Watchpoint,     // An instruction accessed a watched address
+            Jammed,         // Unknown op-code, the CPU cannot make any progress
+            Condition       // The stop condition passed to RunUntil was met
+        };
+
+        /**
+         * Components that can hold the shared IRQ line, the line stays asserted
+         * as long as at least one of them holds it
+         */
+        enum class IrqSource : std::uint8_t
+        {
+            External        = (1 << 0), // Cartridge expansion or a test harness
+            FrameCounter    = (1 << 1), // APU frame counter
+            Dmc             = (1 << 2), // APU delta modulation channel
+            Mapper          = (1 << 3)  // Mapper hardware, such as a scanline counter
+        };
+
+        /** Size of the state written by WriteState in bytes */
+        static constexpr std::size_t STATE_SIZE = 24;
+
     public:
         /**
          * Create a new CPU object
@@ -38,10 +77,14 @@ namespace nes
          */
         CPU(RAM& ramRef);
 
-        CPU(const CPU& other)               = default;
-        CPU(CPU&& other)                    = default;
-        CPU& operator=(const CPU& other)    = default;
-        CPU& operator=(CPU&& other)         = default;
+        // A CPU holds a reference to its RAM, its decode cache refers to the
+        // same RAM and its JIT to both the CPU and the RAM, so a CPU cannot be
+        // copied or moved
+        // Use WriteState and ReadState to duplicate its state instead
+        CPU(const CPU& other)               = delete;
+        CPU(CPU&& other)                    = delete;
+        CPU& operator=(const CPU& other)    = delete;
+        CPU& operator=(CPU&& other)         = delete;
 
         /**
          * Deallocate any used resources
@@ -63,9 +106,60 @@ namespace nes
         /**
          * Fetch the opcode at the program counter and attempt to execute the
          * instruction
+         * When an interrupt is due, the CPU enters its handler instead
          */
         void ExecuteInstruction();
 
+        /**
+         * Execute a single instruction through its op-code handler object, no
+         * matter which backend was compiled in, or enter a pending interrupt
+         * Slow, meant as the reference other backends are checked against
+         * @return  Jammed on an unknown op-code, CycleBudget otherwise
+         */
+        StopReason ExecuteTableInstruction();
+
+        /**
+         * Drive the NMI input
+         * NMI is edge triggered, an interrupt is latched when the line goes from
+         * released to asserted and entered before the next instruction, even
+         * when the interrupt disable flag is set. Keeping the line asserted
+         * does not trigger another one
+         * @param   asserted    True to pull the line low, false to release it
+         */
+        void SetNmiLine(bool asserted);
+
+        /**
+         * Drive the IRQ input on behalf of a single source
+         * IRQ is level triggered, the interrupt is entered before every
+         * instruction that starts while any source holds the line and the
+         * interrupt disable flag is clear. A source has to release the line
+         * once its interrupt has been acknowledged
+         * @param   source      Component driving the line
+         * @param   asserted    True to hold the line, false to release it
+         */
+        void SetIrqLine(IrqSource source, bool asserted);
+
+        /**
+         * Check whether any source holds the IRQ line
+         * @return  True if the IRQ line is asserted
+         */
+        bool IsIrqLineAsserted() const;
+
+        /**
+         * Store the registers, program counter, current cycle and interrupt
+         * inputs in a fixed little-endian layout, as used by save states
+         * @param   destination     Buffer of at least STATE_SIZE bytes
+         */
+        void WriteState(std::uint8_t* destination) const;
+
+        /**
+         * Restore a state stored by WriteState
+         * Breakpoints, tracing, profiling and the attached bus device are left
+         * untouched
+         * @param   source  Buffer of at least STATE_SIZE bytes
+         */
+        void ReadState(const std::uint8_t* source);
+
         /**
          * Manually move the program counter N number of bytes relative to its
          * current memory address
@@ -81,17 +175,29 @@ namespace nes
 
         /**
          * Returns the value of the byte in RAM at the specified address
+         * The read counts as an access of the running instruction, so it is
+         * checked against the read watchpoints
          * @param   address     Address to read from
          * @return  Value of the byte in RAM
          */
-        Byte ReadRamValueAtAddress(std::uint16_t address) const;
+        Byte ReadRamValueAtAddress(std::uint16_t address);
 
         /**
          * Write a byte to RAM at the specified address
+         * The write counts as an access of the running instruction, so it is
+         * checked against the write watchpoints
          * @param   address     Address to write to
          * @param   value       Value to write to RAM
          */
-        void WriteRamValueAtAddress(std::uint16_t address, Byte value) const;
+        void WriteRamValueAtAddress(std::uint16_t address, Byte value);
+
+        /**
+         * Returns the value of the byte in RAM at the specified address without
+         * triggering any watchpoints, for inspecting memory from the outside
+         * @param   address     Address to read from
+         * @return  Value of the byte in RAM
+         */
+        Byte PeekRamValueAtAddress(std::uint16_t address) const;
 
         /**
          * Get the current value of the program counter accounting for the offset
@@ -119,9 +225,210 @@ namespace nes
          */
         std::uint64_t GetCurrentCycle() const;
 
+        /**
+         * Execute instructions until at least the specified number of cycles has
+         * passed, translated blocks are used when the JIT is enabled
+         * All instructions run in a single loop without any trace output
+         * Stops early when the program counter reaches a breakpoint, when a
+         * watchpoint is hit, or when the CPU gets stuck on an unknown op-code
+         * Pending interrupts are entered between instructions, entering one
+         * counts as a step of its own
+         * @param   cycleCount  Number of cycles to run for
+         * @return  Reason the run stopped
+         */
+        StopReason RunCycles(std::uint64_t cycleCount);
+
+        /**
+         * Same as RunCycles, but also stops as soon as the stop condition returns
+         * true after an instruction
+         * The condition is checked after every instruction, so this never uses
+         * the JIT
+         * @param   cycleCount      Maximum number of cycles to run for
+         * @param   stopCondition   Callable taking a const CPU&, returns true to stop
+         * @return  Reason the run stopped
+         */
+        template <typename StopCondition>
+        StopReason RunUntil(std::uint64_t cycleCount, StopCondition stopCondition);
+
+        /**
+         * Make batched runs stop once the program counter reaches an address
+         * The run stops before the instruction at that address executes
+         * @param   address     Address to break on
+         */
+        void SetBreakpoint(std::uint16_t address);
+
+        /**
+         * Remove a breakpoint
+         * @param   address     Address to remove the breakpoint from
+         */
+        void RemoveBreakpoint(std::uint16_t address);
+
+        /**
+         * Remove all breakpoints
+         */
+        void ClearBreakpoints();
+
+        /**
+         * Make batched runs stop once an instruction accesses a range of
+         * addresses, replacing the value condition of an existing watchpoint
+         * with the same type and range
+         * Read and write watchpoints stop the run after the accessing
+         * instruction completed, execute watchpoints stop it before the
+         * instruction executes, just like a breakpoint. The JIT is not used
+         * while any watchpoint is set
+         * @param   type            Kind of access to watch
+         * @param   firstAddress    First address of the range
+         * @param   lastAddress     Last address of the range, may be the same
+         */
+        void SetWatchpoint(CpuWatchpoints::Access type, std::uint16_t firstAddress, std::uint16_t lastAddress);
+
+        /**
+         * Same as SetWatchpoint, but only accesses of a single value stop the
+         * run
+         * @param   type            Kind of access to watch
+         * @param   firstAddress    First address of the range
+         * @param   lastAddress     Last address of the range, may be the same
+         * @param   value           Value read, written or executed (op-code)
+         */
+        void SetWatchpoint(CpuWatchpoints::Access type, std::uint16_t firstAddress, std::uint16_t lastAddress, std::uint8_t value);
+
+        /**
+         * Remove a watchpoint
+         * @param   type            Kind of access the watchpoint watches
+         * @param   firstAddress    First address of its range
+         * @param   lastAddress     Last address of its range
+         */
+        void RemoveWatchpoint(CpuWatchpoints::Access type, std::uint16_t firstAddress, std::uint16_t lastAddress);
+
+        /**
+         * Remove all watchpoints
+         */
+        void ClearWatchpoints();
+
+        /**
+         * Retrieve the access that made the last run stop on a watchpoint
+         * @return  Last hit, including the address of the instruction
+         */
+        const CpuWatchpoints::Hit& GetLastWatchpointHit() const;
+
+        /**
+         * Start recording every executed instruction into an in-memory ring
+         * buffer, replacing any existing recording
+         * Tracing is off by default. While it is enabled, batched runs execute
+         * one instruction at a time and never use the JIT
+         * @param   recordCount     Number of instructions to keep
+         * @param   dumpStream      Stream the recording is written to when a run
+         *                          stops on a breakpoint or a watchpoint, or
+         *                          jams, may be nullptr
+         */
+        void EnableTracing(std::size_t recordCount, std::ostream* dumpStream);
+
+        /**
+         * Stop recording and throw away the recorded instructions
+         */
+        void DisableTracing();
+
+        /**
+         * Check whether executed instructions are being recorded
+         * @return  True if tracing is enabled
+         */
+        bool IsTracingEnabled() const;
+
+        /**
+         * Write the recorded instructions to a stream, oldest first, in the same
+         * format as CpuLogger
+         * @param   stream  Stream to write to
+         */
+        void DumpTrace(std::ostream& stream) const;
+
+        /**
+         * Start counting executions and cycles per op-code and per address,
+         * throwing away any existing profile
+         * Profiling is off by default. While it is enabled, batched runs execute
+         * one instruction at a time and never use the JIT
+         */
+        void EnableProfiling();
+
+        /**
+         * Stop counting and throw away the profile
+         */
+        void DisableProfiling();
+
+        /**
+         * Check whether executed instructions are being counted
+         * @return  True if profiling is enabled
+         */
+        bool IsProfilingEnabled() const;
+
+        /**
+         * Retrieve the profile collected so far
+         * @return  Profiler, nullptr when profiling is disabled
+         */
+        CpuProfiler* GetProfiler();
+        const CpuProfiler* GetProfiler() const;
+
+        /**
+         * Keep a device such as a PPU in sync with batched runs
+         * Whole instructions run on the regular backend while the device does
+         * not need to see the bus, and the device is ticked in bulk afterwards.
+         * Once it asks to be synchronized, instructions run on the cycle-stepped
+         * core, which performs every bus access on its own cycle. The JIT is
+         * never used while a device is attached
+         * @param   device  Device to keep in sync, not owned by the CPU, nullptr
+         *                  to detach the current device
+         */
+        void SetBusDevice(CpuBusDevice* device);
+
+        /**
+         * Write every executed instruction to a binary trace file, independent of
+         * the in-memory recording
+         * Batched runs execute one instruction at a time and never use the JIT
+         * while a writer is attached
+         * @param   writer  Writer to append records to, nullptr to stop writing
+         */
+        void SetTraceWriter(CpuTraceWriter* writer);
+
+        /**
+         * Retrieve the Assembly name of an op-code
+         * @param   opCode  Op-code to look up
+         * @return  Name of the instruction, "???" for unknown op-codes
+         */
+        std::string_view GetOpCodeName(std::uint8_t opCode) const;
+
+        /**
+         * Retrieve the number of bytes an instruction occupies
+         * @param   opCode  Op-code to look up
+         * @return  Size of the instruction in bytes, 1 for unknown op-codes
+         */
+        std::uint8_t GetOpCodeSize(std::uint8_t opCode) const;
+
+        /**
+         * Check whether a breakpoint is set on an address
+         * @param   address     Address to check
+         * @return  True if batched runs stop at this address
+         */
+        bool HasBreakpoint(std::uint16_t address) const;
+
+        /**
+         * Switch between the interpreter and the JIT compiler for RunCycles
+         * Both stop on exactly the same instruction, so the results can be
+         * compared against each other
+         * @param   enabled     True to use the JIT where possible
+         * @return  True if the JIT is enabled, false if it is not available on
+         *          this machine
+         */
+        bool SetJitEnabled(bool enabled);
+
+        /**
+         * Check whether RunCycles uses the JIT compiler
+         * @return  True if the JIT is enabled
+         */
+        bool IsJitEnabled() const;
+
 	private:
         /**
-         * Check if a 256-byte page boundary was crossed between two addresses
+         * Check if a 256-byte page boundary was crossed between two addresses,
+         * that is whether their high bytes differ
          * @param   before  Initial address
          * @param   after   Address to check against
          * @return  True when a page boundary was crossed, false when not
@@ -136,20 +443,29 @@ namespace nes
         /**
          * Retrieve the target address of an instruction based on the addressing
          * mode specified
-         * @param   mode    Addressing mode to use
+         * The addressing mode is a template parameter, so the operand fetch and
+         * address calculation are resolved at compile time
          * @return  Target address of the instruction
          */
-        std::uint16_t GetTargetAddress(AddressingMode mode) const;
+        template <AddressingMode Mode>
+        std::uint16_t GetTargetAddress();
 
         /**
-         * Create a look-up table for all instructions
+         * Retrieve the target address of an instruction based on the addressing
+         * mode specified, and report whether indexing crossed a page boundary
+         * @param   pageCrossed     Set to true when the indexed address lies in a
+         *                          different 256-byte page than the base address
+         * @return  Target address of the instruction
          */
-        void AllocateInstructionTable();
+        template <AddressingMode Mode>
+        std::uint16_t GetTargetAddress(bool& pageCrossed);
 
         /**
-         * Deallocate the look-up table for instructions
+         * Create the look-up table for all instructions, evaluated at compile
+         * time
+         * @return  Handler of every op-code, nullptr for unused op-codes
          */
-        void DeallocateInstructionTable();
+        static constexpr std::array<const CpuInstructionBase*, 256> BuildInstructionTable();
 
         /**
          * Execute the proper op-code
@@ -157,6 +473,99 @@ namespace nes
          */
         void ProcessOpCode(Byte opCode);
 
+        /**
+         * Check whether executed instructions need to be recorded or written
+         * @return  True if a trace recorder or trace writer is attached
+         */
+        bool ShouldTrace() const;
+
+        /**
+         * Store the current CPU state in the trace recorder and trace writer
+         * @param   instruction     Instruction that is about to execute
+         */
+        void RecordTrace(const DecodedInstruction& instruction);
+
+        /**
+         * Check the execute watchpoints against the next instruction and take
+         * the hit of any watchpoint triggered by the previous one
+         * Only called while watchpoints are set
+         * @param   programCounter  Address of the next instruction
+         * @param   cycle           Cycle the next instruction starts on
+         * @return  True if the run has to stop
+         */
+        bool CheckWatchpoints(std::uint16_t programCounter, std::uint64_t cycle);
+
+        /**
+         * Dump the trace when a run stopped on a breakpoint or watchpoint, or
+         * jammed
+         * @param   reason  Reason the run stopped
+         * @return  The same reason
+         */
+        StopReason FinishRun(StopReason reason);
+
+        /**
+         * Calculate the cycle a run of the specified length ends on
+         * @param   cycleCount  Number of cycles to run for
+         * @return  Cycle to stop at, saturated instead of wrapping around
+         */
+        std::uint64_t GetTargetCycle(std::uint64_t cycleCount) const;
+
+        /**
+         * Execute instructions with the configured backend, without any trace
+         * output
+         * @param   instructionCount    Maximum number of instructions to execute
+         * @param   cycleLimit          Stop once this cycle has been reached
+         * @return  Reason the run stopped, CycleBudget when either limit was hit
+         */
+        StopReason RunBatch(std::uint64_t instructionCount, std::uint64_t cycleLimit);
+
+        /**
+         * Same as RunBatch, but keeps the attached bus device in sync
+         * @param   instructionCount    Maximum number of instructions to execute
+         * @param   cycleLimit          Stop once this cycle has been reached
+         * @return  Reason the run stopped, CycleBudget when either limit was hit
+         */
+        StopReason RunSynchronized(std::uint64_t instructionCount, std::uint64_t cycleLimit);
+
+        /**
+         * Execute instructions with the switch-based interpreter, keeping all
+         * registers in locals until the run finishes
+         * @param   instructionCount    Maximum number of instructions to execute
+         * @param   cycleLimit          Stop once this cycle has been reached
+         * @return  Reason the run stopped, CycleBudget when either limit was hit
+         */
+        StopReason RunInterpreter(std::uint64_t instructionCount, std::uint64_t cycleLimit);
+
+        /**
+         * Same as RunInterpreter, but every bus access takes a cycle of its own
+         * and is reported to the attached bus device
+         * @param   instructionCount    Maximum number of instructions to execute
+         * @param   cycleLimit          Stop once this cycle has been reached
+         * @return  Reason the run stopped, CycleBudget when either limit was hit
+         */
+        StopReason RunCycleStepped(std::uint64_t instructionCount, std::uint64_t cycleLimit);
+
+        /**
+         * Interpreter loop shared by RunInterpreter and RunCycleStepped, only
+         * defined in cpu_interpreter.cpp
+         */
+        template <bool CycleStepped>
+        StopReason RunInterpreterLoop(std::uint64_t instructionCount, std::uint64_t cycleLimit);
+
+        /**
+         * Check whether an NMI was latched, or the IRQ line is held while the
+         * interrupt disable flag is clear
+         * Only worth calling when PendingInterrupts is not 0
+         * @return  True if the next step enters an interrupt handler
+         */
+        bool IsInterruptDue() const;
+
+        /**
+         * Push the program counter and status register, and jump through the
+         * vector of the interrupt that is due, NMI taking priority over IRQ
+         */
+        void EnterPendingInterrupt();
+
         /**
          * Push a value to the stack
          * @param   value   Value to push to the stack
@@ -207,62 +616,80 @@ namespace nes
          */
         void UpdateNegativeStatusFlag(Byte byte);
 
+        /**
+         * Build the processor status register from the stored flags and the
+         * results the zero and negative flags are derived from
+         * @return  Processor status register
+         */
+        Byte GetStatusRegister() const;
+
+        /**
+         * Overwrite all processor status flags
+         * @param   value   New value of the processor status register
+         */
+        void SetStatusRegister(Byte value);
+
+    private:
+        /** Largest number of cycles a single instruction takes */
+        static constexpr std::uint64_t MAX_INSTRUCTION_CYCLES = 7;
+
+        /** Bit of PendingInterrupts that is set while a latched NMI waits to be entered */
+        static constexpr std::uint16_t NMI_PENDING = (1 << 8);
+
+        /** Interrupt vectors, the low byte comes first */
+        static constexpr std::uint16_t NMI_VECTOR_ADDRESS = 0xFFFA;
+        static constexpr std::uint16_t IRQ_VECTOR_ADDRESS = 0xFFFE;
+
     private:
         // Give all instructions access to the private and protected members of CPU
         // Friend classes are quite useful here as the instructions would be a massive
         // pain to write if we were to use getter and setter functions only
 		friend class CpuInstructionBase;
 		friend class CpuInstruction;
-		friend class CpuInstructionOpADC;
-		friend class CpuInstructionOpAND;
-		friend class CpuInstructionOpASL;
-		friend class CpuInstructionOpBCC;
-		friend class CpuInstructionOpBCS;
-		friend class CpuInstructionOpBEQ;
-		friend class CpuInstructionOpBIT;
-		friend class CpuInstructionOpBMI;
-		friend class CpuInstructionOpBNE;
-		friend class CpuInstructionOpBPL;
+		friend class CpuJit;
+		template <AddressingMode Mode> friend class CpuInstructionOpADC;
+		template <AddressingMode Mode> friend class CpuInstructionOpAND;
+		template <AddressingMode Mode> friend class CpuInstructionOpASL;
+		template <AddressingMode Mode> friend class CpuInstructionOpBIT;
+		template <StatusFlags Flag, bool BranchIfSet> friend class CpuInstructionOpBranch;
 		friend class CpuInstructionOpBRK;
-		friend class CpuInstructionOpBVC;
-		friend class CpuInstructionOpBVS;
 		friend class CpuInstructionOpCLC;
 		friend class CpuInstructionOpCLD;
 		friend class CpuInstructionOpCLI;
 		friend class CpuInstructionOpCLV;
-		friend class CpuInstructionOpCMP;
-		friend class CpuInstructionOpCPX;
-		friend class CpuInstructionOpCPY;
-		friend class CpuInstructionOpDEC;
+		template <AddressingMode Mode> friend class CpuInstructionOpCMP;
+		template <AddressingMode Mode> friend class CpuInstructionOpCPX;
+		template <AddressingMode Mode> friend class CpuInstructionOpCPY;
+		template <AddressingMode Mode> friend class CpuInstructionOpDEC;
 		friend class CpuInstructionOpDEX;
 		friend class CpuInstructionOpDEY;
-		friend class CpuInstructionOpEOR;
-		friend class CpuInstructionOpINC;
+		template <AddressingMode Mode> friend class CpuInstructionOpEOR;
+		template <AddressingMode Mode> friend class CpuInstructionOpINC;
 		friend class CpuInstructionOpINX;
 		friend class CpuInstructionOpINY;
-		friend class CpuInstructionOpJMP;
+		template <AddressingMode Mode> friend class CpuInstructionOpJMP;
 		friend class CpuInstructionOpJSR;
-		friend class CpuInstructionOpLDA;
-		friend class CpuInstructionOpLDX;
-		friend class CpuInstructionOpLDY;
-		friend class CpuInstructionOpLSR;
+		template <AddressingMode Mode> friend class CpuInstructionOpLDA;
+		template <AddressingMode Mode> friend class CpuInstructionOpLDX;
+		template <AddressingMode Mode> friend class CpuInstructionOpLDY;
+		template <AddressingMode Mode> friend class CpuInstructionOpLSR;
 		friend class CpuInstructionOpNOP;
-		friend class CpuInstructionOpORA;
+		template <AddressingMode Mode> friend class CpuInstructionOpORA;
 		friend class CpuInstructionOpPHA;
 		friend class CpuInstructionOpPHP;
 		friend class CpuInstructionOpPLA;
 		friend class CpuInstructionOpPLP;
-		friend class CpuInstructionOpROL;
-		friend class CpuInstructionOpROR;
+		template <AddressingMode Mode> friend class CpuInstructionOpROL;
+		template <AddressingMode Mode> friend class CpuInstructionOpROR;
 		friend class CpuInstructionOpRTI;
 		friend class CpuInstructionOpRTS;
-		friend class CpuInstructionOpSBC;
+		template <AddressingMode Mode> friend class CpuInstructionOpSBC;
 		friend class CpuInstructionOpSEC;
 		friend class CpuInstructionOpSED;
 		friend class CpuInstructionOpSEI;
-		friend class CpuInstructionOpSTA;
-		friend class CpuInstructionOpSTX;
-		friend class CpuInstructionOpSTY;
+		template <AddressingMode Mode> friend class CpuInstructionOpSTA;
+		template <AddressingMode Mode> friend class CpuInstructionOpSTX;
+		template <AddressingMode Mode> friend class CpuInstructionOpSTY;
 		friend class CpuInstructionOpTAX;
 		friend class CpuInstructionOpTAY;
 		friend class CpuInstructionOpTSX;
@@ -286,8 +713,16 @@ namespace nes
         // 5 - unused bit
         // 6 - overflow flag
         // 7 - negative flag
+        // The zero and negative bits are never stored here, they are derived
+        // lazily from ZeroResult and NegativeResult, see GetStatusRegister
         Byte P;
 
+        // Last value that affected the zero flag, the flag is set when it is 0
+        std::uint8_t ZeroResult;
+
+        // Last value that affected the negative flag, the flag mirrors bit 7
+        std::uint8_t NegativeResult;
+
         // Stack pointer
         Byte SP;
 
@@ -300,9 +735,183 @@ namespace nes
         // Keep track of the current CPU cycle to allow for synchronization
         std::uint64_t CurrentCycle;
 
-        // Look-up table for instructions
-        std::unordered_map<std::uint16_t, CpuInstructionBase*> InstructionTable;
+        // Look-up table for instructions, indexed directly by the op-code
+        // Unused op-codes are left as nullptr. The handlers are stateless, so
+        // a single table is shared by all CPUs
+        static const std::array<const CpuInstructionBase*, 256> InstructionTable;
+
+        // Pre-decoded instructions, indexed by address
+        CpuDecodeCache DecodeCache;
+
+        // Everything that wants to interrupt the CPU in a single word, so run
+        // loops only test one value before every instruction
+        // The low byte holds the IRQ sources holding the line, NMI_PENDING is
+        // set while a latched NMI waits to be entered
+        std::uint16_t PendingInterrupts;
+
+        // Current level of the NMI input, used to detect its edge
+        bool NmiLine;
+
+        // Operand bytes of the instruction that is currently executing
+        std::uint16_t CurrentOperand;
+
+        // Addresses batched runs stop at
+        std::bitset<0x10000> Breakpoints;
+        std::size_t BreakpointCount;
+
+        // Memory watchpoints, tested per page on every access
+        CpuWatchpoints Watchpoints;
+
+        // Flight recorder, only allocated while tracing is enabled
+        std::unique_ptr<CpuTraceRecorder> TraceRecorder;
+        std::ostream* TraceDumpStream;
+
+        // Binary trace output, not owned by the CPU
+        CpuTraceWriter* TraceWriter;
+
+        // Device kept in sync with batched runs, not owned by the CPU
+        CpuBusDevice* BusDevice;
+
+        // Execution counters, only allocated while profiling is enabled
+        std::unique_ptr<CpuProfiler> Profiler;
+
+        // Optional JIT compiler, only allocated once it gets enabled
+        std::unique_ptr<CpuJit> Jit;
+        bool JitEnabled;
     };
+
+    inline Byte CPU::ReadRamValueAtAddress(std::uint16_t address)
+    {
+        Byte value = RamRef.ReadByte(address);
+
+        if (Watchpoints.IsWatched(address, CpuWatchpoints::Access::Read))
+        {
+            Watchpoints.Check(CpuWatchpoints::Access::Read, address, value.value, PC, CurrentCycle);
+        }
+
+        return value;
+    }
+
+    inline void CPU::WriteRamValueAtAddress(std::uint16_t address, Byte value)
+    {
+        RamRef.WriteByte(address, value);
+
+        if (Watchpoints.IsWatched(address, CpuWatchpoints::Access::Write))
+        {
+            Watchpoints.Check(CpuWatchpoints::Access::Write, address, value.value, PC, CurrentCycle);
+        }
+    }
+
+    inline Byte CPU::PeekRamValueAtAddress(std::uint16_t address) const
+    {
+        return RamRef.ReadByte(address);
+    }
+
+    template <AddressingMode Mode>
+    std::uint16_t CPU::GetTargetAddress()
+    {
+        bool pageCrossed = false;
+        return GetTargetAddress<Mode>(pageCrossed);
+    }
+
+    template <AddressingMode Mode>
+    std::uint16_t CPU::GetTargetAddress(bool& pageCrossed)
+    {
+        static_assert(Mode != AddressingMode::Accumulator && Mode != AddressingMode::Implicit && Mode != AddressingMode::Relative,
+            "Addressing mode does not have a target address.");
+
+        pageCrossed = false;
+
+        if constexpr (Mode == AddressingMode::Immediate)
+        {
+            return PC + 1;
+        }
+        else if constexpr (Mode == AddressingMode::Absolute)
+        {
+            return CurrentOperand;
+        }
+        else if constexpr (Mode == AddressingMode::AbsoluteX || Mode == AddressingMode::AbsoluteY)
+        {
+            std::uint16_t address = CurrentOperand;
+            std::uint16_t targetAddress = address + ((Mode == AddressingMode::AbsoluteX) ? X.value : Y.value);
+
+            pageCrossed = ((address & 0xFF00) != (targetAddress & 0xFF00));
+            return targetAddress;
+        }
+        else if constexpr (Mode == AddressingMode::Indirect)
+        {
+            std::uint16_t address = CurrentOperand;
+
+            // The high byte is read without carrying into the page, so a
+            // pointer at $xxFF wraps around to $xx00
+            Byte targetLsb = ReadRamValueAtAddress(address);
+            Byte targetMsb = ReadRamValueAtAddress((address & 0xFF00) | ((address + 1) & 0x00FF));
+            return ConstructAddressFromBytes(targetMsb, targetLsb);
+        }
+        else if constexpr (Mode == AddressingMode::IndirectX)
+        {
+            Byte zeroPageAddress;
+            zeroPageAddress.value = static_cast<std::uint8_t>(CurrentOperand);
+            zeroPageAddress.value += X.value;   // May wrap around
+
+            // The pointer itself never leaves the zero page
+            Byte lsb = ReadRamValueAtAddress(zeroPageAddress.value);
+            Byte msb = ReadRamValueAtAddress(static_cast<std::uint8_t>(zeroPageAddress.value + 1));
+            return ConstructAddressFromBytes(msb, lsb);
+        }
+        else if constexpr (Mode == AddressingMode::IndirectY)
+        {
+            Byte zeroPageAddress;
+            zeroPageAddress.value = static_cast<std::uint8_t>(CurrentOperand);
+
+            // The pointer itself never leaves the zero page
+            Byte lsb = ReadRamValueAtAddress(zeroPageAddress.value);
+            Byte msb = ReadRamValueAtAddress(static_cast<std::uint8_t>(zeroPageAddress.value + 1));
+            std::uint16_t address = ConstructAddressFromBytes(msb, lsb);
+            std::uint16_t targetAddress = address + Y.value;
+
+            pageCrossed = ((address & 0xFF00) != (targetAddress & 0xFF00));
+            return targetAddress;
+        }
+        else if constexpr (Mode == AddressingMode::ZeroPage)
+        {
+            return static_cast<std::uint8_t>(CurrentOperand);
+        }
+        else if constexpr (Mode == AddressingMode::ZeroPageX)
+        {
+            std::uint8_t zeroPageAddress = static_cast<std::uint8_t>(CurrentOperand);
+            zeroPageAddress += X.value; // May wrap around
+            return zeroPageAddress;
+        }
+        else if constexpr (Mode == AddressingMode::ZeroPageY)
+        {
+            std::uint8_t zeroPageAddress = static_cast<std::uint8_t>(CurrentOperand);
+            zeroPageAddress += Y.value; // May wrap around
+            return zeroPageAddress;
+        }
+    }
+
+    template <typename StopCondition>
+    CPU::StopReason CPU::RunUntil(std::uint64_t cycleCount, StopCondition stopCondition)
+    {
+        std::uint64_t targetCycle = GetTargetCycle(cycleCount);
+
+        while (CurrentCycle < targetCycle)
+        {
+            StopReason reason = RunSynchronized(1, targetCycle);
+            if (reason != StopReason::CycleBudget)
+            {
+                return FinishRun(reason);
+            }
+
+            if (stopCondition(static_cast<const CPU&>(*this)))
+            {
+                return StopReason::Condition;
+            }
+        }
+
+        return StopReason::CycleBudget;
+    }
 }
 
 #endif //! NES_CPU_HPP
@@ -0,0 +1,48 @@
+#ifndef NES_CPU_BUS_DEVICE_HPP
+#define NES_CPU_BUS_DEVICE_HPP
+
+#include <cstdint>
+
+namespace nes
+{
+	/**
+	 * Interface for anything that has to stay in sync with the CPU, such as a
+	 * PPU or APU
+	 *
+	 * Most of the time a device only needs to know how much time passed, so the
+	 * CPU runs whole instructions and ticks the device in bulk. Once the device
+	 * is about to do something that depends on the exact timing of the CPU, it
+	 * asks to be synchronized and the CPU switches to its cycle-stepped core, in
+	 * which every read and write is a separate bus access on its own cycle.
+	 */
+	class CpuBusDevice
+	{
+	public:
+		virtual ~CpuBusDevice() = default;
+
+		/**
+		 * Retrieve the number of cycles the CPU may run before the device needs
+		 * to see individual bus accesses again
+		 * @return	Number of cycles, 0 to cycle step the next instruction
+		 */
+		virtual std::uint64_t GetCyclesUntilSync() const = 0;
+
+		/**
+		 * Advance the device
+		 * @param	cycleCount	Number of CPU cycles that passed
+		 */
+		virtual void Tick(std::uint64_t cycleCount) = 0;
+
+		/**
+		 * Observe a single bus access, only called while the CPU is cycle stepped
+		 * The device is ticked for the cycle of the access right after this call
+		 * @param	cycle		Cycle the access happens on
+		 * @param	address		Address on the bus
+		 * @param	value		Value that was read or written
+		 * @param	isWrite		True for writes, false for reads
+		 */
+		virtual void OnBusAccess(std::uint64_t cycle, std::uint16_t address, std::uint8_t value, bool isWrite) = 0;
+	};
+}
+
+#endif //! NES_CPU_BUS_DEVICE_HPP
@@ -0,0 +1,32 @@
+#include "cpu_decode_cache.hpp"
+
+nes::CpuDecodeCache::CpuDecodeCache(const RAM& ramRef) :
+	RamRef(ramRef)
+{}
+
+void nes::CpuDecodeCache::Clear()
+{
+	for (auto& page : Pages)
+	{
+		page.reset();
+	}
+}
+
+nes::CpuDecodeCache::Page& nes::CpuDecodeCache::AllocatePage(std::size_t pageIndex)
+{
+	// Value-initialized, so every entry has a page version of zero
+	Pages[pageIndex] = std::make_unique<Page>();
+	return *Pages[pageIndex];
+}
+
+nes::DecodedInstruction nes::CpuDecodeCache::Decode(std::uint16_t address) const
+{
+	DecodedInstruction instruction;
+	instruction.PageVersion = 0;
+	instruction.OpCode = RamRef.ReadByte(address).value;
+
+	// Always grab both bytes, instructions simply ignore the ones they do not use
+	instruction.Operand = ConstructAddressFromBytes(RamRef.ReadByte(address + 2), RamRef.ReadByte(address + 1));
+
+	return instruction;
+}
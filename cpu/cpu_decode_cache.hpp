@@ -0,0 +1,115 @@
+#ifndef NES_CPU_DECODE_CACHE_HPP
+#define NES_CPU_DECODE_CACHE_HPP
+
+#include "ram/ram.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace nes
+{
+	/**
+	 * Instruction in its pre-decoded form
+	 */
+	struct DecodedInstruction
+	{
+		// Version of the memory page the instruction was decoded from
+		// Zero means the entry has never been decoded
+		std::uint32_t PageVersion;
+
+		// The two bytes following the op-code (second byte in the high byte)
+		std::uint16_t Operand;
+
+		// Op-code of the instruction
+		std::uint8_t OpCode;
+	};
+
+	/**
+	 * Keeps a pre-decoded copy of every instruction that has been executed,
+	 * indexed by the address of its op-code
+	 *
+	 * Entries are validated against the page versions kept by the RAM, so any
+	 * write to a page (self-modifying code, loading a ROM bank) invalidates all
+	 * entries decoded from that page. Entries are allocated a page at a time,
+	 * the first time code on that page runs, so only pages holding code take
+	 * up memory
+	 */
+	class CpuDecodeCache
+	{
+	public:
+		/**
+		 * Create a new, empty decode cache
+		 * @param	ramRef	Reference to the RAM the instructions are decoded from
+		 */
+		CpuDecodeCache(const RAM& ramRef);
+
+		/**
+		 * Retrieve the instruction at the specified address, decoding it when the
+		 * cached entry is missing or outdated
+		 * @param	address		Address of the op-code
+		 * @return	Decoded instruction
+		 */
+		DecodedInstruction Fetch(std::uint16_t address);
+
+		/**
+		 * Invalidate all entries and release their memory
+		 */
+		void Clear();
+
+	private:
+		// Entries of a single page, indexed by the low byte of the address
+		using Page = std::array<DecodedInstruction, RAM::PAGE_SIZE>;
+
+		/**
+		 * Allocate the entries of a page, all of them marked as never decoded
+		 * @param	pageIndex	Index of the page (high byte of the address)
+		 * @return	Entries of the page
+		 */
+		Page& AllocatePage(std::size_t pageIndex);
+
+		/**
+		 * Decode the instruction at the specified address straight from memory
+		 * @param	address		Address of the op-code
+		 * @return	Decoded instruction, with a page version of zero
+		 */
+		DecodedInstruction Decode(std::uint16_t address) const;
+
+	private:
+		// RAM
+		const RAM& RamRef;
+
+		// Entries of every page, nullptr until code on the page runs
+		std::array<std::unique_ptr<Page>, RAM::PAGE_COUNT> Pages;
+	};
+
+	inline DecodedInstruction CpuDecodeCache::Fetch(std::uint16_t address)
+	{
+		// The operand bytes of instructions at the very end of a page live on the
+		// next page, those are rare enough to simply decode them every time
+		if ((address & 0x00FF) > 0x00FD)
+		{
+			return Decode(address);
+		}
+
+		Page* page = Pages[address >> 8].get();
+		if (page == nullptr)
+		{
+			page = &AllocatePage(address >> 8);
+		}
+
+		DecodedInstruction& entry = (*page)[address & 0xFF];
+		std::uint32_t pageVersion = RamRef.GetPageVersion(static_cast<std::uint8_t>(address >> 8));
+
+		if (entry.PageVersion != pageVersion)
+		{
+			entry = Decode(address);
+			entry.PageVersion = pageVersion;
+		}
+
+		return entry;
+	}
+}
+
+#endif //! NES_CPU_DECODE_CACHE_HPP
@@ -0,0 +1,437 @@
+#include "cpu_differential.hpp"
+#include "cpu_bus_device.hpp"
+#include "ram/ram.hpp"
+
+#include <algorithm>	// std::equal / std::min
+#include <ios>			// std::uppercase / std::hex / std::dec
+#include <iomanip>		// std::setfill / std::setw
+#include <ostream>
+#include <sstream>
+#include <utility>		// std::move
+#include <vector>
+
+namespace
+{
+	/**
+	 * Bus device that never lets the CPU run ahead, so every instruction goes
+	 * through the cycle-stepped core
+	 */
+	class StepEveryCycle : public nes::CpuBusDevice
+	{
+	public:
+		std::uint64_t GetCyclesUntilSync() const override
+		{
+			return 0;
+		}
+
+		void Tick(std::uint64_t /*cycleCount*/) override
+		{
+		}
+
+		void OnBusAccess(std::uint64_t /*cycle*/, std::uint16_t /*address*/, std::uint8_t /*value*/, bool /*isWrite*/) override
+		{
+		}
+	};
+
+	bool StopAfterEveryInstruction(const nes::CPU& /*cpu*/)
+	{
+		return true;
+	}
+
+	struct EngineName
+	{
+		nes::CpuDifferential::Engine Engine;
+		std::string_view Name;
+	};
+
+	constexpr EngineName ENGINE_NAMES[] =
+	{
+		{ nes::CpuDifferential::Engine::InstructionTable,	"table" },
+		{ nes::CpuDifferential::Engine::Interpreter,		"interpreter" },
+		{ nes::CpuDifferential::Engine::CycleStepped,		"cycle" },
+		{ nes::CpuDifferential::Engine::Jit,				"jit" }
+	};
+}
+
+nes::CpuDifferential::CpuDifferential(Engine reference, Engine candidate, std::size_t traceLength) :
+	ReferenceEngine(reference),
+	CandidateEngine(candidate),
+	TraceLength(traceLength),
+	IsAvailable(true),
+	ReferenceRam(std::make_unique<RAM>(RAM::Layout::Flat)),
+	CandidateRam(std::make_unique<RAM>(RAM::Layout::Flat)),
+	ReferenceCpu(std::make_unique<CPU>(*ReferenceRam)),
+	CandidateCpu(std::make_unique<CPU>(*CandidateRam)),
+	SteppingDevice(std::make_unique<StepEveryCycle>()),
+	ReferencePageVersions{},
+	CandidatePageVersions{},
+	MatchedStepCount(0),
+	LastResult(Result::Match),
+	DivergentAddress(0),
+	ReferenceValue(0),
+	CandidateValue(0)
+{
+	CPU* cpus[] = { ReferenceCpu.get(), CandidateCpu.get() };
+	Engine engines[] = { ReferenceEngine, CandidateEngine };
+
+	for (std::size_t i = 0; i < 2; ++i)
+	{
+		if (engines[i] == Engine::CycleStepped)
+		{
+			cpus[i]->SetBusDevice(SteppingDevice.get());
+		}
+		else if (engines[i] == Engine::Jit && !cpus[i]->SetJitEnabled(true))
+		{
+			IsAvailable = false;
+		}
+	}
+
+	SynchronizeCandidate();
+}
+
+nes::CpuDifferential::~CpuDifferential() = default;
+
+nes::CPU& nes::CpuDifferential::GetReferenceCpu()
+{
+	return *ReferenceCpu;
+}
+
+nes::RAM& nes::CpuDifferential::GetReferenceRam()
+{
+	return *ReferenceRam;
+}
+
+void nes::CpuDifferential::SynchronizeCandidate()
+{
+	std::uint8_t state[CPU::STATE_SIZE];
+	ReferenceCpu->WriteState(state);
+	CandidateCpu->ReadState(state);
+
+	std::vector<std::uint8_t> memory(ReferenceRam->GetSize());
+	ReferenceRam->WriteState(memory.data());
+	CandidateRam->ReadState(memory.data());
+
+	for (std::size_t page = 0; page < ReferencePageVersions.size(); ++page)
+	{
+		ReferencePageVersions[page] = ReferenceRam->GetPageVersion(static_cast<std::uint8_t>(page));
+		CandidatePageVersions[page] = CandidateRam->GetPageVersion(static_cast<std::uint8_t>(page));
+	}
+
+	// Translated blocks do not record a trace, so a JIT side is left untraced
+	// to keep it on its fast path. Enabling tracing again also throws away the
+	// instructions of any earlier run
+	ReferenceCpu->DisableTracing();
+	CandidateCpu->DisableTracing();
+
+	if (ReferenceEngine != Engine::Jit && TraceLength != 0)
+	{
+		ReferenceCpu->EnableTracing(TraceLength, nullptr);
+	}
+
+	if (CandidateEngine != Engine::Jit && TraceLength != 0)
+	{
+		CandidateCpu->EnableTracing(TraceLength, nullptr);
+	}
+
+	MatchedStepCount = 0;
+	LastResult = Result::Match;
+}
+
+void nes::CpuDifferential::LoadFuzzInput(const std::uint8_t* data, std::size_t size)
+{
+	std::uint8_t header[FUZZ_HEADER_SIZE] = {};
+	std::copy(data, data + std::min(size, FUZZ_HEADER_SIZE), header);
+
+	// A, X, Y, P, SP and the program counter, no interrupts and cycle 0
+	std::uint8_t state[CPU::STATE_SIZE] = {};
+	std::copy(header, header + 5, state);
+	state[6] = header[5];
+	state[7] = header[6];
+	ReferenceCpu->ReadState(state);
+
+	std::vector<std::uint8_t> knownOpCodes;
+	for (std::uint16_t opCode = 0; opCode < 0x100; ++opCode)
+	{
+		if (ReferenceCpu->GetOpCodeName(static_cast<std::uint8_t>(opCode)) != "???")
+		{
+			knownOpCodes.push_back(static_cast<std::uint8_t>(opCode));
+		}
+	}
+
+	const std::uint8_t* body = data + FUZZ_HEADER_SIZE;
+	std::size_t bodySize = (size > FUZZ_HEADER_SIZE) ? (size - FUZZ_HEADER_SIZE) : 0;
+
+	std::vector<std::uint8_t> memory(ReferenceRam->GetSize());
+	for (std::size_t address = 0; address < memory.size(); ++address)
+	{
+		std::uint8_t value = (bodySize != 0) ? body[address % bodySize] : 0;
+		memory[address] = knownOpCodes[value % knownOpCodes.size()];
+	}
+
+	ReferenceRam->ReadState(memory.data());
+	SynchronizeCandidate();
+}
+
+void nes::CpuDifferential::SetNmiLine(bool asserted)
+{
+	ReferenceCpu->SetNmiLine(asserted);
+	CandidateCpu->SetNmiLine(asserted);
+}
+
+void nes::CpuDifferential::SetIrqLine(CPU::IrqSource source, bool asserted)
+{
+	ReferenceCpu->SetIrqLine(source, asserted);
+	CandidateCpu->SetIrqLine(source, asserted);
+}
+
+nes::CpuDifferential::Result nes::CpuDifferential::Run(std::uint64_t cycleCount)
+{
+	if (!IsAvailable)
+	{
+		LastResult = Result::Unavailable;
+		return LastResult;
+	}
+
+	if (LastResult != Result::Match)
+	{
+		return LastResult;
+	}
+
+	bool usesJit = (ReferenceEngine == Engine::Jit || CandidateEngine == Engine::Jit);
+	std::uint64_t stepCycles = usesJit ? JIT_STEP_CYCLES : 1;
+	std::uint64_t targetCycle = ReferenceCpu->GetCurrentCycle() + cycleCount;
+
+	while (ReferenceCpu->GetCurrentCycle() < targetCycle)
+	{
+		DivergentAddress = ReferenceCpu->GetProgramCounter();
+
+		CPU::StopReason referenceReason = Advance(*ReferenceCpu, ReferenceEngine, stepCycles);
+		CPU::StopReason candidateReason = Advance(*CandidateCpu, CandidateEngine, stepCycles);
+
+		if (referenceReason != candidateReason)
+		{
+			SetDivergence("Jammed", referenceReason == CPU::StopReason::Jammed, candidateReason == CPU::StopReason::Jammed);
+			LastResult = Result::Diverged;
+			return LastResult;
+		}
+
+		if (!CompareSides())
+		{
+			LastResult = Result::Diverged;
+			return LastResult;
+		}
+
+		if (referenceReason == CPU::StopReason::Jammed)
+		{
+			DivergentAddress = ReferenceCpu->GetProgramCounter();
+			LastResult = Result::Jammed;
+			return LastResult;
+		}
+
+		++MatchedStepCount;
+	}
+
+	return LastResult;
+}
+
+std::uint64_t nes::CpuDifferential::GetMatchedStepCount() const
+{
+	return MatchedStepCount;
+}
+
+void nes::CpuDifferential::WriteReport(std::ostream& stream) const
+{
+	std::string_view referenceName = GetEngineName(ReferenceEngine);
+	std::string_view candidateName = GetEngineName(CandidateEngine);
+
+	switch (LastResult)
+	{
+	case Result::Match:
+		stream << "The " << candidateName << " matched the " << referenceName << " for " << MatchedStepCount << " steps\n";
+		return;
+
+	case Result::Unavailable:
+		stream << "The JIT is not available on this machine\n";
+		return;
+
+	case Result::Jammed:
+		stream << "Both sides jammed at $" << std::uppercase << std::hex << std::setfill('0') << std::setw(4) << DivergentAddress
+			<< std::dec << " after " << MatchedStepCount << " matching steps\n";
+		return;
+
+	case Result::Diverged:
+		break;
+	}
+
+	stream << "The " << candidateName << " diverged from the " << referenceName << " after " << MatchedStepCount
+		<< " matching steps, in the step starting at $" << std::uppercase << std::hex << std::setfill('0') << std::setw(4) << DivergentAddress << '\n';
+	stream << "  " << DivergentField << ": $" << ReferenceValue << " on the " << referenceName << ", $"
+		<< CandidateValue << " on the " << candidateName << std::dec << '\n';
+
+	const CPU* cpus[] = { ReferenceCpu.get(), CandidateCpu.get() };
+	std::string_view names[] = { referenceName, candidateName };
+
+	// The last recorded instruction is the one that diverged
+	for (std::size_t i = 0; i < 2; ++i)
+	{
+		if (cpus[i]->IsTracingEnabled())
+		{
+			stream << "Last instructions on the " << names[i] << ":\n";
+			cpus[i]->DumpTrace(stream);
+		}
+	}
+}
+
+std::string_view nes::CpuDifferential::GetEngineName(Engine engine)
+{
+	for (const EngineName& entry : ENGINE_NAMES)
+	{
+		if (entry.Engine == engine)
+		{
+			return entry.Name;
+		}
+	}
+
+	return "???";
+}
+
+bool nes::CpuDifferential::ParseEngineName(std::string_view name, Engine& engine)
+{
+	for (const EngineName& entry : ENGINE_NAMES)
+	{
+		if (entry.Name == name)
+		{
+			engine = entry.Engine;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+nes::CPU::StopReason nes::CpuDifferential::Advance(CPU& cpu, Engine engine, std::uint64_t cycleCount)
+{
+	if (engine == Engine::Jit)
+	{
+		return cpu.RunCycles(cycleCount);
+	}
+
+	std::uint64_t targetCycle = cpu.GetCurrentCycle() + cycleCount;
+	CPU::StopReason reason = CPU::StopReason::CycleBudget;
+
+	while (reason == CPU::StopReason::CycleBudget && cpu.GetCurrentCycle() < targetCycle)
+	{
+		if (engine == Engine::InstructionTable)
+		{
+			reason = cpu.ExecuteTableInstruction();
+		}
+		else
+		{
+			// The cycle-stepped core is picked by the bus device of the CPU
+			reason = cpu.RunUntil(1, StopAfterEveryInstruction);
+			if (reason == CPU::StopReason::Condition)
+			{
+				reason = CPU::StopReason::CycleBudget;
+			}
+		}
+	}
+
+	return reason;
+}
+
+bool nes::CpuDifferential::CompareSides()
+{
+	const CPU& reference = *ReferenceCpu;
+	const CPU& candidate = *CandidateCpu;
+
+	struct Register
+	{
+		const char* Name;
+		CPU::RegisterType Type;
+	};
+
+	static constexpr Register REGISTERS[] =
+	{
+		{ "A", CPU::RegisterType::A },
+		{ "X", CPU::RegisterType::X },
+		{ "Y", CPU::RegisterType::Y },
+		{ "P", CPU::RegisterType::P },
+		{ "SP", CPU::RegisterType::SP }
+	};
+
+	for (const Register& entry : REGISTERS)
+	{
+		std::uint8_t referenceValue = reference.GetRegister(entry.Type).value;
+		std::uint8_t candidateValue = candidate.GetRegister(entry.Type).value;
+
+		if (referenceValue != candidateValue)
+		{
+			SetDivergence(entry.Name, referenceValue, candidateValue);
+			return false;
+		}
+	}
+
+	if (reference.GetProgramCounter() != candidate.GetProgramCounter())
+	{
+		SetDivergence("PC", reference.GetProgramCounter(), candidate.GetProgramCounter());
+		return false;
+	}
+
+	if (reference.GetCurrentCycle() != candidate.GetCurrentCycle())
+	{
+		SetDivergence("Cycle", reference.GetCurrentCycle(), candidate.GetCurrentCycle());
+		return false;
+	}
+
+	// Whatever is left in the state are the interrupt lines
+	std::uint8_t referenceState[CPU::STATE_SIZE];
+	std::uint8_t candidateState[CPU::STATE_SIZE];
+	reference.WriteState(referenceState);
+	candidate.WriteState(candidateState);
+
+	if (!std::equal(referenceState, referenceState + CPU::STATE_SIZE, candidateState))
+	{
+		SetDivergence("Interrupt lines", reference.IsIrqLineAsserted(), candidate.IsIrqLineAsserted());
+		return false;
+	}
+
+	// Only pages that were written to on either side can differ
+	for (std::size_t page = 0; page < ReferencePageVersions.size(); ++page)
+	{
+		std::uint32_t referenceVersion = ReferenceRam->GetPageVersion(static_cast<std::uint8_t>(page));
+		std::uint32_t candidateVersion = CandidateRam->GetPageVersion(static_cast<std::uint8_t>(page));
+
+		if (referenceVersion == ReferencePageVersions[page] && candidateVersion == CandidatePageVersions[page])
+		{
+			continue;
+		}
+
+		ReferencePageVersions[page] = referenceVersion;
+		CandidatePageVersions[page] = candidateVersion;
+
+		for (std::size_t offset = 0; offset < 0x100; ++offset)
+		{
+			std::uint16_t address = static_cast<std::uint16_t>((page << 8) | offset);
+			std::uint8_t referenceValue = ReferenceRam->ReadByte(address).value;
+			std::uint8_t candidateValue = CandidateRam->ReadByte(address).value;
+
+			if (referenceValue != candidateValue)
+			{
+				std::ostringstream field;
+				field << "Memory at $" << std::uppercase << std::hex << std::setfill('0') << std::setw(4) << address;
+
+				SetDivergence(field.str(), referenceValue, candidateValue);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+void nes::CpuDifferential::SetDivergence(std::string field, std::uint64_t reference, std::uint64_t candidate)
+{
+	DivergentField = std::move(field);
+	ReferenceValue = reference;
+	CandidateValue = candidate;
+}
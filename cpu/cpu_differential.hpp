@@ -0,0 +1,223 @@
+#ifndef NES_CPU_DIFFERENTIAL_HPP
+#define NES_CPU_DIFFERENTIAL_HPP
+
+#include "cpu.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace nes
+{
+	class RAM;
+
+	/**
+	 * Runs the same program on two execution engines in lockstep and stops at
+	 * the first point where they disagree
+	 *
+	 * Both sides are an ordinary CPU with its own RAM. The reference side is
+	 * set up through the usual interfaces and copied over to the candidate
+	 * side. After every step the registers, the cycle counter, the interrupt
+	 * lines and every memory page either side wrote to are compared.
+	 *
+	 * A step is a single instruction, or entering an interrupt, on every engine
+	 * except the JIT. Translated blocks cannot stop halfway through, so as soon
+	 * as one side uses the JIT both sides run JIT_STEP_CYCLES at a time and are
+	 * compared in between.
+	 */
+	class CpuDifferential
+	{
+	public:
+		/**
+		 * Ways a CPU can execute instructions
+		 */
+		enum class Engine
+		{
+			InstructionTable,	// Op-code handler objects, see CPU::ExecuteTableInstruction
+			Interpreter,		// Backend the core was compiled with
+			CycleStepped,		// Every bus access on its own cycle
+			Jit					// Translated blocks, where the JIT is available
+		};
+
+		/**
+		 * Outcome of a run
+		 */
+		enum class Result
+		{
+			Match,			// Both sides agreed for the entire run
+			Diverged,		// The sides disagree after the last step
+			Jammed,			// Both sides got stuck on the same unknown op-code
+			Unavailable		// One of the engines cannot run on this machine
+		};
+
+		/** Number of cycles every step takes while one of the sides uses the JIT */
+		static constexpr std::uint64_t JIT_STEP_CYCLES = 256;
+
+		/** Size of the input taken by LoadFuzzInput before the memory contents */
+		static constexpr std::size_t FUZZ_HEADER_SIZE = 7;
+
+	public:
+		/**
+		 * Create both sides with cleared RAM and a CPU in its default state
+		 * @param	reference	Engine the candidate is checked against
+		 * @param	candidate	Engine being checked
+		 * @param	traceLength	Number of instructions to show leading up to a
+		 *						divergence
+		 */
+		CpuDifferential(Engine reference, Engine candidate, std::size_t traceLength);
+
+		// CPUs refer to the RAM of their side
+		CpuDifferential(const CpuDifferential& other)				= delete;
+		CpuDifferential(CpuDifferential&& other)					= delete;
+		CpuDifferential& operator=(const CpuDifferential& other)	= delete;
+		CpuDifferential& operator=(CpuDifferential&& other)			= delete;
+
+		/**
+		 * Deallocate any used resources
+		 */
+		~CpuDifferential();
+
+		/**
+		 * Retrieve the CPU of the reference side, to set it up before calling
+		 * SynchronizeCandidate
+		 * @return	Reference CPU
+		 */
+		CPU& GetReferenceCpu();
+
+		/**
+		 * Retrieve the RAM of the reference side, to set it up before calling
+		 * SynchronizeCandidate
+		 * @return	Reference RAM
+		 */
+		RAM& GetReferenceRam();
+
+		/**
+		 * Copy the CPU state and the memory of the reference side over to the
+		 * candidate side, and start counting steps from zero
+		 */
+		void SynchronizeCandidate();
+
+		/**
+		 * Set up both sides from an arbitrary string of bytes, as produced by a
+		 * fuzzer
+		 * The first FUZZ_HEADER_SIZE bytes hold A, X, Y, P, SP and the program
+		 * counter (little-endian). The remaining bytes are repeated over the
+		 * entire memory, with every byte mapped onto a known op-code, so
+		 * wherever control flow ends up it decodes a real instruction instead of
+		 * jamming right away. Missing bytes count as zero
+		 * @param	data	Input bytes
+		 * @param	size	Number of input bytes
+		 */
+		void LoadFuzzInput(const std::uint8_t* data, std::size_t size);
+
+		/**
+		 * Drive the NMI input of both sides, see CPU::SetNmiLine
+		 * @param	asserted	True to pull the line low, false to release it
+		 */
+		void SetNmiLine(bool asserted);
+
+		/**
+		 * Drive an IRQ input of both sides, see CPU::SetIrqLine
+		 * @param	source		Device driving the line
+		 * @param	asserted	True to pull the line low, false to release it
+		 */
+		void SetIrqLine(CPU::IrqSource source, bool asserted);
+
+		/**
+		 * Step both sides until the reference side has run for at least the
+		 * specified number of cycles, comparing them after every step
+		 * @param	cycleCount	Number of cycles to run for
+		 * @return	Outcome of the run
+		 */
+		Result Run(std::uint64_t cycleCount);
+
+		/**
+		 * Retrieve the number of steps both sides agreed on since the last
+		 * synchronization
+		 * @return	Number of matching steps
+		 */
+		std::uint64_t GetMatchedStepCount() const;
+
+		/**
+		 * Describe where and why the last run stopped, followed by the last
+		 * instructions of both sides
+		 * @param	stream	Stream to write the report to
+		 */
+		void WriteReport(std::ostream& stream) const;
+
+		/**
+		 * Retrieve the name of an engine, as accepted by ParseEngineName
+		 * @param	engine	Engine to name
+		 * @return	"table", "interpreter", "cycle" or "jit"
+		 */
+		static std::string_view GetEngineName(Engine engine);
+
+		/**
+		 * Look up an engine by its name
+		 * @param	name	Name of the engine
+		 * @param	engine	Set to the engine when the name is known
+		 * @return	True when the name is known
+		 */
+		static bool ParseEngineName(std::string_view name, Engine& engine);
+
+	private:
+		/**
+		 * Run a CPU on an engine until at least the specified number of cycles
+		 * has passed
+		 * @param	cpu			CPU to run
+		 * @param	engine		Engine to run it on
+		 * @param	cycleCount	Number of cycles to run for, 1 runs a single step
+		 * @return	Jammed when the CPU got stuck, CycleBudget otherwise
+		 */
+		static CPU::StopReason Advance(CPU& cpu, Engine engine, std::uint64_t cycleCount);
+
+		/**
+		 * Compare the state of both sides after a step
+		 * @return	True when both sides agree
+		 */
+		bool CompareSides();
+
+		/**
+		 * Remember where both sides disagree
+		 * @param	field		Name of what differs
+		 * @param	reference	Value on the reference side
+		 * @param	candidate	Value on the candidate side
+		 */
+		void SetDivergence(std::string field, std::uint64_t reference, std::uint64_t candidate);
+
+	private:
+		Engine ReferenceEngine;
+		Engine CandidateEngine;
+		std::size_t TraceLength;
+		bool IsAvailable;
+
+		std::unique_ptr<RAM> ReferenceRam;
+		std::unique_ptr<RAM> CandidateRam;
+		std::unique_ptr<CPU> ReferenceCpu;
+		std::unique_ptr<CPU> CandidateCpu;
+
+		// Asks for cycle stepping before every instruction, shared by both sides
+		std::unique_ptr<CpuBusDevice> SteppingDevice;
+
+		// Page versions at the last comparison, only pages that changed since
+		// then are compared
+		std::array<std::uint32_t, 0x100> ReferencePageVersions;
+		std::array<std::uint32_t, 0x100> CandidatePageVersions;
+
+		// Comparison progress
+		std::uint64_t MatchedStepCount;
+		Result LastResult;
+
+		// State at the point the sides diverged
+		std::uint16_t DivergentAddress;
+		std::string DivergentField;
+		std::uint64_t ReferenceValue;
+		std::uint64_t CandidateValue;
+	};
+}
+
+#endif //! NES_CPU_DIFFERENTIAL_HPP
@@ -0,0 +1,352 @@
+#include "cpu_golden_log.hpp"
+#include "cpu.hpp"
+#include "cpu_logger.hpp"
+
+#include <algorithm>	// std::min
+#include <ios>			// std::uppercase / std::hex / std::dec
+#include <iomanip>		// std::setfill / std::setw
+#include <limits>
+#include <ostream>
+
+namespace
+{
+	bool IsWhitespace(char character)
+	{
+		return (character == ' ' || character == '\t');
+	}
+
+	/**
+	 * Parse a hexadecimal number of at most maxDigits digits
+	 * @param	text		Text to parse
+	 * @param	position	Position of the first digit, moved past the last digit
+	 * @param	maxDigits	Maximum number of digits to read
+	 * @param	value		Parsed value
+	 * @return	True when at least one digit was read
+	 */
+	bool ParseHex(std::string_view text, std::size_t& position, std::size_t maxDigits, std::uint32_t& value)
+	{
+		std::size_t start = position;
+		value = 0;
+
+		while (position < text.size() && position - start < maxDigits)
+		{
+			char character = text[position];
+			std::uint32_t digit = 0;
+
+			if (character >= '0' && character <= '9')
+			{
+				digit = character - '0';
+			}
+			else if (character >= 'A' && character <= 'F')
+			{
+				digit = character - 'A' + 10;
+			}
+			else if (character >= 'a' && character <= 'f')
+			{
+				digit = character - 'a' + 10;
+			}
+			else
+			{
+				break;
+			}
+
+			value = (value << 4) | digit;
+			++position;
+		}
+
+		return (position != start);
+	}
+
+	/**
+	 * Find a "NAME:" field that starts a word, so "P:" never matches "SP:"
+	 * @param	line		Line to search
+	 * @param	name		Field name including the colon
+	 * @param	position	Position to start searching at, moved past the colon
+	 * @return	True when the field was found
+	 */
+	bool FindField(std::string_view line, std::string_view name, std::size_t& position)
+	{
+		std::size_t found = line.find(name, position);
+
+		while (found != std::string_view::npos && found != 0 && !IsWhitespace(line[found - 1]))
+		{
+			found = line.find(name, found + 1);
+		}
+
+		if (found == std::string_view::npos)
+		{
+			return false;
+		}
+
+		position = found + name.size();
+		return true;
+	}
+
+	bool ParseByteField(std::string_view line, std::string_view name, std::size_t& position, std::uint8_t& value)
+	{
+		std::uint32_t parsed = 0;
+		if (!FindField(line, name, position) || !ParseHex(line, position, 2, parsed))
+		{
+			return false;
+		}
+
+		value = static_cast<std::uint8_t>(parsed);
+		return true;
+	}
+}
+
+nes::CpuGoldenLog::CpuGoldenLog(std::size_t contextLineCount) :
+	LogPosition(0),
+	ContextLines(contextLineCount),
+	LineLimit(0),
+	MatchedLineCount(0),
+	LastResult(Result::Match),
+	ActualState()
+{}
+
+bool nes::CpuGoldenLog::Open(std::string_view path)
+{
+	LogPosition = 0;
+	return Log.Open(path);
+}
+
+nes::CpuGoldenLog::Result nes::CpuGoldenLog::Compare(CPU& cpu, std::size_t lineLimit)
+{
+	LogPosition = 0;
+	LineLimit = lineLimit;
+	MatchedLineCount = 0;
+	LastResult = Result::Match;
+	DivergentLine = {};
+	DivergentField = {};
+
+	if (!Log.IsOpen())
+	{
+		LastResult = Result::BadLog;
+		return LastResult;
+	}
+
+	// The first line describes the state before anything executed
+	if (!CompareNextLine(cpu))
+	{
+		return LastResult;
+	}
+
+	CPU::StopReason reason = cpu.RunUntil(std::numeric_limits<std::uint64_t>::max(), [this](const CPU& cpuRef)
+	{
+		return !CompareNextLine(cpuRef);
+	});
+
+	// An unknown op-code leaves the CPU state untouched, so the line that
+	// matched last is the one the CPU got stuck on
+	if (reason == CPU::StopReason::Jammed)
+	{
+		LastResult = Result::Jammed;
+		ActualState = CpuLogger::CaptureRecord(cpu);
+	}
+
+	return LastResult;
+}
+
+std::size_t nes::CpuGoldenLog::GetMatchedLineCount() const
+{
+	return MatchedLineCount;
+}
+
+void nes::CpuGoldenLog::WriteReport(std::ostream& stream, const CPU& cpu) const
+{
+	switch (LastResult)
+	{
+	case Result::Match:
+		stream << "All " << MatchedLineCount << " lines match the reference log\n";
+		return;
+
+	case Result::BadLog:
+		if (!Log.IsOpen())
+		{
+			stream << "No reference log has been opened\n";
+		}
+		else
+		{
+			stream << "Unable to parse line " << (MatchedLineCount + 1) << " of the reference log:\n" << DivergentLine << '\n';
+		}
+		return;
+
+	case Result::Diverged:
+		stream << "CPU state diverged from the reference log at line " << (MatchedLineCount + 1) << " (" << DivergentField << ")\n";
+		break;
+
+	case Result::Jammed:
+		stream << "CPU jammed on unknown op-code $" << std::uppercase << std::hex << std::setfill('0') << std::setw(2)
+			<< static_cast<std::uint16_t>(ActualState.OpCode) << std::dec << " at line " << MatchedLineCount << '\n';
+		break;
+	}
+
+	// Lines leading up to the divergence, oldest first
+	std::size_t contextCount = std::min(MatchedLineCount, ContextLines.size());
+	for (std::size_t i = MatchedLineCount - contextCount; i < MatchedLineCount; ++i)
+	{
+		stream << std::setfill(' ') << std::setw(8) << (i + 1) << "  " << ContextLines[i % ContextLines.size()] << '\n';
+	}
+
+	if (LastResult == Result::Diverged)
+	{
+		std::uint8_t opCodeSize = cpu.GetOpCodeSize(ActualState.OpCode);
+
+		stream << "expected  " << DivergentLine << '\n';
+		stream << "actual    " << CpuLogger::ConstructStreamFromRecord(ActualState, cpu.GetOpCodeName(ActualState.OpCode), opCodeSize).str() << '\n';
+	}
+}
+
+bool nes::CpuGoldenLog::CompareNextLine(const CPU& cpu)
+{
+	if (LineLimit != 0 && MatchedLineCount >= LineLimit)
+	{
+		return false;
+	}
+
+	std::string_view line;
+	if (!ReadLine(line))
+	{
+		return false;
+	}
+
+	Entry expected;
+	if (!ParseLine(line, expected))
+	{
+		LastResult = Result::BadLog;
+		DivergentLine = line;
+		return false;
+	}
+
+	ActualState = CpuLogger::CaptureRecord(cpu);
+
+	// Report the first field that differs
+	if (expected.PC != ActualState.PC)
+	{
+		DivergentField = "PC";
+	}
+	else if (expected.OpCode != ActualState.OpCode)
+	{
+		DivergentField = "op-code";
+	}
+	else if (expected.A != ActualState.A)
+	{
+		DivergentField = "A";
+	}
+	else if (expected.X != ActualState.X)
+	{
+		DivergentField = "X";
+	}
+	else if (expected.Y != ActualState.Y)
+	{
+		DivergentField = "Y";
+	}
+	else if (expected.P != ActualState.P)
+	{
+		DivergentField = "P";
+	}
+	else if (expected.SP != ActualState.SP)
+	{
+		DivergentField = "SP";
+	}
+	else if (expected.HasCycle && expected.Cycle != ActualState.Cycle)
+	{
+		DivergentField = "CYC";
+	}
+
+	if (!DivergentField.empty())
+	{
+		LastResult = Result::Diverged;
+		DivergentLine = line;
+		return false;
+	}
+
+	if (!ContextLines.empty())
+	{
+		ContextLines[MatchedLineCount % ContextLines.size()] = line;
+	}
+
+	++MatchedLineCount;
+	return true;
+}
+
+bool nes::CpuGoldenLog::ReadLine(std::string_view& line)
+{
+	std::string_view remaining(reinterpret_cast<const char*>(Log.GetData()) + LogPosition, Log.GetSize() - LogPosition);
+	if (remaining.empty())
+	{
+		return false;
+	}
+
+	std::size_t lineEnd = remaining.find('\n');
+	if (lineEnd == std::string_view::npos)
+	{
+		lineEnd = remaining.size();
+		LogPosition += lineEnd;
+	}
+	else
+	{
+		LogPosition += lineEnd + 1;
+	}
+
+	line = remaining.substr(0, lineEnd);
+
+	// Logs created on Windows end their lines with "\r\n"
+	if (!line.empty() && line.back() == '\r')
+	{
+		line.remove_suffix(1);
+	}
+
+	return true;
+}
+
+bool nes::CpuGoldenLog::ParseLine(std::string_view line, Entry& entry)
+{
+	std::size_t position = 0;
+	std::uint32_t value = 0;
+
+	// Program counter, followed by the instruction bytes
+	if (!ParseHex(line, position, 4, value))
+	{
+		return false;
+	}
+	entry.PC = static_cast<std::uint16_t>(value);
+
+	while (position < line.size() && IsWhitespace(line[position]))
+	{
+		++position;
+	}
+
+	if (!ParseHex(line, position, 2, value))
+	{
+		return false;
+	}
+	entry.OpCode = static_cast<std::uint8_t>(value);
+
+	if (!ParseByteField(line, "A:", position, entry.A) ||
+		!ParseByteField(line, "X:", position, entry.X) ||
+		!ParseByteField(line, "Y:", position, entry.Y) ||
+		!ParseByteField(line, "P:", position, entry.P) ||
+		!ParseByteField(line, "SP:", position, entry.SP))
+	{
+		return false;
+	}
+
+	// Old versions of nestest.log store the PPU dot in "CYC:" and add a
+	// scanline in "SL:", only a CPU cycle count is worth comparing
+	entry.Cycle = 0;
+	entry.HasCycle = false;
+
+	std::size_t scanlinePosition = position;
+	if (FindField(line, "CYC:", position) && !FindField(line, "SL:", scanlinePosition))
+	{
+		while (position < line.size() && line[position] >= '0' && line[position] <= '9')
+		{
+			entry.Cycle = entry.Cycle * 10 + (line[position] - '0');
+			entry.HasCycle = true;
+			++position;
+		}
+	}
+
+	return true;
+}
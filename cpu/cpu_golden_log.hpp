@@ -0,0 +1,146 @@
+#ifndef NES_CPU_GOLDEN_LOG_HPP
+#define NES_CPU_GOLDEN_LOG_HPP
+
+#include "cpu_trace_recorder.hpp"
+#include "io/mapped_file.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string_view>
+#include <vector>
+
+namespace nes
+{
+	class CPU;
+
+	/**
+	 * Compares the instructions a CPU executes against a reference log, such as
+	 * the nestest.log that ships with the nestest ROM
+	 *
+	 * Every line of the reference log describes the CPU state right before an
+	 * instruction executes. The program counter and op-code are read from the
+	 * first two columns, the registers from the "A:", "X:", "Y:", "P:" and "SP:"
+	 * fields and the cycle from the optional "CYC:" field. Everything else on
+	 * the line, such as the disassembly or PPU timing, is ignored. This means
+	 * both nestest.log and the output of CpuLogger can be used as a reference.
+	 *
+	 * The log is mapped into memory and parsed in place, nothing is copied.
+	 */
+	class CpuGoldenLog
+	{
+	public:
+		/**
+		 * Outcome of a comparison
+		 */
+		enum class Result
+		{
+			Match,		// Every line of the log matched
+			Diverged,	// The CPU state differs from the log
+			Jammed,		// The CPU got stuck on an unknown op-code
+			BadLog		// A line of the log could not be parsed
+		};
+
+	public:
+		/**
+		 * Create a new comparer, no log is opened yet
+		 * @param	contextLineCount	Number of matching lines to show before the
+		 *								first divergence
+		 */
+		CpuGoldenLog(std::size_t contextLineCount);
+
+		/**
+		 * Map a reference log into memory
+		 * @param	path	Path to the reference log
+		 * @return	True when the log could be opened, false otherwise
+		 */
+		bool Open(std::string_view path);
+
+		/**
+		 * Run the CPU from its current state and compare the state before every
+		 * instruction against the next line of the log
+		 * Stops at the first line that does not match
+		 * @param	cpu			CPU to run, its program counter should already
+		 *						point to the first instruction of the log
+		 * @param	lineLimit	Maximum number of lines to compare, 0 compares
+		 *						the entire log
+		 * @return	Outcome of the comparison
+		 */
+		Result Compare(CPU& cpu, std::size_t lineLimit);
+
+		/**
+		 * Retrieve the number of lines that matched during the last comparison
+		 * @return	Number of matching lines
+		 */
+		std::size_t GetMatchedLineCount() const;
+
+		/**
+		 * Describe where and why the last comparison stopped, followed by the
+		 * lines leading up to it, the expected line and the actual CPU state
+		 * @param	stream	Stream to write the report to
+		 * @param	cpu		CPU that was compared, used to name op-codes
+		 */
+		void WriteReport(std::ostream& stream, const CPU& cpu) const;
+
+	private:
+		/**
+		 * CPU state described by a single line of the log
+		 */
+		struct Entry
+		{
+			std::uint64_t Cycle;
+			std::uint16_t PC;
+			std::uint8_t OpCode;
+			std::uint8_t A;
+			std::uint8_t X;
+			std::uint8_t Y;
+			std::uint8_t P;
+			std::uint8_t SP;
+			bool HasCycle;
+		};
+
+	private:
+		/**
+		 * Compare the CPU state against the next line of the log
+		 * @param	cpu		CPU to compare
+		 * @return	True when the comparison should continue, false when it stops
+		 */
+		bool CompareNextLine(const CPU& cpu);
+
+		/**
+		 * Take the next line from the log
+		 * @param	line	Line without its line ending
+		 * @return	True when there was a line left, false at the end of the log
+		 */
+		bool ReadLine(std::string_view& line);
+
+		/**
+		 * Parse a line of the log
+		 * @param	line	Line to parse
+		 * @param	entry	Entry to store the result in
+		 * @return	True when the line holds all required fields
+		 */
+		static bool ParseLine(std::string_view line, Entry& entry);
+
+	private:
+		MappedFile Log;
+
+		// Read position in the log
+		std::size_t LogPosition;
+
+		// Lines that matched most recently, used as a ring buffer
+		std::vector<std::string_view> ContextLines;
+
+		// Comparison progress
+		std::size_t LineLimit;
+		std::size_t MatchedLineCount;
+		Result LastResult;
+
+		// State at the point the comparison stopped
+		std::string_view DivergentLine;
+		std::string_view DivergentField;
+		CpuTraceRecord ActualState;
+	};
+}
+
+#endif //! NES_CPU_GOLDEN_LOG_HPP
@@ -0,0 +1,1277 @@
+#include "cpu.hpp"
+#include "cpu_bus_device.hpp"
+#include "cpu_watchpoints.hpp"
+#include "ram/ram.hpp"
+#include "flags/cpu_b_flags.hpp"
+#include "instructions/cpu_instruction_addressing_mode.hpp"
+#include "utility/bit_tools.hpp"
+
+#include <type_traits>	// std::conditional_t
+
+/**
+ * Switch-based interpreter backend
+ *
+ * Instead of dispatching every op-code through a CpuInstructionBase object, this
+ * backend decodes op-codes in a single loop. All registers are copied into a
+ * local register file for the length of a run, so the compiler is free to keep
+ * them in machine registers. Op-codes and operand bytes come from the decode
+ * cache. The semantics match the instruction classes in cpu/instructions
+ * exactly, both backends must produce identical results.
+ *
+ * Status flags are evaluated lazily. Instead of updating the bits of P after
+ * every ALU operation, the register file keeps the carry as 0 or 1 and the
+ * values the zero, negative and overflow flags are derived from. P is only
+ * assembled when something looks at it (PHP, BRK, and the end of the run).
+ *
+ * When NES_CPU_COMPUTED_GOTO is defined (GCC / Clang only), the switch is
+ * replaced by a table of label addresses, which gives every handler its own
+ * indirect jump to the next op-code.
+ *
+ * The same loop also implements the cycle-stepped core. All memory accesses go
+ * through a bus object: FastBus accesses memory directly and adds the cycles of
+ * an instruction in one go, SteppedBus turns every access into a timed bus
+ * cycle, including the instruction fetches and dummy accesses of a real 6502,
+ * and ticks the attached CpuBusDevice after each of them. Accesses that only
+ * matter for timing compile to nothing on the fast bus.
+ */
+
+namespace
+{
+	/**
+	 * Local copy of the CPU registers used for the length of a run
+	 */
+	struct Registers
+	{
+		std::uint8_t A;
+		std::uint8_t X;
+		std::uint8_t Y;
+		std::uint8_t SP;
+		std::uint16_t PC;
+		std::uint64_t Cycle;
+
+		// Interrupt disable, decimal mode and bits 4 and 5, the remaining
+		// flags are always clear in here
+		std::uint8_t P;
+
+		// Carry flag, either 0 or 1
+		std::uint8_t Carry;
+
+		// Zero flag is set when this is 0
+		std::uint8_t ZeroResult;
+
+		// Negative flag mirrors bit 7
+		std::uint8_t NegativeResult;
+
+		// Overflow flag mirrors bit 7
+		std::uint8_t OverflowResult;
+	};
+
+	/**
+	 * Bus of the regular interpreter, instructions take all of their cycles at
+	 * once when they complete
+	 */
+	class FastBus
+	{
+	public:
+		FastBus(nes::RAM& ram, Registers& regs, nes::CpuBusDevice*, nes::CpuWatchpoints& watchpoints) :
+			Ram(ram),
+			Regs(regs),
+			Watchpoints(watchpoints),
+			InstructionAddress(0)
+		{}
+
+		/**
+		 * Start an instruction by fetching its op-code and operand bytes, the
+		 * bytes themselves come from the decode cache
+		 */
+		void Fetch(std::uint16_t address, std::uint8_t)
+		{
+			InstructionAddress = address;
+		}
+
+		/**
+		 * Bus access whose value is never used, such as a dummy read
+		 */
+		void Touch(std::uint16_t)
+		{}
+
+		/**
+		 * Write that puts back the value that is already there, as done by
+		 * read-modify-write instructions before the actual write
+		 */
+		void TouchWrite(std::uint16_t, std::uint8_t)
+		{}
+
+		std::uint8_t Read(std::uint16_t address)
+		{
+			std::uint8_t value = Ram.ReadByte(address).value;
+
+			if (Watchpoints.IsWatched(address, nes::CpuWatchpoints::Access::Read))
+			{
+				Watchpoints.Check(nes::CpuWatchpoints::Access::Read, address, value, InstructionAddress, Regs.Cycle);
+			}
+
+			return value;
+		}
+
+		void Write(std::uint16_t address, std::uint8_t value)
+		{
+			nes::Byte byte;
+			byte.value = value;
+			Ram.WriteByte(address, byte);
+
+			if (Watchpoints.IsWatched(address, nes::CpuWatchpoints::Access::Write))
+			{
+				Watchpoints.Check(nes::CpuWatchpoints::Access::Write, address, value, InstructionAddress, Regs.Cycle);
+			}
+		}
+
+		/**
+		 * Retrieve the address the stack pointer points to
+		 */
+		std::uint16_t GetStackAddress() const
+		{
+			// Stack grows downwards
+			return Ram.STACK_START_ADDRESS - Regs.SP;
+		}
+
+		/**
+		 * Clear a byte without a bus access, used when popping the stack
+		 */
+		void Clear(std::uint16_t address)
+		{
+			Ram.ClearByte(address);
+		}
+
+		/**
+		 * Finish an instruction
+		 * @param	cycleCount	Total number of cycles the instruction takes
+		 */
+		void Complete(std::uint8_t cycleCount)
+		{
+			Regs.Cycle += cycleCount;
+		}
+
+	protected:
+		nes::RAM& Ram;
+		Registers& Regs;
+		nes::CpuWatchpoints& Watchpoints;
+
+		// Address of the op-code of the current instruction, reported with
+		// watchpoint hits
+		std::uint16_t InstructionAddress;
+	};
+
+	/**
+	 * Bus of the cycle-stepped core, every access takes exactly one cycle
+	 */
+	class SteppedBus : public FastBus
+	{
+	public:
+		SteppedBus(nes::RAM& ram, Registers& regs, nes::CpuBusDevice* device, nes::CpuWatchpoints& watchpoints) :
+			FastBus(ram, regs, device, watchpoints),
+			Device(device),
+			StartCycle(0)
+		{}
+
+		void Fetch(std::uint16_t address, std::uint8_t byteCount)
+		{
+			FastBus::Fetch(address, byteCount);
+			StartCycle = Regs.Cycle;
+
+			for (std::uint8_t i = 0; i < byteCount; ++i)
+			{
+				Touch(address + i);
+			}
+		}
+
+		void Touch(std::uint16_t address)
+		{
+			// Op-code fetches and dummy reads are not seen by read watchpoints,
+			// just like on the regular bus
+			Access(address, Ram.ReadByte(address).value, false);
+		}
+
+		void TouchWrite(std::uint16_t address, std::uint8_t value)
+		{
+			Access(address, value, true);
+		}
+
+		std::uint8_t Read(std::uint16_t address)
+		{
+			std::uint8_t value = FastBus::Read(address);
+			Access(address, value, false);
+			return value;
+		}
+
+		void Write(std::uint16_t address, std::uint8_t value)
+		{
+			FastBus::Write(address, value);
+			Access(address, value, true);
+		}
+
+		void Complete(std::uint8_t cycleCount)
+		{
+			// Internal cycles that have no bus access worth reporting
+			std::uint64_t endCycle = StartCycle + cycleCount;
+			if (Regs.Cycle < endCycle)
+			{
+				Advance(endCycle - Regs.Cycle);
+			}
+		}
+
+	private:
+		void Access(std::uint16_t address, std::uint8_t value, bool isWrite)
+		{
+			if (Device != nullptr)
+			{
+				Device->OnBusAccess(Regs.Cycle, address, value, isWrite);
+			}
+
+			Advance(1);
+		}
+
+		void Advance(std::uint64_t cycleCount)
+		{
+			Regs.Cycle += cycleCount;
+
+			if (Device != nullptr)
+			{
+				Device->Tick(cycleCount);
+			}
+		}
+
+	private:
+		nes::CpuBusDevice* Device;
+
+		// Cycle the current instruction started on
+		std::uint64_t StartCycle;
+	};
+
+	inline void SetFlag(Registers& regs, nes::StatusFlags flag, bool state)
+	{
+		switch (flag)
+		{
+			case nes::StatusFlags::Carry:
+				regs.Carry = state ? 1 : 0;
+				break;
+			case nes::StatusFlags::Zero:
+				regs.ZeroResult = state ? 0 : 1;
+				break;
+			case nes::StatusFlags::Negative:
+				regs.NegativeResult = state ? 0x80 : 0;
+				break;
+			case nes::StatusFlags::Overflow:
+				regs.OverflowResult = state ? 0x80 : 0;
+				break;
+			default:
+				if (state)
+				{
+					regs.P |= static_cast<std::uint8_t>(flag);
+				}
+				else
+				{
+					regs.P &= ~static_cast<std::uint8_t>(flag);
+				}
+				break;
+		}
+	}
+
+	inline bool IsFlagSet(const Registers& regs, nes::StatusFlags flag)
+	{
+		switch (flag)
+		{
+			case nes::StatusFlags::Carry:
+				return (regs.Carry != 0);
+			case nes::StatusFlags::Zero:
+				return (regs.ZeroResult == 0);
+			case nes::StatusFlags::Negative:
+				return nes::IsNthBitSet(regs.NegativeResult, 7);
+			case nes::StatusFlags::Overflow:
+				return nes::IsNthBitSet(regs.OverflowResult, 7);
+			default:
+				return ((regs.P & static_cast<std::uint8_t>(flag)) != 0);
+		}
+	}
+
+	inline void UpdateZeroNegative(Registers& regs, std::uint8_t value)
+	{
+		regs.ZeroResult = value;
+		regs.NegativeResult = value;
+	}
+
+	/**
+	 * Assemble the processor status register from the lazily evaluated flags
+	 */
+	inline std::uint8_t BuildStatusRegister(const Registers& regs)
+	{
+		std::uint8_t status = regs.P | regs.Carry | (regs.NegativeResult & 0x80) | ((regs.OverflowResult & 0x80) >> 1);
+
+		if (regs.ZeroResult == 0)
+		{
+			status |= static_cast<std::uint8_t>(nes::StatusFlags::Zero);
+		}
+
+		return status;
+	}
+
+	/**
+	 * Split a processor status register into the lazily evaluated flags
+	 */
+	inline void SplitStatusRegister(Registers& regs, std::uint8_t status)
+	{
+		regs.P = status & 0x3C;
+		regs.Carry = status & 0x01;
+		regs.ZeroResult = (status & 0x02) ? 0 : 1;
+		regs.NegativeResult = status & 0x80;
+		regs.OverflowResult = static_cast<std::uint8_t>(status << 1);
+	}
+
+	template <typename Bus>
+	inline void PushStack(Bus& bus, Registers& regs, std::uint8_t value)
+	{
+		bus.Write(bus.GetStackAddress(), value);
+		--regs.SP;
+	}
+
+	template <typename Bus>
+	inline std::uint8_t PopStack(Bus& bus, Registers& regs)
+	{
+		++regs.SP;
+
+		std::uint16_t address = bus.GetStackAddress();
+		std::uint8_t value = bus.Read(address);
+
+		// Clear value from stack
+		bus.Clear(address);
+
+		return value;
+	}
+
+	/**
+	 * Same as CPU::GetTargetAddress, but operating on the local register file
+	 */
+	template <nes::AddressingMode Mode, typename Bus>
+	inline std::uint16_t GetTargetAddress(Bus& bus, const Registers& regs, std::uint16_t operand, bool& pageCrossed)
+	{
+		pageCrossed = false;
+
+		if constexpr (Mode == nes::AddressingMode::Immediate)
+		{
+			return regs.PC + 1;
+		}
+		else if constexpr (Mode == nes::AddressingMode::Absolute)
+		{
+			return operand;
+		}
+		else if constexpr (Mode == nes::AddressingMode::AbsoluteX || Mode == nes::AddressingMode::AbsoluteY)
+		{
+			std::uint16_t address = operand;
+			std::uint16_t targetAddress = address + ((Mode == nes::AddressingMode::AbsoluteX) ? regs.X : regs.Y);
+
+			pageCrossed = ((address & 0xFF00) != (targetAddress & 0xFF00));
+			return targetAddress;
+		}
+		else if constexpr (Mode == nes::AddressingMode::Indirect)
+		{
+			// The high byte is read without carrying into the page, so a
+			// pointer at $xxFF wraps around to $xx00
+			std::uint8_t lsb = bus.Read(operand);
+			return nes::ConstructAddressFromBytes(bus.Read((operand & 0xFF00) | ((operand + 1) & 0x00FF)), lsb);
+		}
+		else if constexpr (Mode == nes::AddressingMode::IndirectX)
+		{
+			// The index is added while the unindexed address is read
+			bus.Touch(static_cast<std::uint8_t>(operand));
+
+			std::uint8_t zeroPageAddress = static_cast<std::uint8_t>(operand) + regs.X;
+			std::uint8_t lsb = bus.Read(zeroPageAddress);
+			return nes::ConstructAddressFromBytes(bus.Read(static_cast<std::uint8_t>(zeroPageAddress + 1)), lsb);
+		}
+		else if constexpr (Mode == nes::AddressingMode::IndirectY)
+		{
+			std::uint8_t zeroPageAddress = static_cast<std::uint8_t>(operand);
+			std::uint8_t lsb = bus.Read(zeroPageAddress);
+			std::uint16_t address = nes::ConstructAddressFromBytes(bus.Read(static_cast<std::uint8_t>(zeroPageAddress + 1)), lsb);
+			std::uint16_t targetAddress = address + regs.Y;
+
+			pageCrossed = ((address & 0xFF00) != (targetAddress & 0xFF00));
+			return targetAddress;
+		}
+		else if constexpr (Mode == nes::AddressingMode::ZeroPage)
+		{
+			return static_cast<std::uint8_t>(operand);
+		}
+		else if constexpr (Mode == nes::AddressingMode::ZeroPageX || Mode == nes::AddressingMode::ZeroPageY)
+		{
+			// The index is added while the unindexed address is read
+			bus.Touch(static_cast<std::uint8_t>(operand));
+			return static_cast<std::uint8_t>(operand + ((Mode == nes::AddressingMode::ZeroPageX) ? regs.X : regs.Y));
+		}
+		else
+		{
+			static_assert(Mode == nes::AddressingMode::ZeroPageY, "Addressing mode does not have a target address.");
+			return 0;
+		}
+	}
+
+	/**
+	 * Indexed addressing modes read from the unfixed address first: the right
+	 * low byte, but the high byte from before the index was added
+	 */
+	inline std::uint16_t GetUnfixedAddress(std::uint16_t address, bool pageCrossed)
+	{
+		return pageCrossed ? static_cast<std::uint16_t>(address - 0x100) : address;
+	}
+
+	/**
+	 * Fetch the operand of a read instruction, apply its cycle cost and move the
+	 * program counter to the next instruction
+	 */
+	template <nes::AddressingMode Mode, typename Bus>
+	inline std::uint8_t FetchOperand(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		bool pageCrossed = false;
+		std::uint8_t value = 0;
+
+		bus.Fetch(regs.PC, nes::GetInstructionSize(Mode));
+
+		if constexpr (Mode == nes::AddressingMode::Immediate)
+		{
+			value = static_cast<std::uint8_t>(operand);
+		}
+		else
+		{
+			std::uint16_t address = GetTargetAddress<Mode>(bus, regs, operand, pageCrossed);
+
+			// Fixing the high byte costs one extra read
+			if (pageCrossed)
+			{
+				bus.Touch(GetUnfixedAddress(address, pageCrossed));
+			}
+
+			value = bus.Read(address);
+		}
+
+		bus.Complete(nes::GetReadCycleCount(Mode) + (pageCrossed ? 1 : 0));
+		regs.PC += nes::GetInstructionSize(Mode);
+		return value;
+	}
+
+	/**
+	 * Store a register to memory
+	 */
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void Store(Bus& bus, Registers& regs, std::uint16_t operand, std::uint8_t value)
+	{
+		bool pageCrossed = false;
+
+		bus.Fetch(regs.PC, nes::GetInstructionSize(Mode));
+		std::uint16_t address = GetTargetAddress<Mode>(bus, regs, operand, pageCrossed);
+
+		// Stores always take the extra read, whether the page was crossed or not
+		if constexpr (Mode == nes::AddressingMode::AbsoluteX || Mode == nes::AddressingMode::AbsoluteY || Mode == nes::AddressingMode::IndirectY)
+		{
+			bus.Touch(GetUnfixedAddress(address, pageCrossed));
+		}
+
+		bus.Write(address, value);
+
+		bus.Complete(nes::GetStoreCycleCount(Mode));
+		regs.PC += nes::GetInstructionSize(Mode);
+	}
+
+	/**
+	 * Apply an operation to the accumulator or a memory location
+	 */
+	template <nes::AddressingMode Mode, typename Bus, typename Operation>
+	inline void ReadModifyWrite(Bus& bus, Registers& regs, std::uint16_t operand, Operation operation)
+	{
+		if constexpr (Mode == nes::AddressingMode::Accumulator)
+		{
+			bus.Fetch(regs.PC, 1);
+			bus.Touch(regs.PC + 1);
+
+			regs.A = operation(regs.A);
+		}
+		else
+		{
+			bool pageCrossed = false;
+
+			bus.Fetch(regs.PC, nes::GetInstructionSize(Mode));
+			std::uint16_t address = GetTargetAddress<Mode>(bus, regs, operand, pageCrossed);
+
+			if constexpr (Mode == nes::AddressingMode::AbsoluteX)
+			{
+				bus.Touch(GetUnfixedAddress(address, pageCrossed));
+			}
+
+			// The original value is written back while the new one is computed
+			std::uint8_t value = bus.Read(address);
+			bus.TouchWrite(address, value);
+			bus.Write(address, operation(value));
+		}
+
+		bus.Complete(nes::GetReadModifyWriteCycleCount(Mode));
+		regs.PC += nes::GetInstructionSize(Mode);
+	}
+
+	/**
+	 * Single-byte instructions that take two cycles
+	 */
+	template <typename Bus>
+	inline void Implied(Bus& bus, Registers& regs)
+	{
+		bus.Fetch(regs.PC, 1);
+		bus.Touch(regs.PC + 1);
+
+		bus.Complete(2);
+		regs.PC += 1;
+	}
+
+	inline void AddWithCarry(Registers& regs, std::uint8_t value)
+	{
+		std::uint16_t sum = regs.A + value + regs.Carry;
+
+		regs.Carry = static_cast<std::uint8_t>(sum >> 8);
+		regs.OverflowResult = static_cast<std::uint8_t>(~(regs.A ^ value) & (regs.A ^ sum));
+
+		regs.A = static_cast<std::uint8_t>(sum);
+		UpdateZeroNegative(regs, regs.A);
+	}
+
+	inline void Compare(Registers& regs, std::uint8_t registerValue, std::uint8_t value)
+	{
+		regs.Carry = (registerValue >= value) ? 1 : 0;
+		UpdateZeroNegative(regs, static_cast<std::uint8_t>(registerValue - value));
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void ADC(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		AddWithCarry(regs, FetchOperand<Mode>(bus, regs, operand));
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void SBC(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		// Subtraction is addition of the inverted operand
+		AddWithCarry(regs, ~FetchOperand<Mode>(bus, regs, operand));
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void AND(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		regs.A &= FetchOperand<Mode>(bus, regs, operand);
+		UpdateZeroNegative(regs, regs.A);
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void ORA(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		regs.A |= FetchOperand<Mode>(bus, regs, operand);
+		UpdateZeroNegative(regs, regs.A);
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void EOR(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		regs.A ^= FetchOperand<Mode>(bus, regs, operand);
+		UpdateZeroNegative(regs, regs.A);
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void BIT(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		std::uint8_t value = FetchOperand<Mode>(bus, regs, operand);
+
+		regs.ZeroResult = regs.A & value;
+		regs.NegativeResult = value;
+
+		// Overflow takes bit 6 of the value
+		regs.OverflowResult = static_cast<std::uint8_t>(value << 1);
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void CMP(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		Compare(regs, regs.A, FetchOperand<Mode>(bus, regs, operand));
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void CPX(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		Compare(regs, regs.X, FetchOperand<Mode>(bus, regs, operand));
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void CPY(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		Compare(regs, regs.Y, FetchOperand<Mode>(bus, regs, operand));
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void LDA(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		regs.A = FetchOperand<Mode>(bus, regs, operand);
+		UpdateZeroNegative(regs, regs.A);
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void LDX(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		regs.X = FetchOperand<Mode>(bus, regs, operand);
+		UpdateZeroNegative(regs, regs.X);
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void LDY(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		regs.Y = FetchOperand<Mode>(bus, regs, operand);
+		UpdateZeroNegative(regs, regs.Y);
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void ASL(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		ReadModifyWrite<Mode>(bus, regs, operand, [&regs](std::uint8_t value)
+		{
+			// Set carry to the old contents of bit 7
+			regs.Carry = value >> 7;
+			value <<= 1;
+			UpdateZeroNegative(regs, value);
+			return value;
+		});
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void LSR(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		ReadModifyWrite<Mode>(bus, regs, operand, [&regs](std::uint8_t value)
+		{
+			regs.Carry = value & 0x01;
+			value >>= 1;
+			UpdateZeroNegative(regs, value);
+			return value;
+		});
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void ROL(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		ReadModifyWrite<Mode>(bus, regs, operand, [&regs](std::uint8_t value)
+		{
+			// Old carry becomes the new bit 0, old bit 7 the new carry
+			std::uint8_t carry = value >> 7;
+			value = static_cast<std::uint8_t>((value << 1) | regs.Carry);
+			regs.Carry = carry;
+			UpdateZeroNegative(regs, value);
+			return value;
+		});
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void ROR(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		ReadModifyWrite<Mode>(bus, regs, operand, [&regs](std::uint8_t value)
+		{
+			// Old carry becomes the new bit 7, old bit 0 the new carry
+			std::uint8_t carry = value & 0x01;
+			value = static_cast<std::uint8_t>((value >> 1) | (regs.Carry << 7));
+			regs.Carry = carry;
+			UpdateZeroNegative(regs, value);
+			return value;
+		});
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void INC(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		ReadModifyWrite<Mode>(bus, regs, operand, [&regs](std::uint8_t value)
+		{
+			++value;
+			UpdateZeroNegative(regs, value);
+			return value;
+		});
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void DEC(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		ReadModifyWrite<Mode>(bus, regs, operand, [&regs](std::uint8_t value)
+		{
+			--value;
+			UpdateZeroNegative(regs, value);
+			return value;
+		});
+	}
+
+	template <nes::StatusFlags Flag, bool BranchIfSet, typename Bus>
+	inline void Branch(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		std::uint8_t cycleCount = 2;
+		bus.Fetch(regs.PC, 2);
+
+		if (IsFlagSet(regs, Flag) == BranchIfSet)
+		{
+			std::int8_t displacement = static_cast<std::uint8_t>(operand);
+
+			// The displacement is relative to the instruction after the branch
+			std::uint16_t nextPC = regs.PC + 2;
+			std::uint16_t targetPC = nextPC + displacement;
+
+			// Same page boundary check as CPU::DidProgramCounterCrossPageBoundary
+			bool pageCrossed = (((nextPC ^ targetPC) & 0xFF00) != 0);
+
+			// Taking the branch reads the next op-code, fixing the page reads
+			// from the unfixed target first
+			bus.Touch(nextPC);
+
+			if (pageCrossed)
+			{
+				bus.Touch((nextPC & 0xFF00) | (targetPC & 0x00FF));
+			}
+
+			cycleCount += pageCrossed ? 2 : 1;
+
+			// The size of the instruction is added below
+			regs.PC = targetPC - 2;
+		}
+
+		bus.Complete(cycleCount);
+		regs.PC += 2;
+	}
+
+	template <nes::AddressingMode Mode, typename Bus>
+	inline void JMP(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		bool pageCrossed = false;
+
+		bus.Fetch(regs.PC, 3);
+		regs.PC = GetTargetAddress<Mode>(bus, regs, operand, pageCrossed);
+		bus.Complete((Mode == nes::AddressingMode::Absolute) ? 3 : 5);
+	}
+
+	template <typename Bus>
+	inline void JSR(Bus& bus, Registers& regs, std::uint16_t operand)
+	{
+		// The high byte of the target is only read after the return address
+		// has been pushed
+		bus.Fetch(regs.PC, 2);
+		bus.Touch(bus.GetStackAddress());
+
+		// JSR pushes the address of the next instruction minus one
+		std::uint16_t returnAddress = regs.PC + 2;
+		PushStack(bus, regs, static_cast<std::uint8_t>(returnAddress >> 8));
+		PushStack(bus, regs, static_cast<std::uint8_t>(returnAddress & 0x00FF));
+		bus.Touch(returnAddress);
+
+		bool pageCrossed = false;
+		regs.PC = GetTargetAddress<nes::AddressingMode::Absolute>(bus, regs, operand, pageCrossed);
+		bus.Complete(6);
+	}
+
+	template <typename Bus>
+	inline void RTS(Bus& bus, Registers& regs)
+	{
+		bus.Fetch(regs.PC, 1);
+		bus.Touch(regs.PC + 1);
+		bus.Touch(bus.GetStackAddress());
+
+		std::uint8_t lsb = PopStack(bus, regs);
+		std::uint8_t msb = PopStack(bus, regs);
+		regs.PC = nes::ConstructAddressFromBytes(msb, lsb);
+
+		// The return address is incremented while it is read once more
+		bus.Touch(regs.PC);
+		regs.PC += 1;
+
+		bus.Complete(6);
+	}
+
+	template <typename Bus>
+	inline void BRK(Bus& bus, Registers& regs)
+	{
+		bus.Fetch(regs.PC, 1);
+		bus.Touch(regs.PC + 1);
+
+		// The return address skips the padding byte after the op-code
+		std::uint16_t returnAddress = static_cast<std::uint16_t>(regs.PC + 2);
+
+		PushStack(bus, regs, static_cast<std::uint8_t>(returnAddress >> 8));
+		PushStack(bus, regs, static_cast<std::uint8_t>(returnAddress & 0x00FF));
+		PushStack(bus, regs, BuildStatusRegister(regs) | static_cast<std::uint8_t>(nes::BFlag::Instruction));
+		regs.P |= static_cast<std::uint8_t>(nes::StatusFlags::InterruptDisable);
+
+		// IRQ interrupt vector at 0xFFFE and 0xFFFF
+		std::uint8_t lsb = bus.Read(0xFFFE);
+		regs.PC = nes::ConstructAddressFromBytes(bus.Read(0xFFFF), lsb);
+		bus.Complete(7);
+	}
+
+	/**
+	 * Enter an interrupt handler, which works like BRK without the break flag
+	 */
+	template <typename Bus>
+	inline void Interrupt(Bus& bus, Registers& regs, std::uint16_t vectorAddress)
+	{
+		// The op-code at the program counter is fetched twice and thrown away
+		bus.Fetch(regs.PC, 1);
+		bus.Touch(regs.PC);
+
+		PushStack(bus, regs, static_cast<std::uint8_t>(regs.PC >> 8));
+		PushStack(bus, regs, static_cast<std::uint8_t>(regs.PC & 0x00FF));
+		PushStack(bus, regs, (BuildStatusRegister(regs) & 0xCF) | static_cast<std::uint8_t>(nes::BFlag::Interrupt));
+		regs.P |= static_cast<std::uint8_t>(nes::StatusFlags::InterruptDisable);
+
+		std::uint8_t lsb = bus.Read(vectorAddress);
+		regs.PC = nes::ConstructAddressFromBytes(bus.Read(vectorAddress + 1), lsb);
+		bus.Complete(7);
+	}
+
+	template <typename Bus>
+	inline void RTI(Bus& bus, Registers& regs)
+	{
+		bus.Fetch(regs.PC, 1);
+		bus.Touch(regs.PC + 1);
+		bus.Touch(bus.GetStackAddress());
+
+		// Pulled in the opposite order BRK and interrupts push them
+		SplitStatusRegister(regs, PopStack(bus, regs));
+		std::uint8_t lsb = PopStack(bus, regs);
+		std::uint8_t msb = PopStack(bus, regs);
+		regs.PC = nes::ConstructAddressFromBytes(msb, lsb);
+		bus.Complete(6);
+	}
+
+	template <typename Bus>
+	inline void PHA(Bus& bus, Registers& regs)
+	{
+		bus.Fetch(regs.PC, 1);
+		bus.Touch(regs.PC + 1);
+
+		PushStack(bus, regs, regs.A);
+		bus.Complete(3);
+		regs.PC += 1;
+	}
+
+	template <typename Bus>
+	inline void PHP(Bus& bus, Registers& regs)
+	{
+		bus.Fetch(regs.PC, 1);
+		bus.Touch(regs.PC + 1);
+
+		PushStack(bus, regs, BuildStatusRegister(regs) | static_cast<std::uint8_t>(nes::BFlag::Instruction));
+		bus.Complete(3);
+		regs.PC += 1;
+	}
+
+	template <typename Bus>
+	inline void PLA(Bus& bus, Registers& regs)
+	{
+		bus.Fetch(regs.PC, 1);
+		bus.Touch(regs.PC + 1);
+		bus.Touch(bus.GetStackAddress());
+
+		regs.A = PopStack(bus, regs);
+		UpdateZeroNegative(regs, regs.A);
+		bus.Complete(4);
+		regs.PC += 1;
+	}
+
+	template <typename Bus>
+	inline void PLP(Bus& bus, Registers& regs)
+	{
+		bus.Fetch(regs.PC, 1);
+		bus.Touch(regs.PC + 1);
+		bus.Touch(bus.GetStackAddress());
+
+		// Bits 4 and 5 are not affected by PLP
+		SplitStatusRegister(regs, (regs.P & 0x30) | (PopStack(bus, regs) & 0xCF));
+		bus.Complete(4);
+		regs.PC += 1;
+	}
+}
+
+template <bool CycleStepped>
+nes::CPU::StopReason nes::CPU::RunInterpreterLoop(std::uint64_t instructionCount, std::uint64_t cycleLimit)
+{
+	using Mode = AddressingMode;
+	using Flag = StatusFlags;
+
+	if (instructionCount == 0 || CurrentCycle >= cycleLimit)
+	{
+		return StopReason::CycleBudget;
+	}
+
+	Registers regs {};
+	regs.A = A.value;
+	regs.X = X.value;
+	regs.Y = Y.value;
+	regs.SP = SP.value;
+	regs.PC = PC;
+	regs.Cycle = CurrentCycle;
+	SplitStatusRegister(regs, GetStatusRegister().value);
+
+	using Bus = std::conditional_t<CycleStepped, SteppedBus, FastBus>;
+	Bus bus(RamRef, regs, BusDevice, Watchpoints);
+
+	DecodedInstruction instruction;
+	StopReason reason = StopReason::CycleBudget;
+	const bool checkBreakpoints = (BreakpointCount != 0);
+	const bool checkWatchpoints = !Watchpoints.IsEmpty();
+
+	// Enter the interrupt that is due, NMI first, only called while something
+	// is pending, so the loop tests a single word per instruction
+	auto enterInterrupt = [&]() -> bool
+	{
+		if ((PendingInterrupts & NMI_PENDING) != 0)
+		{
+			PendingInterrupts &= ~NMI_PENDING;
+			Interrupt(bus, regs, NMI_VECTOR_ADDRESS);
+			return true;
+		}
+
+		// Only IRQ sources are left, which wait for the interrupt disable flag
+		if (!IsFlagSet(regs, Flag::InterruptDisable))
+		{
+			Interrupt(bus, regs, IRQ_VECTOR_ADDRESS);
+			return true;
+		}
+
+		return false;
+	};
+
+	// Checked after every instruction
+	#define NES_CHECK_STOP \
+		if (checkWatchpoints && CheckWatchpoints(regs.PC, regs.Cycle)) { reason = StopReason::Watchpoint; goto finished; } \
+		if (checkBreakpoints && Breakpoints[regs.PC]) { reason = StopReason::Breakpoint; goto finished; } \
+		if (--instructionCount == 0 || regs.Cycle >= cycleLimit) { goto finished; }
+
+#if defined(NES_CPU_COMPUTED_GOTO)
+	#define NES_OP(opCode) op_##opCode
+	#define NES_NEXT NES_CHECK_STOP if (PendingInterrupts != 0) { goto interrupt; } instruction = DecodeCache.Fetch(regs.PC); goto *dispatchTable[instruction.OpCode]
+
+	static const void* const dispatchTable[256] =
+	{
+		&&op_0x00,   &&op_0x01,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0x05,   &&op_0x06,   &&op_illegal, &&op_0x08,   &&op_0x09,   &&op_0x0A,   &&op_illegal, &&op_illegal, &&op_0x0D,   &&op_0x0E,   &&op_illegal,
+		&&op_0x10,   &&op_0x11,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0x15,   &&op_0x16,   &&op_illegal, &&op_0x18,   &&op_0x19,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0x1D,   &&op_0x1E,   &&op_illegal,
+		&&op_0x20,   &&op_0x21,   &&op_illegal, &&op_illegal, &&op_0x24,   &&op_0x25,   &&op_0x26,   &&op_illegal, &&op_0x28,   &&op_0x29,   &&op_0x2A,   &&op_illegal, &&op_0x2C,   &&op_0x2D,   &&op_0x2E,   &&op_illegal,
+		&&op_0x30,   &&op_0x31,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0x35,   &&op_0x36,   &&op_illegal, &&op_0x38,   &&op_0x39,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0x3D,   &&op_0x3E,   &&op_illegal,
+		&&op_0x40,   &&op_0x41,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0x45,   &&op_0x46,   &&op_illegal, &&op_0x48,   &&op_0x49,   &&op_0x4A,   &&op_illegal, &&op_0x4C,   &&op_0x4D,   &&op_0x4E,   &&op_illegal,
+		&&op_0x50,   &&op_0x51,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0x55,   &&op_0x56,   &&op_illegal, &&op_0x58,   &&op_0x59,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0x5D,   &&op_0x5E,   &&op_illegal,
+		&&op_0x60,   &&op_0x61,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0x65,   &&op_0x66,   &&op_illegal, &&op_0x68,   &&op_0x69,   &&op_0x6A,   &&op_illegal, &&op_0x6C,   &&op_0x6D,   &&op_0x6E,   &&op_illegal,
+		&&op_0x70,   &&op_0x71,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0x75,   &&op_0x76,   &&op_illegal, &&op_0x78,   &&op_0x79,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0x7D,   &&op_0x7E,   &&op_illegal,
+		&&op_illegal, &&op_0x81,   &&op_illegal, &&op_illegal, &&op_0x84,   &&op_0x85,   &&op_0x86,   &&op_illegal, &&op_0x88,   &&op_illegal, &&op_0x8A,   &&op_illegal, &&op_0x8C,   &&op_0x8D,   &&op_0x8E,   &&op_illegal,
+		&&op_0x90,   &&op_0x91,   &&op_illegal, &&op_illegal, &&op_0x94,   &&op_0x95,   &&op_0x96,   &&op_illegal, &&op_0x98,   &&op_0x99,   &&op_0x9A,   &&op_illegal, &&op_illegal, &&op_0x9D,   &&op_illegal, &&op_illegal,
+		&&op_0xA0,   &&op_0xA1,   &&op_0xA2,   &&op_illegal, &&op_0xA4,   &&op_0xA5,   &&op_0xA6,   &&op_illegal, &&op_0xA8,   &&op_0xA9,   &&op_0xAA,   &&op_illegal, &&op_0xAC,   &&op_0xAD,   &&op_0xAE,   &&op_illegal,
+		&&op_0xB0,   &&op_0xB1,   &&op_illegal, &&op_illegal, &&op_0xB4,   &&op_0xB5,   &&op_0xB6,   &&op_illegal, &&op_0xB8,   &&op_0xB9,   &&op_0xBA,   &&op_illegal, &&op_0xBC,   &&op_0xBD,   &&op_0xBE,   &&op_illegal,
+		&&op_0xC0,   &&op_0xC1,   &&op_illegal, &&op_illegal, &&op_0xC4,   &&op_0xC5,   &&op_0xC6,   &&op_illegal, &&op_0xC8,   &&op_0xC9,   &&op_0xCA,   &&op_illegal, &&op_0xCC,   &&op_0xCD,   &&op_0xCE,   &&op_illegal,
+		&&op_0xD0,   &&op_0xD1,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0xD5,   &&op_0xD6,   &&op_illegal, &&op_0xD8,   &&op_0xD9,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0xDD,   &&op_0xDE,   &&op_illegal,
+		&&op_0xE0,   &&op_0xE1,   &&op_illegal, &&op_illegal, &&op_0xE4,   &&op_0xE5,   &&op_0xE6,   &&op_illegal, &&op_0xE8,   &&op_0xE9,   &&op_0xEA,   &&op_illegal, &&op_0xEC,   &&op_0xED,   &&op_0xEE,   &&op_illegal,
+		&&op_0xF0,   &&op_0xF1,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0xF5,   &&op_0xF6,   &&op_illegal, &&op_0xF8,   &&op_0xF9,   &&op_illegal, &&op_illegal, &&op_illegal, &&op_0xFD,   &&op_0xFE,   &&op_illegal
+	};
+
+	if (PendingInterrupts != 0)
+	{
+		goto interrupt;
+	}
+
+	instruction = DecodeCache.Fetch(regs.PC);
+	goto *dispatchTable[instruction.OpCode];
+
+interrupt:
+	// Entering an interrupt counts as a step of its own
+	if (enterInterrupt())
+	{
+		NES_CHECK_STOP
+
+		if (PendingInterrupts != 0)
+		{
+			goto interrupt;
+		}
+	}
+
+	instruction = DecodeCache.Fetch(regs.PC);
+	goto *dispatchTable[instruction.OpCode];
+#else
+	#define NES_OP(opCode) case opCode
+	#define NES_NEXT break
+
+	for (;;)
+	{
+		// Entering an interrupt counts as a step of its own
+		if (PendingInterrupts != 0 && enterInterrupt())
+		{
+			NES_CHECK_STOP
+			continue;
+		}
+
+		instruction = DecodeCache.Fetch(regs.PC);
+
+		switch (instruction.OpCode)
+		{
+#endif
+			// ADC
+			NES_OP(0x61): ADC<Mode::IndirectX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x65): ADC<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x69): ADC<Mode::Immediate>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x6D): ADC<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x71): ADC<Mode::IndirectY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x75): ADC<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x79): ADC<Mode::AbsoluteY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x7D): ADC<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// AND
+			NES_OP(0x21): AND<Mode::IndirectX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x25): AND<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x29): AND<Mode::Immediate>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x2D): AND<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x31): AND<Mode::IndirectY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x35): AND<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x39): AND<Mode::AbsoluteY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x3D): AND<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// ASL
+			NES_OP(0x06): ASL<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x0A): ASL<Mode::Accumulator>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x0E): ASL<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x16): ASL<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x1E): ASL<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// Branches
+			NES_OP(0x90): Branch<Flag::Carry, false>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xB0): Branch<Flag::Carry, true>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xF0): Branch<Flag::Zero, true>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x30): Branch<Flag::Negative, true>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xD0): Branch<Flag::Zero, false>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x10): Branch<Flag::Negative, false>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x50): Branch<Flag::Overflow, false>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x70): Branch<Flag::Overflow, true>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// BIT
+			NES_OP(0x24): BIT<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x2C): BIT<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// BRK
+			NES_OP(0x00): BRK(bus, regs); NES_NEXT;
+
+			// CLC / CLD / CLI / CLV
+			NES_OP(0x18): SetFlag(regs, Flag::Carry, false); Implied(bus, regs); NES_NEXT;
+			NES_OP(0xD8): SetFlag(regs, Flag::DecimalMode, false); Implied(bus, regs); NES_NEXT;
+			NES_OP(0x58): SetFlag(regs, Flag::InterruptDisable, false); Implied(bus, regs); NES_NEXT;
+			NES_OP(0xB8): SetFlag(regs, Flag::Overflow, false); Implied(bus, regs); NES_NEXT;
+
+			// CMP
+			NES_OP(0xC1): CMP<Mode::IndirectX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xC5): CMP<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xC9): CMP<Mode::Immediate>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xCD): CMP<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xD1): CMP<Mode::IndirectY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xD5): CMP<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xD9): CMP<Mode::AbsoluteY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xDD): CMP<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// CPX
+			NES_OP(0xE0): CPX<Mode::Immediate>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xE4): CPX<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xEC): CPX<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// CPY
+			NES_OP(0xC0): CPY<Mode::Immediate>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xC4): CPY<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xCC): CPY<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// DEC
+			NES_OP(0xC6): DEC<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xD6): DEC<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xCE): DEC<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xDE): DEC<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// DEX / DEY
+			NES_OP(0xCA): --regs.X; UpdateZeroNegative(regs, regs.X); Implied(bus, regs); NES_NEXT;
+			NES_OP(0x88): --regs.Y; UpdateZeroNegative(regs, regs.Y); Implied(bus, regs); NES_NEXT;
+
+			// EOR
+			NES_OP(0x41): EOR<Mode::IndirectX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x45): EOR<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x49): EOR<Mode::Immediate>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x4D): EOR<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x51): EOR<Mode::IndirectY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x55): EOR<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x59): EOR<Mode::AbsoluteY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x5D): EOR<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// INC
+			NES_OP(0xE6): INC<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xF6): INC<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xEE): INC<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xFE): INC<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// INX / INY
+			NES_OP(0xE8): ++regs.X; UpdateZeroNegative(regs, regs.X); Implied(bus, regs); NES_NEXT;
+			NES_OP(0xC8): ++regs.Y; UpdateZeroNegative(regs, regs.Y); Implied(bus, regs); NES_NEXT;
+
+			// JMP
+			NES_OP(0x4C): JMP<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x6C): JMP<Mode::Indirect>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// JSR
+			NES_OP(0x20): JSR(bus, regs, instruction.Operand); NES_NEXT;
+
+			// LDA
+			NES_OP(0xA1): LDA<Mode::IndirectX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xA5): LDA<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xA9): LDA<Mode::Immediate>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xAD): LDA<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xB1): LDA<Mode::IndirectY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xB5): LDA<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xB9): LDA<Mode::AbsoluteY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xBD): LDA<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// LDX
+			NES_OP(0xA2): LDX<Mode::Immediate>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xA6): LDX<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xAE): LDX<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xB6): LDX<Mode::ZeroPageY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xBE): LDX<Mode::AbsoluteY>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// LDY
+			NES_OP(0xA0): LDY<Mode::Immediate>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xA4): LDY<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xAC): LDY<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xB4): LDY<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xBC): LDY<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// LSR
+			NES_OP(0x46): LSR<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x4A): LSR<Mode::Accumulator>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x4E): LSR<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x56): LSR<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x5E): LSR<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// NOP
+			NES_OP(0xEA): Implied(bus, regs); NES_NEXT;
+
+			// ORA
+			NES_OP(0x01): ORA<Mode::IndirectX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x05): ORA<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x09): ORA<Mode::Immediate>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x0D): ORA<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x11): ORA<Mode::IndirectY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x15): ORA<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x19): ORA<Mode::AbsoluteY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x1D): ORA<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// PHA / PHP / PLA / PLP
+			NES_OP(0x48): PHA(bus, regs); NES_NEXT;
+			NES_OP(0x08): PHP(bus, regs); NES_NEXT;
+			NES_OP(0x68): PLA(bus, regs); NES_NEXT;
+			NES_OP(0x28): PLP(bus, regs); NES_NEXT;
+
+			// ROL
+			NES_OP(0x26): ROL<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x2A): ROL<Mode::Accumulator>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x2E): ROL<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x36): ROL<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x3E): ROL<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// ROR
+			NES_OP(0x66): ROR<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x6A): ROR<Mode::Accumulator>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x6E): ROR<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x76): ROR<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0x7E): ROR<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// RTI / RTS
+			NES_OP(0x40): RTI(bus, regs); NES_NEXT;
+			NES_OP(0x60): RTS(bus, regs); NES_NEXT;
+
+			// SBC
+			NES_OP(0xE1): SBC<Mode::IndirectX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xE5): SBC<Mode::ZeroPage>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xE9): SBC<Mode::Immediate>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xED): SBC<Mode::Absolute>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xF1): SBC<Mode::IndirectY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xF5): SBC<Mode::ZeroPageX>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xF9): SBC<Mode::AbsoluteY>(bus, regs, instruction.Operand); NES_NEXT;
+			NES_OP(0xFD): SBC<Mode::AbsoluteX>(bus, regs, instruction.Operand); NES_NEXT;
+
+			// SEC / SED / SEI
+			NES_OP(0x38): SetFlag(regs, Flag::Carry, true); Implied(bus, regs); NES_NEXT;
+			NES_OP(0xF8): SetFlag(regs, Flag::DecimalMode, true); Implied(bus, regs); NES_NEXT;
+			NES_OP(0x78): SetFlag(regs, Flag::InterruptDisable, true); Implied(bus, regs); NES_NEXT;
+
+			// STA
+			NES_OP(0x81): Store<Mode::IndirectX>(bus, regs, instruction.Operand, regs.A); NES_NEXT;
+			NES_OP(0x85): Store<Mode::ZeroPage>(bus, regs, instruction.Operand, regs.A); NES_NEXT;
+			NES_OP(0x8D): Store<Mode::Absolute>(bus, regs, instruction.Operand, regs.A); NES_NEXT;
+			NES_OP(0x91): Store<Mode::IndirectY>(bus, regs, instruction.Operand, regs.A); NES_NEXT;
+			NES_OP(0x95): Store<Mode::ZeroPageX>(bus, regs, instruction.Operand, regs.A); NES_NEXT;
+			NES_OP(0x99): Store<Mode::AbsoluteY>(bus, regs, instruction.Operand, regs.A); NES_NEXT;
+			NES_OP(0x9D): Store<Mode::AbsoluteX>(bus, regs, instruction.Operand, regs.A); NES_NEXT;
+
+			// STX
+			NES_OP(0x86): Store<Mode::ZeroPage>(bus, regs, instruction.Operand, regs.X); NES_NEXT;
+			NES_OP(0x8E): Store<Mode::Absolute>(bus, regs, instruction.Operand, regs.X); NES_NEXT;
+			NES_OP(0x96): Store<Mode::ZeroPageY>(bus, regs, instruction.Operand, regs.X); NES_NEXT;
+
+			// STY
+			NES_OP(0x84): Store<Mode::ZeroPage>(bus, regs, instruction.Operand, regs.Y); NES_NEXT;
+			NES_OP(0x8C): Store<Mode::Absolute>(bus, regs, instruction.Operand, regs.Y); NES_NEXT;
+			NES_OP(0x94): Store<Mode::ZeroPageX>(bus, regs, instruction.Operand, regs.Y); NES_NEXT;
+
+			// Transfers
+			NES_OP(0xAA): regs.X = regs.A; UpdateZeroNegative(regs, regs.X); Implied(bus, regs); NES_NEXT;
+			NES_OP(0xA8): regs.Y = regs.A; UpdateZeroNegative(regs, regs.Y); Implied(bus, regs); NES_NEXT;
+			NES_OP(0xBA): regs.X = regs.SP; UpdateZeroNegative(regs, regs.X); Implied(bus, regs); NES_NEXT;
+			NES_OP(0x8A): regs.A = regs.X; UpdateZeroNegative(regs, regs.A); Implied(bus, regs); NES_NEXT;
+			NES_OP(0x9A): regs.SP = regs.X; Implied(bus, regs); NES_NEXT;
+			NES_OP(0x98): regs.A = regs.Y; UpdateZeroNegative(regs, regs.A); Implied(bus, regs); NES_NEXT;
+
+#if defined(NES_CPU_COMPUTED_GOTO)
+		op_illegal:
+			// Unknown op-codes have no side effects, just like the instruction
+			// table, so the CPU cannot make any progress
+			reason = StopReason::Jammed;
+			goto finished;
+#else
+			default:
+				// Unknown op-codes have no side effects, just like the instruction
+				// table, so the CPU cannot make any progress
+				reason = StopReason::Jammed;
+				goto finished;
+		}
+
+		NES_CHECK_STOP
+	}
+#endif
+
+finished:
+	#undef NES_OP
+	#undef NES_NEXT
+	#undef NES_CHECK_STOP
+
+	// Write the register file back to the CPU
+	A.value = regs.A;
+	X.value = regs.X;
+	Y.value = regs.Y;
+	Byte status;
+	status.value = BuildStatusRegister(regs);
+	SetStatusRegister(status);
+	SP.value = regs.SP;
+	PC = regs.PC;
+	CurrentCycle = regs.Cycle;
+
+	return reason;
+}
+
+nes::CPU::StopReason nes::CPU::RunInterpreter(std::uint64_t instructionCount, std::uint64_t cycleLimit)
+{
+	return RunInterpreterLoop<false>(instructionCount, cycleLimit);
+}
+
+nes::CPU::StopReason nes::CPU::RunCycleStepped(std::uint64_t instructionCount, std::uint64_t cycleLimit)
+{
+	return RunInterpreterLoop<true>(instructionCount, cycleLimit);
+}
@@ -1,15 +1,37 @@
 #include "cpu_logger.hpp"
 #include "cpu.hpp"
 #include "ram/ram.hpp"
+#include "utility/bit_tools.hpp"
 
 #include <ios>		// std::uppercase / std::hex / std::dec
 #include <iomanip>	// std::setfill / std::setw
 #include <iostream>
 
-std::stringstream nes::CpuLogger::ConstructStreamFromData(const CPU& cpuRef, std::string_view opName, std::uint8_t opSize)
+nes::CpuTraceRecord nes::CpuLogger::CaptureRecord(const CPU& cpuRef)
 {
 	std::uint16_t programCounter = cpuRef.GetProgramCounter();
 
+	CpuTraceRecord record;
+	record.Cycle = cpuRef.GetCurrentCycle();
+	record.PC = programCounter;
+	record.OpCode = cpuRef.PeekRamValueAtAddress(programCounter).value;
+	record.Operand = ConstructAddressFromBytes(cpuRef.PeekRamValueAtAddress(programCounter + 2), cpuRef.PeekRamValueAtAddress(programCounter + 1));
+	record.A = cpuRef.GetRegister(CPU::RegisterType::A).value;
+	record.X = cpuRef.GetRegister(CPU::RegisterType::X).value;
+	record.Y = cpuRef.GetRegister(CPU::RegisterType::Y).value;
+	record.P = cpuRef.GetRegister(CPU::RegisterType::P).value;
+	record.SP = cpuRef.GetRegister(CPU::RegisterType::SP).value;
+
+	return record;
+}
+
+std::stringstream nes::CpuLogger::ConstructStreamFromData(const CPU& cpuRef, std::string_view opName, std::uint8_t opSize)
+{
+	return ConstructStreamFromRecord(CaptureRecord(cpuRef), opName, opSize);
+}
+
+std::stringstream nes::CpuLogger::ConstructStreamFromRecord(const CpuTraceRecord& record, std::string_view opName, std::uint8_t opSize)
+{
 	std::stringstream stream;
 
 	// Hexadecimal mode
@@ -17,19 +39,20 @@ std::stringstream nes::CpuLogger::ConstructStreamFromData(const CPU& cpuRef, std
 
 	// Every 8-bit value needs to be a 16-bit value to make the output stream
 	// treat all 8-bit values as numbers instead of characters
-	std::uint16_t A = cpuRef.GetRegister(CPU::RegisterType::A).value;
-	std::uint16_t X = cpuRef.GetRegister(CPU::RegisterType::X).value;
-	std::uint16_t Y = cpuRef.GetRegister(CPU::RegisterType::Y).value;
-	std::uint16_t P = cpuRef.GetRegister(CPU::RegisterType::P).value;
-	std::uint16_t SP = cpuRef.GetRegister(CPU::RegisterType::SP).value;
+	std::uint16_t A = record.A;
+	std::uint16_t X = record.X;
+	std::uint16_t Y = record.Y;
+	std::uint16_t P = record.P;
+	std::uint16_t SP = record.SP;
 
 	// Write current address of the program counter
-	stream << programCounter << "  ";
+	stream << record.PC << "  ";
 
 	// Display instruction bytes
+	std::uint16_t instructionBytes[3] = { record.OpCode, static_cast<std::uint16_t>(record.Operand & 0x00FF), static_cast<std::uint16_t>(record.Operand >> 8) };
 	for (std::uint8_t i = 0; i < opSize; ++i)
 	{
-		stream << std::setfill('0') << std::setw(2) << static_cast<std::uint16_t>(cpuRef.ReadRamValueAtAddress(programCounter + i).value) << ' ';
+		stream << std::setfill('0') << std::setw(2) << instructionBytes[i] << ' ';
 	}
 
 	// An instruction may use up to three bytes
@@ -53,7 +76,7 @@ std::stringstream nes::CpuLogger::ConstructStreamFromData(const CPU& cpuRef, std
 	stream << "P:" << std::setfill('0') << std::setw(2) << P << ' ';
 	stream << "SP:" << SP << ' ';
 	stream << "PPU:  " << "     " << ' ';
-	stream << "CYC:" << std::dec << cpuRef.GetCurrentCycle();
+	stream << "CYC:" << std::dec << record.Cycle;
 
 	return stream;
 }
@@ -1,6 +1,8 @@
 #ifndef NES_CPU_LOGGER_HPP
 #define NES_CPU_LOGGER_HPP
 
+#include "cpu_trace_recorder.hpp"
+
 #include <cstdint>
 #include <sstream>
 #include <string_view>
@@ -15,6 +17,14 @@ namespace nes
 	class CpuLogger
 	{
 	public:
+		/**
+		 * Take a snapshot of the CPU state right before the current instruction
+		 * executes
+		 * @param	cpuRef	Reference to the CPU
+		 * @return	Record holding the current instruction and register states
+		 */
+		static CpuTraceRecord CaptureRecord(const CPU& cpuRef);
+
 		/**
 		 * Utility function to help construct a string stream object that holds
 		 * information about the current CPU instruction and the state of the CPU
@@ -24,6 +34,16 @@ namespace nes
 		 * @return	String stream object with debug information
 		 */
 		static std::stringstream ConstructStreamFromData(const CPU& cpuRef, std::string_view opName, std::uint8_t opSize);
+
+		/**
+		 * Same as ConstructStreamFromData, but using CPU state that was recorded
+		 * earlier instead of the live CPU
+		 * @param	record	Recorded CPU state
+		 * @param	opName	Name of the recorded operation
+		 * @param	opSize	Number of bytes used by the recorded operation
+		 * @return	String stream object with debug information
+		 */
+		static std::stringstream ConstructStreamFromRecord(const CpuTraceRecord& record, std::string_view opName, std::uint8_t opSize);
 	};
 }
 
@@ -0,0 +1,106 @@
+#include "cpu_profiler.hpp"
+#include "cpu.hpp"
+
+#include <algorithm>	// std::fill / std::partial_sort
+#include <ios>			// std::uppercase / std::hex / std::dec
+#include <iomanip>		// std::setfill / std::setw
+#include <numeric>		// std::accumulate
+#include <ostream>
+
+namespace
+{
+	/**
+	 * Collect all non-zero counters and keep the ones with the most cycles
+	 * @param	executions	Execution counter per key
+	 * @param	cycles		Cycle counter per key
+	 * @param	keyCount	Number of keys
+	 * @param	count		Maximum number of entries to return
+	 * @return	Entries sorted by cycles, most cycles first
+	 */
+	std::vector<nes::CpuProfiler::Entry> GetTopEntries(const std::uint64_t* executions, const std::uint64_t* cycles, std::size_t keyCount, std::size_t count)
+	{
+		std::vector<nes::CpuProfiler::Entry> entries;
+
+		for (std::size_t key = 0; key < keyCount; ++key)
+		{
+			if (executions[key] != 0)
+			{
+				entries.push_back({ static_cast<std::uint16_t>(key), executions[key], cycles[key] });
+			}
+		}
+
+		count = std::min(count, entries.size());
+		std::partial_sort(entries.begin(), entries.begin() + count, entries.end(), [](const nes::CpuProfiler::Entry& a, const nes::CpuProfiler::Entry& b)
+		{
+			return (a.Cycles != b.Cycles) ? (a.Cycles > b.Cycles) : (a.Key < b.Key);
+		});
+
+		entries.resize(count);
+		return entries;
+	}
+}
+
+nes::CpuProfiler::CpuProfiler() :
+	OpCodeExecutions{},
+	OpCodeCycles{},
+	AddressExecutions(ADDRESS_COUNT, 0),
+	AddressCycles(ADDRESS_COUNT, 0)
+{}
+
+void nes::CpuProfiler::Clear()
+{
+	OpCodeExecutions.fill(0);
+	OpCodeCycles.fill(0);
+	std::fill(AddressExecutions.begin(), AddressExecutions.end(), 0);
+	std::fill(AddressCycles.begin(), AddressCycles.end(), 0);
+}
+
+std::uint64_t nes::CpuProfiler::GetTotalExecutions() const
+{
+	return std::accumulate(OpCodeExecutions.begin(), OpCodeExecutions.end(), std::uint64_t(0));
+}
+
+std::uint64_t nes::CpuProfiler::GetTotalCycles() const
+{
+	return std::accumulate(OpCodeCycles.begin(), OpCodeCycles.end(), std::uint64_t(0));
+}
+
+std::vector<nes::CpuProfiler::Entry> nes::CpuProfiler::GetTopOpCodes(std::size_t count) const
+{
+	return GetTopEntries(OpCodeExecutions.data(), OpCodeCycles.data(), OpCodeExecutions.size(), count);
+}
+
+std::vector<nes::CpuProfiler::Entry> nes::CpuProfiler::GetHottestAddresses(std::size_t count) const
+{
+	return GetTopEntries(AddressExecutions.data(), AddressCycles.data(), ADDRESS_COUNT, count);
+}
+
+void nes::CpuProfiler::WriteCsv(std::ostream& stream, const CPU& cpuRef) const
+{
+	stream << "type,key,name,executions,cycles\n";
+
+	for (std::size_t opCode = 0; opCode < OpCodeExecutions.size(); ++opCode)
+	{
+		if (OpCodeExecutions[opCode] == 0)
+		{
+			continue;
+		}
+
+		stream << "opcode,0x" << std::uppercase << std::hex << std::setfill('0') << std::setw(2) << opCode << std::dec << ',';
+		stream << cpuRef.GetOpCodeName(static_cast<std::uint8_t>(opCode)) << ',' << OpCodeExecutions[opCode] << ',' << OpCodeCycles[opCode] << '\n';
+	}
+
+	for (std::size_t address = 0; address < ADDRESS_COUNT; ++address)
+	{
+		if (AddressExecutions[address] == 0)
+		{
+			continue;
+		}
+
+		// The code at an address may have changed since it ran, so it is not named
+		stream << "address,0x" << std::uppercase << std::hex << std::setfill('0') << std::setw(4) << address << std::dec << ',';
+		stream << ',' << AddressExecutions[address] << ',' << AddressCycles[address] << '\n';
+	}
+
+	stream.flush();
+}
@@ -0,0 +1,113 @@
+#ifndef NES_CPU_PROFILER_HPP
+#define NES_CPU_PROFILER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <vector>
+
+namespace nes
+{
+	class CPU;
+
+	/**
+	 * Counts how often every op-code and every address executes, and how many
+	 * cycles were spent there
+	 *
+	 * All counters live in flat arrays indexed directly by the op-code or the
+	 * program counter, so recording an instruction is four additions.
+	 */
+	class CpuProfiler
+	{
+	public:
+		/**
+		 * Counters of a single op-code or address
+		 */
+		struct Entry
+		{
+			// Op-code or address the counters belong to
+			std::uint16_t Key;
+
+			std::uint64_t Executions;
+			std::uint64_t Cycles;
+		};
+
+	public:
+		/**
+		 * Create a new profiler with all counters set to zero
+		 */
+		CpuProfiler();
+
+		/**
+		 * Count an executed instruction
+		 * @param	address		Address of the op-code
+		 * @param	opCode		Op-code of the instruction
+		 * @param	cycles		Number of cycles the instruction took
+		 */
+		void Record(std::uint16_t address, std::uint8_t opCode, std::uint64_t cycles);
+
+		/**
+		 * Reset all counters to zero
+		 */
+		void Clear();
+
+		/**
+		 * Retrieve the total number of instructions counted
+		 * @return	Number of instructions
+		 */
+		std::uint64_t GetTotalExecutions() const;
+
+		/**
+		 * Retrieve the total number of cycles counted
+		 * @return	Number of cycles
+		 */
+		std::uint64_t GetTotalCycles() const;
+
+		/**
+		 * Find the op-codes that took the most cycles
+		 * @param	count	Maximum number of op-codes to return
+		 * @return	Op-codes that executed at least once, most cycles first
+		 */
+		std::vector<Entry> GetTopOpCodes(std::size_t count) const;
+
+		/**
+		 * Find the addresses that took the most cycles
+		 * @param	count	Maximum number of addresses to return
+		 * @return	Addresses that executed at least once, most cycles first
+		 */
+		std::vector<Entry> GetHottestAddresses(std::size_t count) const;
+
+		/**
+		 * Write all non-zero counters as comma-separated values
+		 * Op-codes are listed first, followed by the addresses, both in
+		 * ascending order
+		 * @param	stream	Stream to write to
+		 * @param	cpuRef	CPU that was profiled, used to name op-codes
+		 */
+		void WriteCsv(std::ostream& stream, const CPU& cpuRef) const;
+
+	private:
+		/** Number of addresses the program counter can point to */
+		static constexpr std::size_t ADDRESS_COUNT = 0x10000;
+
+	private:
+		std::array<std::uint64_t, 256> OpCodeExecutions;
+		std::array<std::uint64_t, 256> OpCodeCycles;
+
+		// 1 MB in total, so these live on the heap
+		std::vector<std::uint64_t> AddressExecutions;
+		std::vector<std::uint64_t> AddressCycles;
+	};
+
+	inline void CpuProfiler::Record(std::uint16_t address, std::uint8_t opCode, std::uint64_t cycles)
+	{
+		++OpCodeExecutions[opCode];
+		OpCodeCycles[opCode] += cycles;
+
+		++AddressExecutions[address];
+		AddressCycles[address] += cycles;
+	}
+}
+
+#endif //! NES_CPU_PROFILER_HPP
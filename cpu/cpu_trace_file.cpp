@@ -0,0 +1,200 @@
+#include "cpu_trace_file.hpp"
+#include "utility/bit_tools.hpp"
+
+#include <algorithm>	// std::copy / std::equal
+#include <cstring>		// std::memmove
+#include <iterator>		// std::begin / std::end
+#include <string>
+
+nes::CpuTraceWriter::CpuTraceWriter() :
+	PreviousCycle(0)
+{}
+
+nes::CpuTraceWriter::~CpuTraceWriter()
+{
+	Close();
+}
+
+bool nes::CpuTraceWriter::Open(std::string_view path)
+{
+	Close();
+
+	File.open(std::string(path), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	if (!File.is_open())
+	{
+		return false;
+	}
+
+	Buffer.clear();
+	Buffer.reserve(BUFFER_SIZE);
+	PreviousCycle = 0;
+
+	std::uint8_t header[CpuTraceFormat::HEADER_SIZE] = {};
+	std::copy(std::begin(CpuTraceFormat::MAGIC), std::end(CpuTraceFormat::MAGIC), header);
+	WriteLittleEndian(header + 8, CpuTraceFormat::VERSION, 4);
+
+	Buffer.insert(Buffer.end(), std::begin(header), std::end(header));
+	return true;
+}
+
+void nes::CpuTraceWriter::Write(const CpuTraceRecord& record)
+{
+	if (Buffer.size() + CpuTraceFormat::MAX_RECORD_SIZE > BUFFER_SIZE)
+	{
+		Flush();
+	}
+
+	std::uint8_t bytes[CpuTraceFormat::MAX_RECORD_SIZE];
+	std::size_t size = CpuTraceFormat::RECORD_SIZE;
+
+	// Instructions take a handful of cycles, so the delta nearly always fits
+	std::uint64_t delta = record.Cycle - PreviousCycle;
+	std::uint8_t* fields = bytes + 1;
+
+	if (record.Cycle < PreviousCycle || delta >= CpuTraceFormat::CYCLE_ESCAPE)
+	{
+		bytes[0] = CpuTraceFormat::CYCLE_ESCAPE;
+		WriteLittleEndian(bytes + 1, record.Cycle, 8);
+
+		fields += 8;
+		size += 8;
+	}
+	else
+	{
+		bytes[0] = static_cast<std::uint8_t>(delta);
+	}
+
+	WriteLittleEndian(fields + 0, record.PC, 2);
+	fields[2] = record.OpCode;
+	WriteLittleEndian(fields + 3, record.Operand, 2);
+	fields[5] = record.A;
+	fields[6] = record.X;
+	fields[7] = record.Y;
+	fields[8] = record.P;
+	fields[9] = record.SP;
+
+	Buffer.insert(Buffer.end(), bytes, bytes + size);
+	PreviousCycle = record.Cycle;
+}
+
+void nes::CpuTraceWriter::Flush()
+{
+	if (!File.is_open())
+	{
+		return;
+	}
+
+	File.write(reinterpret_cast<const char*>(Buffer.data()), Buffer.size());
+	File.flush();
+	Buffer.clear();
+}
+
+void nes::CpuTraceWriter::Close()
+{
+	if (!File.is_open())
+	{
+		return;
+	}
+
+	Flush();
+	File.close();
+}
+
+bool nes::CpuTraceWriter::IsOpen() const
+{
+	return File.is_open();
+}
+
+nes::CpuTraceReader::CpuTraceReader() :
+	BufferPosition(0),
+	BufferSize(0),
+	PreviousCycle(0)
+{}
+
+bool nes::CpuTraceReader::Open(std::string_view path)
+{
+	File.close();
+	File.clear();
+	File.open(std::string(path), std::ios_base::in | std::ios_base::binary);
+	if (!File.is_open())
+	{
+		return false;
+	}
+
+	Buffer.resize(BUFFER_SIZE);
+	BufferPosition = 0;
+	BufferSize = 0;
+	PreviousCycle = 0;
+
+	if (!FillBuffer(CpuTraceFormat::HEADER_SIZE))
+	{
+		return false;
+	}
+
+	const std::uint8_t* header = Buffer.data() + BufferPosition;
+	BufferPosition += CpuTraceFormat::HEADER_SIZE;
+
+	bool isTraceFile = std::equal(std::begin(CpuTraceFormat::MAGIC), std::end(CpuTraceFormat::MAGIC), header);
+	return (isTraceFile && ReadLittleEndian(header + 8, 4) == CpuTraceFormat::VERSION);
+}
+
+bool nes::CpuTraceReader::Read(CpuTraceRecord& record)
+{
+	if (!FillBuffer(CpuTraceFormat::RECORD_SIZE))
+	{
+		return false;
+	}
+
+	const std::uint8_t* fields = Buffer.data() + BufferPosition + 1;
+	std::size_t size = CpuTraceFormat::RECORD_SIZE;
+
+	if (Buffer[BufferPosition] == CpuTraceFormat::CYCLE_ESCAPE)
+	{
+		if (!FillBuffer(CpuTraceFormat::MAX_RECORD_SIZE))
+		{
+			return false;
+		}
+
+		fields = Buffer.data() + BufferPosition + 1;
+		record.Cycle = ReadLittleEndian(fields, 8);
+
+		fields += 8;
+		size += 8;
+	}
+	else
+	{
+		record.Cycle = PreviousCycle + Buffer[BufferPosition];
+	}
+
+	record.PC = static_cast<std::uint16_t>(ReadLittleEndian(fields + 0, 2));
+	record.OpCode = fields[2];
+	record.Operand = static_cast<std::uint16_t>(ReadLittleEndian(fields + 3, 2));
+	record.A = fields[5];
+	record.X = fields[6];
+	record.Y = fields[7];
+	record.P = fields[8];
+	record.SP = fields[9];
+
+	BufferPosition += size;
+	PreviousCycle = record.Cycle;
+	return true;
+}
+
+bool nes::CpuTraceReader::FillBuffer(std::size_t size)
+{
+	std::size_t available = BufferSize - BufferPosition;
+	if (available >= size)
+	{
+		return true;
+	}
+
+	// Move the remaining bytes to the front and top up the buffer
+	std::memmove(Buffer.data(), Buffer.data() + BufferPosition, available);
+	BufferPosition = 0;
+	BufferSize = available;
+
+	File.read(reinterpret_cast<char*>(Buffer.data() + BufferSize), Buffer.size() - BufferSize);
+	BufferSize += static_cast<std::size_t>(File.gcount());
+
+	return (BufferSize >= size);
+}
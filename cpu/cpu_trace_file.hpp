@@ -0,0 +1,165 @@
+#ifndef NES_CPU_TRACE_FILE_HPP
+#define NES_CPU_TRACE_FILE_HPP
+
+#include "cpu_trace_recorder.hpp"
+#include "utility/literals.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+namespace nes
+{
+	/**
+	 * Binary CPU trace file layout
+	 *
+	 * The file starts with a 16-byte header: the magic bytes "NESTRACE", followed
+	 * by the format version and four reserved bytes (both little-endian 32-bit).
+	 *
+	 * Every record after that is 11 bytes:
+	 *	[0]		Cycle delta to the previous record (the first record is relative
+	 *			to cycle 0)
+	 *	[1-2]	Program counter
+	 *	[3]		Op-code
+	 *	[4-5]	The two bytes following the op-code
+	 *	[6-10]	A, X, Y, P and SP
+	 *
+	 * A delta that does not fit in a byte is written as CYCLE_ESCAPE followed by
+	 * the absolute 64-bit cycle, which makes the record 19 bytes instead.
+	 * All multi-byte values are little-endian.
+	 */
+	namespace CpuTraceFormat
+	{
+		/** Magic bytes at the start of every trace file */
+		constexpr char MAGIC[8] = { 'N', 'E', 'S', 'T', 'R', 'A', 'C', 'E' };
+
+		/** Version of the format written by CpuTraceWriter */
+		constexpr std::uint32_t VERSION = 1;
+
+		/** Size of the file header in bytes */
+		constexpr std::size_t HEADER_SIZE = 16;
+
+		/** Size of a record without an absolute cycle in bytes */
+		constexpr std::size_t RECORD_SIZE = 11;
+
+		/** Size of the largest possible record in bytes */
+		constexpr std::size_t MAX_RECORD_SIZE = RECORD_SIZE + 8;
+
+		/** Cycle delta value that announces an absolute cycle */
+		constexpr std::uint8_t CYCLE_ESCAPE = 0xFF;
+	}
+
+	/**
+	 * Writes CPU trace records to a binary trace file through an in-memory buffer
+	 */
+	class CpuTraceWriter
+	{
+	public:
+		/**
+		 * Create a new writer, no file is opened yet
+		 */
+		CpuTraceWriter();
+
+		CpuTraceWriter(const CpuTraceWriter& other)				= delete;
+		CpuTraceWriter& operator=(const CpuTraceWriter& other)	= delete;
+
+		/**
+		 * Flush and close the file
+		 */
+		~CpuTraceWriter();
+
+		/**
+		 * Create a trace file, overwriting any existing file
+		 * @param	path	Path to the trace file
+		 * @return	True when the file could be created, false otherwise
+		 */
+		bool Open(std::string_view path);
+
+		/**
+		 * Append a record to the trace
+		 * @param	record	Record to write
+		 */
+		void Write(const CpuTraceRecord& record);
+
+		/**
+		 * Write all buffered records to disk
+		 */
+		void Flush();
+
+		/**
+		 * Flush and close the file
+		 */
+		void Close();
+
+		/**
+		 * Check whether a trace file is open
+		 * @return	True if records can be written
+		 */
+		bool IsOpen() const;
+
+	private:
+		/** Number of bytes buffered before they are written to disk */
+		static constexpr std::size_t BUFFER_SIZE = 256_KB;
+
+	private:
+		std::ofstream File;
+		std::vector<std::uint8_t> Buffer;
+
+		// Cycle of the last record written
+		std::uint64_t PreviousCycle;
+	};
+
+	/**
+	 * Reads CPU trace records back from a binary trace file
+	 */
+	class CpuTraceReader
+	{
+	public:
+		/**
+		 * Create a new reader, no file is opened yet
+		 */
+		CpuTraceReader();
+
+		/**
+		 * Open a trace file and validate its header
+		 * @param	path	Path to the trace file
+		 * @return	True when the file is a trace file this reader understands
+		 */
+		bool Open(std::string_view path);
+
+		/**
+		 * Read the next record
+		 * @param	record	Record to store the result in
+		 * @return	True when a record was read, false at the end of the file
+		 */
+		bool Read(CpuTraceRecord& record);
+
+	private:
+		/**
+		 * Make sure the buffer holds at least the specified number of bytes, as
+		 * long as the file has that many left
+		 * @param	size	Number of bytes needed
+		 * @return	True when enough bytes are available
+		 */
+		bool FillBuffer(std::size_t size);
+
+	private:
+		/** Number of bytes read from disk at a time */
+		static constexpr std::size_t BUFFER_SIZE = 256_KB;
+
+	private:
+		std::ifstream File;
+		std::vector<std::uint8_t> Buffer;
+
+		// Read position and number of valid bytes in the buffer
+		std::size_t BufferPosition;
+		std::size_t BufferSize;
+
+		// Cycle of the last record read
+		std::uint64_t PreviousCycle;
+	};
+}
+
+#endif //! NES_CPU_TRACE_FILE_HPP
@@ -0,0 +1,33 @@
+#include "cpu_trace_recorder.hpp"
+
+nes::CpuTraceRecorder::CpuTraceRecorder(std::size_t capacity) :
+	IndexMask(0),
+	RecordCount(0)
+{
+	std::size_t roundedCapacity = 1;
+	while (roundedCapacity < capacity)
+	{
+		roundedCapacity <<= 1;
+	}
+
+	Records.resize(roundedCapacity);
+	IndexMask = roundedCapacity - 1;
+}
+
+std::size_t nes::CpuTraceRecorder::GetRecordCount() const
+{
+	return (RecordCount < Records.size()) ? static_cast<std::size_t>(RecordCount) : Records.size();
+}
+
+const nes::CpuTraceRecord& nes::CpuTraceRecorder::GetRecord(std::size_t index) const
+{
+	// Once the buffer wrapped around, the oldest record is the one that gets
+	// overwritten next
+	std::uint64_t oldest = RecordCount - GetRecordCount();
+	return Records[(oldest + index) & IndexMask];
+}
+
+void nes::CpuTraceRecorder::Clear()
+{
+	RecordCount = 0;
+}
@@ -0,0 +1,93 @@
+#ifndef NES_CPU_TRACE_RECORDER_HPP
+#define NES_CPU_TRACE_RECORDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nes
+{
+	/**
+	 * Raw CPU state right before an instruction executes
+	 */
+	struct CpuTraceRecord
+	{
+		// Cycle the instruction started on
+		std::uint64_t Cycle;
+
+		// Address of the op-code
+		std::uint16_t PC;
+
+		// The two bytes following the op-code (second byte in the high byte)
+		std::uint16_t Operand;
+
+		// Op-code of the instruction
+		std::uint8_t OpCode;
+
+		// Registers
+		std::uint8_t A;
+		std::uint8_t X;
+		std::uint8_t Y;
+		std::uint8_t P;
+		std::uint8_t SP;
+	};
+
+	/**
+	 * Flight recorder that keeps the last N executed instructions in a fixed-size
+	 * ring buffer
+	 *
+	 * Recording only copies the raw CPU state, nothing is formatted until the
+	 * records are dumped.
+	 */
+	class CpuTraceRecorder
+	{
+	public:
+		/**
+		 * Create a new, empty recorder
+		 * @param	capacity	Number of records to keep, rounded up to the next
+		 *						power of two
+		 */
+		CpuTraceRecorder(std::size_t capacity);
+
+		/**
+		 * Store a record, overwriting the oldest one once the buffer is full
+		 * @param	record	Record to store
+		 */
+		void Record(const CpuTraceRecord& record);
+
+		/**
+		 * Retrieve the number of records currently stored
+		 * @return	Number of records, never more than the capacity
+		 */
+		std::size_t GetRecordCount() const;
+
+		/**
+		 * Retrieve a stored record
+		 * @param	index	Index of the record, 0 being the oldest one
+		 * @return	Stored record
+		 */
+		const CpuTraceRecord& GetRecord(std::size_t index) const;
+
+		/**
+		 * Throw away all records
+		 */
+		void Clear();
+
+	private:
+		std::vector<CpuTraceRecord> Records;
+
+		// Capacity - 1, the capacity is always a power of two
+		std::size_t IndexMask;
+
+		// Total number of records stored since the last clear
+		std::uint64_t RecordCount;
+	};
+
+	inline void CpuTraceRecorder::Record(const CpuTraceRecord& record)
+	{
+		Records[RecordCount & IndexMask] = record;
+		++RecordCount;
+	}
+}
+
+#endif //! NES_CPU_TRACE_RECORDER_HPP
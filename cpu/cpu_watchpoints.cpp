@@ -0,0 +1,101 @@
+#include "cpu_watchpoints.hpp"
+
+#include <algorithm>	// std::find_if / std::remove_if
+
+nes::CpuWatchpoints::CpuWatchpoints() :
+	PageMasks{},
+	HitPending(false),
+	LastHit{}
+{}
+
+void nes::CpuWatchpoints::Set(const Watchpoint& watchpoint)
+{
+	auto existing = std::find_if(Watchpoints.begin(), Watchpoints.end(), [&watchpoint](const Watchpoint& entry)
+	{
+		return entry.Type == watchpoint.Type && entry.FirstAddress == watchpoint.FirstAddress && entry.LastAddress == watchpoint.LastAddress;
+	});
+
+	if (existing != Watchpoints.end())
+	{
+		*existing = watchpoint;
+	}
+	else
+	{
+		Watchpoints.push_back(watchpoint);
+	}
+
+	UpdatePageMasks();
+}
+
+void nes::CpuWatchpoints::Remove(Access type, std::uint16_t firstAddress, std::uint16_t lastAddress)
+{
+	Watchpoints.erase(std::remove_if(Watchpoints.begin(), Watchpoints.end(), [=](const Watchpoint& entry)
+	{
+		return entry.Type == type && entry.FirstAddress == firstAddress && entry.LastAddress == lastAddress;
+	}), Watchpoints.end());
+
+	UpdatePageMasks();
+}
+
+void nes::CpuWatchpoints::Clear()
+{
+	Watchpoints.clear();
+	HitPending = false;
+
+	UpdatePageMasks();
+}
+
+bool nes::CpuWatchpoints::IsEmpty() const
+{
+	return Watchpoints.empty();
+}
+
+const std::vector<nes::CpuWatchpoints::Watchpoint>& nes::CpuWatchpoints::GetWatchpoints() const
+{
+	return Watchpoints;
+}
+
+void nes::CpuWatchpoints::Check(Access type, std::uint16_t address, std::uint8_t value, std::uint16_t programCounter, std::uint64_t cycle)
+{
+	// Later accesses of the same instruction do not overwrite the first hit
+	if (HitPending)
+	{
+		return;
+	}
+
+	for (const Watchpoint& watchpoint : Watchpoints)
+	{
+		if (watchpoint.Type == type && address >= watchpoint.FirstAddress && address <= watchpoint.LastAddress &&
+			(!watchpoint.HasValue || watchpoint.Value == value))
+		{
+			HitPending = true;
+			LastHit = { type, address, value, programCounter, cycle };
+			return;
+		}
+	}
+}
+
+bool nes::CpuWatchpoints::TakeHit()
+{
+	bool hit = HitPending;
+	HitPending = false;
+	return hit;
+}
+
+const nes::CpuWatchpoints::Hit& nes::CpuWatchpoints::GetLastHit() const
+{
+	return LastHit;
+}
+
+void nes::CpuWatchpoints::UpdatePageMasks()
+{
+	PageMasks.fill(0);
+
+	for (const Watchpoint& watchpoint : Watchpoints)
+	{
+		for (std::size_t page = (watchpoint.FirstAddress >> 8); page <= static_cast<std::size_t>(watchpoint.LastAddress >> 8); ++page)
+		{
+			PageMasks[page] |= static_cast<std::uint8_t>(watchpoint.Type);
+		}
+	}
+}
@@ -0,0 +1,160 @@
+#ifndef NES_CPU_WATCHPOINTS_HPP
+#define NES_CPU_WATCHPOINTS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nes
+{
+	/**
+	 * Keeps the memory watchpoints of a CPU and the first one that was hit
+	 *
+	 * Every 256-byte page has a mask of the access types watched anywhere on
+	 * it. Memory accesses only test that mask, so pages without watchpoints,
+	 * which is all of them as long as none are set, cost a single load. The
+	 * list of watchpoints is only searched for accesses to watched pages.
+	 */
+	class CpuWatchpoints
+	{
+	public:
+		/**
+		 * Kinds of accesses a watchpoint can look for
+		 */
+		enum class Access : std::uint8_t
+		{
+			Read	= (1 << 0),	// Data read by an instruction, including the stack
+			Write	= (1 << 1),	// Data written by an instruction, including the stack
+			Execute	= (1 << 2)	// Op-code about to execute
+		};
+
+		/**
+		 * Single watchpoint, covering a range of addresses
+		 */
+		struct Watchpoint
+		{
+			Access Type;
+
+			// Both ends are part of the range
+			std::uint16_t FirstAddress;
+			std::uint16_t LastAddress;
+
+			// Only trigger on accesses of this value when set, for execute
+			// watchpoints the value is the op-code
+			bool HasValue;
+			std::uint8_t Value;
+		};
+
+		/**
+		 * Access that triggered a watchpoint
+		 */
+		struct Hit
+		{
+			Access Type;
+			std::uint16_t Address;
+			std::uint8_t Value;
+
+			// Address of the instruction that made the access, or of the
+			// interrupted instruction for accesses of the interrupt sequence
+			std::uint16_t ProgramCounter;
+
+			// Cycle the instruction started on
+			std::uint64_t Cycle;
+		};
+
+	public:
+		/**
+		 * Create a new list without any watchpoints
+		 */
+		CpuWatchpoints();
+
+		/**
+		 * Add a watchpoint, replacing the value condition of an existing one
+		 * with the same type and range
+		 * @param	watchpoint	Watchpoint to add
+		 */
+		void Set(const Watchpoint& watchpoint);
+
+		/**
+		 * Remove the watchpoint with exactly this type and range
+		 * @param	type			Kind of access watched
+		 * @param	firstAddress	First address of the range
+		 * @param	lastAddress		Last address of the range
+		 */
+		void Remove(Access type, std::uint16_t firstAddress, std::uint16_t lastAddress);
+
+		/**
+		 * Remove all watchpoints and forget the pending hit
+		 */
+		void Clear();
+
+		/**
+		 * Check whether any watchpoint is set
+		 * @return	True if there are no watchpoints
+		 */
+		bool IsEmpty() const;
+
+		/**
+		 * Retrieve all watchpoints, in the order they were added
+		 * @return	List of watchpoints
+		 */
+		const std::vector<Watchpoint>& GetWatchpoints() const;
+
+		/**
+		 * Check whether the page of an address has any watchpoint of a type,
+		 * which is all the memory path tests before calling Check
+		 * @param	address		Address that is accessed
+		 * @param	type		Kind of access
+		 * @return	True if Check has to look at the access
+		 */
+		bool IsWatched(std::uint16_t address, Access type) const;
+
+		/**
+		 * Record the access as a hit when it matches a watchpoint, only the
+		 * first hit is kept until TakeHit is called
+		 * @param	type			Kind of access
+		 * @param	address			Address that is accessed
+		 * @param	value			Value read, written or executed
+		 * @param	programCounter	Address of the instruction making the access
+		 * @param	cycle			Cycle the instruction started on
+		 */
+		void Check(Access type, std::uint16_t address, std::uint8_t value, std::uint16_t programCounter, std::uint64_t cycle);
+
+		/**
+		 * Check for a hit since the last call and clear it, the hit itself
+		 * stays available through GetLastHit
+		 * @return	True if a watchpoint was hit
+		 */
+		bool TakeHit();
+
+		/**
+		 * Retrieve the most recent hit
+		 * @return	Last hit, all zero when no watchpoint has been hit yet
+		 */
+		const Hit& GetLastHit() const;
+
+	private:
+		/**
+		 * Rebuild the access masks of all pages from the list of watchpoints
+		 */
+		void UpdatePageMasks();
+
+	private:
+		std::vector<Watchpoint> Watchpoints;
+
+		// Access types watched anywhere on a page, indexed by the high byte of
+		// the address
+		std::array<std::uint8_t, 0x100> PageMasks;
+
+		bool HitPending;
+		Hit LastHit;
+	};
+
+	inline bool CpuWatchpoints::IsWatched(std::uint16_t address, Access type) const
+	{
+		return (PageMasks[address >> 8] & static_cast<std::uint8_t>(type)) != 0;
+	}
+}
+
+#endif //! NES_CPU_WATCHPOINTS_HPP
@@ -1,6 +1,8 @@
 #ifndef NES_CPU_INSTRUCTION_ADDRESSING_MODE_HPP
 #define NES_CPU_INSTRUCTION_ADDRESSING_MODE_HPP
 
+#include <cstdint>
+
 namespace nes
 {
     /**
@@ -22,6 +24,91 @@ namespace nes
         ZeroPageX,
         ZeroPageY
     };
+
+    /**
+     * Number of bytes used by an instruction, op-code included
+     * @param   mode    Addressing mode of the instruction
+     * @return  Size of the instruction in bytes
+     */
+    inline constexpr std::uint8_t GetInstructionSize(AddressingMode mode)
+    {
+        switch (mode)
+        {
+            case AddressingMode::Absolute:
+            case AddressingMode::AbsoluteX:
+            case AddressingMode::AbsoluteY:
+            case AddressingMode::Indirect:
+                return 3;
+
+            case AddressingMode::Immediate:
+            case AddressingMode::IndirectX:
+            case AddressingMode::IndirectY:
+            case AddressingMode::Relative:
+            case AddressingMode::ZeroPage:
+            case AddressingMode::ZeroPageX:
+            case AddressingMode::ZeroPageY:
+                return 2;
+
+            case AddressingMode::Accumulator:
+            case AddressingMode::Implicit:
+                return 1;
+
+            default:
+                return 0;
+        }
+    }
+
+    /**
+     * Base cycle cost of instructions that only read their operand, page
+     * boundary penalties not included
+     * @param   mode    Addressing mode of the instruction
+     * @return  Number of cycles
+     */
+    inline constexpr std::uint8_t GetReadCycleCount(AddressingMode mode)
+    {
+        switch (mode)
+        {
+            case AddressingMode::Immediate:     return 2;
+            case AddressingMode::ZeroPage:      return 3;
+            case AddressingMode::IndirectX:     return 6;
+            case AddressingMode::IndirectY:     return 5;
+            default:                            return 4;
+        }
+    }
+
+    /**
+     * Cycle cost of instructions that write a register to memory
+     * @param   mode    Addressing mode of the instruction
+     * @return  Number of cycles
+     */
+    inline constexpr std::uint8_t GetStoreCycleCount(AddressingMode mode)
+    {
+        switch (mode)
+        {
+            case AddressingMode::ZeroPage:      return 3;
+            case AddressingMode::AbsoluteX:
+            case AddressingMode::AbsoluteY:     return 5;
+            case AddressingMode::IndirectX:
+            case AddressingMode::IndirectY:     return 6;
+            default:                            return 4;
+        }
+    }
+
+    /**
+     * Cycle cost of read-modify-write instructions
+     * @param   mode    Addressing mode of the instruction
+     * @return  Number of cycles
+     */
+    inline constexpr std::uint8_t GetReadModifyWriteCycleCount(AddressingMode mode)
+    {
+        switch (mode)
+        {
+            case AddressingMode::Accumulator:   return 2;
+            case AddressingMode::ZeroPage:      return 5;
+            case AddressingMode::AbsoluteX:     return 7;
+            default:                            return 6;
+        }
+    }
 }
 
 #endif //! NES_CPU_INSTRUCTION_ADDRESSING_MODE_HPP
@@ -1,59 +1,22 @@
 #include "cpu_instruction_base.hpp"
 #include "cpu/cpu.hpp"
-#include "cpu/cpu_logger.hpp"
 
-#include <iostream>
-
-nes::CpuInstructionBase::CpuInstructionBase(CPU& cpuRef, AddressingMode addressingMode, std::string_view name) :
-	CpuRef(cpuRef),
-	InstructionAddressingMode(addressingMode),
-	Name(name),
-	CycleCount(0),
-	AutoUpdateProgramCounter(true)
+void nes::CpuInstructionBase::Execute(CPU& cpuRef) const
 {
-	switch (InstructionAddressingMode)
-	{
-		case nes::AddressingMode::Absolute:
-		case nes::AddressingMode::AbsoluteX:
-		case nes::AddressingMode::AbsoluteY:
-		case nes::AddressingMode::Indirect:
-			InstructionSize = 3;
-			break;
-
-		case nes::AddressingMode::Immediate:
-		case nes::AddressingMode::IndirectX:
-		case nes::AddressingMode::IndirectY:
-		case nes::AddressingMode::Relative:
-		case nes::AddressingMode::ZeroPage:
-		case nes::AddressingMode::ZeroPageX:
-		case nes::AddressingMode::ZeroPageY:
-			InstructionSize = 2;
-			break;
+	cpuRef.UpdateCurrentCycle(ExecuteImpl(cpuRef));
 
-		case nes::AddressingMode::Accumulator:
-		case nes::AddressingMode::Implicit:
-			InstructionSize = 1;
-			break;
-
-		default:
-			InstructionSize = 0;
-			break;
+	if (AutoUpdateProgramCounter)
+	{
+		cpuRef.MoveProgramCounter(InstructionSize);
 	}
 }
 
-void nes::CpuInstructionBase::PrintDebugInformation() const
+std::string_view nes::CpuInstructionBase::GetName() const
 {
-	// Output to the console window
-    std::cout << CpuLogger::ConstructStreamFromData(CpuRef, Name, InstructionSize).str() << std::endl;
+	return Name;
 }
 
-void nes::CpuInstructionBase::Execute()
+std::uint8_t nes::CpuInstructionBase::GetSize() const
 {
-	ExecuteImpl();
-	CpuRef.UpdateCurrentCycle(CycleCount);
-
-	if (AutoUpdateProgramCounter)
-	{
-		CpuRef.MoveProgramCounter(InstructionSize);
-	}
+	return InstructionSize;
 }
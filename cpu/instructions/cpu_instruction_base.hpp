@@ -4,7 +4,6 @@
 #include "cpu_instruction_addressing_mode.hpp"
 
 #include <cstdint>
-#include <string>
 #include <string_view>
 
 namespace nes
@@ -13,54 +12,70 @@ namespace nes
 
 	/**
 	 * Abstract base class for each CPU instruction
+	 *
+	 * Instructions do not hold any state of their own, the CPU to execute on is
+	 * passed to Execute. A single constant instance of every handler is shared
+	 * by all CPUs, see CPU::InstructionTable.
 	 */
 	class CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new CPU instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
-		 * @param	name				Name of this instruction for debugging purposes
+		 * @param	addressingMode				Addressing mode used for this instruction
+		 * @param	name						Name of this instruction for debugging purposes
+		 * @param	autoUpdateProgramCounter	False for instructions that set the
+		 *										program counter themselves, such as JMP
 		 */
-		CpuInstructionBase(CPU& cpuRef, AddressingMode addressingMode, std::string_view name);
+		constexpr CpuInstructionBase(AddressingMode addressingMode, std::string_view name, bool autoUpdateProgramCounter = true);
 
-		CpuInstructionBase(const CpuInstructionBase& other)				= default;
-		CpuInstructionBase(CpuInstructionBase&& other)					= default;
-		CpuInstructionBase& operator=(const CpuInstructionBase& other)	= default;
-		CpuInstructionBase& operator=(CpuInstructionBase&& other)		= default;
+		CpuInstructionBase(const CpuInstructionBase& other)				= delete;
+		CpuInstructionBase& operator=(const CpuInstructionBase& other)	= delete;
 		virtual ~CpuInstructionBase()									= default;
 
 		/**
-		 * Print debug information to the console output stream
+		 * Execute the instruction
+		 * @param	cpuRef	CPU to execute the instruction on
 		 */
-		void PrintDebugInformation() const;
+		void Execute(CPU& cpuRef) const;
 
 		/**
-		 * Execute the instruction
+		 * Retrieve the Assembly name of the instruction
+		 * @return	Name of the instruction
 		 */
-		void Execute();
+		std::string_view GetName() const;
+
+		/**
+		 * Retrieve the number of bytes the instruction occupies
+		 * @return	Size of the instruction in bytes
+		 */
+		std::uint8_t GetSize() const;
 
 	protected:
 		/**
 		 * Override this function with the instruction's logic
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		virtual void ExecuteImpl() = 0;
+		virtual std::uint8_t ExecuteImpl(CPU& cpuRef) const = 0;
 
 	protected:
-		CPU& CpuRef;
 		AddressingMode InstructionAddressingMode;
-		std::string Name;
+		std::string_view Name;
 		std::uint8_t InstructionSize;
 
-		// Number of cycles the instruction took
-		std::uint8_t CycleCount;
-
-		// Set to false to skip updating the program counter automatically based
-		// on the instruction's size
+		// False to skip updating the program counter automatically based on the
+		// instruction's size
 		// This is useful for JMP instructions
 		bool AutoUpdateProgramCounter;
 	};
+
+	constexpr CpuInstructionBase::CpuInstructionBase(AddressingMode addressingMode, std::string_view name, bool autoUpdateProgramCounter) :
+		InstructionAddressingMode(addressingMode),
+		Name(name),
+		InstructionSize(GetInstructionSize(addressingMode)),
+		AutoUpdateProgramCounter(autoUpdateProgramCounter)
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_BASE_HPP
@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Add with carry
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpADC : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new ADC instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpADC(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpADC();
 
 	protected:
 		/**
 		 * Perform add with carry
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpADC<Mode>::CpuInstructionOpADC() :
+		CpuInstructionBase(Mode, "ADC")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_ADC_HPP
@@ -1,67 +1,72 @@
 #include "cpu_instruction_op_and.hpp"
 #include "cpu/cpu.hpp"
 
-#include <iostream>
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpAND<Mode>::ExecuteImpl(CPU& cpuRef) const
+{
+	std::uint8_t cycleCount = 0;
 
-nes::CpuInstructionOpAND::CpuInstructionOpAND(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "AND")
-{}
+	bool pageCrossed = false;
 
-void nes::CpuInstructionOpAND::ExecuteImpl()
-{
 	// Retrieve value to AND against the accumulator
-	std::uint8_t compareAgainst = CpuRef.ReadRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode)).value;
+	std::uint8_t compareAgainst = cpuRef.ReadRamValueAtAddress(cpuRef.GetTargetAddress<Mode>(pageCrossed)).value;
 
 	// Perform logical AND
-	CpuRef.A.value &= compareAgainst;
+	cpuRef.A.value &= compareAgainst;
 
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.A);
-	CpuRef.UpdateZeroStatusFlag(CpuRef.A);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.A);
+	cpuRef.UpdateZeroStatusFlag(cpuRef.A);
 
-	if (InstructionAddressingMode == AddressingMode::Immediate)
+	if constexpr (Mode == AddressingMode::Immediate)
 	{
-		CycleCount = 2;
+		cycleCount = 2;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPage)
+	else if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 3;
+		cycleCount = 3;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPageX)
+	else if constexpr (Mode == AddressingMode::ZeroPageX)
 	{
-		CycleCount = 4;
+		cycleCount = 4;
 	}
-	else if (InstructionAddressingMode == AddressingMode::Absolute)
+	else if constexpr (Mode == AddressingMode::Absolute)
 	{
-		CycleCount = 4;
+		cycleCount = 4;
 	}
-	else if (InstructionAddressingMode == AddressingMode::AbsoluteX || InstructionAddressingMode == AddressingMode::AbsoluteY)
+	else if constexpr (Mode == AddressingMode::AbsoluteX || Mode == AddressingMode::AbsoluteY)
 	{
-		std::uint16_t initialPC = CpuRef.PC;
-		std::uint16_t currentPC = initialPC += 3;
-		CycleCount = 4;
+		cycleCount = 4;
 
-		if (CpuRef.DidProgramCounterCrossPageBoundary(initialPC, currentPC))
+		// Crossed a page boundary
+		if (pageCrossed)
 		{
-			++CycleCount;
+			++cycleCount;
 		}
 	}
-	else if (InstructionAddressingMode == AddressingMode::IndirectX)
+	else if constexpr (Mode == AddressingMode::IndirectX)
 	{
-		CycleCount = 6;
+		cycleCount = 6;
 	}
-	else if (InstructionAddressingMode == AddressingMode::IndirectY)
+	else if constexpr (Mode == AddressingMode::IndirectY)
 	{
-		std::uint16_t initialPC = CpuRef.PC;
-		std::uint16_t currentPC = initialPC += 2;
-		CycleCount = 5;
+		cycleCount = 5;
 
-		if (CpuRef.DidProgramCounterCrossPageBoundary(initialPC, currentPC))
+		// Crossed a page boundary
+		if (pageCrossed)
 		{
-			++CycleCount;
+			++cycleCount;
 		}
 	}
-	else
-	{
-		std::cerr << "AND - Unknown addressing mode.\n";
-	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by AND
+template class nes::CpuInstructionOpAND<nes::AddressingMode::IndirectX>;
+template class nes::CpuInstructionOpAND<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpAND<nes::AddressingMode::Immediate>;
+template class nes::CpuInstructionOpAND<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpAND<nes::AddressingMode::IndirectY>;
+template class nes::CpuInstructionOpAND<nes::AddressingMode::ZeroPageX>;
+template class nes::CpuInstructionOpAND<nes::AddressingMode::AbsoluteY>;
+template class nes::CpuInstructionOpAND<nes::AddressingMode::AbsoluteX>;
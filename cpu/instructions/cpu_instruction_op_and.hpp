@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * AND operation
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpAND : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new AND instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpAND(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpAND();
 
 	protected:
 		/**
 		 * Perform AND operation
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpAND<Mode>::CpuInstructionOpAND() :
+		CpuInstructionBase(Mode, "AND")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_AND_HPP
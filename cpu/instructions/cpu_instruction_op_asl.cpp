@@ -2,25 +2,69 @@
 #include "cpu/cpu.hpp"
 #include "utility/bit_tools.hpp"
 
-nes::CpuInstructionOpASL::CpuInstructionOpASL(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "ASL")
-{}
-
-void nes::CpuInstructionOpASL::ExecuteImpl()
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpASL<Mode>::ExecuteImpl(CPU& cpuRef) const
 {
-	std::uint8_t old = CpuRef.A.value;
-	CpuRef.A.value = (CpuRef.A.value << 1);
+	std::uint8_t cycleCount = 0;
+
+	std::uint16_t address = 0;
+	Byte valueToModify;
+
+	if constexpr (Mode == AddressingMode::Accumulator)
+	{
+		valueToModify = cpuRef.A;
+	}
+	else
+	{
+		address = cpuRef.GetTargetAddress<Mode>();
+		valueToModify = cpuRef.ReadRamValueAtAddress(address);
+	}
+
+	Byte old = valueToModify;
+	valueToModify.value = (valueToModify.value << 1);
 
 	// Set carry to the old contents of bit 7
-	if (IsNthBitSet(old, static_cast<std::uint8_t>(StatusFlags::Negative)))
+	if (IsNthBitSet(old, 7))
 	{
-		CpuRef.SetStatusFlag(StatusFlags::Carry);
+		cpuRef.SetStatusFlag(StatusFlags::Carry);
 	}
 	else
 	{
-		CpuRef.ClearStatusFlag(StatusFlags::Carry);
+		cpuRef.ClearStatusFlag(StatusFlags::Carry);
 	}
 
-	CpuRef.UpdateZeroStatusFlag(CpuRef.A);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.A);
+	cpuRef.UpdateZeroStatusFlag(valueToModify);
+	cpuRef.UpdateNegativeStatusFlag(valueToModify);
+
+	if constexpr (Mode == AddressingMode::Accumulator)
+	{
+		cpuRef.A = valueToModify;
+		cycleCount = 2;
+	}
+	else
+	{
+		cpuRef.WriteRamValueAtAddress(address, valueToModify);
+
+		if constexpr (Mode == AddressingMode::ZeroPage)
+		{
+			cycleCount = 5;
+		}
+		else if constexpr (Mode == AddressingMode::ZeroPageX || Mode == AddressingMode::Absolute)
+		{
+			cycleCount = 6;
+		}
+		else if constexpr (Mode == AddressingMode::AbsoluteX)
+		{
+			cycleCount = 7;
+		}
+	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by ASL
+template class nes::CpuInstructionOpASL<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpASL<nes::AddressingMode::Accumulator>;
+template class nes::CpuInstructionOpASL<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpASL<nes::AddressingMode::ZeroPageX>;
+template class nes::CpuInstructionOpASL<nes::AddressingMode::AbsoluteX>;
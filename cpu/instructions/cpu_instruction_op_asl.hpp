@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Arithmetic shift left
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpASL : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new ASL instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpASL(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpASL();
 
 	protected:
 		/**
 		 * Perform arithmetic shift left
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpASL<Mode>::CpuInstructionOpASL() :
+		CpuInstructionBase(Mode, "ASL")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_ASL_HPP
@@ -2,44 +2,43 @@
 #include "cpu/cpu.hpp"
 #include "utility/bit_tools.hpp"
 
-#include <iostream>
-
-nes::CpuInstructionOpBIT::CpuInstructionOpBIT(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "BIT")
-{}
-
-void nes::CpuInstructionOpBIT::ExecuteImpl()
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpBIT<Mode>::ExecuteImpl(CPU& cpuRef) const
 {
-	std::uint8_t value = CpuRef.ReadRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode)).value;
+	std::uint8_t cycleCount = 0;
 
-	if (InstructionAddressingMode == AddressingMode::ZeroPage)
-	{
-		CycleCount = 3;
-	}
-	else if (InstructionAddressingMode == AddressingMode::Absolute)
+	std::uint8_t value = cpuRef.ReadRamValueAtAddress(cpuRef.GetTargetAddress<Mode>()).value;
+
+	if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 4;
+		cycleCount = 3;
 	}
-	else
+	else if constexpr (Mode == AddressingMode::Absolute)
 	{
-		std::cerr << "BIT - Unknown addressing mode.\n";
+		cycleCount = 4;
 	}
 
 	Byte bitResult;
-	bitResult.value = CpuRef.A.value & value;
-	CpuRef.UpdateZeroStatusFlag(bitResult);
+	bitResult.value = cpuRef.A.value & value;
+	cpuRef.UpdateZeroStatusFlag(bitResult);
 
 	Byte valueAsByte;
 	valueAsByte.value = value;
-	CpuRef.UpdateNegativeStatusFlag(valueAsByte);
+	cpuRef.UpdateNegativeStatusFlag(valueAsByte);
 
 	// Set the overflow flag to the value of the 6th bit
 	if (IsNthBitSet(value, 6))
 	{
-		CpuRef.SetStatusFlag(StatusFlags::Overflow);
+		cpuRef.SetStatusFlag(StatusFlags::Overflow);
 	}
 	else
 	{
-		CpuRef.ClearStatusFlag(StatusFlags::Overflow);
+		cpuRef.ClearStatusFlag(StatusFlags::Overflow);
 	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by BIT
+template class nes::CpuInstructionOpBIT<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpBIT<nes::AddressingMode::Absolute>;
@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * BIT operation
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpBIT : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new BIT instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpBIT(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpBIT();
 
 	protected:
 		/**
 		 * Perform BIT test
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpBIT<Mode>::CpuInstructionOpBIT() :
+		CpuInstructionBase(Mode, "BIT")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_BIT_HPP
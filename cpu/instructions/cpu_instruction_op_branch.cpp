@@ -0,0 +1,41 @@
+#include "cpu_instruction_op_branch.hpp"
+#include "cpu/cpu.hpp"
+
+template <nes::StatusFlags Flag, bool BranchIfSet>
+std::uint8_t nes::CpuInstructionOpBranch<Flag, BranchIfSet>::ExecuteImpl(CPU& cpuRef) const
+{
+	std::uint8_t cycleCount = 2;
+
+	if (cpuRef.IsStatusFlagSet(Flag) == BranchIfSet)
+	{
+		std::int8_t displacement = static_cast<std::uint8_t>(cpuRef.CurrentOperand);
+
+		// The displacement is relative to the instruction after the branch
+		std::uint16_t nextPC = cpuRef.PC + 2;
+		std::uint16_t targetPC = nextPC + displacement;
+
+		// Perform branching, the size of the instruction is added afterwards
+		cpuRef.MoveProgramCounter(displacement);
+
+		if (cpuRef.DidProgramCounterCrossPageBoundary(nextPC, targetPC))
+		{
+			cycleCount += 2;
+		}
+		else
+		{
+			cycleCount += 1;
+		}
+	}
+
+	return cycleCount;
+}
+
+// Explicit instantiations for all eight branch instructions
+template class nes::CpuInstructionOpBranch<nes::StatusFlags::Carry, false>;
+template class nes::CpuInstructionOpBranch<nes::StatusFlags::Carry, true>;
+template class nes::CpuInstructionOpBranch<nes::StatusFlags::Zero, true>;
+template class nes::CpuInstructionOpBranch<nes::StatusFlags::Negative, true>;
+template class nes::CpuInstructionOpBranch<nes::StatusFlags::Zero, false>;
+template class nes::CpuInstructionOpBranch<nes::StatusFlags::Negative, false>;
+template class nes::CpuInstructionOpBranch<nes::StatusFlags::Overflow, false>;
+template class nes::CpuInstructionOpBranch<nes::StatusFlags::Overflow, true>;
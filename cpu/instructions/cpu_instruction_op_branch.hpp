@@ -0,0 +1,89 @@
+#ifndef NES_CPU_INSTRUCTION_OP_BRANCH_HPP
+#define NES_CPU_INSTRUCTION_OP_BRANCH_HPP
+
+#include "cpu_instruction_base.hpp"
+#include "cpu/flags/cpu_status_flags.hpp"
+
+#include <string_view>
+
+namespace nes
+{
+	class CPU;
+
+	/**
+	 * Retrieve the Assembly name of a branch instruction
+	 * @param	flag			Status flag tested by the branch
+	 * @param	branchIfSet		True when the branch is taken on a set flag
+	 * @return	Name of the branch instruction
+	 */
+	constexpr std::string_view GetBranchName(StatusFlags flag, bool branchIfSet)
+	{
+		switch (flag)
+		{
+			case StatusFlags::Carry:
+				return branchIfSet ? "BCS" : "BCC";
+			case StatusFlags::Zero:
+				return branchIfSet ? "BEQ" : "BNE";
+			case StatusFlags::Negative:
+				return branchIfSet ? "BMI" : "BPL";
+			case StatusFlags::Overflow:
+				return branchIfSet ? "BVS" : "BVC";
+			default:
+				return "???";
+		}
+	}
+
+	/**
+	 * Conditional branch
+	 * All branch instructions share the same logic and only differ in which
+	 * status flag they test, and whether they branch on a set or a clear flag
+	 */
+	template <StatusFlags Flag, bool BranchIfSet>
+	class CpuInstructionOpBranch : public CpuInstructionBase
+	{
+	public:
+		/**
+		 * Create a new branch instruction
+		 */
+		constexpr CpuInstructionOpBranch();
+
+	protected:
+		/**
+		 * Perform branch if the status flag is in the expected state
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
+		 */
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
+	};
+
+	template <StatusFlags Flag, bool BranchIfSet>
+	constexpr CpuInstructionOpBranch<Flag, BranchIfSet>::CpuInstructionOpBranch() :
+		CpuInstructionBase(AddressingMode::Relative, GetBranchName(Flag, BranchIfSet))
+	{}
+
+	/** Branch carry clear */
+	using CpuInstructionOpBCC = CpuInstructionOpBranch<StatusFlags::Carry, false>;
+
+	/** Branch carry set */
+	using CpuInstructionOpBCS = CpuInstructionOpBranch<StatusFlags::Carry, true>;
+
+	/** Branch equal */
+	using CpuInstructionOpBEQ = CpuInstructionOpBranch<StatusFlags::Zero, true>;
+
+	/** Branch minus */
+	using CpuInstructionOpBMI = CpuInstructionOpBranch<StatusFlags::Negative, true>;
+
+	/** Branch not equal */
+	using CpuInstructionOpBNE = CpuInstructionOpBranch<StatusFlags::Zero, false>;
+
+	/** Branch positive */
+	using CpuInstructionOpBPL = CpuInstructionOpBranch<StatusFlags::Negative, false>;
+
+	/** Branch overflow clear */
+	using CpuInstructionOpBVC = CpuInstructionOpBranch<StatusFlags::Overflow, false>;
+
+	/** Branch overflow set */
+	using CpuInstructionOpBVS = CpuInstructionOpBranch<StatusFlags::Overflow, true>;
+}
+
+#endif //! NES_CPU_INSTRUCTION_OP_BRANCH_HPP
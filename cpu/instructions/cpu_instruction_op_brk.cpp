@@ -1,30 +1,33 @@
 #include "cpu_instruction_op_brk.hpp"
 #include "cpu/cpu.hpp"
+#include "cpu/flags/cpu_b_flags.hpp"
 #include "utility/bit_tools.hpp"
 
-nes::CpuInstructionOpBRK::CpuInstructionOpBRK(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "BRK")
+std::uint8_t nes::CpuInstructionOpBRK::ExecuteImpl(CPU& cpuRef) const
 {
-	AutoUpdateProgramCounter = false;
-}
+	std::uint8_t cycleCount = 7;
 
-void nes::CpuInstructionOpBRK::ExecuteImpl()
-{
-	CycleCount = 7;
+	// The return address skips the padding byte after the op-code
+	std::uint16_t returnAddress = static_cast<std::uint16_t>(cpuRef.PC + 2);
 
-	// Turn program counter into two bytes so it can be pushed to the stack
+	// Turn return address into two bytes so it can be pushed to the stack
 	Byte msb, lsb;
-	lsb.value = (CpuRef.PC & 0x00FF);
-	msb.value = ((CpuRef.PC & 0xFF00) >> 8);
+	lsb.value = (returnAddress & 0x00FF);
+	msb.value = ((returnAddress & 0xFF00) >> 8);
 
-	// Save state on the stack
-	CpuRef.PushStack(msb);
-	CpuRef.PushStack(lsb);
-	CpuRef.PushStack(CpuRef.P);
-	CpuRef.P.bit4 = 1;
+	// Save state on the stack, with the break flag set in the pushed copy only
+	Byte status = cpuRef.GetStatusRegister();
+	status.value |= static_cast<std::uint8_t>(BFlag::Instruction);
+
+	cpuRef.PushStack(msb);
+	cpuRef.PushStack(lsb);
+	cpuRef.PushStack(status);
+	cpuRef.SetStatusFlag(StatusFlags::InterruptDisable);
 
 	// Set program counter to the IRQ interrupt vector at 0xFFFE and 0xFFFF
-	lsb = CpuRef.ReadRamValueAtAddress(0xFFFE);
-	msb = CpuRef.ReadRamValueAtAddress(0xFFFF);
-	CpuRef.PC = ConstructAddressFromBytes(msb, lsb);
+	lsb = cpuRef.ReadRamValueAtAddress(0xFFFE);
+	msb = cpuRef.ReadRamValueAtAddress(0xFFFF);
+	cpuRef.PC = ConstructAddressFromBytes(msb, lsb);
+
+	return cycleCount;
 }
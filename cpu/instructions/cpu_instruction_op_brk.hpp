@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new BRK instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpBRK(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpBRK();
 
 	protected:
 		/**
 		 * Perform break (force interrupt)
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpBRK::CpuInstructionOpBRK() :
+		CpuInstructionBase(AddressingMode::Implicit, "BRK", false)
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_BRK_HPP
@@ -1,12 +1,8 @@
 #include "cpu_instruction_op_clc.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpCLC::CpuInstructionOpCLC(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "CLC")
-{}
-
-void nes::CpuInstructionOpCLC::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpCLC::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.ClearStatusFlag(StatusFlags::Carry);
-	CycleCount = 2;
+	cpuRef.ClearStatusFlag(StatusFlags::Carry);
+	return 2;
 }
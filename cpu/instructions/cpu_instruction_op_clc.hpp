@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new CLC instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpCLC(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpCLC();
 
 	protected:
 		/**
 		 * Perform clear carry flag
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpCLC::CpuInstructionOpCLC() :
+		CpuInstructionBase(AddressingMode::Implicit, "CLC")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_CLC_HPP
@@ -1,12 +1,8 @@
 #include "cpu_instruction_op_cld.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpCLD::CpuInstructionOpCLD(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "CLD")
-{}
-
-void nes::CpuInstructionOpCLD::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpCLD::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.ClearStatusFlag(StatusFlags::DecimalMode);
-	CycleCount = 2;
+	cpuRef.ClearStatusFlag(StatusFlags::DecimalMode);
+	return 2;
 }
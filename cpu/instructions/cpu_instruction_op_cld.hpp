@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new CLD instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpCLD(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpCLD();
 
 	protected:
 		/**
 		 * Perform clear decimal mode
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpCLD::CpuInstructionOpCLD() :
+		CpuInstructionBase(AddressingMode::Implicit, "CLD")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_CLD_HPP
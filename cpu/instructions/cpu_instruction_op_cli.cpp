@@ -1,12 +1,8 @@
 #include "cpu_instruction_op_cli.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpCLI::CpuInstructionOpCLI(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "CLI")
-{}
-
-void nes::CpuInstructionOpCLI::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpCLI::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.ClearStatusFlag(StatusFlags::InterruptDisable);
-	CycleCount = 2;
+	cpuRef.ClearStatusFlag(StatusFlags::InterruptDisable);
+	return 2;
 }
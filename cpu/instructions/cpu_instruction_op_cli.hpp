@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new CLI instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpCLI(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpCLI();
 
 	protected:
 		/**
 		 * Perform clear interrupt disable
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpCLI::CpuInstructionOpCLI() :
+		CpuInstructionBase(AddressingMode::Implicit, "CLI")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_CLI_HPP
@@ -1,12 +1,8 @@
 #include "cpu_instruction_op_clv.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpCLV::CpuInstructionOpCLV(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "CLV")
-{}
-
-void nes::CpuInstructionOpCLV::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpCLV::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.ClearStatusFlag(StatusFlags::Overflow);
-	CycleCount = 2;
+	cpuRef.ClearStatusFlag(StatusFlags::Overflow);
+	return 2;
 }
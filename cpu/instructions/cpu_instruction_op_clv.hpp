@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new CLV instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpCLV(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpCLV();
 
 	protected:
 		/**
 		 * Perform clear overflow flag
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpCLV::CpuInstructionOpCLV() :
+		CpuInstructionBase(AddressingMode::Implicit, "CLV")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_CLV_HPP
@@ -1,75 +1,80 @@
 #include "cpu_instruction_op_cmp.hpp"
 #include "cpu/cpu.hpp"
 
-#include <iostream>
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpCMP<Mode>::ExecuteImpl(CPU& cpuRef) const
+{
+	std::uint8_t cycleCount = 0;
 
-nes::CpuInstructionOpCMP::CpuInstructionOpCMP(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "CMP")
-{}
+	bool pageCrossed = false;
 
-void nes::CpuInstructionOpCMP::ExecuteImpl()
-{
-	std::uint8_t value = CpuRef.ReadRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode)).value;
-	std::uint8_t result = CpuRef.A.value - value;
+	std::uint8_t value = cpuRef.ReadRamValueAtAddress(cpuRef.GetTargetAddress<Mode>(pageCrossed)).value;
+	std::uint8_t result = cpuRef.A.value - value;
 
-	if (CpuRef.A.value >= value)
+	if (cpuRef.A.value >= value)
 	{
-		CpuRef.SetStatusFlag(StatusFlags::Carry);
+		cpuRef.SetStatusFlag(StatusFlags::Carry);
 	}
 	else
 	{
-		CpuRef.ClearStatusFlag(StatusFlags::Carry);
+		cpuRef.ClearStatusFlag(StatusFlags::Carry);
 	}
 
 	Byte zero;
-	zero.value = CpuRef.A.value - value;
+	zero.value = cpuRef.A.value - value;
 
 	Byte negative;
 	negative.value = result;
 
-	CpuRef.UpdateZeroStatusFlag(zero);
-	CpuRef.UpdateNegativeStatusFlag(negative);
+	cpuRef.UpdateZeroStatusFlag(zero);
+	cpuRef.UpdateNegativeStatusFlag(negative);
 
-	if (InstructionAddressingMode == AddressingMode::Immediate)
+	if constexpr (Mode == AddressingMode::Immediate)
 	{
-		CycleCount = 2;
+		cycleCount = 2;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPage)
+	else if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 3;
+		cycleCount = 3;
 	}
-	else if (InstructionAddressingMode == AddressingMode::Absolute || InstructionAddressingMode == AddressingMode::ZeroPageX)
+	else if constexpr (Mode == AddressingMode::Absolute || Mode == AddressingMode::ZeroPageX)
 	{
-		CycleCount = 4;
+		cycleCount = 4;
 	}
-	else if (InstructionAddressingMode == AddressingMode::AbsoluteX || InstructionAddressingMode == AddressingMode::AbsoluteY)
+	else if constexpr (Mode == AddressingMode::AbsoluteX || Mode == AddressingMode::AbsoluteY)
 	{
-		std::uint16_t initialPC = CpuRef.PC;
-		std::uint16_t currentPC = initialPC + 3;
-		CycleCount = 4;
+		cycleCount = 4;
 
-		if (CpuRef.DidProgramCounterCrossPageBoundary(initialPC, currentPC))
+		// Crossed a page boundary
+		if (pageCrossed)
 		{
-			++CycleCount;
+			++cycleCount;
 		}
 	}
-	else if (InstructionAddressingMode == AddressingMode::IndirectX)
+	else if constexpr (Mode == AddressingMode::IndirectX)
 	{
-		CycleCount = 6;
+		cycleCount = 6;
 	}
-	else if (InstructionAddressingMode == AddressingMode::IndirectY)
+	else if constexpr (Mode == AddressingMode::IndirectY)
 	{
-		std::uint16_t initialPC = CpuRef.PC;
-		std::uint16_t currentPC = initialPC + 2;
-		CycleCount = 5;
+		cycleCount = 5;
 
-		if (CpuRef.DidProgramCounterCrossPageBoundary(initialPC, currentPC))
+		// Crossed a page boundary
+		if (pageCrossed)
 		{
-			++CycleCount;
+			++cycleCount;
 		}
 	}
-	else
-	{
-		std::cerr << "CMP - Unknown addressing mode.\n";
-	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by CMP
+template class nes::CpuInstructionOpCMP<nes::AddressingMode::IndirectX>;
+template class nes::CpuInstructionOpCMP<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpCMP<nes::AddressingMode::Immediate>;
+template class nes::CpuInstructionOpCMP<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpCMP<nes::AddressingMode::IndirectY>;
+template class nes::CpuInstructionOpCMP<nes::AddressingMode::ZeroPageX>;
+template class nes::CpuInstructionOpCMP<nes::AddressingMode::AbsoluteY>;
+template class nes::CpuInstructionOpCMP<nes::AddressingMode::AbsoluteX>;
@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Compare operation
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpCMP : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new CMP instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpCMP(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpCMP();
 
 	protected:
 		/**
 		 * Perform compare operation
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpCMP<Mode>::CpuInstructionOpCMP() :
+		CpuInstructionBase(Mode, "CMP")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_CMP_HPP
@@ -1,49 +1,49 @@
 #include "cpu_instruction_op_cpx.hpp"
 #include "cpu/cpu.hpp"
 
-#include <iostream>
-
-nes::CpuInstructionOpCPX::CpuInstructionOpCPX(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "CPX")
-{}
-
-void nes::CpuInstructionOpCPX::ExecuteImpl()
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpCPX<Mode>::ExecuteImpl(CPU& cpuRef) const
 {
-	std::uint8_t value = CpuRef.ReadRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode)).value;
-	std::uint8_t result = CpuRef.X.value - value;
+	std::uint8_t cycleCount = 0;
 
-	if (CpuRef.X.value >= value)
+	std::uint8_t value = cpuRef.ReadRamValueAtAddress(cpuRef.GetTargetAddress<Mode>()).value;
+	std::uint8_t result = cpuRef.X.value - value;
+
+	if (cpuRef.X.value >= value)
 	{
-		CpuRef.SetStatusFlag(StatusFlags::Carry);
+		cpuRef.SetStatusFlag(StatusFlags::Carry);
 	}
 	else
 	{
-		CpuRef.ClearStatusFlag(StatusFlags::Carry);
+		cpuRef.ClearStatusFlag(StatusFlags::Carry);
 	}
 
 	Byte zero;
-	zero.value = CpuRef.X.value - value;
+	zero.value = cpuRef.X.value - value;
 
 	Byte negative;
 	negative.value = result;
 
-	CpuRef.UpdateZeroStatusFlag(zero);
-	CpuRef.UpdateNegativeStatusFlag(negative);
+	cpuRef.UpdateZeroStatusFlag(zero);
+	cpuRef.UpdateNegativeStatusFlag(negative);
 
-	if (InstructionAddressingMode == AddressingMode::Immediate)
-	{
-		CycleCount = 2;
-	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPage)
+	if constexpr (Mode == AddressingMode::Immediate)
 	{
-		CycleCount = 3;
+		cycleCount = 2;
 	}
-	else if (InstructionAddressingMode == AddressingMode::Absolute)
+	else if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 4;
+		cycleCount = 3;
 	}
-	else
+	else if constexpr (Mode == AddressingMode::Absolute)
 	{
-		std::cerr << "CPX - Unknown addressing mode.\n";
+		cycleCount = 4;
 	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by CPX
+template class nes::CpuInstructionOpCPX<nes::AddressingMode::Immediate>;
+template class nes::CpuInstructionOpCPX<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpCPX<nes::AddressingMode::Absolute>;
@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Compare X register
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpCPX : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new CPX instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpCPX(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpCPX();
 
 	protected:
 		/**
 		 * Perform compare X register
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpCPX<Mode>::CpuInstructionOpCPX() :
+		CpuInstructionBase(Mode, "CPX")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_CPX_HPP
@@ -1,49 +1,49 @@
 #include "cpu_instruction_op_cpy.hpp"
 #include "cpu/cpu.hpp"
 
-#include <iostream>
-
-nes::CpuInstructionOpCPY::CpuInstructionOpCPY(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "CPY")
-{}
-
-void nes::CpuInstructionOpCPY::ExecuteImpl()
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpCPY<Mode>::ExecuteImpl(CPU& cpuRef) const
 {
-	std::uint8_t value = CpuRef.ReadRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode)).value;
-	std::uint8_t result = CpuRef.Y.value - value;
+	std::uint8_t cycleCount = 0;
 
-	if (CpuRef.Y.value >= value)
+	std::uint8_t value = cpuRef.ReadRamValueAtAddress(cpuRef.GetTargetAddress<Mode>()).value;
+	std::uint8_t result = cpuRef.Y.value - value;
+
+	if (cpuRef.Y.value >= value)
 	{
-		CpuRef.SetStatusFlag(StatusFlags::Carry);
+		cpuRef.SetStatusFlag(StatusFlags::Carry);
 	}
 	else
 	{
-		CpuRef.ClearStatusFlag(StatusFlags::Carry);
+		cpuRef.ClearStatusFlag(StatusFlags::Carry);
 	}
 
 	Byte zero;
-	zero.value = CpuRef.Y.value - value;
+	zero.value = cpuRef.Y.value - value;
 
 	Byte negative;
 	negative.value = result;
 
-	CpuRef.UpdateZeroStatusFlag(zero);
-	CpuRef.UpdateNegativeStatusFlag(negative);
+	cpuRef.UpdateZeroStatusFlag(zero);
+	cpuRef.UpdateNegativeStatusFlag(negative);
 
-	if (InstructionAddressingMode == AddressingMode::Immediate)
-	{
-		CycleCount = 2;
-	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPage)
+	if constexpr (Mode == AddressingMode::Immediate)
 	{
-		CycleCount = 3;
+		cycleCount = 2;
 	}
-	else if (InstructionAddressingMode == AddressingMode::Absolute)
+	else if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 4;
+		cycleCount = 3;
 	}
-	else
+	else if constexpr (Mode == AddressingMode::Absolute)
 	{
-		std::cerr << "CPY - Unknown addressing mode.\n";
+		cycleCount = 4;
 	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by CPY
+template class nes::CpuInstructionOpCPY<nes::AddressingMode::Immediate>;
+template class nes::CpuInstructionOpCPY<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpCPY<nes::AddressingMode::Absolute>;
@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Compare Y register
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpCPY : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new CPY instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpCPY(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpCPY();
 
 	protected:
 		/**
 		 * Perform compare Y register
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpCPY<Mode>::CpuInstructionOpCPY() :
+		CpuInstructionBase(Mode, "CPY")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_CPY_HPP
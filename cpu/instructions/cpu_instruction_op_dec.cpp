@@ -2,33 +2,37 @@
 #include "cpu/cpu.hpp"
 #include "utility/bit_tools.hpp"
 
-#include <iostream>
-
-nes::CpuInstructionOpDEC::CpuInstructionOpDEC(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "DEC")
-{}
-
-void nes::CpuInstructionOpDEC::ExecuteImpl()
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpDEC<Mode>::ExecuteImpl(CPU& cpuRef) const
 {
-	std::uint16_t targetAddress = CpuRef.GetTargetAddress(InstructionAddressingMode);
-	Byte ramValue = CpuRef.ReadRamValueAtAddress(targetAddress);
+	std::uint8_t cycleCount = 0;
+
+	std::uint16_t targetAddress = cpuRef.GetTargetAddress<Mode>();
+	Byte ramValue = cpuRef.ReadRamValueAtAddress(targetAddress);
 	--ramValue.value;
-	CpuRef.WriteRamValueAtAddress(targetAddress, ramValue);
+	cpuRef.WriteRamValueAtAddress(targetAddress, ramValue);
 
-	if (InstructionAddressingMode == AddressingMode::ZeroPage)
-	{
-		CycleCount = 5;
-	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPageX || InstructionAddressingMode == AddressingMode::Absolute)
+	cpuRef.UpdateZeroStatusFlag(ramValue);
+	cpuRef.UpdateNegativeStatusFlag(ramValue);
+
+	if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 6;
+		cycleCount = 5;
 	}
-	else if (InstructionAddressingMode == AddressingMode::AbsoluteX)
+	else if constexpr (Mode == AddressingMode::ZeroPageX || Mode == AddressingMode::Absolute)
 	{
-		CycleCount = 7;
+		cycleCount = 6;
 	}
-	else
+	else if constexpr (Mode == AddressingMode::AbsoluteX)
 	{
-		std::cerr << "DEC - Unknown addressing mode.\n";
+		cycleCount = 7;
 	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by DEC
+template class nes::CpuInstructionOpDEC<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpDEC<nes::AddressingMode::ZeroPageX>;
+template class nes::CpuInstructionOpDEC<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpDEC<nes::AddressingMode::AbsoluteX>;
@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Decrement memory
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpDEC : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new DEC instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpDEC(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpDEC();
 
 	protected:
 		/**
 		 * Perform decrement memory
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpDEC<Mode>::CpuInstructionOpDEC() :
+		CpuInstructionBase(Mode, "DEC")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_DEC_HPP
@@ -1,15 +1,11 @@
 #include "cpu_instruction_op_dex.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpDEX::CpuInstructionOpDEX(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "DEX")
-{}
-
-void nes::CpuInstructionOpDEX::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpDEX::ExecuteImpl(CPU& cpuRef) const
 {
-	--CpuRef.X.value;
-	CpuRef.UpdateZeroStatusFlag(CpuRef.X);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.X);
+	--cpuRef.X.value;
+	cpuRef.UpdateZeroStatusFlag(cpuRef.X);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.X);
 
-	CycleCount = 2;
+	return 2;
 }
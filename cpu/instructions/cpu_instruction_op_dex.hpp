@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new DEX instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpDEX(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpDEX();
 
 	protected:
 		/**
 		 * Perform compare operation
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpDEX::CpuInstructionOpDEX() :
+		CpuInstructionBase(AddressingMode::Implicit, "DEX")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_DEX_HPP
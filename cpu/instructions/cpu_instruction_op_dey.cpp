@@ -1,15 +1,11 @@
 #include "cpu_instruction_op_dey.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpDEY::CpuInstructionOpDEY(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "DEY")
-{}
-
-void nes::CpuInstructionOpDEY::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpDEY::ExecuteImpl(CPU& cpuRef) const
 {
-	--CpuRef.Y.value;
-	CpuRef.UpdateZeroStatusFlag(CpuRef.Y);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.Y);
+	--cpuRef.Y.value;
+	cpuRef.UpdateZeroStatusFlag(cpuRef.Y);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.Y);
 
-	CycleCount = 2;
+	return 2;
 }
@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new DEY instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpDEY(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpDEY();
 
 	protected:
 		/**
 		 * Perform decrement Y register
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpDEY::CpuInstructionOpDEY() :
+		CpuInstructionBase(AddressingMode::Implicit, "DEY")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_DEY_HPP
@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Exclusive OR
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpEOR : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new EOR instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpEOR(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpEOR();
 
 	protected:
 		/**
 		 * Perform exclusive OR
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpEOR<Mode>::CpuInstructionOpEOR() :
+		CpuInstructionBase(Mode, "EOR")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_EOR_HPP
@@ -1,38 +1,39 @@
 #include "cpu_instruction_op_inc.hpp"
 #include "cpu/cpu.hpp"
 
-#include <iostream>
-
-nes::CpuInstructionOpINC::CpuInstructionOpINC(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "INC")
-{}
-
-void nes::CpuInstructionOpINC::ExecuteImpl()
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpINC<Mode>::ExecuteImpl(CPU& cpuRef) const
 {
-	std::uint16_t address = CpuRef.GetTargetAddress(InstructionAddressingMode);
+	std::uint8_t cycleCount = 0;
+
+	std::uint16_t address = cpuRef.GetTargetAddress<Mode>();
 
 	// Increment and store the value at the specified address
-	Byte valueAtAddress = CpuRef.ReadRamValueAtAddress(address);
+	Byte valueAtAddress = cpuRef.ReadRamValueAtAddress(address);
 	++valueAtAddress.value;
-	CpuRef.WriteRamValueAtAddress(address, valueAtAddress);
+	cpuRef.WriteRamValueAtAddress(address, valueAtAddress);
 
-	CpuRef.UpdateZeroStatusFlag(valueAtAddress);
-	CpuRef.UpdateNegativeStatusFlag(valueAtAddress);
+	cpuRef.UpdateZeroStatusFlag(valueAtAddress);
+	cpuRef.UpdateNegativeStatusFlag(valueAtAddress);
 
-	if (InstructionAddressingMode == AddressingMode::ZeroPage)
+	if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 5;
+		cycleCount = 5;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPageX || InstructionAddressingMode == AddressingMode::Absolute)
+	else if constexpr (Mode == AddressingMode::ZeroPageX || Mode == AddressingMode::Absolute)
 	{
-		CycleCount = 6;
+		cycleCount = 6;
 	}
-	else if (InstructionAddressingMode == AddressingMode::AbsoluteX)
+	else if constexpr (Mode == AddressingMode::AbsoluteX)
 	{
-		CycleCount = 7;
-	}
-	else
-	{
-		std::cerr << "INC - Unknown addressing mode.\n";
+		cycleCount = 7;
 	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by INC
+template class nes::CpuInstructionOpINC<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpINC<nes::AddressingMode::ZeroPageX>;
+template class nes::CpuInstructionOpINC<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpINC<nes::AddressingMode::AbsoluteX>;
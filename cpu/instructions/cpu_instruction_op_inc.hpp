@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Increment memory
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpINC : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new INC instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpINC(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpINC();
 
 	protected:
 		/**
 		 * Perform increment memory
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpINC<Mode>::CpuInstructionOpINC() :
+		CpuInstructionBase(Mode, "INC")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_INC_HPP
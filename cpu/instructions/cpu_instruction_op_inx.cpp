@@ -1,15 +1,11 @@
 #include "cpu_instruction_op_inx.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpINX::CpuInstructionOpINX(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "INX")
-{}
-
-void nes::CpuInstructionOpINX::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpINX::ExecuteImpl(CPU& cpuRef) const
 {
-	++CpuRef.X.value;
-	CpuRef.UpdateZeroStatusFlag(CpuRef.X);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.X);
+	++cpuRef.X.value;
+	cpuRef.UpdateZeroStatusFlag(cpuRef.X);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.X);
 
-	CycleCount = 2;
+	return 2;
 }
@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new INX instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpINX(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpINX();
 
 	protected:
 		/**
 		 * Perform increment X register
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpINX::CpuInstructionOpINX() :
+		CpuInstructionBase(AddressingMode::Implicit, "INX")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_INX_HPP
@@ -1,15 +1,11 @@
 #include "cpu_instruction_op_iny.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpINY::CpuInstructionOpINY(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "INY")
-{}
-
-void nes::CpuInstructionOpINY::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpINY::ExecuteImpl(CPU& cpuRef) const
 {
-	++CpuRef.Y.value;
-	CpuRef.UpdateZeroStatusFlag(CpuRef.Y);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.Y);
+	++cpuRef.Y.value;
+	cpuRef.UpdateZeroStatusFlag(cpuRef.Y);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.Y);
 
-	CycleCount = 2;
+	return 2;
 }
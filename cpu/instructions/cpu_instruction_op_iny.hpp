@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new INY instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpINY(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpINY();
 
 	protected:
 		/**
 		 * Perform increment Y register
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpINY::CpuInstructionOpINY() :
+		CpuInstructionBase(AddressingMode::Implicit, "INY")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_INY_HPP
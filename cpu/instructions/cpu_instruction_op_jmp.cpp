@@ -1,30 +1,25 @@
 #include "cpu_instruction_op_jmp.hpp"
 #include "cpu/cpu.hpp"
 
-#include <iostream>
-
-nes::CpuInstructionOpJMP::CpuInstructionOpJMP(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "JMP")
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpJMP<Mode>::ExecuteImpl(CPU& cpuRef) const
 {
-	// Jump instructions modify the program counter already, no need to increment
-	// it in the base class afterwards
-	AutoUpdateProgramCounter = false;
-}
+	std::uint8_t cycleCount = 0;
 
-void nes::CpuInstructionOpJMP::ExecuteImpl()
-{
-	CpuRef.SetProgramCounterToAddress(CpuRef.GetTargetAddress(InstructionAddressingMode));
+	cpuRef.SetProgramCounterToAddress(cpuRef.GetTargetAddress<Mode>());
 
-	if (InstructionAddressingMode == AddressingMode::Absolute)
+	if constexpr (Mode == AddressingMode::Absolute)
 	{
-		CycleCount = 3;
+		cycleCount = 3;
 	}
-	else if (InstructionAddressingMode == AddressingMode::Indirect)
+	else if constexpr (Mode == AddressingMode::Indirect)
 	{
-		CycleCount = 5;
-	}
-	else
-	{
-		std::cerr << "JMP - Unknown addressing mode.\n";
+		cycleCount = 5;
 	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by JMP
+template class nes::CpuInstructionOpJMP<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpJMP<nes::AddressingMode::Indirect>;
@@ -10,22 +10,30 @@ namespace nes
 	/**
 	 * Jump
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpJMP : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new JMP instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpJMP(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpJMP();
 
 	protected:
 		/**
 		 * Perform jump
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpJMP<Mode>::CpuInstructionOpJMP() :
+		// Jump instructions modify the program counter already, no need to increment
+		// it in the base class afterwards
+		CpuInstructionBase(Mode, "JMP", false)
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_JMP_HPP
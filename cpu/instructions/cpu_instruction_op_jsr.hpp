@@ -15,17 +15,23 @@ namespace nes
 	public:
 		/**
 		 * Create a new JSR instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpJSR(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpJSR();
 
 	protected:
 		/**
 		 * Perform jump to subroutine
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpJSR::CpuInstructionOpJSR() :
+		// Jump instructions modify the program counter already, no need to increment
+		// it in the base class afterwards
+		CpuInstructionBase(AddressingMode::Absolute, "JSR", false)
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_JSR_HPP
@@ -1,60 +1,63 @@
 #include "cpu_instruction_op_lda.hpp"
 #include "cpu/cpu.hpp"
 
-#include <iostream>
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpLDA<Mode>::ExecuteImpl(CPU& cpuRef) const
+{
+	std::uint8_t cycleCount = 0;
 
-nes::CpuInstructionOpLDA::CpuInstructionOpLDA(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "LDA")
-{}
+	bool pageCrossed = false;
 
-void nes::CpuInstructionOpLDA::ExecuteImpl()
-{
-	CpuRef.A = CpuRef.ReadRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode));
-	CpuRef.UpdateZeroStatusFlag(CpuRef.A);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.A);
+	cpuRef.A = cpuRef.ReadRamValueAtAddress(cpuRef.GetTargetAddress<Mode>(pageCrossed));
+	cpuRef.UpdateZeroStatusFlag(cpuRef.A);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.A);
 
-	if (InstructionAddressingMode == AddressingMode::Immediate)
+	if constexpr (Mode == AddressingMode::Immediate)
 	{
-		CycleCount = 2;
+		cycleCount = 2;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPage)
+	else if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 3;
+		cycleCount = 3;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPageX || InstructionAddressingMode == AddressingMode::Absolute)
+	else if constexpr (Mode == AddressingMode::ZeroPageX || Mode == AddressingMode::Absolute)
 	{
-		CycleCount = 4;
+		cycleCount = 4;
 	}
-	else if (InstructionAddressingMode == AddressingMode::AbsoluteX || InstructionAddressingMode == AddressingMode::AbsoluteY)
+	else if constexpr (Mode == AddressingMode::AbsoluteX || Mode == AddressingMode::AbsoluteY)
 	{
-		std::uint16_t initialPC = CpuRef.PC;
-		std::uint16_t currentPC = initialPC + 3;
-		CycleCount = 4;
+		cycleCount = 4;
 
 		// Crossed a page boundary
-		if (CpuRef.DidProgramCounterCrossPageBoundary(initialPC, currentPC))
+		if (pageCrossed)
 		{
-			++CycleCount;
+			++cycleCount;
 		}
 	}
-	else if (InstructionAddressingMode == AddressingMode::IndirectX)
+	else if constexpr (Mode == AddressingMode::IndirectX)
 	{
-		CycleCount = 6;
+		cycleCount = 6;
 	}
-	else if (InstructionAddressingMode == AddressingMode::IndirectY)
+	else if constexpr (Mode == AddressingMode::IndirectY)
 	{
-		std::uint16_t initialPC = CpuRef.PC;
-		std::uint16_t currentPC = initialPC + 2;
-		CycleCount = 5;
+		cycleCount = 5;
 
 		// Crossed a page boundary
-		if (CpuRef.DidProgramCounterCrossPageBoundary(initialPC, currentPC))
+		if (pageCrossed)
 		{
-			++CycleCount;
+			++cycleCount;
 		}
 	}
-	else
-	{
-		std::cerr << "LDA - Unknown addressing mode.\n";
-	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by LDA
+template class nes::CpuInstructionOpLDA<nes::AddressingMode::IndirectX>;
+template class nes::CpuInstructionOpLDA<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpLDA<nes::AddressingMode::Immediate>;
+template class nes::CpuInstructionOpLDA<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpLDA<nes::AddressingMode::IndirectY>;
+template class nes::CpuInstructionOpLDA<nes::AddressingMode::ZeroPageX>;
+template class nes::CpuInstructionOpLDA<nes::AddressingMode::AbsoluteY>;
+template class nes::CpuInstructionOpLDA<nes::AddressingMode::AbsoluteX>;
@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Load accumulator
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpLDA : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new LDA instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpLDA(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpLDA();
 
 	protected:
 		/**
 		 * Perform load accumulator
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpLDA<Mode>::CpuInstructionOpLDA() :
+		CpuInstructionBase(Mode, "LDA")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_LDA_HPP
@@ -1,44 +1,46 @@
 #include "cpu_instruction_op_ldx.hpp"
 #include "cpu/cpu.hpp"
 
-#include <iostream>
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpLDX<Mode>::ExecuteImpl(CPU& cpuRef) const
+{
+	std::uint8_t cycleCount = 0;
 
-nes::CpuInstructionOpLDX::CpuInstructionOpLDX(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "LDX")
-{}
+	bool pageCrossed = false;
 
-void nes::CpuInstructionOpLDX::ExecuteImpl()
-{
-	CpuRef.X = CpuRef.ReadRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode));
-	CpuRef.UpdateZeroStatusFlag(CpuRef.X);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.X);
+	cpuRef.X = cpuRef.ReadRamValueAtAddress(cpuRef.GetTargetAddress<Mode>(pageCrossed));
+	cpuRef.UpdateZeroStatusFlag(cpuRef.X);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.X);
 
-	if (InstructionAddressingMode == AddressingMode::Immediate)
+	if constexpr (Mode == AddressingMode::Immediate)
 	{
-		CycleCount = 2;
+		cycleCount = 2;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPage)
+	else if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 3;
+		cycleCount = 3;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPageY || InstructionAddressingMode == AddressingMode::Absolute)
+	else if constexpr (Mode == AddressingMode::ZeroPageY || Mode == AddressingMode::Absolute)
 	{
-		CycleCount = 4;
+		cycleCount = 4;
 	}
-	else if (InstructionAddressingMode == AddressingMode::AbsoluteY)
+	else if constexpr (Mode == AddressingMode::AbsoluteY)
 	{
-		std::uint16_t initialPC = CpuRef.PC;
-		std::uint16_t currentPC = initialPC + 3;
-		CycleCount = 4;
+		cycleCount = 4;
 
 		// Crossed a page boundary
-		if (CpuRef.DidProgramCounterCrossPageBoundary(initialPC, currentPC))
+		if (pageCrossed)
 		{
-			++CycleCount;
+			++cycleCount;
 		}
 	}
-	else
-	{
-		std::cerr << "LDX - Unknown addressing mode.\n";
-	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by LDX
+template class nes::CpuInstructionOpLDX<nes::AddressingMode::Immediate>;
+template class nes::CpuInstructionOpLDX<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpLDX<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpLDX<nes::AddressingMode::ZeroPageY>;
+template class nes::CpuInstructionOpLDX<nes::AddressingMode::AbsoluteY>;
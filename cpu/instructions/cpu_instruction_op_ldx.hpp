@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Load X register
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpLDX : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new LDX instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpLDX(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpLDX();
 
 	protected:
 		/**
 		 * Perform load X register
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpLDX<Mode>::CpuInstructionOpLDX() :
+		CpuInstructionBase(Mode, "LDX")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_LDX_HPP
@@ -1,44 +1,46 @@
 #include "cpu_instruction_op_ldy.hpp"
 #include "cpu/cpu.hpp"
 
-#include <iostream>
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpLDY<Mode>::ExecuteImpl(CPU& cpuRef) const
+{
+	std::uint8_t cycleCount = 0;
 
-nes::CpuInstructionOpLDY::CpuInstructionOpLDY(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "LDY")
-{}
+	bool pageCrossed = false;
 
-void nes::CpuInstructionOpLDY::ExecuteImpl()
-{
-	CpuRef.Y = CpuRef.ReadRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode));
-	CpuRef.UpdateZeroStatusFlag(CpuRef.Y);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.Y);
+	cpuRef.Y = cpuRef.ReadRamValueAtAddress(cpuRef.GetTargetAddress<Mode>(pageCrossed));
+	cpuRef.UpdateZeroStatusFlag(cpuRef.Y);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.Y);
 
-	if (InstructionAddressingMode == AddressingMode::Immediate)
+	if constexpr (Mode == AddressingMode::Immediate)
 	{
-		CycleCount = 2;
+		cycleCount = 2;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPage)
+	else if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 3;
+		cycleCount = 3;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPageX || InstructionAddressingMode == AddressingMode::Absolute)
+	else if constexpr (Mode == AddressingMode::ZeroPageX || Mode == AddressingMode::Absolute)
 	{
-		CycleCount = 4;
+		cycleCount = 4;
 	}
-	else if (InstructionAddressingMode == AddressingMode::AbsoluteX)
+	else if constexpr (Mode == AddressingMode::AbsoluteX)
 	{
-		std::uint16_t initialPC = CpuRef.PC;
-		std::uint16_t currentPC = initialPC + 3;
-		CycleCount = 4;
+		cycleCount = 4;
 
 		// Crossed a page boundary
-		if (CpuRef.DidProgramCounterCrossPageBoundary(initialPC, currentPC))
+		if (pageCrossed)
 		{
-			++CycleCount;
+			++cycleCount;
 		}
 	}
-	else
-	{
-		std::cerr << "LDY - Unknown addressing InstructionAddressingMode.\n";
-	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by LDY
+template class nes::CpuInstructionOpLDY<nes::AddressingMode::Immediate>;
+template class nes::CpuInstructionOpLDY<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpLDY<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpLDY<nes::AddressingMode::ZeroPageX>;
+template class nes::CpuInstructionOpLDY<nes::AddressingMode::AbsoluteX>;
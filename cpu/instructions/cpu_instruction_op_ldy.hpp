@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Load Y register
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpLDY : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new LDY instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpLDY(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpLDY();
 
 	protected:
 		/**
 		 * Perform load Y register
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpLDY<Mode>::CpuInstructionOpLDY() :
+		CpuInstructionBase(Mode, "LDY")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_LDY_HPP
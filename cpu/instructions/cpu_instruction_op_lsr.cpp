@@ -2,68 +2,72 @@
 #include "cpu/cpu.hpp"
 #include "utility/bit_tools.hpp"
 
-#include <iostream>
-
-nes::CpuInstructionOpLSR::CpuInstructionOpLSR(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "LSR")
-{}
-
-void nes::CpuInstructionOpLSR::ExecuteImpl()
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpLSR<Mode>::ExecuteImpl(CPU& cpuRef) const
 {
-	if (InstructionAddressingMode == AddressingMode::Accumulator)
+	std::uint8_t cycleCount = 0;
+
+	if constexpr (Mode == AddressingMode::Accumulator)
 	{
-		CycleCount = 2;
-	
+		cycleCount = 2;
+
 		// Need to shift in the accumulator
-		Byte old = CpuRef.A;
-		CpuRef.A.value = (CpuRef.A.value >> 1);
+		Byte old = cpuRef.A;
+		cpuRef.A.value = (cpuRef.A.value >> 1);
 
-		if (IsNthBitSet(old, static_cast<std::uint8_t>(StatusFlags::Carry)))
+		if (IsNthBitSet(old, 0))
 		{
-			CpuRef.SetStatusFlag(StatusFlags::Carry);
+			cpuRef.SetStatusFlag(StatusFlags::Carry);
 		}
 		else
 		{
-			CpuRef.ClearStatusFlag(StatusFlags::Carry);
+			cpuRef.ClearStatusFlag(StatusFlags::Carry);
 		}
 
-		CpuRef.UpdateZeroStatusFlag(CpuRef.A);
-		CpuRef.UpdateNegativeStatusFlag(CpuRef.A);
+		cpuRef.UpdateZeroStatusFlag(cpuRef.A);
+		cpuRef.UpdateNegativeStatusFlag(cpuRef.A);
 	}
 	else
 	{
 		// Need to shift in a memory location
-		Byte memoryValue = CpuRef.ReadRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode));
+		std::uint16_t address = cpuRef.GetTargetAddress<Mode>();
+		Byte memoryValue = cpuRef.ReadRamValueAtAddress(address);
 		Byte old = memoryValue;
 		memoryValue.value = (memoryValue.value >> 1);
 
-		if (IsNthBitSet(old, static_cast<std::uint8_t>(StatusFlags::Carry)))
+		if (IsNthBitSet(old, 0))
 		{
-			CpuRef.SetStatusFlag(StatusFlags::Carry);
+			cpuRef.SetStatusFlag(StatusFlags::Carry);
 		}
 		else
 		{
-			CpuRef.ClearStatusFlag(StatusFlags::Carry);
+			cpuRef.ClearStatusFlag(StatusFlags::Carry);
 		}
 
-		CpuRef.UpdateZeroStatusFlag(memoryValue);
-		CpuRef.UpdateNegativeStatusFlag(memoryValue);
+		cpuRef.UpdateZeroStatusFlag(memoryValue);
+		cpuRef.UpdateNegativeStatusFlag(memoryValue);
+		cpuRef.WriteRamValueAtAddress(address, memoryValue);
 
-		if (InstructionAddressingMode == AddressingMode::ZeroPage)
+		if constexpr (Mode == AddressingMode::ZeroPage)
 		{
-			CycleCount = 5;
+			cycleCount = 5;
 		}
-		else if (InstructionAddressingMode == AddressingMode::ZeroPageX || InstructionAddressingMode == AddressingMode::Absolute)
+		else if constexpr (Mode == AddressingMode::ZeroPageX || Mode == AddressingMode::Absolute)
 		{
-			CycleCount = 6;
+			cycleCount = 6;
 		}
-		else if (InstructionAddressingMode == AddressingMode::AbsoluteX)
+		else if constexpr (Mode == AddressingMode::AbsoluteX)
 		{
-			CycleCount = 7;
-		}
-		else
-		{
-			std::cerr << "LSR - Unknown addressing mode.\n";
+			cycleCount = 7;
 		}
 	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by LSR
+template class nes::CpuInstructionOpLSR<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpLSR<nes::AddressingMode::Accumulator>;
+template class nes::CpuInstructionOpLSR<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpLSR<nes::AddressingMode::ZeroPageX>;
+template class nes::CpuInstructionOpLSR<nes::AddressingMode::AbsoluteX>;
@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Logical shift right
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpLSR : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new LSR instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpLSR(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpLSR();
 
 	protected:
 		/**
 		 * Perform logical shift right
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpLSR<Mode>::CpuInstructionOpLSR() :
+		CpuInstructionBase(Mode, "LSR")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_LSR_HPP
@@ -1,11 +1,7 @@
 #include "cpu_instruction_op_nop.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpNOP::CpuInstructionOpNOP(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "NOP")
-{}
-
-void nes::CpuInstructionOpNOP::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpNOP::ExecuteImpl(CPU&) const
 {
-	CycleCount = 2;
+	return 2;
 }
@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new NOP instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpNOP(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpNOP();
 
 	protected:
 		/**
 		 * Perform no operation
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpNOP::CpuInstructionOpNOP() :
+		CpuInstructionBase(AddressingMode::Implicit, "NOP")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_NOP_HPP
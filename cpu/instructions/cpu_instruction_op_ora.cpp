@@ -1,62 +1,67 @@
 #include "cpu_instruction_op_ora.hpp"
 #include "cpu/cpu.hpp"
 
-#include <iostream>
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpORA<Mode>::ExecuteImpl(CPU& cpuRef) const
+{
+	std::uint8_t cycleCount = 0;
 
-nes::CpuInstructionOpORA::CpuInstructionOpORA(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "ORA")
-{}
+	bool pageCrossed = false;
 
-void nes::CpuInstructionOpORA::ExecuteImpl()
-{
-	std::uint8_t value = CpuRef.ReadRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode)).value;
+	std::uint8_t value = cpuRef.ReadRamValueAtAddress(cpuRef.GetTargetAddress<Mode>(pageCrossed)).value;
 
 	// Perform bit-wise OR on the accumulator
-	CpuRef.A.value |= value;
+	cpuRef.A.value |= value;
 
-	CpuRef.UpdateZeroStatusFlag(CpuRef.A);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.A);
+	cpuRef.UpdateZeroStatusFlag(cpuRef.A);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.A);
 
-	if (InstructionAddressingMode == AddressingMode::Immediate)
+	if constexpr (Mode == AddressingMode::Immediate)
 	{
-		CycleCount = 2;
+		cycleCount = 2;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPage)
+	else if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 3;
+		cycleCount = 3;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPageX || InstructionAddressingMode == AddressingMode::Absolute)
+	else if constexpr (Mode == AddressingMode::ZeroPageX || Mode == AddressingMode::Absolute)
 	{
-		CycleCount = 4;
+		cycleCount = 4;
 	}
-	else if (InstructionAddressingMode == AddressingMode::AbsoluteX || InstructionAddressingMode == AddressingMode::AbsoluteY)
+	else if constexpr (Mode == AddressingMode::AbsoluteX || Mode == AddressingMode::AbsoluteY)
 	{
-		std::uint16_t initialPC = CpuRef.PC;
-		std::uint16_t currentPC = initialPC + 3;
-		CycleCount = 4;
+		cycleCount = 4;
 
-		if (CpuRef.DidProgramCounterCrossPageBoundary(initialPC, currentPC))
+		// Crossed a page boundary
+		if (pageCrossed)
 		{
-			++CycleCount;
+			++cycleCount;
 		}
 	}
-	else if (InstructionAddressingMode == AddressingMode::IndirectX)
+	else if constexpr (Mode == AddressingMode::IndirectX)
 	{
-		CycleCount = 6;
+		cycleCount = 6;
 	}
-	else if (InstructionAddressingMode == AddressingMode::IndirectY)
+	else if constexpr (Mode == AddressingMode::IndirectY)
 	{
-		std::uint16_t initialPC = CpuRef.PC;
-		std::uint16_t currentPC = initialPC + 2;
-		CycleCount = 5;
+		cycleCount = 5;
 
-		if (CpuRef.DidProgramCounterCrossPageBoundary(initialPC, currentPC))
+		// Crossed a page boundary
+		if (pageCrossed)
 		{
-			++CycleCount;
+			++cycleCount;
 		}
 	}
-	else
-	{
-		std::cerr << "ORA - Unknown addressing InstructionAddressingMode.\n";
-	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by ORA
+template class nes::CpuInstructionOpORA<nes::AddressingMode::IndirectX>;
+template class nes::CpuInstructionOpORA<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpORA<nes::AddressingMode::Immediate>;
+template class nes::CpuInstructionOpORA<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpORA<nes::AddressingMode::IndirectY>;
+template class nes::CpuInstructionOpORA<nes::AddressingMode::ZeroPageX>;
+template class nes::CpuInstructionOpORA<nes::AddressingMode::AbsoluteY>;
+template class nes::CpuInstructionOpORA<nes::AddressingMode::AbsoluteX>;
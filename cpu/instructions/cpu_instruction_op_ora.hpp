@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Logical inclusive OR
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpORA : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new ORA instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpORA(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpORA();
 
 	protected:
 		/**
 		 * Perform logical inclusive OR
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpORA<Mode>::CpuInstructionOpORA() :
+		CpuInstructionBase(Mode, "ORA")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_ORA_HPP
@@ -1,12 +1,8 @@
 #include "cpu_instruction_op_pha.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpPHA::CpuInstructionOpPHA(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "PHA")
-{}
-
-void nes::CpuInstructionOpPHA::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpPHA::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.PushStack(CpuRef.A);
-	CycleCount = 3;
+	cpuRef.PushStack(cpuRef.A);
+	return 3;
 }
@@ -2,14 +2,10 @@
 #include "cpu/cpu.hpp"
 #include "cpu/flags/cpu_b_flags.hpp"
 
-nes::CpuInstructionOpPHP::CpuInstructionOpPHP(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "PHP")
-{}
-
-void nes::CpuInstructionOpPHP::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpPHP::ExecuteImpl(CPU& cpuRef) const
 {
 	Byte newFlags;
-	newFlags.value = (CpuRef.P.value | static_cast<std::uint8_t>(BFlag::Instruction));
-	CpuRef.PushStack(newFlags);
-	CycleCount = 3;
+	newFlags.value = (cpuRef.GetStatusRegister().value | static_cast<std::uint8_t>(BFlag::Instruction));
+	cpuRef.PushStack(newFlags);
+	return 3;
 }
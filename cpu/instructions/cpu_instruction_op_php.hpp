@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new PHP instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpPHP(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpPHP();
 
 	protected:
 		/**
 		 * Perform push processor status
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpPHP::CpuInstructionOpPHP() :
+		CpuInstructionBase(AddressingMode::Implicit, "PHP")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_PHP_HPP
@@ -1,14 +1,10 @@
 #include "cpu_instruction_op_pla.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpPLA::CpuInstructionOpPLA(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "PLA")
-{}
-
-void nes::CpuInstructionOpPLA::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpPLA::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.A = CpuRef.PopStack();
-	CpuRef.UpdateZeroStatusFlag(CpuRef.A);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.A);
-	CycleCount = 4;
+	cpuRef.A = cpuRef.PopStack();
+	cpuRef.UpdateZeroStatusFlag(cpuRef.A);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.A);
+	return 4;
 }
@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new PLA instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpPLA(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpPLA();
 
 	protected:
 		/**
 		 * Perform pull accumulator
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpPLA::CpuInstructionOpPLA() :
+		CpuInstructionBase(AddressingMode::Implicit, "PLA")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_PLA_HPP
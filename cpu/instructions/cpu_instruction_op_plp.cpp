@@ -2,20 +2,19 @@
 #include "cpu/cpu.hpp"
 #include "utility/bit_tools.hpp"
 
-nes::CpuInstructionOpPLP::CpuInstructionOpPLP(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "PLP")
-{}
-
-void nes::CpuInstructionOpPLP::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpPLP::ExecuteImpl(CPU& cpuRef) const
 {
-	Byte fromStack = CpuRef.PopStack();
+	Byte fromStack = cpuRef.PopStack();
+	Byte flags = cpuRef.GetStatusRegister();
+
+	MatchBitStateOfNthBit(flags, fromStack, 0);
+	MatchBitStateOfNthBit(flags, fromStack, 1);
+	MatchBitStateOfNthBit(flags, fromStack, 2);
+	MatchBitStateOfNthBit(flags, fromStack, 3);
+	MatchBitStateOfNthBit(flags, fromStack, 6);
+	MatchBitStateOfNthBit(flags, fromStack, 7);
 
-	MatchBitStateOfNthBit(CpuRef.P, fromStack, 0);
-	MatchBitStateOfNthBit(CpuRef.P, fromStack, 1);
-	MatchBitStateOfNthBit(CpuRef.P, fromStack, 2);
-	MatchBitStateOfNthBit(CpuRef.P, fromStack, 3);
-	MatchBitStateOfNthBit(CpuRef.P, fromStack, 6);
-	MatchBitStateOfNthBit(CpuRef.P, fromStack, 7);
+	cpuRef.SetStatusRegister(flags);
 
-	CycleCount = 4;
+	return 4;
 }
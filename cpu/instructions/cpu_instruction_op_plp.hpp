@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new PLP instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpPLP(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpPLP();
 
 	protected:
 		/**
 		 * Perform pull processor status
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpPLP::CpuInstructionOpPLP() :
+		CpuInstructionBase(AddressingMode::Implicit, "PLP")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_PLP_HPP
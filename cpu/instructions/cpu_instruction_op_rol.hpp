@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Rotate bits left
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpROL : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new ROL instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpROL(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpROL();
 
 	protected:
 		/**
 		 * Perform rotate bits left
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpROL<Mode>::CpuInstructionOpROL() :
+		CpuInstructionBase(Mode, "ROL")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_ROL_HPP
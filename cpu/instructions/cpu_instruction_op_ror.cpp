@@ -2,61 +2,72 @@
 #include "cpu/cpu.hpp"
 #include "utility/bit_tools.hpp"
 
-#include <iostream>
-
-nes::CpuInstructionOpROR::CpuInstructionOpROR(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "ROR")
-{}
-
-void nes::CpuInstructionOpROR::ExecuteImpl()
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpROR<Mode>::ExecuteImpl(CPU& cpuRef) const
 {
-	std::uint16_t address = CpuRef.GetTargetAddress(InstructionAddressingMode);
+	std::uint8_t cycleCount = 0;
+
+	std::uint16_t address = 0;
 	Byte valueToModify;
 
-	if (InstructionAddressingMode == AddressingMode::Accumulator)
+	if constexpr (Mode == AddressingMode::Accumulator)
 	{
-		valueToModify = CpuRef.A;
+		valueToModify = cpuRef.A;
 	}
 	else
 	{
-		valueToModify = CpuRef.ReadRamValueAtAddress(address);
+		address = cpuRef.GetTargetAddress<Mode>();
+		valueToModify = cpuRef.ReadRamValueAtAddress(address);
 	}
 
 	Byte old = valueToModify;
 
-	// Shift right
+	// Shift right, the old carry becomes the new bit 7
 	valueToModify.value = (valueToModify.value >> 1);
+	valueToModify.bit7 = cpuRef.IsStatusFlagSet(StatusFlags::Carry);
 
 	// Old bit 0 becomes the new carry bit
-	valueToModify.bit0 = old.bit0;
+	if (IsNthBitSet(old, 0))
+	{
+		cpuRef.SetStatusFlag(StatusFlags::Carry);
+	}
+	else
+	{
+		cpuRef.ClearStatusFlag(StatusFlags::Carry);
+	}
 
-	CpuRef.UpdateZeroStatusFlag(valueToModify);
-	CpuRef.UpdateNegativeStatusFlag(valueToModify);
+	cpuRef.UpdateZeroStatusFlag(valueToModify);
+	cpuRef.UpdateNegativeStatusFlag(valueToModify);
 
-	if (InstructionAddressingMode == AddressingMode::Accumulator)
+	if constexpr (Mode == AddressingMode::Accumulator)
 	{
-		CpuRef.A = valueToModify;
-		CycleCount = 2;
+		cpuRef.A = valueToModify;
+		cycleCount = 2;
 	}
 	else
 	{
-		CpuRef.WriteRamValueAtAddress(address, valueToModify);
+		cpuRef.WriteRamValueAtAddress(address, valueToModify);
 
-		if (InstructionAddressingMode == AddressingMode::ZeroPage)
-		{
-			CycleCount = 5;
-		}
-		else if (InstructionAddressingMode == AddressingMode::ZeroPageX || InstructionAddressingMode == AddressingMode::Absolute)
+		if constexpr (Mode == AddressingMode::ZeroPage)
 		{
-			CycleCount = 6;
+			cycleCount = 5;
 		}
-		else if (InstructionAddressingMode == AddressingMode::AbsoluteX)
+		else if constexpr (Mode == AddressingMode::ZeroPageX || Mode == AddressingMode::Absolute)
 		{
-			CycleCount = 7;
+			cycleCount = 6;
 		}
-		else
+		else if constexpr (Mode == AddressingMode::AbsoluteX)
 		{
-			std::cerr << "ROL - Unknown addressing mode.\n";
+			cycleCount = 7;
 		}
 	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by ROR
+template class nes::CpuInstructionOpROR<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpROR<nes::AddressingMode::Accumulator>;
+template class nes::CpuInstructionOpROR<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpROR<nes::AddressingMode::ZeroPageX>;
+template class nes::CpuInstructionOpROR<nes::AddressingMode::AbsoluteX>;
@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Rotate bits right
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpROR : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new ROR instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpROR(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpROR();
 
 	protected:
 		/**
 		 * Perform rotate bits right
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpROR<Mode>::CpuInstructionOpROR() :
+		CpuInstructionBase(Mode, "ROR")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_ROR_HPP
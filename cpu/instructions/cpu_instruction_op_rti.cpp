@@ -2,18 +2,15 @@
 #include "cpu/cpu.hpp"
 #include "utility/bit_tools.hpp"
 
-nes::CpuInstructionOpRTI::CpuInstructionOpRTI(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "RTI")
+std::uint8_t nes::CpuInstructionOpRTI::ExecuteImpl(CPU& cpuRef) const
 {
-	AutoUpdateProgramCounter = false;
-}
+	std::uint8_t cycleCount = 6;
 
-void nes::CpuInstructionOpRTI::ExecuteImpl()
-{
-	CycleCount = 6;
+	// Pulled in the opposite order BRK and interrupts push them
+	cpuRef.SetStatusRegister(cpuRef.PopStack());
+	Byte lsb = cpuRef.PopStack();
+	Byte msb = cpuRef.PopStack();
+	cpuRef.PC = ConstructAddressFromBytes(msb, lsb);
 
-	CpuRef.P = CpuRef.PopStack();
-	Byte msb = CpuRef.PopStack();
-	Byte lsb = CpuRef.PopStack();
-	CpuRef.PC = ConstructAddressFromBytes(msb, lsb);
+	return cycleCount;
 }
@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new RTI instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpRTI(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpRTI();
 
 	protected:
 		/**
 		 * Perform return from interrupt
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpRTI::CpuInstructionOpRTI() :
+		CpuInstructionBase(AddressingMode::Implicit, "RTI", false)
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_RTI_HPP
@@ -2,23 +2,15 @@
 #include "cpu/cpu.hpp"
 #include "utility/bit_tools.hpp"
 
-nes::CpuInstructionOpRTS::CpuInstructionOpRTS(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "RTS")
-{
-	// Program counter is modified in the instruction, no need to do this in the
-	// base class again
-	AutoUpdateProgramCounter = false;
-}
-
-void nes::CpuInstructionOpRTS::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpRTS::ExecuteImpl(CPU& cpuRef) const
 {
 	Byte lsb, msb;
-	lsb = CpuRef.PopStack();
-	msb = CpuRef.PopStack();
+	lsb = cpuRef.PopStack();
+	msb = cpuRef.PopStack();
 	std::uint16_t address = ConstructAddressFromBytes(msb, lsb);
 
 	// Because JSR stores the target address - 1 on the stack, we have to add 1 to
 	// the target address to get the location of the next instruction
-	CpuRef.PC = address + 1;
-	CycleCount = 6;
+	cpuRef.PC = address + 1;
+	return 6;
 }
@@ -15,17 +15,23 @@ namespace nes
 	public:
 		/**
 		 * Create a new RTS instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpRTS(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpRTS();
 
 	protected:
 		/**
 		 * Perform return from subroutine
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpRTS::CpuInstructionOpRTS() :
+		// Program counter is modified in the instruction, no need to do this in the
+		// base class again
+		CpuInstructionBase(AddressingMode::Implicit, "RTS", false)
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_RTS_HPP
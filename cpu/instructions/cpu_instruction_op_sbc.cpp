@@ -2,86 +2,91 @@
 #include "cpu/cpu.hpp"
 #include "utility/bit_tools.hpp"
 
-#include <iostream>
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpSBC<Mode>::ExecuteImpl(CPU& cpuRef) const
+{
+	std::uint8_t cycleCount = 0;
 
-nes::CpuInstructionOpSBC::CpuInstructionOpSBC(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "SBC")
-{}
+	bool pageCrossed = false;
 
-void nes::CpuInstructionOpSBC::ExecuteImpl()
-{
-	std::uint8_t value = CpuRef.ReadRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode)).value;
+	std::uint8_t value = cpuRef.ReadRamValueAtAddress(cpuRef.GetTargetAddress<Mode>(pageCrossed)).value;
 
 	// Same as ADC but we invert the bits of the value to turn ADC into SBC
-	std::uint16_t sum = CpuRef.A.value + ~value + (CpuRef.P.value & static_cast<std::uint8_t>(StatusFlags::Carry));
+	std::uint16_t sum = cpuRef.A.value + ~value + (cpuRef.P.value & static_cast<std::uint8_t>(StatusFlags::Carry));
 
 	// Carry if we did not exceed the maximum value for a byte
 	if (!(sum > 0xFF))
 	{
-		CpuRef.SetStatusFlag(StatusFlags::Carry);
+		cpuRef.SetStatusFlag(StatusFlags::Carry);
 	}
 	else
 	{
-		CpuRef.ClearStatusFlag(StatusFlags::Carry);
+		cpuRef.ClearStatusFlag(StatusFlags::Carry);
 	}
 
 	// Same as ADC but we invert the bits of the value to turn ADC into SBC
-	if ((~(CpuRef.A.value ^ ~value) & (CpuRef.A.value ^ sum) & static_cast<std::uint8_t>(StatusFlags::Negative)) != 0)
+	if ((~(cpuRef.A.value ^ ~value) & (cpuRef.A.value ^ sum) & static_cast<std::uint8_t>(StatusFlags::Negative)) != 0)
 	{
-		CpuRef.SetStatusFlag(StatusFlags::Overflow);
+		cpuRef.SetStatusFlag(StatusFlags::Overflow);
 	}
 	else
 	{
-		CpuRef.ClearStatusFlag(StatusFlags::Overflow);
+		cpuRef.ClearStatusFlag(StatusFlags::Overflow);
 	}
 
 	// Only save the lower 8 bits
 	Byte sumAsByte;
 	sumAsByte.value = static_cast<std::uint8_t>(sum);
-	CpuRef.UpdateZeroStatusFlag(sumAsByte);
-	CpuRef.UpdateNegativeStatusFlag(sumAsByte);
-	CpuRef.A = sumAsByte;
+	cpuRef.UpdateZeroStatusFlag(sumAsByte);
+	cpuRef.UpdateNegativeStatusFlag(sumAsByte);
+	cpuRef.A = sumAsByte;
 
-	if (InstructionAddressingMode == AddressingMode::Immediate)
+	if constexpr (Mode == AddressingMode::Immediate)
 	{
-		CycleCount = 2;
+		cycleCount = 2;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPage)
+	else if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 3;
+		cycleCount = 3;
 	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPageX || InstructionAddressingMode == AddressingMode::Absolute)
+	else if constexpr (Mode == AddressingMode::ZeroPageX || Mode == AddressingMode::Absolute)
 	{
-		CycleCount = 4;
+		cycleCount = 4;
 	}
-	else if (InstructionAddressingMode == AddressingMode::AbsoluteX || InstructionAddressingMode == AddressingMode::AbsoluteY)
+	else if constexpr (Mode == AddressingMode::AbsoluteX || Mode == AddressingMode::AbsoluteY)
 	{
-		std::uint16_t initialPC = CpuRef.PC;
-		std::uint16_t currentPC = initialPC + 3;
-		CycleCount = 4;
+		cycleCount = 4;
 
-		if (CpuRef.DidProgramCounterCrossPageBoundary(initialPC, currentPC))
+		// Crossed a page boundary
+		if (pageCrossed)
 		{
-			++CycleCount;
+			++cycleCount;
 		}
 	}
-	else if (InstructionAddressingMode == AddressingMode::IndirectX)
+	else if constexpr (Mode == AddressingMode::IndirectX)
 	{
-		CycleCount = 6;
+		cycleCount = 6;
 	}
-	else if (InstructionAddressingMode == AddressingMode::IndirectY)
+	else if constexpr (Mode == AddressingMode::IndirectY)
 	{
-		std::uint16_t initialPC = CpuRef.PC;
-		std::uint16_t currentPC = initialPC + 2;
-		CycleCount = 5;
+		cycleCount = 5;
 
-		if (CpuRef.DidProgramCounterCrossPageBoundary(initialPC, currentPC))
+		// Crossed a page boundary
+		if (pageCrossed)
 		{
-			++CycleCount;
+			++cycleCount;
 		}
 	}
-	else
-	{
-		std::cerr << "SBC - Unknown addressing mode.\n";
-	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by SBC
+template class nes::CpuInstructionOpSBC<nes::AddressingMode::IndirectX>;
+template class nes::CpuInstructionOpSBC<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpSBC<nes::AddressingMode::Immediate>;
+template class nes::CpuInstructionOpSBC<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpSBC<nes::AddressingMode::IndirectY>;
+template class nes::CpuInstructionOpSBC<nes::AddressingMode::ZeroPageX>;
+template class nes::CpuInstructionOpSBC<nes::AddressingMode::AbsoluteY>;
+template class nes::CpuInstructionOpSBC<nes::AddressingMode::AbsoluteX>;
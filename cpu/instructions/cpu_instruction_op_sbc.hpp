@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Subtract with carry
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpSBC : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new SBC instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpSBC(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpSBC();
 
 	protected:
 		/**
 		 * Perform subtract with carry
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpSBC<Mode>::CpuInstructionOpSBC() :
+		CpuInstructionBase(Mode, "SBC")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_SBC_HPP
@@ -1,12 +1,8 @@
 #include "cpu_instruction_op_sec.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpSEC::CpuInstructionOpSEC(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "SEC")
-{}
-
-void nes::CpuInstructionOpSEC::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpSEC::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.SetStatusFlag(StatusFlags::Carry);
-	CycleCount = 2;
+	cpuRef.SetStatusFlag(StatusFlags::Carry);
+	return 2;
 }
@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new SEC instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpSEC(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpSEC();
 
 	protected:
 		/**
 		 * Perform set carry
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpSEC::CpuInstructionOpSEC() :
+		CpuInstructionBase(AddressingMode::Implicit, "SEC")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_SEC_HPP
@@ -1,12 +1,8 @@
 #include "cpu_instruction_op_sed.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpSED::CpuInstructionOpSED(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "SED")
-{}
-
-void nes::CpuInstructionOpSED::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpSED::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.SetStatusFlag(StatusFlags::DecimalMode);
-	CycleCount = 2;
+	cpuRef.SetStatusFlag(StatusFlags::DecimalMode);
+	return 2;
 }
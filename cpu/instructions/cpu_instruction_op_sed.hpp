@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new SED instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpSED(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpSED();
 
 	protected:
 		/**
 		 * Perform set decimal flag
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpSED::CpuInstructionOpSED() :
+		CpuInstructionBase(AddressingMode::Implicit, "SED")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_SED_HPP
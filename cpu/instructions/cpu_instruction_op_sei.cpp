@@ -1,12 +1,8 @@
 #include "cpu_instruction_op_sei.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpSEI::CpuInstructionOpSEI(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "SEI")
-{}
-
-void nes::CpuInstructionOpSEI::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpSEI::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.SetStatusFlag(StatusFlags::InterruptDisable);
-	CycleCount = 2;
+	cpuRef.SetStatusFlag(StatusFlags::InterruptDisable);
+	return 2;
 }
@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new SEI instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpSEI(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpSEI();
 
 	protected:
 		/**
 		 * Perform interrupt disable
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpSEI::CpuInstructionOpSEI() :
+		CpuInstructionBase(AddressingMode::Implicit, "SEI")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_SEI_HPP
@@ -1,34 +1,38 @@
 #include "cpu_instruction_op_sta.hpp"
 #include "cpu/cpu.hpp"
 
-#include <iostream>
-
-nes::CpuInstructionOpSTA::CpuInstructionOpSTA(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "STA")
-{}
-
-void nes::CpuInstructionOpSTA::ExecuteImpl()
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpSTA<Mode>::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.WriteRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode), CpuRef.A);
+	std::uint8_t cycleCount = 0;
 
-	if (InstructionAddressingMode == AddressingMode::ZeroPage)
-	{
-		CycleCount = 3;
-	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPageX || InstructionAddressingMode == AddressingMode::Absolute)
+	cpuRef.WriteRamValueAtAddress(cpuRef.GetTargetAddress<Mode>(), cpuRef.A);
+
+	if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 4;
+		cycleCount = 3;
 	}
-	else if (InstructionAddressingMode == AddressingMode::AbsoluteX || InstructionAddressingMode == AddressingMode::AbsoluteY)
+	else if constexpr (Mode == AddressingMode::ZeroPageX || Mode == AddressingMode::Absolute)
 	{
-		CycleCount = 5;
+		cycleCount = 4;
 	}
-	else if (InstructionAddressingMode == AddressingMode::IndirectX || InstructionAddressingMode == AddressingMode::IndirectY)
+	else if constexpr (Mode == AddressingMode::AbsoluteX || Mode == AddressingMode::AbsoluteY)
 	{
-		CycleCount = 6;
+		cycleCount = 5;
 	}
-	else
+	else if constexpr (Mode == AddressingMode::IndirectX || Mode == AddressingMode::IndirectY)
 	{
-		std::cerr << "STA - Unknown addressing mode.\n";
+		cycleCount = 6;
 	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by STA
+template class nes::CpuInstructionOpSTA<nes::AddressingMode::IndirectX>;
+template class nes::CpuInstructionOpSTA<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpSTA<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpSTA<nes::AddressingMode::IndirectY>;
+template class nes::CpuInstructionOpSTA<nes::AddressingMode::ZeroPageX>;
+template class nes::CpuInstructionOpSTA<nes::AddressingMode::AbsoluteY>;
+template class nes::CpuInstructionOpSTA<nes::AddressingMode::AbsoluteX>;
@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Store accumulator
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpSTA : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new STA instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpSTA(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpSTA();
 
 	protected:
 		/**
 		 * Perform store accumulator
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpSTA<Mode>::CpuInstructionOpSTA() :
+		CpuInstructionBase(Mode, "STA")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_STA_HPP
@@ -1,26 +1,26 @@
 #include "cpu_instruction_op_stx.hpp"
 #include "cpu/cpu.hpp"
 
-#include <iostream>
-
-nes::CpuInstructionOpSTX::CpuInstructionOpSTX(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "STX")
-{}
-
-void nes::CpuInstructionOpSTX::ExecuteImpl()
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpSTX<Mode>::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.WriteRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode), CpuRef.X);
+	std::uint8_t cycleCount = 0;
 
-	if (InstructionAddressingMode == AddressingMode::ZeroPage)
-	{
-		CycleCount = 3;
-	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPageY || InstructionAddressingMode == AddressingMode::Absolute)
+	cpuRef.WriteRamValueAtAddress(cpuRef.GetTargetAddress<Mode>(), cpuRef.X);
+
+	if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 4;
+		cycleCount = 3;
 	}
-	else
+	else if constexpr (Mode == AddressingMode::ZeroPageY || Mode == AddressingMode::Absolute)
 	{
-		std::cerr << "STX - Unknown addressing mode.\n";
+		cycleCount = 4;
 	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by STX
+template class nes::CpuInstructionOpSTX<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpSTX<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpSTX<nes::AddressingMode::ZeroPageY>;
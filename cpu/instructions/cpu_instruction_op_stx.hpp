@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Store X register
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpSTX : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new STX instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpSTX(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpSTX();
 
 	protected:
 		/**
 		 * Perform store X register
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpSTX<Mode>::CpuInstructionOpSTX() :
+		CpuInstructionBase(Mode, "STX")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_STX_HPP
@@ -1,26 +1,26 @@
 #include "cpu_instruction_op_sty.hpp"
 #include "cpu/cpu.hpp"
 
-#include <iostream>
-
-nes::CpuInstructionOpSTY::CpuInstructionOpSTY(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "STY")
-{}
-
-void nes::CpuInstructionOpSTY::ExecuteImpl()
+template <nes::AddressingMode Mode>
+std::uint8_t nes::CpuInstructionOpSTY<Mode>::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.WriteRamValueAtAddress(CpuRef.GetTargetAddress(InstructionAddressingMode), CpuRef.Y);
+	std::uint8_t cycleCount = 0;
 
-	if (InstructionAddressingMode == AddressingMode::ZeroPage)
-	{
-		CycleCount = 3;
-	}
-	else if (InstructionAddressingMode == AddressingMode::ZeroPageX || InstructionAddressingMode == AddressingMode::Absolute)
+	cpuRef.WriteRamValueAtAddress(cpuRef.GetTargetAddress<Mode>(), cpuRef.Y);
+
+	if constexpr (Mode == AddressingMode::ZeroPage)
 	{
-		CycleCount = 4;
+		cycleCount = 3;
 	}
-	else
+	else if constexpr (Mode == AddressingMode::ZeroPageX || Mode == AddressingMode::Absolute)
 	{
-		std::cerr << "STY - Unknown addressing mode.\n";
+		cycleCount = 4;
 	}
+
+	return cycleCount;
 }
+
+// Explicit instantiations for every addressing mode supported by STY
+template class nes::CpuInstructionOpSTY<nes::AddressingMode::ZeroPage>;
+template class nes::CpuInstructionOpSTY<nes::AddressingMode::Absolute>;
+template class nes::CpuInstructionOpSTY<nes::AddressingMode::ZeroPageX>;
@@ -10,22 +10,28 @@ namespace nes
 	/**
 	 * Store Y register
 	 */
+	template <AddressingMode Mode>
 	class CpuInstructionOpSTY : public CpuInstructionBase
 	{
 	public:
 		/**
 		 * Create a new STY instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpSTY(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpSTY();
 
 	protected:
 		/**
 		 * Perform store Y register
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	template <AddressingMode Mode>
+	constexpr CpuInstructionOpSTY<Mode>::CpuInstructionOpSTY() :
+		CpuInstructionBase(Mode, "STY")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_STY_HPP
@@ -1,14 +1,10 @@
 #include "cpu_instruction_op_tax.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpTAX::CpuInstructionOpTAX(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "TAX")
-{}
-
-void nes::CpuInstructionOpTAX::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpTAX::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.X = CpuRef.A;
-	CpuRef.UpdateZeroStatusFlag(CpuRef.X);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.X);
-	CycleCount = 2;
+	cpuRef.X = cpuRef.A;
+	cpuRef.UpdateZeroStatusFlag(cpuRef.X);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.X);
+	return 2;
 }
@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new TAX instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpTAX(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpTAX();
 
 	protected:
 		/**
 		 * Perform transfer accumulator to X
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpTAX::CpuInstructionOpTAX() :
+		CpuInstructionBase(AddressingMode::Implicit, "TAX")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_TAX_HPP
@@ -1,14 +1,10 @@
 #include "cpu_instruction_op_tay.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpTAY::CpuInstructionOpTAY(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "TAY")
-{}
-
-void nes::CpuInstructionOpTAY::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpTAY::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.Y = CpuRef.A;
-	CpuRef.UpdateZeroStatusFlag(CpuRef.Y);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.Y);
-	CycleCount = 2;
+	cpuRef.Y = cpuRef.A;
+	cpuRef.UpdateZeroStatusFlag(cpuRef.Y);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.Y);
+	return 2;
 }
@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new TAY instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpTAY(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpTAY();
 
 	protected:
 		/**
 		 * Perform transfer accumulator to Y
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpTAY::CpuInstructionOpTAY() :
+		CpuInstructionBase(AddressingMode::Implicit, "TAY")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_TAY_HPP
@@ -1,14 +1,10 @@
 #include "cpu_instruction_op_tsx.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpTSX::CpuInstructionOpTSX(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "TSX")
-{}
-
-void nes::CpuInstructionOpTSX::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpTSX::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.X = CpuRef.SP;
-	CpuRef.UpdateZeroStatusFlag(CpuRef.X);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.X);
-	CycleCount = 2;
+	cpuRef.X = cpuRef.SP;
+	cpuRef.UpdateZeroStatusFlag(cpuRef.X);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.X);
+	return 2;
 }
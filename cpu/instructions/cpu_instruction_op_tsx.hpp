@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new TSX instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpTSX(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpTSX();
 
 	protected:
 		/**
 		 * Perform transfer stack pointer to X
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpTSX::CpuInstructionOpTSX() :
+		CpuInstructionBase(AddressingMode::Implicit, "TSX")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_TSX_HPP
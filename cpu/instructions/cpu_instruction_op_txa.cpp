@@ -1,14 +1,10 @@
 #include "cpu_instruction_op_txa.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpTXA::CpuInstructionOpTXA(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "TXA")
-{}
-
-void nes::CpuInstructionOpTXA::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpTXA::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.A = CpuRef.X;
-	CpuRef.UpdateZeroStatusFlag(CpuRef.A);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.A);
-	CycleCount = 2;
+	cpuRef.A = cpuRef.X;
+	cpuRef.UpdateZeroStatusFlag(cpuRef.A);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.A);
+	return 2;
 }
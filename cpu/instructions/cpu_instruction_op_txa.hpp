@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new TXA instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpTXA(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpTXA();
 
 	protected:
 		/**
 		 * Perform transfer X to accumulator
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpTXA::CpuInstructionOpTXA() :
+		CpuInstructionBase(AddressingMode::Implicit, "TXA")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_TXA_HPP
@@ -1,12 +1,8 @@
 #include "cpu_instruction_op_txs.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpTXS::CpuInstructionOpTXS(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "TXS")
-{}
-
-void nes::CpuInstructionOpTXS::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpTXS::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.SP = CpuRef.X;
-	CycleCount = 2;
+	cpuRef.SP = cpuRef.X;
+	return 2;
 }
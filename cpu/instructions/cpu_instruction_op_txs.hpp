@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new TXS instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpTXS(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpTXS();
 
 	protected:
 		/**
 		 * Perform transfer X to stack pointer
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpTXS::CpuInstructionOpTXS() :
+		CpuInstructionBase(AddressingMode::Implicit, "TXS")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_TXS_HPP
@@ -1,14 +1,10 @@
 #include "cpu_instruction_op_tya.hpp"
 #include "cpu/cpu.hpp"
 
-nes::CpuInstructionOpTYA::CpuInstructionOpTYA(CPU& cpuRef, AddressingMode addressingMode) :
-	CpuInstructionBase(cpuRef, addressingMode, "TYA")
-{}
-
-void nes::CpuInstructionOpTYA::ExecuteImpl()
+std::uint8_t nes::CpuInstructionOpTYA::ExecuteImpl(CPU& cpuRef) const
 {
-	CpuRef.A = CpuRef.Y;
-	CpuRef.UpdateZeroStatusFlag(CpuRef.A);
-	CpuRef.UpdateNegativeStatusFlag(CpuRef.A);
-	CycleCount = 2;
+	cpuRef.A = cpuRef.Y;
+	cpuRef.UpdateZeroStatusFlag(cpuRef.A);
+	cpuRef.UpdateNegativeStatusFlag(cpuRef.A);
+	return 2;
 }
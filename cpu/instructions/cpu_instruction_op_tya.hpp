@@ -15,17 +15,21 @@ namespace nes
 	public:
 		/**
 		 * Create a new TYA instruction
-		 * @param	cpuRef				Reference to the CPU object
-		 * @param	addressingMode		Addressing mode used for this instruction
 		 */
-		CpuInstructionOpTYA(CPU& cpuRef, AddressingMode addressingMode);
+		constexpr CpuInstructionOpTYA();
 
 	protected:
 		/**
 		 * Perform transfer Y to accumulator
+		 * @param	cpuRef	CPU to execute the instruction on
+		 * @return	Number of cycles the instruction took
 		 */
-		void ExecuteImpl() final override;
+		std::uint8_t ExecuteImpl(CPU& cpuRef) const final override;
 	};
+
+	constexpr CpuInstructionOpTYA::CpuInstructionOpTYA() :
+		CpuInstructionBase(AddressingMode::Implicit, "TYA")
+	{}
 }
 
 #endif //! NES_CPU_INSTRUCTION_OP_TYA_HPP
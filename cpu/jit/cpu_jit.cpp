@@ -0,0 +1,1036 @@
+#include "cpu_jit.hpp"
+#include "cpu_jit_emitter.hpp"
+#include "cpu/cpu.hpp"
+#include "ram/ram.hpp"
+#include "utility/literals.hpp"
+
+#include <algorithm>	// std::max
+#include <cstddef>	// offsetof
+#include <utility>	// std::move / std::swap
+
+#if defined(__x86_64__) || defined(_M_X64)
+	#define NES_CPU_JIT_X86_64
+#endif
+
+namespace
+{
+	using nes::AddressingMode;
+	using nes::JitAluOperation;
+	using nes::JitCondition;
+	using nes::JitRegister;
+
+	// Number of times a block has to be entered before it gets translated
+	constexpr std::uint16_t HOT_BLOCK_THRESHOLD = 32;
+
+	// Blocks invalidated this many times are considered self-modifying
+	constexpr std::uint8_t MAX_INVALIDATION_COUNT = 8;
+
+	// Upper limit on the number of instructions in a single block
+	constexpr std::size_t MAX_BLOCK_INSTRUCTIONS = 64;
+
+	// Shorter blocks are left to the interpreter, entering and leaving a block
+	// costs more than the few instructions in it save
+	constexpr std::size_t MIN_BLOCK_INSTRUCTIONS = 4;
+
+	// Size of the executable memory arena
+	constexpr std::size_t ARENA_SIZE = 4096_KB;
+
+	// PPU and APU / input registers, never touched by translated code
+	constexpr std::uint16_t IO_FIRST_ADDRESS = 0x2000;
+	constexpr std::uint16_t IO_LAST_ADDRESS = 0x401F;
+
+	// Location of the registers inside of CpuJitState
+	constexpr std::uint8_t STATE_CYCLE = offsetof(nes::CpuJitState, Cycle);
+	constexpr std::uint8_t STATE_PC = offsetof(nes::CpuJitState, PC);
+	constexpr std::uint8_t STATE_A = offsetof(nes::CpuJitState, A);
+	constexpr std::uint8_t STATE_X = offsetof(nes::CpuJitState, X);
+	constexpr std::uint8_t STATE_Y = offsetof(nes::CpuJitState, Y);
+	constexpr std::uint8_t STATE_P = offsetof(nes::CpuJitState, P);
+	constexpr std::uint8_t STATE_SP = offsetof(nes::CpuJitState, SP);
+	constexpr std::uint8_t STATE_ZERO_RESULT = offsetof(nes::CpuJitState, ZeroResult);
+	constexpr std::uint8_t STATE_NEGATIVE_RESULT = offsetof(nes::CpuJitState, NegativeResult);
+
+	/**
+	 * Operations the translator knows about
+	 */
+	enum class Operation
+	{
+		Unsupported,
+		LDA, LDX, LDY,
+		STA, STX, STY,
+		ADC, SBC, AND, ORA, EOR, BIT,
+		CMP, CPX, CPY,
+		ASL, LSR, ROL, ROR, INC, DEC,
+		INX, INY, DEX, DEY,
+		TAX, TAY, TSX, TXA, TXS, TYA,
+		CLC, CLD, CLI, CLV, SEC, SED, SEI, NOP,
+		BCC, BCS, BEQ, BMI, BNE, BPL, BVC, BVS,
+		JMP
+	};
+
+	struct OpCodeInfo
+	{
+		Operation InstructionOperation;
+		AddressingMode InstructionAddressingMode;
+	};
+
+	/**
+	 * Map an op-code to its operation and addressing mode
+	 * Instructions the translator does not handle map to Operation::Unsupported
+	 */
+	OpCodeInfo GetOpCodeInfo(std::uint8_t opCode)
+	{
+		using Mode = AddressingMode;
+
+		switch (opCode)
+		{
+			case 0xA9: return { Operation::LDA, Mode::Immediate };
+			case 0xA5: return { Operation::LDA, Mode::ZeroPage };
+			case 0xB5: return { Operation::LDA, Mode::ZeroPageX };
+			case 0xAD: return { Operation::LDA, Mode::Absolute };
+			case 0xBD: return { Operation::LDA, Mode::AbsoluteX };
+			case 0xB9: return { Operation::LDA, Mode::AbsoluteY };
+			case 0xA2: return { Operation::LDX, Mode::Immediate };
+			case 0xA6: return { Operation::LDX, Mode::ZeroPage };
+			case 0xB6: return { Operation::LDX, Mode::ZeroPageY };
+			case 0xAE: return { Operation::LDX, Mode::Absolute };
+			case 0xBE: return { Operation::LDX, Mode::AbsoluteY };
+			case 0xA0: return { Operation::LDY, Mode::Immediate };
+			case 0xA4: return { Operation::LDY, Mode::ZeroPage };
+			case 0xB4: return { Operation::LDY, Mode::ZeroPageX };
+			case 0xAC: return { Operation::LDY, Mode::Absolute };
+			case 0xBC: return { Operation::LDY, Mode::AbsoluteX };
+
+			case 0x85: return { Operation::STA, Mode::ZeroPage };
+			case 0x95: return { Operation::STA, Mode::ZeroPageX };
+			case 0x8D: return { Operation::STA, Mode::Absolute };
+			case 0x9D: return { Operation::STA, Mode::AbsoluteX };
+			case 0x99: return { Operation::STA, Mode::AbsoluteY };
+			case 0x86: return { Operation::STX, Mode::ZeroPage };
+			case 0x96: return { Operation::STX, Mode::ZeroPageY };
+			case 0x8E: return { Operation::STX, Mode::Absolute };
+			case 0x84: return { Operation::STY, Mode::ZeroPage };
+			case 0x94: return { Operation::STY, Mode::ZeroPageX };
+			case 0x8C: return { Operation::STY, Mode::Absolute };
+
+			case 0x69: return { Operation::ADC, Mode::Immediate };
+			case 0x65: return { Operation::ADC, Mode::ZeroPage };
+			case 0x75: return { Operation::ADC, Mode::ZeroPageX };
+			case 0x6D: return { Operation::ADC, Mode::Absolute };
+			case 0x7D: return { Operation::ADC, Mode::AbsoluteX };
+			case 0x79: return { Operation::ADC, Mode::AbsoluteY };
+			case 0xE9: return { Operation::SBC, Mode::Immediate };
+			case 0xE5: return { Operation::SBC, Mode::ZeroPage };
+			case 0xF5: return { Operation::SBC, Mode::ZeroPageX };
+			case 0xED: return { Operation::SBC, Mode::Absolute };
+			case 0xFD: return { Operation::SBC, Mode::AbsoluteX };
+			case 0xF9: return { Operation::SBC, Mode::AbsoluteY };
+			case 0x29: return { Operation::AND, Mode::Immediate };
+			case 0x25: return { Operation::AND, Mode::ZeroPage };
+			case 0x35: return { Operation::AND, Mode::ZeroPageX };
+			case 0x2D: return { Operation::AND, Mode::Absolute };
+			case 0x3D: return { Operation::AND, Mode::AbsoluteX };
+			case 0x39: return { Operation::AND, Mode::AbsoluteY };
+			case 0x09: return { Operation::ORA, Mode::Immediate };
+			case 0x05: return { Operation::ORA, Mode::ZeroPage };
+			case 0x15: return { Operation::ORA, Mode::ZeroPageX };
+			case 0x0D: return { Operation::ORA, Mode::Absolute };
+			case 0x1D: return { Operation::ORA, Mode::AbsoluteX };
+			case 0x19: return { Operation::ORA, Mode::AbsoluteY };
+			case 0x49: return { Operation::EOR, Mode::Immediate };
+			case 0x45: return { Operation::EOR, Mode::ZeroPage };
+			case 0x55: return { Operation::EOR, Mode::ZeroPageX };
+			case 0x4D: return { Operation::EOR, Mode::Absolute };
+			case 0x5D: return { Operation::EOR, Mode::AbsoluteX };
+			case 0x59: return { Operation::EOR, Mode::AbsoluteY };
+			case 0x24: return { Operation::BIT, Mode::ZeroPage };
+			case 0x2C: return { Operation::BIT, Mode::Absolute };
+
+			case 0xC9: return { Operation::CMP, Mode::Immediate };
+			case 0xC5: return { Operation::CMP, Mode::ZeroPage };
+			case 0xD5: return { Operation::CMP, Mode::ZeroPageX };
+			case 0xCD: return { Operation::CMP, Mode::Absolute };
+			case 0xDD: return { Operation::CMP, Mode::AbsoluteX };
+			case 0xD9: return { Operation::CMP, Mode::AbsoluteY };
+			case 0xE0: return { Operation::CPX, Mode::Immediate };
+			case 0xE4: return { Operation::CPX, Mode::ZeroPage };
+			case 0xEC: return { Operation::CPX, Mode::Absolute };
+			case 0xC0: return { Operation::CPY, Mode::Immediate };
+			case 0xC4: return { Operation::CPY, Mode::ZeroPage };
+			case 0xCC: return { Operation::CPY, Mode::Absolute };
+
+			case 0x0A: return { Operation::ASL, Mode::Accumulator };
+			case 0x06: return { Operation::ASL, Mode::ZeroPage };
+			case 0x16: return { Operation::ASL, Mode::ZeroPageX };
+			case 0x0E: return { Operation::ASL, Mode::Absolute };
+			case 0x1E: return { Operation::ASL, Mode::AbsoluteX };
+			case 0x4A: return { Operation::LSR, Mode::Accumulator };
+			case 0x46: return { Operation::LSR, Mode::ZeroPage };
+			case 0x56: return { Operation::LSR, Mode::ZeroPageX };
+			case 0x4E: return { Operation::LSR, Mode::Absolute };
+			case 0x5E: return { Operation::LSR, Mode::AbsoluteX };
+			case 0x2A: return { Operation::ROL, Mode::Accumulator };
+			case 0x26: return { Operation::ROL, Mode::ZeroPage };
+			case 0x36: return { Operation::ROL, Mode::ZeroPageX };
+			case 0x2E: return { Operation::ROL, Mode::Absolute };
+			case 0x3E: return { Operation::ROL, Mode::AbsoluteX };
+			case 0x6A: return { Operation::ROR, Mode::Accumulator };
+			case 0x66: return { Operation::ROR, Mode::ZeroPage };
+			case 0x76: return { Operation::ROR, Mode::ZeroPageX };
+			case 0x6E: return { Operation::ROR, Mode::Absolute };
+			case 0x7E: return { Operation::ROR, Mode::AbsoluteX };
+			case 0xE6: return { Operation::INC, Mode::ZeroPage };
+			case 0xF6: return { Operation::INC, Mode::ZeroPageX };
+			case 0xEE: return { Operation::INC, Mode::Absolute };
+			case 0xFE: return { Operation::INC, Mode::AbsoluteX };
+			case 0xC6: return { Operation::DEC, Mode::ZeroPage };
+			case 0xD6: return { Operation::DEC, Mode::ZeroPageX };
+			case 0xCE: return { Operation::DEC, Mode::Absolute };
+			case 0xDE: return { Operation::DEC, Mode::AbsoluteX };
+
+			case 0xE8: return { Operation::INX, Mode::Implicit };
+			case 0xC8: return { Operation::INY, Mode::Implicit };
+			case 0xCA: return { Operation::DEX, Mode::Implicit };
+			case 0x88: return { Operation::DEY, Mode::Implicit };
+			case 0xAA: return { Operation::TAX, Mode::Implicit };
+			case 0xA8: return { Operation::TAY, Mode::Implicit };
+			case 0xBA: return { Operation::TSX, Mode::Implicit };
+			case 0x8A: return { Operation::TXA, Mode::Implicit };
+			case 0x9A: return { Operation::TXS, Mode::Implicit };
+			case 0x98: return { Operation::TYA, Mode::Implicit };
+			case 0x18: return { Operation::CLC, Mode::Implicit };
+			case 0xD8: return { Operation::CLD, Mode::Implicit };
+			case 0x58: return { Operation::CLI, Mode::Implicit };
+			case 0xB8: return { Operation::CLV, Mode::Implicit };
+			case 0x38: return { Operation::SEC, Mode::Implicit };
+			case 0xF8: return { Operation::SED, Mode::Implicit };
+			case 0x78: return { Operation::SEI, Mode::Implicit };
+			case 0xEA: return { Operation::NOP, Mode::Implicit };
+
+			case 0x90: return { Operation::BCC, Mode::Relative };
+			case 0xB0: return { Operation::BCS, Mode::Relative };
+			case 0xF0: return { Operation::BEQ, Mode::Relative };
+			case 0x30: return { Operation::BMI, Mode::Relative };
+			case 0xD0: return { Operation::BNE, Mode::Relative };
+			case 0x10: return { Operation::BPL, Mode::Relative };
+			case 0x50: return { Operation::BVC, Mode::Relative };
+			case 0x70: return { Operation::BVS, Mode::Relative };
+
+			case 0x4C: return { Operation::JMP, Mode::Absolute };
+
+			// Indirect addressing, stack, subroutine and interrupt instructions are
+			// left to the interpreter
+			default: return { Operation::Unsupported, Mode::Implicit };
+		}
+	}
+
+	bool IsIoAddress(std::uint32_t address)
+	{
+		address &= 0xFFFF;
+		return (address >= IO_FIRST_ADDRESS && address <= IO_LAST_ADDRESS);
+	}
+
+	/**
+	 * Check whether the memory an instruction accesses is known to stay clear of
+	 * the I/O registers
+	 */
+	bool CanAccessMemory(AddressingMode mode, std::uint16_t operand)
+	{
+		switch (mode)
+		{
+			case AddressingMode::Accumulator:
+			case AddressingMode::Immediate:
+			case AddressingMode::Implicit:
+			case AddressingMode::Relative:
+			case AddressingMode::ZeroPage:
+			case AddressingMode::ZeroPageX:
+			case AddressingMode::ZeroPageY:
+				return true;
+
+			case AddressingMode::Absolute:
+				return !IsIoAddress(operand);
+
+			case AddressingMode::AbsoluteX:
+			case AddressingMode::AbsoluteY:
+				// The index register can move the address up to 255 bytes forward,
+				// the I/O range is larger than that so checking both ends is enough
+				return !IsIoAddress(operand) && !IsIoAddress(operand + 0xFF);
+
+			default:
+				return false;
+		}
+	}
+
+	std::uint32_t ReadByteHelper(nes::RAM* ram, std::uint32_t address, std::uint32_t)
+	{
+		return ram->ReadByte(static_cast<std::uint16_t>(address)).value;
+	}
+
+	/**
+	 * Writes the low byte of the value, bits 8-15 hold the page of the block
+	 * making the write. Returns non-zero when the version of that page changed,
+	 * which happens when the write modifies the block itself or makes a mapper
+	 * switch the bank under it, so translated code can leave the block
+	 */
+	std::uint32_t WriteByteHelper(nes::RAM* ram, std::uint32_t address, std::uint32_t value)
+	{
+		std::uint8_t blockPage = static_cast<std::uint8_t>(value >> 8);
+		std::uint32_t blockVersion = ram->GetPageVersion(blockPage);
+
+		nes::Byte byte;
+		byte.value = static_cast<std::uint8_t>(value);
+		ram->WriteByte(static_cast<std::uint16_t>(address), byte);
+
+		return (ram->GetPageVersion(blockPage) != blockVersion) ? 1 : 0;
+	}
+
+	std::uint8_t GetRegisterOffset(Operation operation)
+	{
+		switch (operation)
+		{
+			case Operation::LDX:
+			case Operation::STX:
+			case Operation::CPX:
+				return STATE_X;
+
+			case Operation::LDY:
+			case Operation::STY:
+			case Operation::CPY:
+				return STATE_Y;
+
+			default:
+				return STATE_A;
+		}
+	}
+
+	/**
+	 * Update the zero and negative flags based on the value in EAX
+	 * Both flags are evaluated lazily, so this only records the value
+	 */
+	void EmitUpdateZeroNegative(nes::CpuJitEmitter& emitter)
+	{
+		emitter.StoreStateByte(STATE_ZERO_RESULT, JitRegister::Eax);
+		emitter.StoreStateByte(STATE_NEGATIVE_RESULT, JitRegister::Eax);
+	}
+
+	/**
+	 * Replace the carry flag with the value in EDX (0 or 1)
+	 * Clobbers ECX
+	 */
+	void EmitSetCarry(nes::CpuJitEmitter& emitter)
+	{
+		emitter.LoadStateByte(JitRegister::Ecx, STATE_P);
+		emitter.AluImmediate(JitAluOperation::And, JitRegister::Ecx, 0xFE);
+		emitter.Alu(JitAluOperation::Or, JitRegister::Ecx, JitRegister::Edx);
+		emitter.StoreStateByte(STATE_P, JitRegister::Ecx);
+	}
+}
+
+nes::CpuJit::CpuJit(CPU& cpuRef, RAM& ramRef) :
+	CpuRef(cpuRef),
+	RamRef(ramRef),
+	Arena(ARENA_SIZE),
+	RomGeneration(ramRef.GetRomGeneration()),
+	CompiledBlockCount(0)
+{}
+
+bool nes::CpuJit::IsAvailable() const
+{
+#if defined(NES_CPU_JIT_X86_64)
+	return Arena.IsValid();
+#else
+	return false;
+#endif
+}
+
+bool nes::CpuJit::ExecuteBlock(std::uint64_t cycleLimit, std::uint64_t& instructionCount)
+{
+	instructionCount = 1;
+
+	if (RomGeneration != RamRef.GetRomGeneration())
+	{
+		RomGeneration = RamRef.GetRomGeneration();
+
+		for (auto& entries : Pages)
+		{
+			entries.clear();
+		}
+
+		Reset();
+	}
+
+	std::uint16_t address = CpuRef.PC;
+	std::uint8_t page = static_cast<std::uint8_t>(address >> 8);
+	const Byte* memory = RamRef.GetPageMemory(page);
+
+	// Code read from a handler is left to the interpreter
+	if (memory == nullptr)
+	{
+		return false;
+	}
+
+	std::vector<std::unique_ptr<PageBlocks>>& entries = Pages[page];
+	PageBlocks& pageBlocks = (!entries.empty() && entries[0]->Memory == memory) ? *entries[0] : FindPageBlocks(page, memory);
+	Block& block = pageBlocks.Blocks[address & 0xFF];
+	std::uint32_t pageVersion = RamRef.GetPageVersion(page);
+
+	// Memory under the block changed since it was last looked at. Pages that
+	// cannot be written show ROM, their version only changes when a bank is
+	// switched, and the blocks of every bank are kept apart already
+	if (block.PageVersion != pageVersion && RamRef.IsPageWritable(page))
+	{
+		if (block.Code != nullptr && block.InvalidationCount < MAX_INVALIDATION_COUNT)
+		{
+			++block.InvalidationCount;
+		}
+
+		block.Code = nullptr;
+		block.PageVersion = pageVersion;
+		block.EntryCount = 0;
+		block.Untranslatable = false;
+	}
+
+	if (block.Code == nullptr)
+	{
+		if (block.Untranslatable)
+		{
+			instructionCount = block.InterpretedCount;
+			return false;
+		}
+
+		if (block.InvalidationCount >= MAX_INVALIDATION_COUNT || !IsAvailable())
+		{
+			return false;
+		}
+
+		if (++block.EntryCount < HOT_BLOCK_THRESHOLD)
+		{
+			return false;
+		}
+
+		if (!Compile(address, block))
+		{
+			block.Untranslatable = true;
+			instructionCount = block.InterpretedCount;
+			return false;
+		}
+
+		// Compiling may have flushed the arena, which resets all blocks
+		block.PageVersion = pageVersion;
+	}
+
+	// Do not run past the cycle limit, let the interpreter finish the job
+	if (CpuRef.CurrentCycle + block.MaxCycles > cycleLimit)
+	{
+		return false;
+	}
+
+	CpuJitState state;
+	state.Cycle = CpuRef.CurrentCycle;
+	state.PC = CpuRef.PC;
+	state.A = CpuRef.A.value;
+	state.X = CpuRef.X.value;
+	state.Y = CpuRef.Y.value;
+	state.P = CpuRef.P.value;
+	state.SP = CpuRef.SP.value;
+	state.ZeroResult = CpuRef.ZeroResult;
+	state.NegativeResult = CpuRef.NegativeResult;
+
+	block.Code(&state, &RamRef);
+
+	CpuRef.CurrentCycle = state.Cycle;
+	CpuRef.PC = state.PC;
+	CpuRef.A.value = state.A;
+	CpuRef.X.value = state.X;
+	CpuRef.Y.value = state.Y;
+	CpuRef.P.value = state.P;
+	CpuRef.SP.value = state.SP;
+	CpuRef.ZeroResult = state.ZeroResult;
+	CpuRef.NegativeResult = state.NegativeResult;
+
+	return true;
+}
+
+void nes::CpuJit::Reset()
+{
+	Arena.Reset();
+
+	// The pages stay allocated, ExecuteBlock holds on to a block while it is
+	// compiled
+	for (auto& entries : Pages)
+	{
+		for (auto& entry : entries)
+		{
+			entry->Blocks.fill(Block{});
+		}
+	}
+
+	CompiledBlockCount = 0;
+}
+
+std::size_t nes::CpuJit::GetCompiledBlockCount() const
+{
+	return CompiledBlockCount;
+}
+
+nes::CpuJit::PageBlocks& nes::CpuJit::FindPageBlocks(std::uint8_t page, const Byte* memory)
+{
+	std::vector<std::unique_ptr<PageBlocks>>& entries = Pages[page];
+
+	for (std::size_t i = 0; i < entries.size(); ++i)
+	{
+		if (entries[i]->Memory == memory)
+		{
+			// Keep the memory the page shows right now in front, so the search
+			// almost always ends at the first entry
+			std::swap(entries[0], entries[i]);
+			return *entries[0];
+		}
+	}
+
+	auto entry = std::make_unique<PageBlocks>();
+	entry->Memory = memory;
+	entries.insert(entries.begin(), std::move(entry));
+
+	return *entries[0];
+}
+
+bool nes::CpuJit::Compile(std::uint16_t address, Block& block)
+{
+	block.InterpretedCount = 1;
+
+#if defined(NES_CPU_JIT_X86_64)
+	CpuJitEmitter emitter;
+	emitter.EmitPrologue();
+
+	Translation translation;
+	translation.Page = static_cast<std::uint8_t>(address >> 8);
+	translation.Cycles = 0;
+	translation.MaxCycles = 0;
+
+	std::uint32_t nextAddress = address;
+	std::size_t instructionCount = 0;
+	TranslationResult result = TranslationResult::Unsupported;
+
+	while (instructionCount < MAX_BLOCK_INSTRUCTIONS)
+	{
+		std::uint8_t opCode = ReadCodeByte(static_cast<std::uint16_t>(nextAddress));
+		std::uint32_t size = GetInstructionSize(GetOpCodeInfo(opCode).InstructionAddressingMode);
+
+		// Blocks never leave the page they started on
+		if (((nextAddress + size - 1) >> 8) != translation.Page)
+		{
+			break;
+		}
+
+		translation.Address = static_cast<std::uint16_t>(nextAddress);
+		translation.Operand = ConstructAddressFromBytes(ReadCodeByte(translation.Address + 2), ReadCodeByte(translation.Address + 1));
+
+		result = TranslateInstruction(emitter, translation, opCode);
+
+		if (result == TranslationResult::Unsupported)
+		{
+			break;
+		}
+
+		++instructionCount;
+		nextAddress += size;
+
+		if (result == TranslationResult::EndOfBlock)
+		{
+			break;
+		}
+	}
+
+	if (instructionCount < MIN_BLOCK_INSTRUCTIONS)
+	{
+		// The instruction that stopped the translation is interpreted as well
+		std::size_t interpretedCount = instructionCount + ((result == TranslationResult::Unsupported) ? 1 : 0);
+		block.InterpretedCount = static_cast<std::uint8_t>(std::max<std::size_t>(interpretedCount, 1));
+		return false;
+	}
+
+	// Leave the block at the first instruction that was not translated
+	if (result != TranslationResult::EndOfBlock)
+	{
+		emitter.AddStateQword(STATE_CYCLE, translation.Cycles);
+		emitter.StoreStateWord(STATE_PC, static_cast<std::uint16_t>(nextAddress));
+	}
+
+	for (std::size_t exitJump : translation.ExitJumps)
+	{
+		emitter.PatchJump(exitJump);
+	}
+
+	emitter.EmitEpilogue();
+
+	const std::vector<std::uint8_t>& code = emitter.GetCode();
+	const void* nativeCode = Arena.Write(code.data(), code.size());
+
+	if (nativeCode == nullptr)
+	{
+		// Arena is full, start over with an empty one
+		Reset();
+		nativeCode = Arena.Write(code.data(), code.size());
+
+		if (nativeCode == nullptr)
+		{
+			return false;
+		}
+	}
+
+	block.Code = reinterpret_cast<BlockFunction>(const_cast<void*>(nativeCode));
+	block.MaxCycles = static_cast<std::uint16_t>(translation.MaxCycles);
+	++CompiledBlockCount;
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+nes::CpuJit::TranslationResult nes::CpuJit::TranslateInstruction(CpuJitEmitter& emitter, Translation& translation, std::uint8_t opCode)
+{
+	OpCodeInfo info = GetOpCodeInfo(opCode);
+	Operation operation = info.InstructionOperation;
+	AddressingMode mode = info.InstructionAddressingMode;
+	std::uint16_t operand = translation.Operand;
+	std::uint16_t nextAddress = static_cast<std::uint16_t>(translation.Address + GetInstructionSize(mode));
+
+	if (operation == Operation::Unsupported || !CanAccessMemory(mode, operand))
+	{
+		return TranslationResult::Unsupported;
+	}
+
+	// Leave the block with the program counter at the specified address, the
+	// cycles of all instructions translated so far are added on the way out
+	auto emitExit = [&emitter, &translation](std::uint16_t programCounter, std::uint32_t extraCycles)
+	{
+		emitter.AddStateQword(STATE_CYCLE, translation.Cycles + extraCycles);
+		emitter.StoreStateWord(STATE_PC, programCounter);
+		translation.ExitJumps.push_back(emitter.Jump());
+	};
+
+	// Effective address ends up in EAX
+	auto emitAddress = [&emitter, &translation, mode, operand](bool pageCrossPenalty)
+	{
+		switch (mode)
+		{
+			case AddressingMode::ZeroPage:
+			case AddressingMode::Absolute:
+				emitter.MoveImmediate(JitRegister::Eax, (mode == AddressingMode::ZeroPage) ? (operand & 0xFF) : operand);
+				break;
+
+			case AddressingMode::ZeroPageX:
+			case AddressingMode::ZeroPageY:
+				emitter.LoadStateByte(JitRegister::Eax, (mode == AddressingMode::ZeroPageX) ? STATE_X : STATE_Y);
+				emitter.AluImmediate(JitAluOperation::Add, JitRegister::Eax, operand & 0xFF);
+				emitter.AluImmediate(JitAluOperation::And, JitRegister::Eax, 0xFF);
+				break;
+
+			case AddressingMode::AbsoluteX:
+			case AddressingMode::AbsoluteY:
+				emitter.LoadStateByte(JitRegister::Eax, (mode == AddressingMode::AbsoluteX) ? STATE_X : STATE_Y);
+				emitter.AluImmediate(JitAluOperation::Add, JitRegister::Eax, operand);
+				emitter.AluImmediate(JitAluOperation::And, JitRegister::Eax, 0xFFFF);
+
+				if (pageCrossPenalty)
+				{
+					// One extra cycle when the index crosses into the next page
+					emitter.Move(JitRegister::Ecx, JitRegister::Eax);
+					emitter.AluImmediate(JitAluOperation::Xor, JitRegister::Ecx, operand);
+					emitter.AluImmediate(JitAluOperation::And, JitRegister::Ecx, 0xFF00);
+					emitter.SetCondition(JitCondition::NotEqual, JitRegister::Edx);
+					emitter.AddStateQword(STATE_CYCLE, JitRegister::Edx);
+					translation.MaxCycles += 1;
+				}
+				break;
+
+			default:
+				break;
+		}
+	};
+
+	// Operand value ends up in EAX
+	auto emitLoadOperand = [&emitter, &emitAddress, mode, operand]()
+	{
+		if (mode == AddressingMode::Immediate)
+		{
+			emitter.MoveImmediate(JitRegister::Eax, operand & 0xFF);
+		}
+		else
+		{
+			emitAddress(true);
+			emitter.CallHelper(reinterpret_cast<const void*>(&ReadByteHelper));
+		}
+	};
+
+	// Write ECX to the address in EAX, leaving the block if the write modified
+	// or remapped the block's own page, through any address
+	auto emitWrite = [&emitter, &translation, &emitExit, nextAddress]()
+	{
+		emitter.AluImmediate(JitAluOperation::Or, JitRegister::Ecx, translation.Page << 8);
+		emitter.CallHelper(reinterpret_cast<const void*>(&WriteByteHelper));
+		emitter.AluImmediate(JitAluOperation::Cmp, JitRegister::Eax, 0);
+
+		std::size_t unchanged = emitter.JumpIf(JitCondition::Equal);
+		emitExit(nextAddress, 0);
+		emitter.PatchJump(unchanged);
+	};
+
+	auto addCycles = [&translation](std::uint32_t cycles)
+	{
+		translation.Cycles += cycles;
+		translation.MaxCycles += cycles;
+	};
+
+	switch (operation)
+	{
+		case Operation::LDA:
+		case Operation::LDX:
+		case Operation::LDY:
+			addCycles(GetReadCycleCount(mode));
+			emitLoadOperand();
+			emitter.StoreStateByte(GetRegisterOffset(operation), JitRegister::Eax);
+			EmitUpdateZeroNegative(emitter);
+			return TranslationResult::Continue;
+
+		case Operation::STA:
+		case Operation::STX:
+		case Operation::STY:
+			addCycles(GetStoreCycleCount(mode));
+			emitAddress(false);
+			emitter.LoadStateByte(JitRegister::Ecx, GetRegisterOffset(operation));
+			emitWrite();
+			return TranslationResult::Continue;
+
+		case Operation::ADC:
+		case Operation::SBC:
+			addCycles(GetReadCycleCount(mode));
+			emitLoadOperand();
+
+			// Subtraction is addition of the inverted operand
+			if (operation == Operation::SBC)
+			{
+				emitter.AluImmediate(JitAluOperation::Xor, JitRegister::Eax, 0xFF);
+			}
+
+			// EDX = A + value + carry
+			emitter.LoadStateByte(JitRegister::Ecx, STATE_A);
+			emitter.LoadStateByte(JitRegister::Edx, STATE_P);
+			emitter.AluImmediate(JitAluOperation::And, JitRegister::Edx, 0x01);
+			emitter.Alu(JitAluOperation::Add, JitRegister::Edx, JitRegister::Ecx);
+			emitter.Alu(JitAluOperation::Add, JitRegister::Edx, JitRegister::Eax);
+
+			// Overflow: ~(A ^ value) & (A ^ sum) & 0x80, moved to bit 6
+			emitter.Alu(JitAluOperation::Xor, JitRegister::Eax, JitRegister::Ecx);
+			emitter.Not(JitRegister::Eax);
+			emitter.Alu(JitAluOperation::Xor, JitRegister::Ecx, JitRegister::Edx);
+			emitter.Alu(JitAluOperation::And, JitRegister::Eax, JitRegister::Ecx);
+			emitter.AluImmediate(JitAluOperation::And, JitRegister::Eax, 0x80);
+			emitter.ShiftRight(JitRegister::Eax, 1);
+
+			// Carry: sum > 0xFF
+			emitter.Move(JitRegister::Ecx, JitRegister::Edx);
+			emitter.ShiftRight(JitRegister::Ecx, 8);
+			emitter.AluImmediate(JitAluOperation::And, JitRegister::Ecx, 0x01);
+			emitter.Alu(JitAluOperation::Or, JitRegister::Eax, JitRegister::Ecx);
+
+			emitter.LoadStateByte(JitRegister::Ecx, STATE_P);
+			emitter.AluImmediate(JitAluOperation::And, JitRegister::Ecx, 0xBE);
+			emitter.Alu(JitAluOperation::Or, JitRegister::Ecx, JitRegister::Eax);
+			emitter.StoreStateByte(STATE_P, JitRegister::Ecx);
+
+			emitter.AluImmediate(JitAluOperation::And, JitRegister::Edx, 0xFF);
+			emitter.StoreStateByte(STATE_A, JitRegister::Edx);
+			emitter.Move(JitRegister::Eax, JitRegister::Edx);
+			EmitUpdateZeroNegative(emitter);
+			return TranslationResult::Continue;
+
+		case Operation::AND:
+		case Operation::ORA:
+		case Operation::EOR:
+		{
+			addCycles(GetReadCycleCount(mode));
+			emitLoadOperand();
+
+			JitAluOperation aluOperation = JitAluOperation::And;
+			if (operation == Operation::ORA)
+			{
+				aluOperation = JitAluOperation::Or;
+			}
+			else if (operation == Operation::EOR)
+			{
+				aluOperation = JitAluOperation::Xor;
+			}
+
+			emitter.LoadStateByte(JitRegister::Ecx, STATE_A);
+			emitter.Alu(aluOperation, JitRegister::Eax, JitRegister::Ecx);
+			emitter.StoreStateByte(STATE_A, JitRegister::Eax);
+			EmitUpdateZeroNegative(emitter);
+			return TranslationResult::Continue;
+		}
+
+		case Operation::BIT:
+			addCycles(GetReadCycleCount(mode));
+			emitLoadOperand();
+
+			// Zero flag from A & value, negative and overflow straight from the value
+			emitter.LoadStateByte(JitRegister::Ecx, STATE_A);
+			emitter.Alu(JitAluOperation::And, JitRegister::Ecx, JitRegister::Eax);
+			emitter.StoreStateByte(STATE_ZERO_RESULT, JitRegister::Ecx);
+			emitter.StoreStateByte(STATE_NEGATIVE_RESULT, JitRegister::Eax);
+
+			emitter.AluImmediate(JitAluOperation::And, JitRegister::Eax, 0x40);
+			emitter.LoadStateByte(JitRegister::Ecx, STATE_P);
+			emitter.AluImmediate(JitAluOperation::And, JitRegister::Ecx, 0xBF);
+			emitter.Alu(JitAluOperation::Or, JitRegister::Ecx, JitRegister::Eax);
+			emitter.StoreStateByte(STATE_P, JitRegister::Ecx);
+			return TranslationResult::Continue;
+
+		case Operation::CMP:
+		case Operation::CPX:
+		case Operation::CPY:
+			addCycles(GetReadCycleCount(mode));
+			emitLoadOperand();
+
+			emitter.LoadStateByte(JitRegister::Ecx, GetRegisterOffset(operation));
+			emitter.Alu(JitAluOperation::Cmp, JitRegister::Ecx, JitRegister::Eax);
+			emitter.SetCondition(JitCondition::AboveOrEqual, JitRegister::Edx);
+			emitter.Alu(JitAluOperation::Sub, JitRegister::Ecx, JitRegister::Eax);
+			emitter.AluImmediate(JitAluOperation::And, JitRegister::Ecx, 0xFF);
+			emitter.Move(JitRegister::Eax, JitRegister::Ecx);
+			EmitSetCarry(emitter);
+			EmitUpdateZeroNegative(emitter);
+			return TranslationResult::Continue;
+
+		case Operation::ASL:
+		case Operation::LSR:
+		case Operation::ROL:
+		case Operation::ROR:
+		case Operation::INC:
+		case Operation::DEC:
+			addCycles(GetReadModifyWriteCycleCount(mode));
+
+			if (mode == AddressingMode::Accumulator)
+			{
+				emitter.LoadStateByte(JitRegister::Eax, STATE_A);
+			}
+			else
+			{
+				emitAddress(false);
+				emitter.SaveAddress();
+				emitter.CallHelper(reinterpret_cast<const void*>(&ReadByteHelper));
+			}
+
+			switch (operation)
+			{
+				case Operation::ASL:
+					// Carry gets the old bit 7
+					emitter.Move(JitRegister::Edx, JitRegister::Eax);
+					emitter.ShiftRight(JitRegister::Edx, 7);
+					EmitSetCarry(emitter);
+					emitter.ShiftLeft(JitRegister::Eax, 1);
+					emitter.AluImmediate(JitAluOperation::And, JitRegister::Eax, 0xFF);
+					EmitUpdateZeroNegative(emitter);
+					break;
+
+				case Operation::LSR:
+					// Carry gets the old bit 0
+					emitter.Move(JitRegister::Edx, JitRegister::Eax);
+					emitter.AluImmediate(JitAluOperation::And, JitRegister::Edx, 0x01);
+					EmitSetCarry(emitter);
+					emitter.ShiftRight(JitRegister::Eax, 1);
+					EmitUpdateZeroNegative(emitter);
+					break;
+
+				case Operation::ROL:
+					// Old carry becomes the new bit 0, the old bit 7 ends up
+					// in bit 8 and becomes the new carry
+					emitter.LoadStateByte(JitRegister::Ecx, STATE_P);
+					emitter.AluImmediate(JitAluOperation::And, JitRegister::Ecx, 0x01);
+					emitter.ShiftLeft(JitRegister::Eax, 1);
+					emitter.Alu(JitAluOperation::Or, JitRegister::Eax, JitRegister::Ecx);
+					emitter.Move(JitRegister::Edx, JitRegister::Eax);
+					emitter.ShiftRight(JitRegister::Edx, 8);
+					EmitSetCarry(emitter);
+					emitter.AluImmediate(JitAluOperation::And, JitRegister::Eax, 0xFF);
+					EmitUpdateZeroNegative(emitter);
+					break;
+
+				case Operation::ROR:
+					// Old carry becomes the new bit 7, old bit 0 the new carry
+					emitter.LoadStateByte(JitRegister::Ecx, STATE_P);
+					emitter.AluImmediate(JitAluOperation::And, JitRegister::Ecx, 0x01);
+					emitter.ShiftLeft(JitRegister::Ecx, 7);
+					emitter.Move(JitRegister::Edx, JitRegister::Eax);
+					emitter.AluImmediate(JitAluOperation::And, JitRegister::Edx, 0x01);
+					emitter.ShiftRight(JitRegister::Eax, 1);
+					emitter.Alu(JitAluOperation::Or, JitRegister::Eax, JitRegister::Ecx);
+					EmitSetCarry(emitter);
+					EmitUpdateZeroNegative(emitter);
+					break;
+
+				case Operation::INC:
+					emitter.AluImmediate(JitAluOperation::Add, JitRegister::Eax, 1);
+					emitter.AluImmediate(JitAluOperation::And, JitRegister::Eax, 0xFF);
+					EmitUpdateZeroNegative(emitter);
+					break;
+
+				default:
+					emitter.AluImmediate(JitAluOperation::Sub, JitRegister::Eax, 1);
+					emitter.AluImmediate(JitAluOperation::And, JitRegister::Eax, 0xFF);
+					EmitUpdateZeroNegative(emitter);
+					break;
+			}
+
+			if (mode == AddressingMode::Accumulator)
+			{
+				emitter.StoreStateByte(STATE_A, JitRegister::Eax);
+			}
+			else
+			{
+				emitter.Move(JitRegister::Ecx, JitRegister::Eax);
+				emitter.RestoreAddress();
+				emitWrite();
+			}
+
+			return TranslationResult::Continue;
+
+		case Operation::INX:
+		case Operation::INY:
+		case Operation::DEX:
+		case Operation::DEY:
+		{
+			addCycles(2);
+
+			std::uint8_t offset = (operation == Operation::INX || operation == Operation::DEX) ? STATE_X : STATE_Y;
+			JitAluOperation aluOperation = (operation == Operation::INX || operation == Operation::INY) ? JitAluOperation::Add : JitAluOperation::Sub;
+
+			emitter.LoadStateByte(JitRegister::Eax, offset);
+			emitter.AluImmediate(aluOperation, JitRegister::Eax, 1);
+			emitter.AluImmediate(JitAluOperation::And, JitRegister::Eax, 0xFF);
+			emitter.StoreStateByte(offset, JitRegister::Eax);
+			EmitUpdateZeroNegative(emitter);
+			return TranslationResult::Continue;
+		}
+
+		case Operation::TAX:
+		case Operation::TAY:
+		case Operation::TSX:
+		case Operation::TXA:
+		case Operation::TXS:
+		case Operation::TYA:
+		{
+			addCycles(2);
+
+			std::uint8_t source = STATE_A;
+			std::uint8_t destination = STATE_X;
+
+			switch (operation)
+			{
+				case Operation::TAY: source = STATE_A;	destination = STATE_Y;	break;
+				case Operation::TSX: source = STATE_SP;	destination = STATE_X;	break;
+				case Operation::TXA: source = STATE_X;	destination = STATE_A;	break;
+				case Operation::TXS: source = STATE_X;	destination = STATE_SP;	break;
+				case Operation::TYA: source = STATE_Y;	destination = STATE_A;	break;
+				default: break;
+			}
+
+			emitter.LoadStateByte(JitRegister::Eax, source);
+			emitter.StoreStateByte(destination, JitRegister::Eax);
+
+			// TXS is the only transfer that leaves the flags alone
+			if (operation != Operation::TXS)
+			{
+				EmitUpdateZeroNegative(emitter);
+			}
+
+			return TranslationResult::Continue;
+		}
+
+		case Operation::CLC: addCycles(2); emitter.AndStateByte(STATE_P, ~static_cast<std::uint8_t>(StatusFlags::Carry)); return TranslationResult::Continue;
+		case Operation::CLD: addCycles(2); emitter.AndStateByte(STATE_P, ~static_cast<std::uint8_t>(StatusFlags::DecimalMode)); return TranslationResult::Continue;
+		case Operation::CLI: addCycles(2); emitter.AndStateByte(STATE_P, ~static_cast<std::uint8_t>(StatusFlags::InterruptDisable)); return TranslationResult::Continue;
+		case Operation::CLV: addCycles(2); emitter.AndStateByte(STATE_P, ~static_cast<std::uint8_t>(StatusFlags::Overflow)); return TranslationResult::Continue;
+		case Operation::SEC: addCycles(2); emitter.OrStateByte(STATE_P, static_cast<std::uint8_t>(StatusFlags::Carry)); return TranslationResult::Continue;
+		case Operation::SED: addCycles(2); emitter.OrStateByte(STATE_P, static_cast<std::uint8_t>(StatusFlags::DecimalMode)); return TranslationResult::Continue;
+		case Operation::SEI: addCycles(2); emitter.OrStateByte(STATE_P, static_cast<std::uint8_t>(StatusFlags::InterruptDisable)); return TranslationResult::Continue;
+		case Operation::NOP: addCycles(2); return TranslationResult::Continue;
+
+		case Operation::BCC:
+		case Operation::BCS:
+		case Operation::BEQ:
+		case Operation::BMI:
+		case Operation::BNE:
+		case Operation::BPL:
+		case Operation::BVC:
+		case Operation::BVS:
+		{
+			StatusFlags flag = StatusFlags::Carry;
+			bool branchIfSet = false;
+
+			switch (operation)
+			{
+				case Operation::BCS: flag = StatusFlags::Carry;		branchIfSet = true;		break;
+				case Operation::BEQ: flag = StatusFlags::Zero;		branchIfSet = true;		break;
+				case Operation::BMI: flag = StatusFlags::Negative;	branchIfSet = true;		break;
+				case Operation::BNE: flag = StatusFlags::Zero;		branchIfSet = false;	break;
+				case Operation::BPL: flag = StatusFlags::Negative;	branchIfSet = false;	break;
+				case Operation::BVC: flag = StatusFlags::Overflow;	branchIfSet = false;	break;
+				case Operation::BVS: flag = StatusFlags::Overflow;	branchIfSet = true;		break;
+				default: break;
+			}
+
+			// Same timing and program counter rules as CpuInstructionOpBranch
+			std::int8_t displacement = static_cast<std::uint8_t>(operand);
+			std::uint16_t targetPC = nextAddress + displacement;
+			std::uint32_t takenCycles = (((nextAddress ^ targetPC) & 0xFF00) != 0) ? 2 : 1;
+
+			translation.Cycles += 2;
+			translation.MaxCycles += 2 + takenCycles;
+
+			// The zero flag is set when its result byte is 0, so the test
+			// has the opposite sense of all other flags
+			bool flagSetWhenNonZero = true;
+
+			if (flag == StatusFlags::Zero)
+			{
+				emitter.TestStateByte(STATE_ZERO_RESULT, 0xFF);
+				flagSetWhenNonZero = false;
+			}
+			else if (flag == StatusFlags::Negative)
+			{
+				emitter.TestStateByte(STATE_NEGATIVE_RESULT, 0x80);
+			}
+			else
+			{
+				emitter.TestStateByte(STATE_P, static_cast<std::uint8_t>(flag));
+			}
+
+			std::size_t notTaken = emitter.JumpIf((branchIfSet == flagSetWhenNonZero) ? JitCondition::Equal : JitCondition::NotEqual);
+			emitExit(targetPC, takenCycles);
+			emitter.PatchJump(notTaken);
+			emitExit(nextAddress, 0);
+			return TranslationResult::EndOfBlock;
+		}
+
+		case Operation::JMP:
+			if (mode != AddressingMode::Absolute)
+			{
+				return TranslationResult::Unsupported;
+			}
+
+			addCycles(3);
+			emitExit(operand, 0);
+			return TranslationResult::EndOfBlock;
+
+		default:
+			return TranslationResult::Unsupported;
+	}
+}
+
+std::uint8_t nes::CpuJit::ReadCodeByte(std::uint16_t address) const
+{
+	return RamRef.ReadByte(address).value;
+}
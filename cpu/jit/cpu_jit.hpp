@@ -0,0 +1,227 @@
+#ifndef NES_CPU_JIT_HPP
+#define NES_CPU_JIT_HPP
+
+#include "cpu_jit_arena.hpp"
+#include "ram/ram.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace nes
+{
+	class CPU;
+	class CpuJitEmitter;
+
+	/**
+	 * CPU registers as seen by translated code
+	 */
+	struct CpuJitState
+	{
+		std::uint64_t Cycle;
+		std::uint16_t PC;
+		std::uint8_t A;
+		std::uint8_t X;
+		std::uint8_t Y;
+		std::uint8_t P;
+		std::uint8_t SP;
+
+		// Lazily evaluated zero and negative flags, same as in CPU
+		std::uint8_t ZeroResult;
+		std::uint8_t NegativeResult;
+	};
+
+	/**
+	 * Translates hot basic blocks of 6502 code into x86-64 machine code
+	 *
+	 * Every address a block could start at keeps an entry counter. Once a block
+	 * has been entered often enough, it is translated up to the first instruction
+	 * the translator does not handle (indirect addressing, stack and interrupt
+	 * instructions, anything touching the I/O registers) or the first branch or
+	 * jump. The CPU falls back to the interpreter for everything that is not
+	 * translated. Blocks that stop after only a few instructions cost more to
+	 * enter than they save, so they are not translated at all and the
+	 * interpreter runs them without looking up every single instruction.
+	 *
+	 * Blocks never span more than one page of memory and are kept apart for
+	 * every piece of memory the page has shown, so switching banks back and
+	 * forth keeps the blocks of all of them. Blocks on writable pages are tied
+	 * to the version of that page, so self-modifying code simply invalidates the
+	 * block. Blocks that keep getting invalidated are left to the interpreter for
+	 * good.
+	 */
+	class CpuJit
+	{
+	public:
+		/**
+		 * Create a new JIT compiler
+		 * @param	cpuRef	Reference to the CPU object
+		 * @param	ramRef	Reference to the RAM
+		 */
+		CpuJit(CPU& cpuRef, RAM& ramRef);
+
+		/**
+		 * Check whether native code can be generated and executed on this machine
+		 * @return	True if the JIT can be used
+		 */
+		bool IsAvailable() const;
+
+		/**
+		 * Execute the translated block at the current program counter
+		 * Blocks only run when they are guaranteed to finish before the cycle
+		 * limit, so the CPU stops on exactly the same instruction as it would with
+		 * the interpreter
+		 * @param	cycleLimit			Cycle the block is not allowed to run past
+		 * @param	instructionCount	Set to the number of instructions the
+		 *								interpreter has to execute before the next
+		 *								call when no block was executed
+		 * @return	True if a block was executed, false if the interpreter needs to
+		 *			execute the next instructions
+		 */
+		bool ExecuteBlock(std::uint64_t cycleLimit, std::uint64_t& instructionCount);
+
+		/**
+		 * Throw away all translated code and profiling data
+		 */
+		void Reset();
+
+		/**
+		 * Retrieve the number of blocks translated since the last reset
+		 * @return	Number of translated blocks
+		 */
+		std::size_t GetCompiledBlockCount() const;
+
+	private:
+		/**
+		 * Signature of translated blocks
+		 */
+		using BlockFunction = void(*)(CpuJitState* state, RAM* ram);
+
+		/**
+		 * Book-keeping for every address a block can start at
+		 */
+		struct Block
+		{
+			// Translated code, nullptr when the block has not been translated
+			BlockFunction Code;
+
+			// Version of the page the block was translated from, only checked
+			// for writable pages
+			std::uint32_t PageVersion;
+
+			// Worst-case number of cycles the block takes
+			std::uint16_t MaxCycles;
+
+			// Number of times the block was entered while not translated
+			std::uint16_t EntryCount;
+
+			// Number of times translated code was thrown away because the
+			// underlying memory changed
+			std::uint8_t InvalidationCount;
+
+			// Too few instructions from the start of the block can be
+			// translated to make it worth entering
+			bool Untranslatable;
+
+			// Instructions the interpreter runs at once for an untranslatable
+			// block, up to where its translation stopped, so it is not looked up
+			// again for every one of them
+			std::uint8_t InterpretedCount;
+		};
+
+		/**
+		 * Blocks of a page while it shows a particular piece of memory
+		 */
+		struct PageBlocks
+		{
+			// Start of the memory the blocks were translated from
+			const Byte* Memory;
+
+			// Indexed by the low byte of the address
+			std::array<Block, RAM::PAGE_SIZE> Blocks;
+		};
+
+		/**
+		 * Translation state of the block that is being compiled
+		 */
+		struct Translation
+		{
+			// Address of the instruction being translated
+			std::uint16_t Address;
+
+			// The two bytes following the op-code
+			std::uint16_t Operand;
+
+			// Page the block lives on
+			std::uint8_t Page;
+
+			// Cycles of all instructions translated so far
+			std::uint32_t Cycles;
+
+			// Worst-case cycles of all instructions translated so far
+			std::uint32_t MaxCycles;
+
+			// Jumps that need to be pointed at the epilogue
+			std::vector<std::size_t> ExitJumps;
+		};
+
+		/**
+		 * Outcome of translating a single instruction
+		 */
+		enum class TranslationResult
+		{
+			Continue,		// Instruction translated, keep going
+			EndOfBlock,		// Instruction translated, it ends the block
+			Unsupported		// Instruction cannot be translated
+		};
+
+		/**
+		 * Find the blocks of a page for the memory it shows, they are created
+		 * the first time code runs from that memory
+		 * @param	page	Index of the page (high byte of the address)
+		 * @param	memory	Memory the page shows
+		 * @return	Blocks of the page
+		 */
+		PageBlocks& FindPageBlocks(std::uint8_t page, const Byte* memory);
+
+		/**
+		 * Translate the block starting at the specified address
+		 * @param	address		Address of the first instruction
+		 * @param	block		Block to store the result in
+		 * @return	True if enough instructions were translated to make the
+		 *			block worth entering
+		 */
+		bool Compile(std::uint16_t address, Block& block);
+
+		/**
+		 * Translate a single instruction
+		 * @param	emitter			Machine code output
+		 * @param	translation		Translation state
+		 * @param	opCode			Op-code of the instruction
+		 * @return	Outcome of the translation
+		 */
+		TranslationResult TranslateInstruction(CpuJitEmitter& emitter, Translation& translation, std::uint8_t opCode);
+
+		std::uint8_t ReadCodeByte(std::uint16_t address) const;
+
+	private:
+		CPU& CpuRef;
+		RAM& RamRef;
+
+		CpuJitArena Arena;
+
+		// Blocks of every page, one entry for every piece of memory the page
+		// showed while code ran from it, the most recently used one first
+		std::array<std::vector<std::unique_ptr<PageBlocks>>, RAM::PAGE_COUNT> Pages;
+
+		// Blocks remember memory by its address, which a newly stored ROM may
+		// reuse, see RAM::GetRomGeneration
+		std::uint32_t RomGeneration;
+
+		std::size_t CompiledBlockCount;
+	};
+}
+
+#endif //! NES_CPU_JIT_HPP
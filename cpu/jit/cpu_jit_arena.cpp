@@ -0,0 +1,102 @@
+#include "cpu_jit_arena.hpp"
+
+#include <cstring>	// std::memcpy
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+#endif
+
+nes::CpuJitArena::CpuJitArena(std::size_t capacity) :
+	Memory(nullptr),
+	Capacity(capacity),
+	Used(0)
+{
+#if defined(_WIN32)
+	Memory = static_cast<std::uint8_t*>(VirtualAlloc(nullptr, Capacity, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+#else
+	void* memory = mmap(nullptr, Capacity, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+	Memory = (memory == MAP_FAILED) ? nullptr : static_cast<std::uint8_t*>(memory);
+#endif
+
+	// Some systems refuse to hand out executable memory at all
+	if (Memory != nullptr && !SetWritable(false))
+	{
+		Release();
+	}
+}
+
+nes::CpuJitArena::~CpuJitArena()
+{
+	Release();
+}
+
+const void* nes::CpuJitArena::Write(const std::uint8_t* code, std::size_t size)
+{
+	// Keep every block 16-byte aligned
+	std::size_t alignedSize = (size + 15) & ~static_cast<std::size_t>(15);
+
+	if (Memory == nullptr || Used + alignedSize > Capacity)
+	{
+		return nullptr;
+	}
+
+	if (!SetWritable(true))
+	{
+		return nullptr;
+	}
+
+	std::uint8_t* destination = Memory + Used;
+	std::memcpy(destination, code, size);
+	Used += alignedSize;
+
+	if (!SetWritable(false))
+	{
+		return nullptr;
+	}
+
+#if defined(_WIN32)
+	FlushInstructionCache(GetCurrentProcess(), destination, size);
+#endif
+
+	return destination;
+}
+
+void nes::CpuJitArena::Reset()
+{
+	Used = 0;
+}
+
+bool nes::CpuJitArena::IsValid() const
+{
+	return (Memory != nullptr);
+}
+
+void nes::CpuJitArena::Release()
+{
+	if (Memory == nullptr)
+	{
+		return;
+	}
+
+#if defined(_WIN32)
+	VirtualFree(Memory, 0, MEM_RELEASE);
+#else
+	munmap(Memory, Capacity);
+#endif
+
+	Memory = nullptr;
+}
+
+bool nes::CpuJitArena::SetWritable(bool writable)
+{
+#if defined(_WIN32)
+	DWORD oldProtection = 0;
+	return (VirtualProtect(Memory, Capacity, writable ? PAGE_READWRITE : PAGE_EXECUTE_READ, &oldProtection) != 0);
+#else
+	return (mprotect(Memory, Capacity, writable ? (PROT_READ | PROT_WRITE) : (PROT_READ | PROT_EXEC)) == 0);
+#endif
+}
@@ -0,0 +1,71 @@
+#ifndef NES_CPU_JIT_ARENA_HPP
+#define NES_CPU_JIT_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nes
+{
+	/**
+	 * Block of executable memory that translated code is copied into
+	 *
+	 * The memory is only writable while code is being copied into it, the rest of
+	 * the time it is read-only and executable
+	 */
+	class CpuJitArena
+	{
+	public:
+		/**
+		 * Reserve a new arena
+		 * @param	capacity	Size of the arena in bytes
+		 */
+		CpuJitArena(std::size_t capacity);
+
+		CpuJitArena(const CpuJitArena& other)				= delete;
+		CpuJitArena& operator=(const CpuJitArena& other)	= delete;
+
+		/**
+		 * Release the arena
+		 */
+		~CpuJitArena();
+
+		/**
+		 * Copy machine code into the arena
+		 * @param	code	Machine code to copy
+		 * @param	size	Size of the machine code in bytes
+		 * @return	Address of the copied code, nullptr when the arena is full
+		 */
+		const void* Write(const std::uint8_t* code, std::size_t size);
+
+		/**
+		 * Discard all code in the arena
+		 */
+		void Reset();
+
+		/**
+		 * Check whether the operating system handed out executable memory
+		 * @return	True if the arena can be used
+		 */
+		bool IsValid() const;
+
+	private:
+		/**
+		 * Switch the arena between writable and executable
+		 * @param	writable	True to make the arena writable, false to make it executable
+		 * @return	True if the protection was changed
+		 */
+		bool SetWritable(bool writable);
+
+		/**
+		 * Hand the memory back to the operating system
+		 */
+		void Release();
+
+	private:
+		std::uint8_t* Memory;
+		std::size_t Capacity;
+		std::size_t Used;
+	};
+}
+
+#endif //! NES_CPU_JIT_ARENA_HPP
@@ -0,0 +1,248 @@
+#include "cpu_jit_emitter.hpp"
+
+namespace
+{
+	// RBX holds the state pointer, every state access uses [rbx + disp8]
+	constexpr std::uint8_t MODRM_RBX_DISP8 = 0x43;
+
+	constexpr std::uint8_t ToIndex(nes::JitRegister reg)
+	{
+		return static_cast<std::uint8_t>(reg);
+	}
+}
+
+void nes::CpuJitEmitter::EmitPrologue()
+{
+	Emit(0x53);							// push rbx
+	Emit(0x41); Emit(0x54);				// push r12
+	Emit(0x41); Emit(0x55);				// push r13
+
+	// Keeps the stack 16-byte aligned for helper calls and provides the
+	// 32 bytes of shadow space the Windows calling convention requires
+	Emit(0x48); Emit(0x83); Emit(0xEC); Emit(0x20);		// sub rsp, 32
+
+#if defined(_WIN32)
+	Emit(0x48); Emit(0x89); Emit(0xCB);	// mov rbx, rcx
+	Emit(0x49); Emit(0x89); Emit(0xD4);	// mov r12, rdx
+#else
+	Emit(0x48); Emit(0x89); Emit(0xFB);	// mov rbx, rdi
+	Emit(0x49); Emit(0x89); Emit(0xF4);	// mov r12, rsi
+#endif
+}
+
+void nes::CpuJitEmitter::EmitEpilogue()
+{
+	Emit(0x48); Emit(0x83); Emit(0xC4); Emit(0x20);		// add rsp, 32
+	Emit(0x41); Emit(0x5D);				// pop r13
+	Emit(0x41); Emit(0x5C);				// pop r12
+	Emit(0x5B);							// pop rbx
+	Emit(0xC3);							// ret
+}
+
+void nes::CpuJitEmitter::LoadStateByte(JitRegister reg, std::uint8_t offset)
+{
+	Emit(0x0F);
+	Emit(0xB6);
+	Emit(MODRM_RBX_DISP8 | (ToIndex(reg) << 3));
+	Emit(offset);
+}
+
+void nes::CpuJitEmitter::StoreStateByte(std::uint8_t offset, JitRegister reg)
+{
+	Emit(0x88);
+	Emit(MODRM_RBX_DISP8 | (ToIndex(reg) << 3));
+	Emit(offset);
+}
+
+void nes::CpuJitEmitter::StoreStateWord(std::uint8_t offset, std::uint16_t value)
+{
+	Emit(0x66);
+	Emit(0xC7);
+	Emit(MODRM_RBX_DISP8);
+	Emit(offset);
+	Emit16(value);
+}
+
+void nes::CpuJitEmitter::AddStateQword(std::uint8_t offset, std::uint32_t value)
+{
+	Emit(0x48);
+	Emit(0x81);
+	Emit(MODRM_RBX_DISP8);
+	Emit(offset);
+	Emit32(value);
+}
+
+void nes::CpuJitEmitter::AddStateQword(std::uint8_t offset, JitRegister reg)
+{
+	Emit(0x48);
+	Emit(0x01);
+	Emit(MODRM_RBX_DISP8 | (ToIndex(reg) << 3));
+	Emit(offset);
+}
+
+void nes::CpuJitEmitter::AndStateByte(std::uint8_t offset, std::uint8_t value)
+{
+	Emit(0x80);
+	Emit(MODRM_RBX_DISP8 | (4 << 3));
+	Emit(offset);
+	Emit(value);
+}
+
+void nes::CpuJitEmitter::OrStateByte(std::uint8_t offset, std::uint8_t value)
+{
+	Emit(0x80);
+	Emit(MODRM_RBX_DISP8 | (1 << 3));
+	Emit(offset);
+	Emit(value);
+}
+
+void nes::CpuJitEmitter::TestStateByte(std::uint8_t offset, std::uint8_t value)
+{
+	Emit(0xF6);
+	Emit(MODRM_RBX_DISP8);
+	Emit(offset);
+	Emit(value);
+}
+
+void nes::CpuJitEmitter::MoveImmediate(JitRegister reg, std::uint32_t value)
+{
+	Emit(0xB8 + ToIndex(reg));
+	Emit32(value);
+}
+
+void nes::CpuJitEmitter::Move(JitRegister destination, JitRegister source)
+{
+	Emit(0x89);
+	Emit(0xC0 | (ToIndex(source) << 3) | ToIndex(destination));
+}
+
+void nes::CpuJitEmitter::AluImmediate(JitAluOperation operation, JitRegister reg, std::uint32_t value)
+{
+	Emit(0x81);
+	Emit(0xC0 | (static_cast<std::uint8_t>(operation) << 3) | ToIndex(reg));
+	Emit32(value);
+}
+
+void nes::CpuJitEmitter::Alu(JitAluOperation operation, JitRegister destination, JitRegister source)
+{
+	Emit((static_cast<std::uint8_t>(operation) << 3) | 0x01);
+	Emit(0xC0 | (ToIndex(source) << 3) | ToIndex(destination));
+}
+
+void nes::CpuJitEmitter::Not(JitRegister reg)
+{
+	Emit(0xF7);
+	Emit(0xD0 | ToIndex(reg));
+}
+
+void nes::CpuJitEmitter::ShiftLeft(JitRegister reg, std::uint8_t count)
+{
+	Emit(0xC1);
+	Emit(0xE0 | ToIndex(reg));
+	Emit(count);
+}
+
+void nes::CpuJitEmitter::ShiftRight(JitRegister reg, std::uint8_t count)
+{
+	Emit(0xC1);
+	Emit(0xE8 | ToIndex(reg));
+	Emit(count);
+}
+
+void nes::CpuJitEmitter::SetCondition(JitCondition condition, JitRegister reg)
+{
+	// setcc reg8
+	Emit(0x0F);
+	Emit(0x90 | static_cast<std::uint8_t>(condition));
+	Emit(0xC0 | ToIndex(reg));
+
+	// movzx reg, reg8
+	Emit(0x0F);
+	Emit(0xB6);
+	Emit(0xC0 | (ToIndex(reg) << 3) | ToIndex(reg));
+}
+
+void nes::CpuJitEmitter::SaveAddress()
+{
+	Emit(0x41); Emit(0x89); Emit(0xC5);	// mov r13d, eax
+}
+
+void nes::CpuJitEmitter::RestoreAddress()
+{
+	Emit(0x44); Emit(0x89); Emit(0xE8);	// mov eax, r13d
+}
+
+void nes::CpuJitEmitter::CallHelper(const void* function)
+{
+#if defined(_WIN32)
+	Emit(0x41); Emit(0x89); Emit(0xC8);	// mov r8d, ecx
+	Emit(0x89); Emit(0xC2);				// mov edx, eax
+	Emit(0x4C); Emit(0x89); Emit(0xE1);	// mov rcx, r12
+#else
+	Emit(0x89); Emit(0xCA);				// mov edx, ecx
+	Emit(0x89); Emit(0xC6);				// mov esi, eax
+	Emit(0x4C); Emit(0x89); Emit(0xE7);	// mov rdi, r12
+#endif
+
+	Emit(0x48); Emit(0xB8);				// mov rax, function
+	Emit64(reinterpret_cast<std::uintptr_t>(function));
+	Emit(0xFF); Emit(0xD0);				// call rax
+}
+
+std::size_t nes::CpuJitEmitter::JumpIf(JitCondition condition)
+{
+	Emit(0x0F);
+	Emit(0x80 | static_cast<std::uint8_t>(condition));
+
+	std::size_t jumpOffset = Code.size();
+	Emit32(0);
+	return jumpOffset;
+}
+
+std::size_t nes::CpuJitEmitter::Jump()
+{
+	Emit(0xE9);
+
+	std::size_t jumpOffset = Code.size();
+	Emit32(0);
+	return jumpOffset;
+}
+
+void nes::CpuJitEmitter::PatchJump(std::size_t jumpOffset)
+{
+	// Relative to the end of the 32-bit displacement
+	std::uint32_t displacement = static_cast<std::uint32_t>(Code.size() - (jumpOffset + 4));
+
+	for (std::size_t i = 0; i < 4; ++i)
+	{
+		Code[jumpOffset + i] = static_cast<std::uint8_t>(displacement >> (8 * i));
+	}
+}
+
+const std::vector<std::uint8_t>& nes::CpuJitEmitter::GetCode() const
+{
+	return Code;
+}
+
+void nes::CpuJitEmitter::Emit(std::uint8_t byte)
+{
+	Code.push_back(byte);
+}
+
+void nes::CpuJitEmitter::Emit16(std::uint16_t value)
+{
+	Emit(static_cast<std::uint8_t>(value));
+	Emit(static_cast<std::uint8_t>(value >> 8));
+}
+
+void nes::CpuJitEmitter::Emit32(std::uint32_t value)
+{
+	Emit16(static_cast<std::uint16_t>(value));
+	Emit16(static_cast<std::uint16_t>(value >> 16));
+}
+
+void nes::CpuJitEmitter::Emit64(std::uint64_t value)
+{
+	Emit32(static_cast<std::uint32_t>(value));
+	Emit32(static_cast<std::uint32_t>(value >> 32));
+}
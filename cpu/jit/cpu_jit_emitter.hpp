@@ -0,0 +1,162 @@
+#ifndef NES_CPU_JIT_EMITTER_HPP
+#define NES_CPU_JIT_EMITTER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nes
+{
+	/**
+	 * Scratch registers available to translated code
+	 */
+	enum class JitRegister : std::uint8_t
+	{
+		Eax = 0,
+		Ecx = 1,
+		Edx = 2
+	};
+
+	/**
+	 * Integer operations that share the same x86 encoding scheme
+	 */
+	enum class JitAluOperation : std::uint8_t
+	{
+		Add = 0,
+		Or  = 1,
+		And = 4,
+		Sub = 5,
+		Xor = 6,
+		Cmp = 7
+	};
+
+	/**
+	 * x86 condition codes
+	 */
+	enum class JitCondition : std::uint8_t
+	{
+		Below           = 0x2,
+		AboveOrEqual    = 0x3,
+		Equal           = 0x4,
+		NotEqual        = 0x5
+	};
+
+	/**
+	 * Emits x86-64 machine code into a byte buffer
+	 *
+	 * Translated blocks keep a pointer to the CPU state in RBX, the RAM pointer in
+	 * R12, and use R13 to keep an address alive across helper calls. Only the
+	 * handful of instruction forms the translator needs are supported, all state
+	 * accesses use an 8-bit displacement from RBX.
+	 */
+	class CpuJitEmitter
+	{
+	public:
+		/**
+		 * Save the callee-saved registers and load the state and RAM pointers
+		 * from the first two arguments
+		 */
+		void EmitPrologue();
+
+		/**
+		 * Restore the callee-saved registers and return
+		 */
+		void EmitEpilogue();
+
+		/** movzx reg, byte [rbx + offset] */
+		void LoadStateByte(JitRegister reg, std::uint8_t offset);
+
+		/** mov byte [rbx + offset], reg */
+		void StoreStateByte(std::uint8_t offset, JitRegister reg);
+
+		/** mov word [rbx + offset], value */
+		void StoreStateWord(std::uint8_t offset, std::uint16_t value);
+
+		/** add qword [rbx + offset], value */
+		void AddStateQword(std::uint8_t offset, std::uint32_t value);
+
+		/** add qword [rbx + offset], reg (64-bit, upper half of reg must be zero) */
+		void AddStateQword(std::uint8_t offset, JitRegister reg);
+
+		/** and byte [rbx + offset], value */
+		void AndStateByte(std::uint8_t offset, std::uint8_t value);
+
+		/** or byte [rbx + offset], value */
+		void OrStateByte(std::uint8_t offset, std::uint8_t value);
+
+		/** test byte [rbx + offset], value */
+		void TestStateByte(std::uint8_t offset, std::uint8_t value);
+
+		/** mov reg, value */
+		void MoveImmediate(JitRegister reg, std::uint32_t value);
+
+		/** mov destination, source */
+		void Move(JitRegister destination, JitRegister source);
+
+		/** op reg, value */
+		void AluImmediate(JitAluOperation operation, JitRegister reg, std::uint32_t value);
+
+		/** op destination, source */
+		void Alu(JitAluOperation operation, JitRegister destination, JitRegister source);
+
+		/** not reg */
+		void Not(JitRegister reg);
+
+		/** shl reg, count */
+		void ShiftLeft(JitRegister reg, std::uint8_t count);
+
+		/** shr reg, count */
+		void ShiftRight(JitRegister reg, std::uint8_t count);
+
+		/** setcc reg8 followed by movzx reg, reg8 */
+		void SetCondition(JitCondition condition, JitRegister reg);
+
+		/** mov r13d, eax */
+		void SaveAddress();
+
+		/** mov eax, r13d */
+		void RestoreAddress();
+
+		/**
+		 * Call a helper function as helper(ram, eax, ecx), the result ends up in eax
+		 * @param	function	Address of the function to call
+		 */
+		void CallHelper(const void* function);
+
+		/**
+		 * Emit a conditional jump with a placeholder target
+		 * @param	condition	Condition to jump on
+		 * @return	Offset of the jump, to be passed to PatchJump
+		 */
+		std::size_t JumpIf(JitCondition condition);
+
+		/**
+		 * Emit an unconditional jump with a placeholder target
+		 * @return	Offset of the jump, to be passed to PatchJump
+		 */
+		std::size_t Jump();
+
+		/**
+		 * Point a previously emitted jump at the current end of the buffer
+		 * @param	jumpOffset	Value returned by JumpIf or Jump
+		 */
+		void PatchJump(std::size_t jumpOffset);
+
+		/**
+		 * Retrieve the emitted machine code
+		 * @return	Machine code
+		 */
+		const std::vector<std::uint8_t>& GetCode() const;
+
+	private:
+		void Emit(std::uint8_t byte);
+		void Emit16(std::uint16_t value);
+		void Emit32(std::uint32_t value);
+		void Emit64(std::uint64_t value);
+
+	private:
+		std::vector<std::uint8_t> Code;
+	};
+}
+
+#endif //! NES_CPU_JIT_EMITTER_HPP
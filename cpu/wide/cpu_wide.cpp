@@ -0,0 +1,739 @@
+#include "cpu_wide.hpp"
+#include "ram/ram.hpp"
+#include "utility/bit_tools.hpp"
+
+#include <algorithm>	// std::min / std::max / std::minmax_element
+#include <limits>
+
+#if defined(__AVX2__)
+	#include <immintrin.h>
+	#define NES_CPU_WIDE_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define NES_CPU_WIDE_SSE2
+#endif
+
+namespace
+{
+	// Lanes are allocated in multiples of the widest vector, so the kernels
+	// never need a scalar tail
+	constexpr std::size_t LANE_ALIGNMENT = 32;
+
+	// End of a list of lanes
+	constexpr std::uint32_t NO_LANE = 0xFFFFFFFF;
+
+	// Number of addresses the program counter can point to
+	constexpr std::size_t ADDRESS_COUNT = 0x10000;
+
+	// Location of the registers inside of the state written by CPU::WriteState
+	constexpr std::size_t STATE_A = 0;
+	constexpr std::size_t STATE_X = 1;
+	constexpr std::size_t STATE_Y = 2;
+	constexpr std::size_t STATE_P = 3;
+	constexpr std::size_t STATE_SP = 4;
+	constexpr std::size_t STATE_PC = 6;
+	constexpr std::size_t STATE_PENDING_INTERRUPTS = 8;
+	constexpr std::size_t STATE_CYCLE = 16;
+
+	constexpr std::uint8_t FLAG_CARRY = static_cast<std::uint8_t>(nes::StatusFlags::Carry);
+	constexpr std::uint8_t FLAG_ZERO = static_cast<std::uint8_t>(nes::StatusFlags::Zero);
+	constexpr std::uint8_t FLAG_INTERRUPT_DISABLE = static_cast<std::uint8_t>(nes::StatusFlags::InterruptDisable);
+	constexpr std::uint8_t FLAG_DECIMAL_MODE = static_cast<std::uint8_t>(nes::StatusFlags::DecimalMode);
+	constexpr std::uint8_t FLAG_OVERFLOW = static_cast<std::uint8_t>(nes::StatusFlags::Overflow);
+	constexpr std::uint8_t FLAG_NEGATIVE = static_cast<std::uint8_t>(nes::StatusFlags::Negative);
+
+	/**
+	 * Size and timing of an instruction that has a vector kernel
+	 */
+	struct VectorInstruction
+	{
+		// Size in bytes, 0 for op-codes that run lane by lane
+		std::uint8_t Size;
+
+		// Cycles taken, branches add their own penalty on top
+		std::uint8_t Cycles;
+	};
+
+	/**
+	 * Build the table of instructions that have a vector kernel
+	 * @return	Size and timing per op-code
+	 */
+	constexpr std::array<VectorInstruction, 256> CreateVectorInstructions()
+	{
+		std::array<VectorInstruction, 256> instructions {};
+
+		// Implied and accumulator addressing
+		for (std::uint8_t opCode : { 0xEA, 0x18, 0x38, 0x58, 0x78, 0xB8, 0xD8, 0xF8, 0xAA, 0xA8, 0xBA, 0x8A,
+									 0x9A, 0x98, 0xE8, 0xC8, 0xCA, 0x88, 0x0A, 0x4A, 0x2A, 0x6A })
+		{
+			instructions[opCode] = { 1, 2 };
+		}
+
+		// Immediate addressing and branches
+		for (std::uint8_t opCode : { 0xA9, 0xA2, 0xA0, 0x29, 0x09, 0x49, 0x69, 0xE9, 0xC9, 0xE0, 0xC0,
+									 0x10, 0x30, 0x50, 0x70, 0x90, 0xB0, 0xD0, 0xF0 })
+		{
+			instructions[opCode] = { 2, 2 };
+		}
+
+		// Loads and stores with zero page addressing
+		for (std::uint8_t opCode : { 0xA5, 0xA6, 0xA4, 0x85, 0x86, 0x84 })
+		{
+			instructions[opCode] = { 2, 3 };
+		}
+
+		// Loads and stores with absolute addressing, and the absolute jump
+		for (std::uint8_t opCode : { 0xAD, 0xAE, 0xAC, 0x8D, 0x8E, 0x8C, 0x4C })
+		{
+			instructions[opCode] = { 3, (opCode == 0x4C) ? std::uint8_t(3) : std::uint8_t(4) };
+		}
+
+		return instructions;
+	}
+
+	constexpr std::array<VectorInstruction, 256> VECTOR_INSTRUCTIONS = CreateVectorInstructions();
+
+	// Operations on a vector of one byte per lane, masks are 0xFF for lanes in
+	// which a condition holds and 0x00 in all others
+#if defined(NES_CPU_WIDE_AVX2)
+	using Vector = __m256i;
+	constexpr std::size_t VECTOR_SIZE = 32;
+
+	inline Vector Load(const std::uint8_t* source) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source)); }
+	inline void Store(std::uint8_t* destination, Vector value) { _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination), value); }
+	inline Vector Broadcast(std::uint8_t value) { return _mm256_set1_epi8(static_cast<char>(value)); }
+	inline Vector Add(Vector a, Vector b) { return _mm256_add_epi8(a, b); }
+	inline Vector Subtract(Vector a, Vector b) { return _mm256_sub_epi8(a, b); }
+	inline Vector And(Vector a, Vector b) { return _mm256_and_si256(a, b); }
+	inline Vector Or(Vector a, Vector b) { return _mm256_or_si256(a, b); }
+	inline Vector Xor(Vector a, Vector b) { return _mm256_xor_si256(a, b); }
+	inline Vector Equal(Vector a, Vector b) { return _mm256_cmpeq_epi8(a, b); }
+	inline Vector Maximum(Vector a, Vector b) { return _mm256_max_epu8(a, b); }
+	inline Vector Select(Vector mask, Vector a, Vector b) { return _mm256_blendv_epi8(b, a, mask); }
+
+	// There is no 8-bit shift, bits shifted in from the neighbouring byte are masked off
+	inline Vector ShiftRightOne(Vector a) { return And(_mm256_srli_epi16(a, 1), Broadcast(0x7F)); }
+#elif defined(NES_CPU_WIDE_SSE2)
+	using Vector = __m128i;
+	constexpr std::size_t VECTOR_SIZE = 16;
+
+	inline Vector Load(const std::uint8_t* source) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source)); }
+	inline void Store(std::uint8_t* destination, Vector value) { _mm_storeu_si128(reinterpret_cast<__m128i*>(destination), value); }
+	inline Vector Broadcast(std::uint8_t value) { return _mm_set1_epi8(static_cast<char>(value)); }
+	inline Vector Add(Vector a, Vector b) { return _mm_add_epi8(a, b); }
+	inline Vector Subtract(Vector a, Vector b) { return _mm_sub_epi8(a, b); }
+	inline Vector And(Vector a, Vector b) { return _mm_and_si128(a, b); }
+	inline Vector Or(Vector a, Vector b) { return _mm_or_si128(a, b); }
+	inline Vector Xor(Vector a, Vector b) { return _mm_xor_si128(a, b); }
+	inline Vector Equal(Vector a, Vector b) { return _mm_cmpeq_epi8(a, b); }
+	inline Vector Maximum(Vector a, Vector b) { return _mm_max_epu8(a, b); }
+	inline Vector Select(Vector mask, Vector a, Vector b) { return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b)); }
+
+	// There is no 8-bit shift, bits shifted in from the neighbouring byte are masked off
+	inline Vector ShiftRightOne(Vector a) { return And(_mm_srli_epi16(a, 1), Broadcast(0x7F)); }
+#else
+	// Plain bytes, one lane at a time
+	using Vector = std::uint8_t;
+	constexpr std::size_t VECTOR_SIZE = 1;
+
+	inline Vector Load(const std::uint8_t* source) { return *source; }
+	inline void Store(std::uint8_t* destination, Vector value) { *destination = value; }
+	inline Vector Broadcast(std::uint8_t value) { return value; }
+	inline Vector Add(Vector a, Vector b) { return static_cast<Vector>(a + b); }
+	inline Vector Subtract(Vector a, Vector b) { return static_cast<Vector>(a - b); }
+	inline Vector And(Vector a, Vector b) { return a & b; }
+	inline Vector Or(Vector a, Vector b) { return a | b; }
+	inline Vector Xor(Vector a, Vector b) { return a ^ b; }
+	inline Vector Equal(Vector a, Vector b) { return (a == b) ? 0xFF : 0x00; }
+	inline Vector Maximum(Vector a, Vector b) { return std::max(a, b); }
+	inline Vector Select(Vector mask, Vector a, Vector b) { return static_cast<Vector>((mask & a) | (~mask & b)); }
+	inline Vector ShiftRightOne(Vector a) { return static_cast<Vector>(a >> 1); }
+#endif
+
+	inline Vector Not(Vector a)
+	{
+		return Xor(a, Broadcast(0xFF));
+	}
+
+	/**
+	 * Unsigned comparison
+	 * @return	Mask of the lanes in which a >= b
+	 */
+	inline Vector GreaterOrEqual(Vector a, Vector b)
+	{
+		return Equal(Maximum(a, b), a);
+	}
+
+	/**
+	 * @return	Mask of the lanes in which bit 7 is set
+	 */
+	inline Vector IsHighBitSet(Vector a)
+	{
+		return Equal(And(a, Broadcast(0x80)), Broadcast(0x80));
+	}
+
+	/**
+	 * Same as CPU::UpdateZeroNegative, but on the status register of every lane
+	 * @param	status	Status registers
+	 * @param	value	Results the flags are based on
+	 * @return	Updated status registers
+	 */
+	inline Vector UpdateZeroNegative(Vector status, Vector value)
+	{
+		Vector zero = And(Equal(value, Broadcast(0)), Broadcast(FLAG_ZERO));
+		Vector negative = And(value, Broadcast(FLAG_NEGATIVE));
+
+		status = And(status, Broadcast(static_cast<std::uint8_t>(~(FLAG_ZERO | FLAG_NEGATIVE))));
+		return Or(status, Or(zero, negative));
+	}
+
+	/**
+	 * Replace the carry flag of every lane
+	 * @param	status	Status registers
+	 * @param	carry	Mask of the lanes in which carry is set
+	 * @return	Updated status registers
+	 */
+	inline Vector UpdateCarry(Vector status, Vector carry)
+	{
+		status = And(status, Broadcast(static_cast<std::uint8_t>(~FLAG_CARRY)));
+		return Or(status, And(carry, Broadcast(FLAG_CARRY)));
+	}
+}
+
+nes::CpuWide::CpuWide(std::size_t laneCount) :
+	LaneCount(laneCount),
+	PaddedLaneCount((laneCount + LANE_ALIGNMENT - 1) / LANE_ALIGNMENT * LANE_ALIGNMENT),
+	LaneStates(laneCount),
+	A(PaddedLaneCount, 0),
+	X(PaddedLaneCount, 0),
+	Y(PaddedLaneCount, 0),
+	P(PaddedLaneCount, 0),
+	SP(PaddedLaneCount, 0),
+	PC(PaddedLaneCount, 0),
+	Cycle(PaddedLaneCount, 0),
+	TargetCycle(PaddedLaneCount, 0),
+	HasPendingInterrupt(PaddedLaneCount, 0),
+	LoadedValues(PaddedLaneCount, 0),
+	FirstLaneAtAddress(ADDRESS_COUNT, NO_LANE),
+	NextLane(laneCount, NO_LANE),
+	OccupiedAddresses(ADDRESS_COUNT / 64, 0),
+	LowestOccupiedWord(ADDRESS_COUNT / 64),
+	GroupMask(PaddedLaneCount, 0),
+	StopReasons(laneCount, CPU::StopReason::CycleBudget),
+	RunStatistics{}
+{
+	LaneRams.reserve(laneCount);
+	LaneCpus.reserve(laneCount);
+
+	for (std::size_t lane = 0; lane < laneCount; ++lane)
+	{
+		LaneRams.push_back(std::make_unique<RAM>());
+		LaneCpus.push_back(std::make_unique<CPU>(*LaneRams.back()));
+	}
+
+	GroupLanes.reserve(laneCount);
+}
+
+nes::CpuWide::~CpuWide()
+{
+	// The CPUs refer to the RAM, so they have to go first
+	LaneCpus.clear();
+}
+
+std::size_t nes::CpuWide::GetLaneCount() const
+{
+	return LaneCount;
+}
+
+nes::CPU& nes::CpuWide::GetLaneCpu(std::size_t lane)
+{
+	return *LaneCpus[lane];
+}
+
+nes::RAM& nes::CpuWide::GetLaneRam(std::size_t lane)
+{
+	return *LaneRams[lane];
+}
+
+nes::CPU::StopReason nes::CpuWide::GetLaneStopReason(std::size_t lane) const
+{
+	return StopReasons[lane];
+}
+
+const nes::CpuWide::Statistics& nes::CpuWide::GetStatistics() const
+{
+	return RunStatistics;
+}
+
+const char* nes::CpuWide::GetInstructionSetName()
+{
+#if defined(NES_CPU_WIDE_AVX2)
+	return "AVX2";
+#elif defined(NES_CPU_WIDE_SSE2)
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
+
+void nes::CpuWide::RunCycles(std::uint64_t cycleCount)
+{
+	RunStatistics = {};
+	LoadLanes(cycleCount);
+
+	std::uint16_t address = 0;
+	std::uint32_t waitingLanes = NO_LANE;
+
+	// Always continuing with the lowest program counter makes lanes that
+	// skipped ahead wait for the others, so lanes that took different paths
+	// through a loop or subroutine end up in the same group again
+	while ((waitingLanes = TakeLowestAddress(address)) != NO_LANE)
+	{
+		std::uint32_t leader = waitingLanes;
+		const RAM& leaderRam = *LaneRams[leader];
+
+		std::uint8_t opCode = leaderRam.ReadByte(address).value;
+		std::uint8_t size = VECTOR_INSTRUCTIONS[opCode].Size;
+
+		if (size == 0 || HasPendingInterrupt[leader])
+		{
+			while (waitingLanes != NO_LANE)
+			{
+				std::uint32_t lane = waitingLanes;
+				waitingLanes = NextLane[lane];
+				ExecuteLane(lane);
+			}
+
+			continue;
+		}
+
+		std::uint8_t lowByte = (size > 1) ? leaderRam.ReadByte(address + 1).value : 0;
+		std::uint8_t highByte = (size > 2) ? leaderRam.ReadByte(address + 2).value : 0;
+
+		// Only lanes that see the exact same bytes run the same instruction,
+		// every lane has its own RAM. All others stay at the address and form
+		// a group of their own in the next step
+		GroupLanes.clear();
+		std::uint32_t remainingLanes = NO_LANE;
+
+		while (waitingLanes != NO_LANE)
+		{
+			std::uint32_t lane = waitingLanes;
+			waitingLanes = NextLane[lane];
+
+			const RAM& ram = *LaneRams[lane];
+			if (HasPendingInterrupt[lane] || ram.ReadByte(address).value != opCode ||
+				(size > 1 && ram.ReadByte(address + 1).value != lowByte) ||
+				(size > 2 && ram.ReadByte(address + 2).value != highByte))
+			{
+				NextLane[lane] = remainingLanes;
+				remainingLanes = lane;
+				continue;
+			}
+
+			GroupMask[lane] = 0xFF;
+			GroupLanes.push_back(lane);
+		}
+
+		while (remainingLanes != NO_LANE)
+		{
+			std::uint32_t lane = remainingLanes;
+			remainingLanes = NextLane[lane];
+			ScheduleLane(lane);
+		}
+
+		ExecuteGroup(opCode, static_cast<std::uint16_t>((highByte << 8) | lowByte));
+
+		for (std::size_t lane : GroupLanes)
+		{
+			GroupMask[lane] = 0x00;
+			ScheduleLane(lane);
+		}
+
+		++RunStatistics.VectorGroups;
+		RunStatistics.VectorInstructions += GroupLanes.size();
+	}
+
+	StoreLanes();
+}
+
+void nes::CpuWide::LoadLanes(std::uint64_t cycleCount)
+{
+	for (std::size_t lane = 0; lane < LaneCount; ++lane)
+	{
+		LaneCpus[lane]->WriteState(LaneStates[lane].data());
+		UnpackLaneState(lane);
+
+		std::uint64_t maxCycle = std::numeric_limits<std::uint64_t>::max();
+		TargetCycle[lane] = (cycleCount > maxCycle - Cycle[lane]) ? maxCycle : (Cycle[lane] + cycleCount);
+
+		StopReasons[lane] = CPU::StopReason::CycleBudget;
+		ScheduleLane(lane);
+	}
+}
+
+void nes::CpuWide::StoreLanes()
+{
+	for (std::size_t lane = 0; lane < LaneCount; ++lane)
+	{
+		PackLaneState(lane);
+		LaneCpus[lane]->ReadState(LaneStates[lane].data());
+	}
+}
+
+void nes::CpuWide::UnpackLaneState(std::size_t lane)
+{
+	const std::uint8_t* state = LaneStates[lane].data();
+
+	A[lane] = state[STATE_A];
+	X[lane] = state[STATE_X];
+	Y[lane] = state[STATE_Y];
+	P[lane] = state[STATE_P];
+	SP[lane] = state[STATE_SP];
+	PC[lane] = static_cast<std::uint16_t>(ReadLittleEndian(state + STATE_PC, 2));
+	Cycle[lane] = ReadLittleEndian(state + STATE_CYCLE, 8);
+	HasPendingInterrupt[lane] = (ReadLittleEndian(state + STATE_PENDING_INTERRUPTS, 2) != 0) ? 1 : 0;
+}
+
+void nes::CpuWide::PackLaneState(std::size_t lane)
+{
+	// Interrupt inputs are left alone, only the lane CPU itself changes them
+	std::uint8_t* state = LaneStates[lane].data();
+
+	state[STATE_A] = A[lane];
+	state[STATE_X] = X[lane];
+	state[STATE_Y] = Y[lane];
+	state[STATE_P] = P[lane];
+	state[STATE_SP] = SP[lane];
+	WriteLittleEndian(state + STATE_PC, PC[lane], 2);
+	WriteLittleEndian(state + STATE_CYCLE, Cycle[lane], 8);
+}
+
+void nes::CpuWide::ExecuteGroup(std::uint8_t opCode, std::uint16_t operand)
+{
+	std::uint8_t* mask = GroupMask.data();
+	std::uint8_t* status = P.data();
+
+	// Only the vectors between the first and the last lane of the group
+	auto groupRange = std::minmax_element(GroupLanes.begin(), GroupLanes.end());
+	std::size_t firstLane = *groupRange.first / VECTOR_SIZE * VECTOR_SIZE;
+	std::size_t lastLane = *groupRange.second;
+
+	auto forEachVector = [firstLane, lastLane, mask](auto kernel)
+	{
+		for (std::size_t lane = firstLane; lane <= lastLane; lane += VECTOR_SIZE)
+		{
+			kernel(lane, Load(mask + lane));
+		}
+	};
+
+	// Write a result to a register, optionally updating the zero and negative flags
+	auto assign = [&forEachVector, status](std::uint8_t* target, bool updateFlags, auto operation)
+	{
+		forEachVector([target, updateFlags, status, &operation](std::size_t lane, Vector laneMask)
+		{
+			Vector value = operation(lane);
+			Store(target + lane, Select(laneMask, value, Load(target + lane)));
+
+			if (updateFlags)
+			{
+				Vector flags = Load(status + lane);
+				Store(status + lane, Select(laneMask, UpdateZeroNegative(flags, value), flags));
+			}
+		});
+	};
+
+	auto setFlag = [&forEachVector, status](std::uint8_t flag, bool state)
+	{
+		forEachVector([flag, state, status](std::size_t lane, Vector laneMask)
+		{
+			Vector flags = Load(status + lane);
+			Vector updated = state ? Or(flags, Broadcast(flag)) : And(flags, Broadcast(static_cast<std::uint8_t>(~flag)));
+			Store(status + lane, Select(laneMask, updated, flags));
+		});
+	};
+
+	// Same as the interpreter, overflow = ~(A ^ value) & (A ^ sum)
+	auto addWithCarry = [&forEachVector, status, this](std::uint8_t addend)
+	{
+		std::uint8_t* accumulator = A.data();
+
+		forEachVector([addend, status, accumulator](std::size_t lane, Vector laneMask)
+		{
+			Vector a = Load(accumulator + lane);
+			Vector value = Broadcast(addend);
+			Vector flags = Load(status + lane);
+
+			Vector carryIn = And(flags, Broadcast(FLAG_CARRY));
+			Vector partialSum = Add(a, value);
+			Vector sum = Add(partialSum, carryIn);
+
+			// a + value carries when a > ~value, adding the carry only carries
+			// when a + value is 0xFF
+			Vector carryOut = Or(Not(GreaterOrEqual(Not(value), a)),
+								 And(Equal(partialSum, Broadcast(0xFF)), Equal(carryIn, Broadcast(FLAG_CARRY))));
+			Vector overflow = And(ShiftRightOne(And(Not(Xor(a, value)), Xor(a, sum))), Broadcast(FLAG_OVERFLOW));
+
+			Vector updated = UpdateCarry(And(flags, Broadcast(static_cast<std::uint8_t>(~FLAG_OVERFLOW))), carryOut);
+			updated = UpdateZeroNegative(Or(updated, overflow), sum);
+
+			Store(accumulator + lane, Select(laneMask, sum, a));
+			Store(status + lane, Select(laneMask, updated, flags));
+		});
+	};
+
+	auto compare = [&forEachVector, status](const std::uint8_t* source, std::uint8_t operandValue)
+	{
+		forEachVector([source, operandValue, status](std::size_t lane, Vector laneMask)
+		{
+			Vector registerValue = Load(source + lane);
+			Vector value = Broadcast(operandValue);
+			Vector flags = Load(status + lane);
+
+			Vector updated = UpdateCarry(flags, GreaterOrEqual(registerValue, value));
+			updated = UpdateZeroNegative(updated, Subtract(registerValue, value));
+
+			Store(status + lane, Select(laneMask, updated, flags));
+		});
+	};
+
+	// Shifts of the accumulator that move a bit into carry, rotates also
+	// move the old carry into the bit that was freed
+	auto shiftAccumulator = [&forEachVector, status, this](bool shiftLeft, bool rotate)
+	{
+		std::uint8_t* accumulator = A.data();
+
+		forEachVector([shiftLeft, rotate, status, accumulator](std::size_t lane, Vector laneMask)
+		{
+			Vector a = Load(accumulator + lane);
+			Vector flags = Load(status + lane);
+
+			Vector carry = shiftLeft ? IsHighBitSet(a) : Equal(And(a, Broadcast(0x01)), Broadcast(0x01));
+			Vector value = shiftLeft ? Add(a, a) : ShiftRightOne(a);
+
+			if (rotate)
+			{
+				Vector carryIn = Equal(And(flags, Broadcast(FLAG_CARRY)), Broadcast(FLAG_CARRY));
+				value = Or(value, And(carryIn, Broadcast(shiftLeft ? 0x01 : 0x80)));
+			}
+
+			Store(accumulator + lane, Select(laneMask, value, a));
+			Store(status + lane, Select(laneMask, UpdateZeroNegative(UpdateCarry(flags, carry), value), flags));
+		});
+	};
+
+	std::uint8_t value = static_cast<std::uint8_t>(operand);
+	std::uint8_t* a = A.data();
+	std::uint8_t* x = X.data();
+	std::uint8_t* y = Y.data();
+	std::uint8_t* sp = SP.data();
+
+	switch (opCode)
+	{
+		// Branches test bit 7 of P (N), bit 6 (V), bit 0 (C) or bit 1 (Z)
+		// depending on the top two bits of the op-code, bit 5 tells whether
+		// the flag has to be set or clear
+		case 0x10: case 0x30: case 0x50: case 0x70:
+		case 0x90: case 0xB0: case 0xD0: case 0xF0:
+		{
+			static constexpr std::uint8_t BRANCH_FLAGS[] = { FLAG_NEGATIVE, FLAG_OVERFLOW, FLAG_CARRY, FLAG_ZERO };
+			std::uint8_t flag = BRANCH_FLAGS[opCode >> 6];
+			bool branchIfSet = (opCode & 0x20) != 0;
+
+			for (std::size_t lane : GroupLanes)
+			{
+				std::uint8_t cycleCount = 2;
+				std::uint16_t programCounter = PC[lane] + 2;
+
+				if (((P[lane] & flag) != 0) == branchIfSet)
+				{
+					std::uint16_t targetPC = programCounter + static_cast<std::int8_t>(value);
+
+					// Same page boundary check as CPU::DidProgramCounterCrossPageBoundary
+					cycleCount += (((programCounter ^ targetPC) & 0xFF00) != 0) ? 2 : 1;
+					programCounter = targetPC;
+				}
+
+				PC[lane] = programCounter;
+				Cycle[lane] += cycleCount;
+			}
+
+			return;
+		}
+
+		case 0x4C:
+			for (std::size_t lane : GroupLanes)
+			{
+				PC[lane] = operand;
+				Cycle[lane] += 3;
+			}
+
+			return;
+
+		// Every lane has its own memory, so loads and stores gather and
+		// scatter lane by lane even though the address is the same
+		case 0xA5: case 0xA6: case 0xA4:
+		case 0xAD: case 0xAE: case 0xAC:
+		{
+			std::uint8_t* loaded = LoadedValues.data();
+			for (std::size_t lane : GroupLanes)
+			{
+				loaded[lane] = LaneRams[lane]->ReadByte(operand).value;
+			}
+
+			std::uint8_t* target = ((opCode & 0x03) == 0x01) ? a : (((opCode & 0x03) == 0x02) ? x : y);
+			assign(target, true, [loaded](std::size_t lane) { return Load(loaded + lane); });
+			break;
+		}
+
+		case 0x85: case 0x86: case 0x84:
+		case 0x8D: case 0x8E: case 0x8C:
+		{
+			const std::uint8_t* source = ((opCode & 0x03) == 0x01) ? a : (((opCode & 0x03) == 0x02) ? x : y);
+			for (std::size_t lane : GroupLanes)
+			{
+				Byte stored;
+				stored.value = source[lane];
+				LaneRams[lane]->WriteByte(operand, stored);
+			}
+
+			break;
+		}
+
+		// NOP
+		case 0xEA: break;
+
+		// Flags
+		case 0x18: setFlag(FLAG_CARRY, false); break;
+		case 0x38: setFlag(FLAG_CARRY, true); break;
+		case 0x58: setFlag(FLAG_INTERRUPT_DISABLE, false); break;
+		case 0x78: setFlag(FLAG_INTERRUPT_DISABLE, true); break;
+		case 0xB8: setFlag(FLAG_OVERFLOW, false); break;
+		case 0xD8: setFlag(FLAG_DECIMAL_MODE, false); break;
+		case 0xF8: setFlag(FLAG_DECIMAL_MODE, true); break;
+
+		// Transfers, TXS is the only one that leaves the flags alone
+		case 0xAA: assign(x, true, [a](std::size_t lane) { return Load(a + lane); }); break;
+		case 0xA8: assign(y, true, [a](std::size_t lane) { return Load(a + lane); }); break;
+		case 0xBA: assign(x, true, [sp](std::size_t lane) { return Load(sp + lane); }); break;
+		case 0x8A: assign(a, true, [x](std::size_t lane) { return Load(x + lane); }); break;
+		case 0x9A: assign(sp, false, [x](std::size_t lane) { return Load(x + lane); }); break;
+		case 0x98: assign(a, true, [y](std::size_t lane) { return Load(y + lane); }); break;
+
+		// Increments and decrements
+		case 0xE8: assign(x, true, [x](std::size_t lane) { return Add(Load(x + lane), Broadcast(1)); }); break;
+		case 0xC8: assign(y, true, [y](std::size_t lane) { return Add(Load(y + lane), Broadcast(1)); }); break;
+		case 0xCA: assign(x, true, [x](std::size_t lane) { return Subtract(Load(x + lane), Broadcast(1)); }); break;
+		case 0x88: assign(y, true, [y](std::size_t lane) { return Subtract(Load(y + lane), Broadcast(1)); }); break;
+
+		// Loads and logic
+		case 0xA9: assign(a, true, [value](std::size_t) { return Broadcast(value); }); break;
+		case 0xA2: assign(x, true, [value](std::size_t) { return Broadcast(value); }); break;
+		case 0xA0: assign(y, true, [value](std::size_t) { return Broadcast(value); }); break;
+		case 0x29: assign(a, true, [a, value](std::size_t lane) { return And(Load(a + lane), Broadcast(value)); }); break;
+		case 0x09: assign(a, true, [a, value](std::size_t lane) { return Or(Load(a + lane), Broadcast(value)); }); break;
+		case 0x49: assign(a, true, [a, value](std::size_t lane) { return Xor(Load(a + lane), Broadcast(value)); }); break;
+
+		// Arithmetic, subtraction is addition of the inverted operand
+		case 0x69: addWithCarry(value); break;
+		case 0xE9: addWithCarry(static_cast<std::uint8_t>(~value)); break;
+		case 0xC9: compare(a, value); break;
+		case 0xE0: compare(x, value); break;
+		case 0xC0: compare(y, value); break;
+
+		// Accumulator shifts and rotates
+		case 0x0A: shiftAccumulator(true, false); break;
+		case 0x4A: shiftAccumulator(false, false); break;
+		case 0x2A: shiftAccumulator(true, true); break;
+		case 0x6A: shiftAccumulator(false, true); break;
+
+		default:
+			break;
+	}
+
+	const VectorInstruction& instruction = VECTOR_INSTRUCTIONS[opCode];
+	for (std::size_t lane : GroupLanes)
+	{
+		PC[lane] += instruction.Size;
+		Cycle[lane] += instruction.Cycles;
+	}
+}
+
+void nes::CpuWide::ExecuteLane(std::size_t lane)
+{
+	CPU& cpu = *LaneCpus[lane];
+
+	PackLaneState(lane);
+	cpu.ReadState(LaneStates[lane].data());
+
+	// Copying the state in and out costs more than most instructions, so the
+	// lane keeps going until it reaches an instruction the kernels handle and
+	// can rejoin a group. A step may also be entering an interrupt
+	const RAM& ram = *LaneRams[lane];
+	std::uint64_t stepCount = 0;
+
+	CPU::StopReason reason = cpu.RunUntil(TargetCycle[lane] - Cycle[lane], [&ram, &stepCount](const CPU& laneCpu)
+	{
+		++stepCount;
+		return VECTOR_INSTRUCTIONS[ram.ReadByte(laneCpu.GetProgramCounter()).value].Size != 0;
+	});
+
+	cpu.WriteState(LaneStates[lane].data());
+	UnpackLaneState(lane);
+
+	RunStatistics.ScalarInstructions += stepCount;
+
+	if (reason != CPU::StopReason::Condition && reason != CPU::StopReason::CycleBudget)
+	{
+		StopReasons[lane] = reason;
+		return;
+	}
+
+	ScheduleLane(lane);
+}
+
+void nes::CpuWide::ScheduleLane(std::size_t lane)
+{
+	if (Cycle[lane] >= TargetCycle[lane])
+	{
+		return;
+	}
+
+	std::uint16_t address = PC[lane];
+	std::size_t word = address / 64;
+
+	NextLane[lane] = FirstLaneAtAddress[address];
+	FirstLaneAtAddress[address] = static_cast<std::uint32_t>(lane);
+
+	OccupiedAddresses[word] |= (std::uint64_t(1) << (address % 64));
+	LowestOccupiedWord = std::min(LowestOccupiedWord, word);
+}
+
+std::uint32_t nes::CpuWide::TakeLowestAddress(std::uint16_t& address)
+{
+	while (LowestOccupiedWord < OccupiedAddresses.size() && OccupiedAddresses[LowestOccupiedWord] == 0)
+	{
+		++LowestOccupiedWord;
+	}
+
+	if (LowestOccupiedWord == OccupiedAddresses.size())
+	{
+		return NO_LANE;
+	}
+
+	// Index of the lowest set bit
+	std::uint64_t bits = OccupiedAddresses[LowestOccupiedWord];
+	std::size_t bit = 0;
+	while ((bits & (std::uint64_t(1) << bit)) == 0)
+	{
+		++bit;
+	}
+
+	address = static_cast<std::uint16_t>(LowestOccupiedWord * 64 + bit);
+	OccupiedAddresses[LowestOccupiedWord] &= ~(std::uint64_t(1) << bit);
+
+	std::uint32_t lanes = FirstLaneAtAddress[address];
+	FirstLaneAtAddress[address] = NO_LANE;
+
+	return lanes;
+}
@@ -0,0 +1,224 @@
+#ifndef NES_CPU_WIDE_HPP
+#define NES_CPU_WIDE_HPP
+
+#include "cpu/cpu.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace nes
+{
+	class RAM;
+
+	/**
+	 * Experimental core that runs many independent CPUs in lockstep, one per
+	 * lane, meant for search and fuzzing workloads that run thousands of
+	 * instances of the same ROM with different inputs
+	 *
+	 * Between runs every lane is an ordinary CPU with its own RAM, which is set
+	 * up and inspected through the usual interfaces. During a run the registers
+	 * of all lanes are held in struct-of-arrays form. Every step picks the
+	 * lowest program counter of all running lanes and groups the lanes that are
+	 * about to execute the exact same instruction there. Lanes that diverged
+	 * are masked out until control flow brings them back together.
+	 *
+	 * Instructions that only touch registers (implied, accumulator and
+	 * immediate addressing), zero page and absolute loads and stores, branches
+	 * and absolute jumps execute across the whole group with SSE2 or AVX2
+	 * kernels. Everything else, including entering interrupts, is executed lane
+	 * by lane by the lane's own CPU through the regular op-code handlers until
+	 * the lane reaches an instruction the kernels handle again.
+	 *
+	 * Every lane ends up in exactly the same state as a CPU that executed
+	 * RunCycles on its own. Breakpoints, tracing and profiling of the lane CPUs
+	 * only see the instructions that run lane by lane, so they should not be
+	 * used with the wide core.
+	 */
+	class CpuWide
+	{
+	public:
+		/**
+		 * Counters of the last run
+		 */
+		struct Statistics
+		{
+			// Number of groups executed by a vector kernel
+			std::uint64_t VectorGroups;
+
+			// Instructions executed by vector kernels, counted once per lane
+			std::uint64_t VectorInstructions;
+
+			// Instructions and interrupts executed lane by lane
+			std::uint64_t ScalarInstructions;
+		};
+
+	public:
+		/**
+		 * Create a new wide core, every lane starts out with cleared RAM and a
+		 * CPU in its default state
+		 * @param	laneCount	Number of lanes
+		 */
+		explicit CpuWide(std::size_t laneCount);
+
+		// Lane CPUs refer to the RAM of their lane
+		CpuWide(const CpuWide& other)				= delete;
+		CpuWide(CpuWide&& other)					= delete;
+		CpuWide& operator=(const CpuWide& other)	= delete;
+		CpuWide& operator=(CpuWide&& other)			= delete;
+
+		/**
+		 * Deallocate any used resources
+		 */
+		~CpuWide();
+
+		/**
+		 * Retrieve the number of lanes
+		 * @return	Number of lanes
+		 */
+		std::size_t GetLaneCount() const;
+
+		/**
+		 * Retrieve the CPU of a lane, to set up or inspect the lane between runs
+		 * @param	lane	Index of the lane
+		 * @return	CPU of the lane
+		 */
+		CPU& GetLaneCpu(std::size_t lane);
+
+		/**
+		 * Retrieve the RAM of a lane, to set up or inspect the lane between runs
+		 * @param	lane	Index of the lane
+		 * @return	RAM of the lane
+		 */
+		RAM& GetLaneRam(std::size_t lane);
+
+		/**
+		 * Run every lane until at least the specified number of cycles has passed
+		 * for that lane, or until the lane gets stuck on an unknown op-code
+		 * @param	cycleCount	Number of cycles to run every lane for
+		 */
+		void RunCycles(std::uint64_t cycleCount);
+
+		/**
+		 * Retrieve the reason a lane stopped during the last run
+		 * @param	lane	Index of the lane
+		 * @return	CycleBudget, or the reason the lane CPU stopped early
+		 */
+		CPU::StopReason GetLaneStopReason(std::size_t lane) const;
+
+		/**
+		 * Retrieve the counters of the last run
+		 * @return	Counters of the last run
+		 */
+		const Statistics& GetStatistics() const;
+
+		/**
+		 * Retrieve the name of the instruction set the vector kernels were
+		 * compiled for
+		 * @return	"AVX2", "SSE2" or "scalar"
+		 */
+		static const char* GetInstructionSetName();
+
+	private:
+		/**
+		 * Copy the state of every lane CPU into the register arrays
+		 * @param	cycleCount	Number of cycles every lane is going to run for
+		 */
+		void LoadLanes(std::uint64_t cycleCount);
+
+		/**
+		 * Copy the register arrays back into the lane CPUs
+		 */
+		void StoreLanes();
+
+		/**
+		 * Copy the registers of a lane from its stored CPU state into the
+		 * register arrays
+		 * @param	lane	Index of the lane
+		 */
+		void UnpackLaneState(std::size_t lane);
+
+		/**
+		 * Copy the registers of a lane from the register arrays into its stored
+		 * CPU state
+		 * @param	lane	Index of the lane
+		 */
+		void PackLaneState(std::size_t lane);
+
+		/**
+		 * Execute the instruction shared by the current group across all lanes
+		 * in the group
+		 * @param	opCode		Op-code of the instruction
+		 * @param	operand		Operand of the instruction
+		 */
+		void ExecuteGroup(std::uint8_t opCode, std::uint16_t operand);
+
+		/**
+		 * Execute a single instruction, or enter a pending interrupt, on the CPU
+		 * of a lane
+		 * @param	lane	Index of the lane
+		 */
+		void ExecuteLane(std::size_t lane);
+
+		/**
+		 * Add a lane to the lanes waiting at its program counter, unless it used
+		 * up its cycles
+		 * @param	lane	Index of the lane
+		 */
+		void ScheduleLane(std::size_t lane);
+
+		/**
+		 * Remove all lanes waiting at the lowest address from the schedule
+		 * @param	address		Set to the lowest address lanes were waiting at
+		 * @return	First lane of the list of lanes, linked through NextLane, or
+		 *			0xFFFFFFFF when no lane is running anymore
+		 */
+		std::uint32_t TakeLowestAddress(std::uint16_t& address);
+
+	private:
+		std::size_t LaneCount;
+
+		// Lanes are padded up to a whole number of the widest vector
+		std::size_t PaddedLaneCount;
+
+		std::vector<std::unique_ptr<RAM>> LaneRams;
+		std::vector<std::unique_ptr<CPU>> LaneCpus;
+
+		// Full CPU state of every lane, as written by CPU::WriteState
+		std::vector<std::array<std::uint8_t, CPU::STATE_SIZE>> LaneStates;
+
+		// Registers of every lane while running
+		std::vector<std::uint8_t> A;
+		std::vector<std::uint8_t> X;
+		std::vector<std::uint8_t> Y;
+		std::vector<std::uint8_t> P;
+		std::vector<std::uint8_t> SP;
+		std::vector<std::uint16_t> PC;
+		std::vector<std::uint64_t> Cycle;
+		std::vector<std::uint64_t> TargetCycle;
+		std::vector<std::uint8_t> HasPendingInterrupt;
+
+		// Values the current group loaded from memory, one per lane
+		std::vector<std::uint8_t> LoadedValues;
+
+		// Running lanes waiting at every address, as lists linked through NextLane
+		std::vector<std::uint32_t> FirstLaneAtAddress;
+		std::vector<std::uint32_t> NextLane;
+
+		// One bit per address with at least one lane waiting, the lowest
+		// address is found by scanning upwards from LowestOccupiedWord
+		std::vector<std::uint64_t> OccupiedAddresses;
+		std::size_t LowestOccupiedWord;
+
+		// 0xFF for every lane in the current group, 0x00 for all others
+		std::vector<std::uint8_t> GroupMask;
+		std::vector<std::size_t> GroupLanes;
+
+		std::vector<CPU::StopReason> StopReasons;
+		Statistics RunStatistics;
+	};
+}
+
+#endif //! NES_CPU_WIDE_HPP
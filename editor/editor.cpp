@@ -9,11 +9,14 @@
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Window/Event.hpp>
 
+#include <utility>	// std::move
+
 nes::Editor::Editor(sf::RenderWindow& window, CPU& cpu, RAM& ram) :
 	WindowRef(window),
 	CpuRef(cpu),
 	RamRef(ram),
 	CpuControllerUI(cpu),
+	ProfilerUI(cpu),
 	RamVisualizerUI(ram, cpu)
 {}
 
@@ -57,6 +60,12 @@ void nes::Editor::DrawUI() const
 				ImGui::EndMenu();
 			}
 
+			if (ImGui::BeginMenu("Profiler"))
+			{
+				ProfilerUI.Draw();
+				ImGui::EndMenu();
+			}
+
 			if (ImGui::BeginMenu("Load"))
 			{
 				RomBrowserUI.Draw();
@@ -99,19 +108,29 @@ void nes::Editor::ApplyStyle()
 
 void nes::Editor::LoadROM(const std::string& romPath)
 {
-	if (!ActiveRom.LoadFromDisk(romPath))
+	// The RAM reads the active ROM in place, so it is only replaced once the
+	// new one turns out to be usable
+	RomFile romFile;
+	if (!romFile.LoadFromDisk(romPath))
 	{
 		// ROM failed to load from disk
 		return;
 	}
 
-	if (!ActiveRom.IsValidRom())
+	if (!romFile.IsValidRom())
 	{
 		// ROM is invalid
 		return;
 	}
 
-	// Success, load the ROM file into memory
-	RamRef.StoreRomData(ActiveRom);
+	if (!RamRef.StoreRomData(romFile))
+	{
+		// Mapper is not supported
+		return;
+	}
+
+	// Success, moving the ROM keeps its data where the RAM expects it
+	ActiveRom = std::move(romFile);
+
 	CpuRef.SetProgramCounterToResetVector();
 }
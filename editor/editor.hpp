@@ -4,6 +4,7 @@
 #include "io/rom_file.hpp"
 
 #include "ui/ui_cpu_controller.hpp"
+#include "ui/ui_profiler.hpp"
 #include "ui/ui_ram_visualizer.hpp"
 #include "ui/ui_rom_browser.hpp"
 
@@ -80,6 +81,7 @@ namespace nes
         RomFile ActiveRom;
 
         UICpuController CpuControllerUI;
+        UIProfiler ProfilerUI;
         UIRamVisualizer RamVisualizerUI;
         UIRomBrowser RomBrowserUI;
     };
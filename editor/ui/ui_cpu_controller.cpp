@@ -3,6 +3,8 @@
 
 #include <imgui.h>
 
+#include <iostream>
+
 nes::UICpuController::UICpuController(CPU& cpuRef) :
 	CpuRef(cpuRef)
 {}
@@ -54,9 +56,33 @@ void nes::UICpuController::Draw() const
 
 	if (ImGui::Button("Execute until cycle"))
 	{
-		while (CpuRef.GetCurrentCycle() <= targetCycle)
+		// Run until the target cycle has been passed
+		std::uint64_t currentCycle = CpuRef.GetCurrentCycle();
+		if (targetCycle >= 0 && currentCycle <= static_cast<std::uint64_t>(targetCycle))
 		{
-			CpuRef.ExecuteInstruction();
+			CpuRef.RunCycles(static_cast<std::uint64_t>(targetCycle) - currentCycle + 1);
 		}
 	}
+
+	// Keep the last instructions around to inspect them after a breakpoint or
+	// an unknown op-code
+	bool tracing = CpuRef.IsTracingEnabled();
+	if (ImGui::Checkbox("Record trace", &tracing))
+	{
+		if (tracing)
+		{
+			CpuRef.EnableTracing(TRACE_RECORD_COUNT, &std::cout);
+		}
+		else
+		{
+			CpuRef.DisableTracing();
+		}
+	}
+
+	ImGui::SameLine();
+
+	if (ImGui::Button("Dump trace"))
+	{
+		CpuRef.DumpTrace(std::cout);
+	}
 }
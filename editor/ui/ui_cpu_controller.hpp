@@ -1,6 +1,8 @@
 #ifndef NES_UI_CPU_CONTROLLER_HPP
 #define NES_UI_CPU_CONTROLLER_HPP
 
+#include <cstddef>
+
 namespace nes
 {
 	class CPU;
@@ -24,6 +26,10 @@ namespace nes
 		 */
 		void Draw() const;
 
+	private:
+		// Number of instructions kept while tracing is enabled
+		static constexpr std::size_t TRACE_RECORD_COUNT = 4096;
+
 	private:
 		CPU& CpuRef;
 	};
@@ -0,0 +1,101 @@
+#include "ui_profiler.hpp"
+#include "cpu/cpu.hpp"
+#include "cpu/cpu_profiler.hpp"
+
+#include <imgui.h>
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+nes::UIProfiler::UIProfiler(CPU& cpuRef) :
+	CpuRef(cpuRef)
+{}
+
+void nes::UIProfiler::Draw() const
+{
+	bool profiling = CpuRef.IsProfilingEnabled();
+	if (ImGui::Checkbox("Enable profiling", &profiling))
+	{
+		if (profiling)
+		{
+			CpuRef.EnableProfiling();
+		}
+		else
+		{
+			CpuRef.DisableProfiling();
+		}
+	}
+
+	CpuProfiler* profiler = CpuRef.GetProfiler();
+	if (profiler == nullptr)
+	{
+		ImGui::Text("Profiling is disabled, the JIT is used when it is enabled");
+		return;
+	}
+
+	ImGui::SameLine();
+	if (ImGui::Button("Clear"))
+	{
+		profiler->Clear();
+	}
+
+	ImGui::SameLine();
+	if (ImGui::Button("Export CSV"))
+	{
+		std::ofstream csvFile(CSV_EXPORT_PATH, std::ios_base::out | std::ios_base::trunc);
+		if (csvFile.is_open())
+		{
+			profiler->WriteCsv(csvFile, CpuRef);
+		}
+	}
+
+	ImGui::Text("%llu instructions, %llu cycles", static_cast<unsigned long long>(profiler->GetTotalExecutions()), static_cast<unsigned long long>(profiler->GetTotalCycles()));
+
+	ImGui::Separator();
+	ImGui::Text("Top op-codes");
+	DrawTable("##top_opcodes", true);
+
+	ImGui::Separator();
+	ImGui::Text("Hottest addresses");
+	DrawTable("##hottest_addresses", false);
+}
+
+void nes::UIProfiler::DrawTable(const char* id, bool opCodes) const
+{
+	const CpuProfiler* profiler = CpuRef.GetProfiler();
+	std::vector<CpuProfiler::Entry> entries = opCodes ? profiler->GetTopOpCodes(TOP_ENTRY_COUNT) : profiler->GetHottestAddresses(TOP_ENTRY_COUNT);
+
+	ImGui::Columns(4, id);
+	ImGui::Text(opCodes ? "Op-code" : "Address");	ImGui::NextColumn();
+	ImGui::Text("Name");							ImGui::NextColumn();
+	ImGui::Text("Executions");						ImGui::NextColumn();
+	ImGui::Text("Cycles");							ImGui::NextColumn();
+	ImGui::Separator();
+
+	for (const CpuProfiler::Entry& entry : entries)
+	{
+		if (opCodes)
+		{
+			ImGui::Text("0x%02X", entry.Key);
+		}
+		else
+		{
+			ImGui::Text("0x%04X", entry.Key);
+		}
+		ImGui::NextColumn();
+
+		// Addresses are named after the op-code that is there right now
+		std::uint8_t opCode = opCodes ? static_cast<std::uint8_t>(entry.Key) : CpuRef.PeekRamValueAtAddress(entry.Key).value;
+		ImGui::Text("%s", std::string(CpuRef.GetOpCodeName(opCode)).c_str());
+		ImGui::NextColumn();
+
+		ImGui::Text("%llu", static_cast<unsigned long long>(entry.Executions));
+		ImGui::NextColumn();
+
+		ImGui::Text("%llu", static_cast<unsigned long long>(entry.Cycles));
+		ImGui::NextColumn();
+	}
+
+	ImGui::Columns(1);
+}
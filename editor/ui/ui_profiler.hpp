@@ -0,0 +1,51 @@
+#ifndef NES_UI_PROFILER_HPP
+#define NES_UI_PROFILER_HPP
+
+#include <cstddef>
+
+namespace nes
+{
+	class CPU;
+
+	/**
+	 * Editor UI element that shows which op-codes and addresses the CPU spends
+	 * most of its cycles on
+	 * This element does not create an ImGui window, therefore, it is expected to
+	 * either be part of an existing window, or a menu bar
+	 */
+	class UIProfiler
+	{
+	public:
+		/**
+		 * Create a new profiler panel
+		 * @param	cpuRef	Reference to the CPU object to profile
+		 */
+		UIProfiler(CPU& cpuRef);
+
+		/**
+		 * Render the UI for this panel
+		 */
+		void Draw() const;
+
+	private:
+		/**
+		 * Draw a table of profiler entries
+		 * @param	id			Unique ImGui ID of the table
+		 * @param	opCodes		True when the entries are op-codes, false when
+		 *						they are addresses
+		 */
+		void DrawTable(const char* id, bool opCodes) const;
+
+	private:
+		// Number of rows shown per table
+		static constexpr std::size_t TOP_ENTRY_COUNT = 16;
+
+		// File the profile is exported to
+		static constexpr const char* CSV_EXPORT_PATH = "./profile.csv";
+
+	private:
+		CPU& CpuRef;
+	};
+}
+
+#endif //! NES_UI_PROFILER_HPP
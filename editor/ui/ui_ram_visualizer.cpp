@@ -15,7 +15,7 @@ nes::UIRamVisualizer::UIRamVisualizer(const RAM& ramRef, const CPU& cpuRef) :
 
 void nes::UIRamVisualizer::Draw() const
 {
-	ImGuiListClipper clipper(static_cast<std::int32_t>(std::ceil(static_cast<float>(RamRef.GetSize()) / 16.0f)));
+	ImGuiListClipper clipper(static_cast<std::int32_t>(std::ceil(static_cast<float>(RAM::ADDRESS_SPACE_SIZE) / 16.0f)));
 	while (clipper.Step())
 	{
 		for (std::int32_t row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
@@ -0,0 +1,130 @@
+#include "mapped_file.hpp"
+
+#include <string>
+
+#if defined(_WIN32)
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+nes::MappedFile::MappedFile() :
+	Data(nullptr),
+	Size(0)
+{}
+
+nes::MappedFile::~MappedFile()
+{
+	Close();
+}
+
+bool nes::MappedFile::Open(std::string_view path, AccessPattern accessPattern)
+{
+	Close();
+
+	std::string pathString(path);
+
+#if defined(_WIN32)
+	DWORD accessFlags = (accessPattern == AccessPattern::Sequential) ? FILE_FLAG_SEQUENTIAL_SCAN : FILE_FLAG_RANDOM_ACCESS;
+	HANDLE file = CreateFileA(pathString.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, accessFlags, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	// The view keeps the file alive, so both handles can be closed right away
+	HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	CloseHandle(file);
+
+	if (mapping == nullptr)
+	{
+		return false;
+	}
+
+	void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(mapping);
+
+	if (view == nullptr)
+	{
+		return false;
+	}
+
+	Data = static_cast<const std::uint8_t*>(view);
+	Size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+	int file = open(pathString.c_str(), O_RDONLY);
+	if (file < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStatus;
+	if (fstat(file, &fileStatus) != 0 || fileStatus.st_size <= 0)
+	{
+		close(file);
+		return false;
+	}
+
+	// The mapping keeps the file alive, so the descriptor can be closed right away
+	std::size_t fileSize = static_cast<std::size_t>(fileStatus.st_size);
+	void* view = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, file, 0);
+	close(file);
+
+	if (view == MAP_FAILED)
+	{
+		return false;
+	}
+
+	// Reading ahead only pays off for files that are read front to back
+	madvise(view, fileSize, (accessPattern == AccessPattern::Sequential) ? MADV_SEQUENTIAL : MADV_RANDOM);
+
+	Data = static_cast<const std::uint8_t*>(view);
+	Size = fileSize;
+#endif
+
+	return true;
+}
+
+void nes::MappedFile::Close()
+{
+	if (Data == nullptr)
+	{
+		return;
+	}
+
+#if defined(_WIN32)
+	UnmapViewOfFile(Data);
+#else
+	munmap(const_cast<std::uint8_t*>(Data), Size);
+#endif
+
+	Data = nullptr;
+	Size = 0;
+}
+
+bool nes::MappedFile::IsOpen() const
+{
+	return (Data != nullptr);
+}
+
+const std::uint8_t* nes::MappedFile::GetData() const
+{
+	return Data;
+}
+
+std::size_t nes::MappedFile::GetSize() const
+{
+	return Size;
+}
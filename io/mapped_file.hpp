@@ -0,0 +1,80 @@
+#ifndef NES_MAPPED_FILE_HPP
+#define NES_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace nes
+{
+	/**
+	 * Read-only view of a file that is mapped into memory
+	 *
+	 * Pages are loaded by the operating system as they are touched, so even very
+	 * large files can be scanned front to back without copying them into a buffer.
+	 */
+	class MappedFile
+	{
+	public:
+		/**
+		 * How the contents of the file are going to be read
+		 */
+		enum class AccessPattern
+		{
+			Sequential,	// Front to back, the operating system reads ahead
+			Random		// Scattered, only touched pages are loaded
+		};
+
+	public:
+		/**
+		 * Create a new mapping, no file is mapped yet
+		 */
+		MappedFile();
+
+		MappedFile(const MappedFile& other)				= delete;
+		MappedFile& operator=(const MappedFile& other)	= delete;
+
+		/**
+		 * Unmap the file
+		 */
+		~MappedFile();
+
+		/**
+		 * Map a file into memory, unmapping any previously mapped file
+		 * @param	path			Path to the file
+		 * @param	accessPattern	How the file is going to be read
+		 * @return	True when the file could be mapped, false otherwise
+		 */
+		bool Open(std::string_view path, AccessPattern accessPattern = AccessPattern::Sequential);
+
+		/**
+		 * Unmap the file
+		 */
+		void Close();
+
+		/**
+		 * Check whether a file is mapped
+		 * Empty files are never mapped, as there is nothing to read from them
+		 * @return	True if the data can be read
+		 */
+		bool IsOpen() const;
+
+		/**
+		 * Get the contents of the file
+		 * @return	Pointer to the first byte of the file, nullptr when nothing is mapped
+		 */
+		const std::uint8_t* GetData() const;
+
+		/**
+		 * Get the size of the file
+		 * @return	Size of the file in bytes
+		 */
+		std::size_t GetSize() const;
+
+	private:
+		const std::uint8_t* Data;
+		std::size_t Size;
+	};
+}
+
+#endif //! NES_MAPPED_FILE_HPP
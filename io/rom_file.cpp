@@ -1,41 +1,134 @@
 #include "rom_file.hpp"
+#include "mapped_file.hpp"
+
+#include <algorithm>	// std::min
+#include <limits>
+#include <utility>		// std::move
+
+nes::RomFile::RomFile() :
+	RawData(nullptr),
+	RawSize(0)
+{}
+
+nes::RomFile::RomFile(RomFile&& other) noexcept :
+	Mapping(std::move(other.Mapping)),
+	OwnedData(std::move(other.OwnedData)),
+	RawData(other.RawData),
+	RawSize(other.RawSize)
+{
+	other.RawData = nullptr;
+	other.RawSize = 0;
+}
+
+nes::RomFile& nes::RomFile::operator=(RomFile&& other) noexcept
+{
+	if (this != &other)
+	{
+		// Neither the mapping nor the buffer of the vector move in memory, so
+		// the data stays where mappers expect it
+		Mapping = std::move(other.Mapping);
+		OwnedData = std::move(other.OwnedData);
+		RawData = other.RawData;
+		RawSize = other.RawSize;
+
+		other.RawData = nullptr;
+		other.RawSize = 0;
+	}
 
-#include <cstring>
-#include <fstream>
-#include <string>
+	return *this;
+}
+
+nes::RomFile::~RomFile() = default;
 
 bool nes::RomFile::LoadFromDisk(std::string_view path)
 {
-	std::ifstream rom(path.data(), std::ios_base::in | std::ios_base::binary);
-	if (!rom.is_open())
+	// Random access keeps the operating system from reading ahead, only the
+	// banks that actually get touched are loaded
+	auto mapping = std::make_unique<MappedFile>();
+	if (!mapping->Open(path, MappedFile::AccessPattern::Random))
+	{
+		return false;
+	}
+
+	if (mapping->GetSize() > std::numeric_limits<std::uint32_t>::max())
 	{
 		return false;
 	}
 
-	// Determine file size
-	rom.seekg(0, std::ios_base::end);
-	size_t romSize = rom.tellg();
-	rom.seekg(0, std::ios_base::beg);
+	static_assert(sizeof(Byte) == 1, "The mapped file is read as raw bytes");
 
-	// Dump the file into memory
-	RawData.resize(romSize, Byte());
-	rom.read(reinterpret_cast<char*>(RawData.data()), romSize);
-	rom.close();
+	Mapping = std::move(mapping);
+	OwnedData.clear();
+	OwnedData.shrink_to_fit();
+	RawData = reinterpret_cast<const Byte*>(Mapping->GetData());
+	RawSize = static_cast<std::uint32_t>(Mapping->GetSize());
 
 	return true;
 }
 
+void nes::RomFile::LoadFromMemory(const std::uint8_t* data, std::size_t size)
+{
+	size = std::min<std::size_t>(size, std::numeric_limits<std::uint32_t>::max());
+
+	OwnedData.resize(size, Byte());
+
+	for (std::size_t i = 0; i < size; ++i)
+	{
+		OwnedData[i].value = data[i];
+	}
+
+	Mapping.reset();
+	RawData = OwnedData.data();
+	RawSize = static_cast<std::uint32_t>(size);
+}
+
 bool nes::RomFile::IsValidRom() const
 {
-	std::uint8_t magicNumber[5];
-	std::memcpy(magicNumber, RawData.data(), 5);
+	// "NES" followed by an MS-DOS end-of-file character, at the start of the
+	// 16-byte header
+	constexpr std::uint8_t MAGIC_NUMBER[4] = { 'N', 'E', 'S', 0x1A };
+
+	if (RawSize < HEADER_SIZE)
+	{
+		return false;
+	}
+
+	for (std::size_t i = 0; i < sizeof(MAGIC_NUMBER); ++i)
+	{
+		if (RawData[i].value != MAGIC_NUMBER[i])
+		{
+			return false;
+		}
+	}
+
+	// The PRG-ROM and the CHR-ROM have to be there in full
+	std::uint64_t chrRomEnd = static_cast<std::uint64_t>(GetFirstVRomBankByteIndex()) + GetNumberOfVRomBanks() * VROM_BANK_SIZE;
+	return (chrRomEnd <= RawSize);
+}
+
+nes::RomFile::Span nes::RomFile::GetRaw() const
+{
+	return Span{ RawData, RawSize };
+}
+
+nes::RomFile::Span nes::RomFile::GetPrgRom() const
+{
+	if (RawSize < HEADER_SIZE)
+	{
+		return Span{ nullptr, 0 };
+	}
 
-	return std::strcmp(reinterpret_cast<char*>(magicNumber), "NES^Z");
+	return GetBlock(GetFirstRomBankByteIndex(), GetNumberOfRomBanks() * static_cast<std::uint32_t>(ROM_BANK_SIZE));
 }
 
-const std::vector<nes::Byte>& nes::RomFile::GetRaw() const
+nes::RomFile::Span nes::RomFile::GetChrRom() const
 {
-	return RawData;
+	if (RawSize < HEADER_SIZE)
+	{
+		return Span{ nullptr, 0 };
+	}
+
+	return GetBlock(GetFirstVRomBankByteIndex(), GetNumberOfVRomBanks() * static_cast<std::uint32_t>(VROM_BANK_SIZE));
 }
 
 std::uint8_t nes::RomFile::GetNumberOfRomBanks() const
@@ -55,9 +148,11 @@ std::uint8_t nes::RomFile::GetNumberOfRamBanks() const
 
 std::uint8_t nes::RomFile::GetRomMapperTypeId() const
 {
-	std::uint8_t lower	= (RawData[6].value & 0xF0);
+	// Lower nibble in the upper half of flags 6, upper nibble in the upper
+	// half of flags 7
+	std::uint8_t lower	= (RawData[6].value >> 4);
 	std::uint8_t higher	= (RawData[7].value & 0xF0);
-	return (lower | (higher << 4));
+	return (lower | higher);
 }
 
 nes::RomFile::MirroringType nes::RomFile::GetNametableMirroringType() const
@@ -90,10 +185,10 @@ bool nes::RomFile::IsPal() const
 	return (RawData[9].bit0 != 0);
 }
 
-std::uint16_t nes::RomFile::GetFirstRomBankByteIndex() const
+std::uint32_t nes::RomFile::GetFirstRomBankByteIndex() const
 {
 	// The first ROM bank starts at the 16th byte
-	std::uint16_t startIndex = 16;
+	std::uint32_t startIndex = HEADER_SIZE;
 
 	if (HasTrainer())
 	{
@@ -104,9 +199,24 @@ std::uint16_t nes::RomFile::GetFirstRomBankByteIndex() const
 	return startIndex;
 }
 
-std::uint16_t nes::RomFile::GetSecondRomBankByteIndex() const
+std::uint32_t nes::RomFile::GetSecondRomBankByteIndex() const
 {
 	// The second bank comes right after the first index
-	std::uint16_t firstBankIndex = GetFirstRomBankByteIndex();
+	std::uint32_t firstBankIndex = GetFirstRomBankByteIndex();
 	return firstBankIndex + ROM_BANK_SIZE;
 }
+
+std::uint32_t nes::RomFile::GetFirstVRomBankByteIndex() const
+{
+	return GetFirstRomBankByteIndex() + GetNumberOfRomBanks() * static_cast<std::uint32_t>(ROM_BANK_SIZE);
+}
+
+nes::RomFile::Span nes::RomFile::GetBlock(std::uint32_t offset, std::uint32_t size) const
+{
+	if (offset >= RawSize)
+	{
+		return Span{ nullptr, 0 };
+	}
+
+	return Span{ RawData + offset, std::min(size, RawSize - offset) };
+}
@@ -4,15 +4,35 @@
 #include "utility/literals.hpp"
 #include "utility/bit_tools.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string_view>
 #include <vector>
 
 namespace nes
 {
+	class MappedFile;
+
+	/**
+	 * iNES file, either mapped straight from disk or copied from memory
+	 *
+	 * Files on disk are mapped read-only, so loading a ROM costs nothing until
+	 * its pages are touched. Mappers read PRG and CHR data through spans into
+	 * the file, moving a RomFile keeps that data at the same address.
+	 */
 	class RomFile
 	{
 	public:
+		/**
+		 * Read-only view of a block of bytes inside the file
+		 */
+		struct Span
+		{
+			const Byte* Data;
+			std::uint32_t Size;
+		};
+
 		/**
 		 * Nametable mirroring types
 		 */
@@ -28,25 +48,65 @@ namespace nes
 		/** Size of a trainer in bytes */
 		static constexpr std::uint16_t ROM_TRAINER_SIZE = 512;
 
+		/** Size of a single VROM (CHR-ROM) bank in bytes */
+		static constexpr std::uint16_t VROM_BANK_SIZE = 8_KB;
+
+		/** Size of the iNES header in bytes */
+		static constexpr std::uint16_t HEADER_SIZE = 16;
+
 	public:
 		/**
-		 * Read a NES file from disk
+		 * Create an empty ROM file
+		 */
+		RomFile();
+
+		RomFile(RomFile&& other) noexcept;
+		RomFile& operator=(RomFile&& other) noexcept;
+
+		/**
+		 * Unmap the file, if it was mapped
+		 */
+		~RomFile();
+
+		/**
+		 * Map a NES file from disk, the previous contents are kept when this
+		 * fails
 		 * @param	path	Path to the NES file
 		 * @return	True when the loading succeeded, false otherwise
 		 */
 		bool LoadFromDisk(std::string_view path);
 
 		/**
-		 * Check if the magic number is present in the file header
+		 * Take a NES file that is already in memory, such as a generated one
+		 * @param	data	Bytes that make up the entire NES file
+		 * @param	size	Number of bytes
+		 */
+		void LoadFromMemory(const std::uint8_t* data, std::size_t size);
+
+		/**
+		 * Check if the magic number is present in the file header, and the file
+		 * holds all the PRG and CHR data the header promises
 		 * @return	True when the ROM is a valid NES ROM, false otherwise
 		 */
 		bool IsValidRom() const;
 
 		/**
 		 * Get the raw ROM data
-		 * @return	Bytes that make up the entire ROM
+		 * @return	Bytes that make up the entire file
+		 */
+		Span GetRaw() const;
+
+		/**
+		 * Get the PRG-ROM, cut short when the file is
+		 * @return	Every PRG-ROM bank, in order
 		 */
-		const std::vector<Byte>& GetRaw() const;
+		Span GetPrgRom() const;
+
+		/**
+		 * Get the CHR-ROM, cut short when the file is
+		 * @return	Every VROM bank in order, empty for boards with CHR-RAM
+		 */
+		Span GetChrRom() const;
 
 		/**
 		 * Get the number of ROM banks
@@ -114,16 +174,39 @@ namespace nes
 		 * Get the index of the first ROM bank byte
 		 * @return	Start index of the first ROM bank
 		 */
-		std::uint16_t GetFirstRomBankByteIndex() const;
+		std::uint32_t GetFirstRomBankByteIndex() const;
 
 		/**
 		 * Get the index of the second ROM bank byte
 		 * @return	Start index of the second ROM bank
 		 */
-		std::uint16_t GetSecondRomBankByteIndex() const;
+		std::uint32_t GetSecondRomBankByteIndex() const;
+
+		/**
+		 * Get the index of the first VROM bank byte, right after the PRG-ROM
+		 * @return	Start index of the CHR-ROM
+		 */
+		std::uint32_t GetFirstVRomBankByteIndex() const;
+
+	private:
+		/**
+		 * Cut a block of the file short where the file ends
+		 * @param	offset	Start of the block
+		 * @param	size	Size of the block according to the header
+		 * @return	Part of the block that is inside of the file
+		 */
+		Span GetBlock(std::uint32_t offset, std::uint32_t size) const;
 
 	private:
-		std::vector<Byte> RawData;
+		// Set when the file was mapped from disk
+		std::unique_ptr<MappedFile> Mapping;
+
+		// Set when the file was copied from memory
+		std::vector<Byte> OwnedData;
+
+		// Contents of the file, inside of either of the above
+		const Byte* RawData;
+		std::uint32_t RawSize;
 	};
 }
 
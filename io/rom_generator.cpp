@@ -0,0 +1,607 @@
+#include "rom_generator.hpp"
+#include "rom_file.hpp"
+
+#include <algorithm>	// std::min / std::max
+#include <utility>		// std::pair
+
+namespace
+{
+	/** Address the PRG-ROM is mapped at */
+	constexpr std::uint16_t PROGRAM_ADDRESS = 0x8000;
+
+	/** Room for the start-up code in front of the workload */
+	constexpr std::size_t STARTUP_SIZE = 0x40;
+
+	/**
+	 * Room behind the code for the data table, the interrupt handler and the
+	 * vectors, at the end of the last bank
+	 */
+	constexpr std::size_t TAIL_SIZE = 0x200;
+
+	/** Zero page bytes the workloads use as scratch space */
+	constexpr std::uint8_t SCRATCH_SIZE = 0x20;
+
+	/** Zero page byte holding the state of the pseudo-random sequence */
+	constexpr std::uint8_t SEQUENCE_ADDRESS = 0x20;
+
+	/** Zero page pointers used by indirect copies */
+	constexpr std::uint8_t SOURCE_POINTER_ADDRESS = 0xF0;
+	constexpr std::uint8_t DESTINATION_POINTER_ADDRESS = 0xF2;
+
+	/** Internal RAM the workloads copy to, above the stack */
+	constexpr std::uint16_t BUFFER_START_ADDRESS = 0x0200;
+	constexpr std::uint16_t BUFFER_END_ADDRESS = 0x0800;
+
+	/** Largest number of bytes a single piece of workload code takes */
+	constexpr std::size_t MAX_PIECE_SIZE = 0x60;
+
+	/** Subroutines call each other this many levels deep at most */
+	constexpr std::size_t CALL_LEVEL_COUNT = 4;
+
+	// Op-codes used by the generated code
+	constexpr std::uint8_t OP_ADC_IMMEDIATE		= 0x69;
+	constexpr std::uint8_t OP_ADC_ZERO_PAGE		= 0x65;
+	constexpr std::uint8_t OP_AND_IMMEDIATE		= 0x29;
+	constexpr std::uint8_t OP_ASL_ACCUMULATOR	= 0x0A;
+	constexpr std::uint8_t OP_BCC				= 0x90;
+	constexpr std::uint8_t OP_BCS				= 0xB0;
+	constexpr std::uint8_t OP_BEQ				= 0xF0;
+	constexpr std::uint8_t OP_BMI				= 0x30;
+	constexpr std::uint8_t OP_BNE				= 0xD0;
+	constexpr std::uint8_t OP_BPL				= 0x10;
+	constexpr std::uint8_t OP_CLC				= 0x18;
+	constexpr std::uint8_t OP_CLD				= 0xD8;
+	constexpr std::uint8_t OP_CMP_IMMEDIATE		= 0xC9;
+	constexpr std::uint8_t OP_CPY_IMMEDIATE		= 0xC0;
+	constexpr std::uint8_t OP_DEX				= 0xCA;
+	constexpr std::uint8_t OP_DEY				= 0x88;
+	constexpr std::uint8_t OP_EOR_IMMEDIATE		= 0x49;
+	constexpr std::uint8_t OP_EOR_ZERO_PAGE		= 0x45;
+	constexpr std::uint8_t OP_INC_ZERO_PAGE		= 0xE6;
+	constexpr std::uint8_t OP_INX				= 0xE8;
+	constexpr std::uint8_t OP_INY				= 0xC8;
+	constexpr std::uint8_t OP_JMP_ABSOLUTE		= 0x4C;
+	constexpr std::uint8_t OP_JSR				= 0x20;
+	constexpr std::uint8_t OP_LDA_ABSOLUTE_X	= 0xBD;
+	constexpr std::uint8_t OP_LDA_ABSOLUTE_Y	= 0xB9;
+	constexpr std::uint8_t OP_LDA_IMMEDIATE		= 0xA9;
+	constexpr std::uint8_t OP_LDA_INDIRECT_Y	= 0xB1;
+	constexpr std::uint8_t OP_LDA_ZERO_PAGE		= 0xA5;
+	constexpr std::uint8_t OP_LDX_IMMEDIATE		= 0xA2;
+	constexpr std::uint8_t OP_LDY_IMMEDIATE		= 0xA0;
+	constexpr std::uint8_t OP_LSR_ACCUMULATOR	= 0x4A;
+	constexpr std::uint8_t OP_ORA_IMMEDIATE		= 0x09;
+	constexpr std::uint8_t OP_PHA				= 0x48;
+	constexpr std::uint8_t OP_PHP				= 0x08;
+	constexpr std::uint8_t OP_PLA				= 0x68;
+	constexpr std::uint8_t OP_PLP				= 0x28;
+	constexpr std::uint8_t OP_RTI				= 0x40;
+	constexpr std::uint8_t OP_RTS				= 0x60;
+	constexpr std::uint8_t OP_SBC_IMMEDIATE		= 0xE9;
+	constexpr std::uint8_t OP_SEC				= 0x38;
+	constexpr std::uint8_t OP_SEI				= 0x78;
+	constexpr std::uint8_t OP_STA_ABSOLUTE_X	= 0x9D;
+	constexpr std::uint8_t OP_STA_ABSOLUTE_Y	= 0x99;
+	constexpr std::uint8_t OP_STA_INDIRECT_Y	= 0x91;
+	constexpr std::uint8_t OP_STA_ZERO_PAGE		= 0x85;
+	constexpr std::uint8_t OP_STA_ZERO_PAGE_X	= 0x95;
+	constexpr std::uint8_t OP_TAY				= 0xA8;
+	constexpr std::uint8_t OP_TSX				= 0xBA;
+	constexpr std::uint8_t OP_TXS				= 0x9A;
+	constexpr std::uint8_t OP_TYA				= 0x98;
+
+	struct WorkloadName
+	{
+		nes::RomGenerator::Workload Workload;
+		std::string_view Name;
+	};
+
+	constexpr WorkloadName WORKLOAD_NAMES[] =
+	{
+		{ nes::RomGenerator::Workload::AluLoop,		"alu" },
+		{ nes::RomGenerator::Workload::MemoryCopy,	"memcpy" },
+		{ nes::RomGenerator::Workload::Branches,	"branches" },
+		{ nes::RomGenerator::Workload::Calls,		"calls" },
+		{ nes::RomGenerator::Workload::Stack,		"stack" }
+	};
+}
+
+nes::RomGenerator::RomGenerator(std::uint64_t seed) :
+	Random(seed),
+	ProgramLimit(0),
+	TableAddress(0)
+{
+}
+
+std::vector<std::uint8_t> nes::RomGenerator::Generate(Workload workload, std::size_t programSize)
+{
+	programSize = std::min(programSize, MAX_PROGRAM_SIZE);
+
+	std::size_t bankCount = (STARTUP_SIZE + programSize + TAIL_SIZE > RomFile::ROM_BANK_SIZE) ? 2 : 1;
+	std::size_t romSize = bankCount * RomFile::ROM_BANK_SIZE;
+
+	Program.clear();
+	Program.reserve(romSize);
+	TableAddress = static_cast<std::uint16_t>(PROGRAM_ADDRESS + romSize - TAIL_SIZE);
+
+	// Interrupts stay masked, the stack starts out empty
+	Emit(OP_SEI);
+	Emit(OP_CLD);
+	Emit(OP_LDX_IMMEDIATE, 0xFF);
+	Emit(OP_TXS);
+
+	// Copy the data table to the zero page and every page of the buffer
+	Emit(OP_INX);
+	std::uint16_t copyLoop = GetCurrentAddress();
+	EmitAbsolute(OP_LDA_ABSOLUTE_X, TableAddress);
+	Emit(OP_STA_ZERO_PAGE_X, 0x00);
+
+	for (std::uint16_t page = BUFFER_START_ADDRESS; page < BUFFER_END_ADDRESS; page += 0x100)
+	{
+		EmitAbsolute(OP_STA_ABSOLUTE_X, page);
+	}
+
+	Emit(OP_INX);
+	EmitBranchBack(OP_BNE, copyLoop);
+
+	// The sequence never leaves zero once it gets there
+	Emit(OP_LDA_IMMEDIATE, static_cast<std::uint8_t>(1 + Next(0xFF)));
+	Emit(OP_STA_ZERO_PAGE, SEQUENCE_ADDRESS);
+
+	// The start-up code always fits within STARTUP_SIZE, and every workload
+	// needs room for at least a single piece of code
+	ProgramLimit = std::min(Program.size() + std::max(programSize, MAX_PIECE_SIZE), romSize - TAIL_SIZE);
+
+	switch (workload)
+	{
+	case Workload::AluLoop:
+		WriteAluLoops();
+		break;
+	case Workload::MemoryCopy:
+		WriteMemoryCopies();
+		break;
+	case Workload::Branches:
+		WriteBranches();
+		break;
+	case Workload::Calls:
+		WriteCalls();
+		break;
+	case Workload::Stack:
+		WriteStackCode();
+		break;
+	}
+
+	// Unused space holds an unknown op-code, so stray jumps jam right away
+	Program.resize(romSize, 0xFF);
+
+	for (std::size_t i = 0; i < 0x100; ++i)
+	{
+		Program[TableAddress - PROGRAM_ADDRESS + i] = static_cast<std::uint8_t>(Next(0x100));
+	}
+
+	std::uint16_t handlerAddress = static_cast<std::uint16_t>(TableAddress + 0x100);
+	Program[handlerAddress - PROGRAM_ADDRESS] = OP_RTI;
+
+	// NMI, reset and IRQ vectors
+	const std::uint16_t vectors[] = { handlerAddress, PROGRAM_ADDRESS, handlerAddress };
+	for (std::size_t i = 0; i < 3; ++i)
+	{
+		Program[romSize - 6 + 2 * i] = static_cast<std::uint8_t>(vectors[i]);
+		Program[romSize - 5 + 2 * i] = static_cast<std::uint8_t>(vectors[i] >> 8);
+	}
+
+	// Mapper 0 without CHR-ROM, trainer or battery
+	std::vector<std::uint8_t> image = { 'N', 'E', 'S', 0x1A, static_cast<std::uint8_t>(bankCount) };
+	image.resize(16, 0x00);
+	image.insert(image.end(), Program.begin(), Program.end());
+
+	return image;
+}
+
+std::string_view nes::RomGenerator::GetWorkloadName(Workload workload)
+{
+	for (const WorkloadName& entry : WORKLOAD_NAMES)
+	{
+		if (entry.Workload == workload)
+		{
+			return entry.Name;
+		}
+	}
+
+	return "???";
+}
+
+bool nes::RomGenerator::ParseWorkloadName(std::string_view name, Workload& workload)
+{
+	for (const WorkloadName& entry : WORKLOAD_NAMES)
+	{
+		if (entry.Name == name)
+		{
+			workload = entry.Workload;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void nes::RomGenerator::Emit(std::uint8_t opCode)
+{
+	Program.push_back(opCode);
+}
+
+void nes::RomGenerator::Emit(std::uint8_t opCode, std::uint8_t operand)
+{
+	Program.push_back(opCode);
+	Program.push_back(operand);
+}
+
+void nes::RomGenerator::EmitAbsolute(std::uint8_t opCode, std::uint16_t address)
+{
+	Program.push_back(opCode);
+	Program.push_back(static_cast<std::uint8_t>(address));
+	Program.push_back(static_cast<std::uint8_t>(address >> 8));
+}
+
+void nes::RomGenerator::EmitBranchBack(std::uint8_t opCode, std::uint16_t target)
+{
+	// Offsets are relative to the instruction after the branch, every piece of
+	// code is kept below MAX_PIECE_SIZE so they always fit
+	int offset = static_cast<int>(target) - static_cast<int>(GetCurrentAddress() + 2);
+
+	Emit(opCode, static_cast<std::uint8_t>(offset));
+}
+
+std::size_t nes::RomGenerator::EmitBranchForward(std::uint8_t opCode)
+{
+	Emit(opCode, 0x00);
+	return Program.size() - 1;
+}
+
+void nes::RomGenerator::PatchBranch(std::size_t offsetPosition)
+{
+	std::size_t offset = Program.size() - (offsetPosition + 1);
+	Program[offsetPosition] = static_cast<std::uint8_t>(offset);
+}
+
+void nes::RomGenerator::EmitAluInstruction()
+{
+	std::uint8_t value = static_cast<std::uint8_t>(Next(0x100));
+	std::uint8_t scratch = static_cast<std::uint8_t>(Next(SCRATCH_SIZE));
+
+	switch (Next(18))
+	{
+	case 0:		Emit(OP_ADC_IMMEDIATE, value);		break;
+	case 1:		Emit(OP_SBC_IMMEDIATE, value);		break;
+	case 2:		Emit(OP_AND_IMMEDIATE, value);		break;
+	case 3:		Emit(OP_ORA_IMMEDIATE, value);		break;
+	case 4:		Emit(OP_EOR_IMMEDIATE, value);		break;
+	case 5:		Emit(OP_CMP_IMMEDIATE, value);		break;
+	case 6:		Emit(OP_LDA_IMMEDIATE, value);		break;
+	case 7:		Emit(OP_ASL_ACCUMULATOR);			break;
+	case 8:		Emit(OP_LSR_ACCUMULATOR);			break;
+	case 9:		Emit(OP_INY);						break;
+	case 10:	Emit(OP_DEY);						break;
+	case 11:	Emit(OP_TAY);						break;
+	case 12:	Emit(OP_TYA);						break;
+	case 13:	Emit(Next(2) ? OP_CLC : OP_SEC);	break;
+	case 14:	Emit(OP_ADC_ZERO_PAGE, scratch);	break;
+	case 15:	Emit(OP_EOR_ZERO_PAGE, scratch);	break;
+	case 16:	Emit(OP_STA_ZERO_PAGE, scratch);	break;
+	default:	Emit(OP_INC_ZERO_PAGE, scratch);	break;
+	}
+}
+
+void nes::RomGenerator::WriteAluLoops()
+{
+	std::uint16_t start = GetCurrentAddress();
+
+	do
+	{
+		// LDX #count / body / DEX / BNE, at most 2 + 24 * 2 + 3 bytes
+		Emit(OP_LDX_IMMEDIATE, static_cast<std::uint8_t>(8 + Next(57)));
+		std::uint16_t loop = GetCurrentAddress();
+
+		for (std::uint32_t count = 4 + Next(21); count > 0; --count)
+		{
+			EmitAluInstruction();
+		}
+
+		Emit(OP_DEX);
+		EmitBranchBack(OP_BNE, loop);
+	}
+	while (HasRoomFor(MAX_PIECE_SIZE));
+
+	EmitAbsolute(OP_JMP_ABSOLUTE, start);
+}
+
+void nes::RomGenerator::WriteMemoryCopies()
+{
+	std::uint16_t start = GetCurrentAddress();
+
+	do
+	{
+		// Between 16 and 256 bytes from the data table or RAM, into RAM
+		std::uint16_t count = static_cast<std::uint16_t>(16 + Next(241));
+		std::uint16_t source = Next(2) ? TableAddress : static_cast<std::uint16_t>(BUFFER_START_ADDRESS + Next(BUFFER_END_ADDRESS - BUFFER_START_ADDRESS - 0x100));
+		std::uint16_t destination = static_cast<std::uint16_t>(BUFFER_START_ADDRESS + Next(BUFFER_END_ADDRESS - BUFFER_START_ADDRESS - count + 1));
+
+		switch (Next(3))
+		{
+		case 0:
+		{
+			// Upwards with Y
+			Emit(OP_LDY_IMMEDIATE, 0x00);
+			std::uint16_t loop = GetCurrentAddress();
+			EmitAbsolute(OP_LDA_ABSOLUTE_Y, source);
+			EmitAbsolute(OP_STA_ABSOLUTE_Y, destination);
+			Emit(OP_INY);
+			Emit(OP_CPY_IMMEDIATE, static_cast<std::uint8_t>(count));
+			EmitBranchBack(OP_BNE, loop);
+			break;
+		}
+
+		case 1:
+		{
+			// Downwards with X, which counts from count to 1
+			count = std::min<std::uint16_t>(count, 0xFF);
+			Emit(OP_LDX_IMMEDIATE, static_cast<std::uint8_t>(count));
+			std::uint16_t loop = GetCurrentAddress();
+			EmitAbsolute(OP_LDA_ABSOLUTE_X, static_cast<std::uint16_t>(source - 1));
+			EmitAbsolute(OP_STA_ABSOLUTE_X, static_cast<std::uint16_t>(destination - 1));
+			Emit(OP_DEX);
+			EmitBranchBack(OP_BNE, loop);
+			break;
+		}
+
+		default:
+		{
+			// Through a pair of zero page pointers
+			const std::pair<std::uint8_t, std::uint16_t> pointers[] =
+			{
+				{ SOURCE_POINTER_ADDRESS, source },
+				{ DESTINATION_POINTER_ADDRESS, destination }
+			};
+
+			for (const auto& pointer : pointers)
+			{
+				Emit(OP_LDA_IMMEDIATE, static_cast<std::uint8_t>(pointer.second));
+				Emit(OP_STA_ZERO_PAGE, pointer.first);
+				Emit(OP_LDA_IMMEDIATE, static_cast<std::uint8_t>(pointer.second >> 8));
+				Emit(OP_STA_ZERO_PAGE, static_cast<std::uint8_t>(pointer.first + 1));
+			}
+
+			Emit(OP_LDY_IMMEDIATE, 0x00);
+			std::uint16_t loop = GetCurrentAddress();
+			Emit(OP_LDA_INDIRECT_Y, SOURCE_POINTER_ADDRESS);
+			Emit(OP_STA_INDIRECT_Y, DESTINATION_POINTER_ADDRESS);
+			Emit(OP_INY);
+			Emit(OP_CPY_IMMEDIATE, static_cast<std::uint8_t>(count));
+			EmitBranchBack(OP_BNE, loop);
+			break;
+		}
+		}
+	}
+	while (HasRoomFor(MAX_PIECE_SIZE));
+
+	EmitAbsolute(OP_JMP_ABSOLUTE, start);
+}
+
+void nes::RomGenerator::WriteBranches()
+{
+	static constexpr std::uint8_t BRANCHES_ON_ZERO[] = { OP_BEQ, OP_BNE };
+	static constexpr std::uint8_t BRANCHES_ON_CARRY[] = { OP_BCC, OP_BCS };
+	static constexpr std::uint8_t BRANCHES_ON_SIGN[] = { OP_BMI, OP_BPL };
+
+	std::uint16_t start = GetCurrentAddress();
+
+	do
+	{
+		// Advance the 8-bit Galois LFSR with taps 0x1D, it goes through all
+		// 255 non-zero values before it repeats
+		Emit(OP_LDA_ZERO_PAGE, SEQUENCE_ADDRESS);
+		Emit(OP_ASL_ACCUMULATOR);
+		std::size_t noCarry = EmitBranchForward(OP_BCC);
+		Emit(OP_EOR_IMMEDIATE, 0x1D);
+		PatchBranch(noCarry);
+		Emit(OP_STA_ZERO_PAGE, SEQUENCE_ADDRESS);
+
+		// A few tests on the new value, each skips up to three instructions,
+		// at most 6 * 12 bytes
+		for (std::uint32_t count = 2 + Next(5); count > 0; --count)
+		{
+			Emit(OP_LDA_ZERO_PAGE, SEQUENCE_ADDRESS);
+
+			std::size_t skip = 0;
+			switch (Next(3))
+			{
+			case 0:
+				Emit(OP_AND_IMMEDIATE, static_cast<std::uint8_t>(1 << Next(8)));
+				skip = EmitBranchForward(BRANCHES_ON_ZERO[Next(2)]);
+				break;
+			case 1:
+				Emit(OP_CMP_IMMEDIATE, static_cast<std::uint8_t>(Next(0x100)));
+				skip = EmitBranchForward(BRANCHES_ON_CARRY[Next(2)]);
+				break;
+			default:
+				Emit(OP_EOR_IMMEDIATE, static_cast<std::uint8_t>(Next(0x100)));
+				skip = EmitBranchForward(BRANCHES_ON_SIGN[Next(2)]);
+				break;
+			}
+
+			for (std::uint32_t skipped = 1 + Next(3); skipped > 0; --skipped)
+			{
+				EmitAluInstruction();
+			}
+
+			PatchBranch(skip);
+		}
+	}
+	while (HasRoomFor(MAX_PIECE_SIZE));
+
+	EmitAbsolute(OP_JMP_ABSOLUTE, start);
+}
+
+void nes::RomGenerator::WriteCalls()
+{
+	// Jump over the subroutines to the main loop, which comes last
+	std::size_t mainJump = Program.size() + 1;
+	EmitAbsolute(OP_JMP_ABSOLUTE, 0x0000);
+
+	// Subroutines are split into levels by their position and only call
+	// subroutines of a later level, so calls never nest deeper than the number
+	// of levels. A quarter of the program is left for the main loop
+	std::size_t subroutineStart = Program.size();
+	std::size_t subroutineLimit = ProgramLimit - (ProgramLimit - subroutineStart) / 4;
+	std::size_t lastLevel = CALL_LEVEL_COUNT - 1;
+
+	std::vector<std::uint16_t> subroutines;
+	std::vector<std::size_t> levels;
+
+	// Positions of JSR operands along with the level of the calling
+	// subroutine, filled in once every subroutine is known
+	std::vector<std::pair<std::size_t, std::size_t>> nestedCalls;
+
+	do
+	{
+		std::size_t used = (Program.size() - subroutineStart) * CALL_LEVEL_COUNT;
+		std::size_t available = std::max<std::size_t>(subroutineLimit - subroutineStart, 1);
+
+		subroutines.push_back(GetCurrentAddress());
+		levels.push_back(std::min(used / available, lastLevel));
+
+		// At most 2 * 8 + 3 + 2 * 8 + 1 bytes
+		for (std::uint32_t count = 1 + Next(8); count > 0; --count)
+		{
+			EmitAluInstruction();
+		}
+
+		if (levels.back() != lastLevel && Next(2))
+		{
+			nestedCalls.emplace_back(Program.size() + 1, levels.back());
+			EmitAbsolute(OP_JSR, 0x0000);
+
+			for (std::uint32_t count = Next(8); count > 0; --count)
+			{
+				EmitAluInstruction();
+			}
+		}
+
+		Emit(OP_RTS);
+	}
+	while (Program.size() + MAX_PIECE_SIZE <= subroutineLimit || levels.back() != lastLevel);
+
+	for (const auto& call : nestedCalls)
+	{
+		std::size_t calleeStart = 0;
+		while (levels[calleeStart] <= call.second)
+		{
+			++calleeStart;
+		}
+
+		std::uint16_t callee = subroutines[calleeStart + Next(static_cast<std::uint32_t>(subroutines.size() - calleeStart))];
+		Program[call.first] = static_cast<std::uint8_t>(callee);
+		Program[call.first + 1] = static_cast<std::uint8_t>(callee >> 8);
+	}
+
+	std::uint16_t start = GetCurrentAddress();
+	Program[mainJump] = static_cast<std::uint8_t>(start);
+	Program[mainJump + 1] = static_cast<std::uint8_t>(start >> 8);
+
+	do
+	{
+		EmitAbsolute(OP_JSR, subroutines[Next(static_cast<std::uint32_t>(subroutines.size()))]);
+
+		if (Next(2))
+		{
+			EmitAluInstruction();
+		}
+	}
+	while (HasRoomFor(MAX_PIECE_SIZE));
+
+	EmitAbsolute(OP_JMP_ABSOLUTE, start);
+}
+
+void nes::RomGenerator::WriteStackCode()
+{
+	std::uint16_t start = GetCurrentAddress();
+
+	do
+	{
+		// Pushes can be undone through TXS as well, as long as X survives
+		bool restoresPointer = (Next(4) == 0);
+		if (restoresPointer)
+		{
+			Emit(OP_TSX);
+		}
+
+		// At most 6 * (2 + 1 + 2 + 2 + 1 + 2) bytes
+		std::vector<bool> pushedFlags;
+		for (std::uint32_t depth = 1 + Next(6); depth > 0; --depth)
+		{
+			pushedFlags.push_back(Next(3) == 0);
+
+			if (pushedFlags.back())
+			{
+				Emit(Next(2) ? OP_CLC : OP_SEC);
+				Emit(OP_PHP);
+			}
+			else
+			{
+				Emit(OP_LDA_IMMEDIATE, static_cast<std::uint8_t>(Next(0x100)));
+				Emit(OP_PHA);
+			}
+
+			if (Next(2))
+			{
+				EmitAluInstruction();
+			}
+		}
+
+		if (restoresPointer && Next(2))
+		{
+			Emit(OP_TXS);
+			continue;
+		}
+
+		for (auto flags = pushedFlags.rbegin(); flags != pushedFlags.rend(); ++flags)
+		{
+			if (*flags)
+			{
+				Emit(OP_PLP);
+			}
+			else
+			{
+				Emit(OP_PLA);
+
+				if (Next(2))
+				{
+					Emit(OP_TAY);
+				}
+				else
+				{
+					Emit(OP_STA_ZERO_PAGE, static_cast<std::uint8_t>(Next(SCRATCH_SIZE)));
+				}
+			}
+		}
+	}
+	while (HasRoomFor(MAX_PIECE_SIZE));
+
+	EmitAbsolute(OP_JMP_ABSOLUTE, start);
+}
+
+std::uint16_t nes::RomGenerator::GetCurrentAddress() const
+{
+	return static_cast<std::uint16_t>(PROGRAM_ADDRESS + Program.size());
+}
+
+bool nes::RomGenerator::HasRoomFor(std::size_t size) const
+{
+	// Leave room for the jump back at the end
+	return (Program.size() + size + 3 <= ProgramLimit);
+}
+
+std::uint32_t nes::RomGenerator::Next(std::uint32_t count)
+{
+	return static_cast<std::uint32_t>(Random() % count);
+}
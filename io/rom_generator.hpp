@@ -0,0 +1,198 @@
+#ifndef NES_ROM_GENERATOR_HPP
+#define NES_ROM_GENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace nes
+{
+	/**
+	 * Builds synthetic iNES images that stress a single kind of 6502 code, as
+	 * redistributable inputs for benchmarks
+	 *
+	 * Every program starts at the reset vector, sets up the stack and zero
+	 * page, and then runs its workload in an endless loop. Programs only write
+	 * to the 2 KB of internal RAM, keep the stack balanced and stay away from
+	 * BRK, RTI and the emulator's non-standard flag behavior, so they never
+	 * jam and run the same on every backend.
+	 *
+	 * The same workload, size and seed always produce the exact same image on
+	 * every platform. std::mt19937_64 is fully specified by the standard, its
+	 * distributions are not, so raw numbers are used throughout.
+	 */
+	class RomGenerator
+	{
+	public:
+		/**
+		 * Kinds of code a program can consist of
+		 */
+		enum class Workload
+		{
+			AluLoop,	// Tight counted loops of register arithmetic
+			MemoryCopy,	// Indexed and indirect copy loops between tables
+			Branches,	// Data-dependent branches driven by a pseudo-random sequence
+			Calls,		// Chains of nested JSR / RTS
+			Stack		// Balanced sequences of PHA, PHP, PLA, PLP, TSX and TXS
+		};
+
+		/** Every workload, in the order they are listed by tools */
+		static constexpr Workload WORKLOADS[] =
+		{
+			Workload::AluLoop,
+			Workload::MemoryCopy,
+			Workload::Branches,
+			Workload::Calls,
+			Workload::Stack
+		};
+
+		/** Largest number of workload bytes a program can hold */
+		static constexpr std::size_t MAX_PROGRAM_SIZE = 0x7000;
+
+	public:
+		/**
+		 * Create a new generator
+		 * @param	seed	Seed of every random choice
+		 */
+		explicit RomGenerator(std::uint64_t seed);
+
+		/**
+		 * Generate a complete iNES image
+		 * @param	workload		Kind of code to generate
+		 * @param	programSize		Approximate number of bytes of workload code,
+		 *							limited to MAX_PROGRAM_SIZE
+		 * @return	Bytes of the iNES file, mapper 0 with one or two 16 KB
+		 *			PRG-ROM banks
+		 */
+		std::vector<std::uint8_t> Generate(Workload workload, std::size_t programSize);
+
+		/**
+		 * Retrieve the name of a workload, as accepted by ParseWorkloadName
+		 * @param	workload	Workload to name
+		 * @return	"alu", "memcpy", "branches", "calls" or "stack"
+		 */
+		static std::string_view GetWorkloadName(Workload workload);
+
+		/**
+		 * Look up a workload by its name
+		 * @param	name		Name of the workload
+		 * @param	workload	Set to the workload when the name is known
+		 * @return	True when the name is known
+		 */
+		static bool ParseWorkloadName(std::string_view name, Workload& workload);
+
+	private:
+		/**
+		 * Append a single-byte instruction
+		 * @param	opCode	Op-code to append
+		 */
+		void Emit(std::uint8_t opCode);
+
+		/**
+		 * Append an instruction with an 8-bit operand
+		 * @param	opCode	Op-code to append
+		 * @param	operand	Immediate value, zero page address or branch offset
+		 */
+		void Emit(std::uint8_t opCode, std::uint8_t operand);
+
+		/**
+		 * Append an instruction with a 16-bit operand
+		 * @param	opCode	Op-code to append
+		 * @param	address	Absolute address
+		 */
+		void EmitAbsolute(std::uint8_t opCode, std::uint16_t address);
+
+		/**
+		 * Append a branch back to an earlier address
+		 * @param	opCode	Op-code of the branch
+		 * @param	target	Address to branch to, at most 128 bytes back
+		 */
+		void EmitBranchBack(std::uint8_t opCode, std::uint16_t target);
+
+		/**
+		 * Append a branch that skips ahead, the offset is filled in by
+		 * PatchBranch once the target is known
+		 * @param	opCode	Op-code of the branch
+		 * @return	Position of the offset in the program
+		 */
+		std::size_t EmitBranchForward(std::uint8_t opCode);
+
+		/**
+		 * Point a forward branch at the current address
+		 * @param	offsetPosition	Position returned by EmitBranchForward
+		 */
+		void PatchBranch(std::size_t offsetPosition);
+
+		/**
+		 * Append a random register operation that leaves X alone
+		 */
+		void EmitAluInstruction();
+
+		/**
+		 * Append counted loops of register arithmetic, followed by a jump back
+		 * to the first loop
+		 */
+		void WriteAluLoops();
+
+		/**
+		 * Append copy loops between the data table and RAM, followed by a jump
+		 * back to the first loop
+		 */
+		void WriteMemoryCopies();
+
+		/**
+		 * Append tests on a pseudo-random sequence that skip short pieces of
+		 * code, followed by a jump back to the first test
+		 */
+		void WriteBranches();
+
+		/**
+		 * Append subroutines that call each other at most four levels deep, and
+		 * a main loop that calls them in random order
+		 */
+		void WriteCalls();
+
+		/**
+		 * Append balanced sequences of pushes and pulls, followed by a jump back
+		 * to the first sequence
+		 */
+		void WriteStackCode();
+
+		/**
+		 * Retrieve the address the next appended byte ends up at
+		 * @return	Current address
+		 */
+		std::uint16_t GetCurrentAddress() const;
+
+		/**
+		 * Check whether another piece of code of the given size still fits
+		 * within the program size
+		 * @param	size	Size of the piece of code in bytes
+		 * @return	True when it fits
+		 */
+		bool HasRoomFor(std::size_t size) const;
+
+		/**
+		 * Draw a random number
+		 * @param	count	Number of possible values
+		 * @return	Number from 0 up to, but not including, count
+		 */
+		std::uint32_t Next(std::uint32_t count);
+
+	private:
+		std::mt19937_64 Random;
+
+		// PRG-ROM being generated, mapped at 0x8000
+		std::vector<std::uint8_t> Program;
+
+		// Workload code ends at this position
+		std::size_t ProgramLimit;
+
+		// 256 random bytes in ROM, copied to RAM at startup
+		std::uint16_t TableAddress;
+	};
+}
+
+#endif //! NES_ROM_GENERATOR_HPP
@@ -0,0 +1,93 @@
+#include "save_state.hpp"
+#include "mapped_file.hpp"
+#include "cpu/cpu.hpp"
+#include "ram/ram.hpp"
+#include "utility/bit_tools.hpp"
+
+#include <algorithm>	// std::copy / std::equal
+#include <fstream>
+#include <iterator>		// std::begin / std::end
+#include <string>
+
+namespace
+{
+	/**
+	 * Calculate the number of bytes that follow the header
+	 * @param	ramRef	RAM whose size determines the size of the state
+	 * @return	Size of the state without the header
+	 */
+	std::size_t GetPayloadSize(const nes::RAM& ramRef)
+	{
+		return nes::CPU::STATE_SIZE + ramRef.GetSize();
+	}
+}
+
+std::vector<std::uint8_t> nes::SaveState::Create(const CPU& cpuRef, const RAM& ramRef)
+{
+	std::size_t payloadSize = GetPayloadSize(ramRef);
+	std::vector<std::uint8_t> state(SaveStateFormat::HEADER_SIZE + payloadSize);
+
+	std::uint8_t* header = state.data();
+	std::copy(std::begin(SaveStateFormat::MAGIC), std::end(SaveStateFormat::MAGIC), header);
+	WriteLittleEndian(header + 8, SaveStateFormat::VERSION, 4);
+	WriteLittleEndian(header + 12, payloadSize, 4);
+
+	std::uint8_t* payload = header + SaveStateFormat::HEADER_SIZE;
+	cpuRef.WriteState(payload);
+	ramRef.WriteState(payload + CPU::STATE_SIZE);
+
+	return state;
+}
+
+bool nes::SaveState::Restore(CPU& cpuRef, RAM& ramRef, const std::uint8_t* data, std::size_t size)
+{
+	if (data == nullptr || size < SaveStateFormat::HEADER_SIZE)
+	{
+		return false;
+	}
+
+	if (!std::equal(std::begin(SaveStateFormat::MAGIC), std::end(SaveStateFormat::MAGIC), data))
+	{
+		return false;
+	}
+
+	std::size_t payloadSize = GetPayloadSize(ramRef);
+
+	if (ReadLittleEndian(data + 8, 4) != SaveStateFormat::VERSION ||
+		ReadLittleEndian(data + 12, 4) != payloadSize ||
+		size - SaveStateFormat::HEADER_SIZE < payloadSize)
+	{
+		return false;
+	}
+
+	const std::uint8_t* payload = data + SaveStateFormat::HEADER_SIZE;
+	cpuRef.ReadState(payload);
+	ramRef.ReadState(payload + CPU::STATE_SIZE);
+
+	return true;
+}
+
+bool nes::SaveState::WriteToDisk(std::string_view path, const CPU& cpuRef, const RAM& ramRef)
+{
+	std::ofstream file(std::string(path), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	std::vector<std::uint8_t> state = Create(cpuRef, ramRef);
+	file.write(reinterpret_cast<const char*>(state.data()), state.size());
+
+	return file.good();
+}
+
+bool nes::SaveState::LoadFromDisk(std::string_view path, CPU& cpuRef, RAM& ramRef)
+{
+	MappedFile file;
+	if (!file.Open(path))
+	{
+		return false;
+	}
+
+	return Restore(cpuRef, ramRef, file.GetData(), file.GetSize());
+}
@@ -0,0 +1,86 @@
+#ifndef NES_SAVE_STATE_HPP
+#define NES_SAVE_STATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace nes
+{
+	class CPU;
+	class RAM;
+
+	/**
+	 * Binary save state layout
+	 *
+	 * The file starts with a 16-byte header: the magic bytes "NESSTATE", followed
+	 * by the format version and the number of bytes that follow the header (both
+	 * little-endian 32-bit).
+	 *
+	 * The header is followed by the CPU state as written by CPU::WriteState, and
+	 * the writable memory as written by RAM::WriteState. Every block has a
+	 * fixed size, so a state is restored with a couple of plain copies.
+	 */
+	namespace SaveStateFormat
+	{
+		/** Magic bytes at the start of every save state */
+		constexpr char MAGIC[8] = { 'N', 'E', 'S', 'S', 'T', 'A', 'T', 'E' };
+
+		/** Version of the format written by SaveState, bump it whenever the layout changes */
+		constexpr std::uint32_t VERSION = 2;
+
+		/** Size of the header in bytes */
+		constexpr std::size_t HEADER_SIZE = 16;
+	}
+
+	/**
+	 * Captures and restores the state of the CPU and the RAM
+	 */
+	class SaveState
+	{
+	public:
+		/**
+		 * Capture the current state
+		 * @param	cpuRef	CPU to capture
+		 * @param	ramRef	RAM to capture
+		 * @return	Save state, including the header
+		 */
+		static std::vector<std::uint8_t> Create(const CPU& cpuRef, const RAM& ramRef);
+
+		/**
+		 * Restore a state captured by Create
+		 * Nothing is modified unless the state is valid
+		 * @param	cpuRef	CPU to restore
+		 * @param	ramRef	RAM to restore
+		 * @param	data	Save state, including the header
+		 * @param	size	Size of the save state in bytes
+		 * @return	True when the state was restored, false when it is not a
+		 *			save state of this version
+		 */
+		static bool Restore(CPU& cpuRef, RAM& ramRef, const std::uint8_t* data, std::size_t size);
+
+		/**
+		 * Capture the current state and write it to a file, overwriting any
+		 * existing file
+		 * @param	path	Path to the save state file
+		 * @param	cpuRef	CPU to capture
+		 * @param	ramRef	RAM to capture
+		 * @return	True when the file was written, false otherwise
+		 */
+		static bool WriteToDisk(std::string_view path, const CPU& cpuRef, const RAM& ramRef);
+
+		/**
+		 * Restore a state from a file
+		 * The file is mapped into memory and copied straight into the CPU and
+		 * the RAM, without reading it into a buffer first
+		 * @param	path	Path to the save state file
+		 * @param	cpuRef	CPU to restore
+		 * @param	ramRef	RAM to restore
+		 * @return	True when the state was restored, false otherwise
+		 */
+		static bool LoadFromDisk(std::string_view path, CPU& cpuRef, RAM& ramRef);
+	};
+}
+
+#endif //! NES_SAVE_STATE_HPP
@@ -0,0 +1,186 @@
+#include "mapper.hpp"
+#include "mapper_axrom.hpp"
+#include "mapper_cnrom.hpp"
+#include "mapper_mmc1.hpp"
+#include "mapper_mmc3.hpp"
+#include "mapper_nrom.hpp"
+#include "mapper_uxrom.hpp"
+#include "io/rom_file.hpp"
+#include "ram/ram.hpp"
+
+#include <algorithm>	// std::copy / std::max
+
+namespace
+{
+	/**
+	 * Wrap a bank index around the number of banks
+	 * @param	bank		Index of the bank, negative values count from the end
+	 * @param	bankCount	Number of banks, at least one
+	 * @return	Index between zero and bankCount
+	 */
+	std::size_t WrapBank(std::int32_t bank, std::size_t bankCount)
+	{
+		std::int64_t count = static_cast<std::int64_t>(bankCount);
+		return static_cast<std::size_t>(((bank % count) + count) % count);
+	}
+}
+
+std::unique_ptr<nes::Mapper> nes::Mapper::Create(const RomFile& romFile, RAM& ramRef)
+{
+	std::size_t prgRomSize = romFile.GetNumberOfRomBanks() * static_cast<std::size_t>(RomFile::ROM_BANK_SIZE);
+	std::size_t chrRomSize = romFile.GetNumberOfVRomBanks() * static_cast<std::size_t>(RomFile::VROM_BANK_SIZE);
+
+	// Spans are cut short when the file is
+	if (prgRomSize == 0 || romFile.GetPrgRom().Size != prgRomSize || romFile.GetChrRom().Size != chrRomSize)
+	{
+		return nullptr;
+	}
+
+	std::unique_ptr<Mapper> mapper;
+	switch (romFile.GetRomMapperTypeId())
+	{
+	case MapperNrom::ID:	mapper = std::make_unique<MapperNrom>(romFile, ramRef);		break;
+	case MapperMmc1::ID:	mapper = std::make_unique<MapperMmc1>(romFile, ramRef);		break;
+	case MapperUxRom::ID:	mapper = std::make_unique<MapperUxRom>(romFile, ramRef);	break;
+	case MapperCnRom::ID:	mapper = std::make_unique<MapperCnRom>(romFile, ramRef);	break;
+	case MapperMmc3::ID:	mapper = std::make_unique<MapperMmc3>(romFile, ramRef);		break;
+	case MapperAxRom::ID:	mapper = std::make_unique<MapperAxRom>(romFile, ramRef);	break;
+	default:				return nullptr;
+	}
+
+	mapper->Reset();
+	return mapper;
+}
+
+std::string_view nes::Mapper::GetMapperName(std::uint8_t mapperId)
+{
+	switch (mapperId)
+	{
+	case MapperNrom::ID:	return "NROM";
+	case MapperMmc1::ID:	return "MMC1";
+	case MapperUxRom::ID:	return "UxROM";
+	case MapperCnRom::ID:	return "CNROM";
+	case MapperMmc3::ID:	return "MMC3";
+	case MapperAxRom::ID:	return "AxROM";
+	default:				return "unknown";
+	}
+}
+
+nes::Mapper::Mapper(const RomFile& romFile, RAM& ramRef, std::uint8_t mapperId, std::size_t registerCount) :
+	Registers(registerCount, 0),
+	RamRef(ramRef),
+	MapperId(mapperId),
+	PrgRom(romFile.GetPrgRom().Data),
+	PrgRomSize(romFile.GetPrgRom().Size),
+	ChrMemory(romFile.GetChrRom().Data),
+	ChrSize(romFile.GetChrRom().Size),
+	ChrPages{},
+	ChrWritePages{}
+{
+	if (ChrSize == 0)
+	{
+		// Boards without CHR-ROM come with 8 KB of CHR-RAM instead
+		ChrRam.resize(CHR_SIZE, Byte());
+		ChrMemory = ChrRam.data();
+		ChrSize = ChrRam.size();
+	}
+
+	if (romFile.UseFourScreenVRam())
+	{
+		DefaultMirroring = Mirroring::FourScreen;
+	}
+	else
+	{
+		DefaultMirroring = (romFile.GetNametableMirroringType() == RomFile::MirroringType::Horizontal) ? Mirroring::Horizontal : Mirroring::Vertical;
+	}
+
+	CurrentMirroring = DefaultMirroring;
+}
+
+void nes::Mapper::Reset()
+{
+	ResetRegisters();
+	CurrentMirroring = DefaultMirroring;
+	UpdateBanks();
+}
+
+std::uint8_t nes::Mapper::Read(std::uint16_t)
+{
+	return 0;
+}
+
+nes::Mapper::Mirroring nes::Mapper::GetMirroring() const
+{
+	return CurrentMirroring;
+}
+
+std::uint8_t nes::Mapper::GetMapperId() const
+{
+	return MapperId;
+}
+
+std::size_t nes::Mapper::GetStateSize() const
+{
+	return 1 + Registers.size() + ChrRam.size();
+}
+
+void nes::Mapper::WriteState(std::uint8_t* destination) const
+{
+	static_assert(sizeof(Byte) == 1, "CHR-RAM is copied as raw bytes");
+
+	destination[0] = static_cast<std::uint8_t>(CurrentMirroring);
+	std::copy(Registers.begin(), Registers.end(), destination + 1);
+
+	const std::uint8_t* chrRam = reinterpret_cast<const std::uint8_t*>(ChrRam.data());
+	std::copy(chrRam, chrRam + ChrRam.size(), destination + 1 + Registers.size());
+}
+
+void nes::Mapper::ReadState(const std::uint8_t* source)
+{
+	CurrentMirroring = static_cast<Mirroring>(source[0]);
+	std::copy(source + 1, source + 1 + Registers.size(), Registers.begin());
+	std::copy(source + 1 + Registers.size(), source + GetStateSize(), reinterpret_cast<std::uint8_t*>(ChrRam.data()));
+
+	UpdateBanks();
+}
+
+void nes::Mapper::MapPrgBank(std::uint16_t address, std::size_t bankSize, std::int32_t bank)
+{
+	// Windows larger than the entire ROM show the ROM repeatedly, so they are
+	// mapped in chunks of the smallest bank size
+	std::size_t bankStart = WrapBank(bank, std::max<std::size_t>(PrgRomSize / bankSize, 1)) * bankSize;
+
+	for (std::size_t offset = 0; offset < bankSize; offset += PRG_BANK_SIZE)
+	{
+		const Byte* chunk = PrgRom + (bankStart + offset) % PrgRomSize;
+		RamRef.MapReadOnlyMemory(static_cast<std::uint8_t>((address + offset) >> 8), PRG_BANK_SIZE / RAM::PAGE_SIZE, chunk, this);
+	}
+}
+
+void nes::Mapper::MapChrBank(std::uint16_t address, std::size_t bankSize, std::int32_t bank)
+{
+	std::size_t bankStart = WrapBank(bank, std::max<std::size_t>(ChrSize / bankSize, 1)) * bankSize;
+	Byte* chrRam = ChrRam.empty() ? nullptr : ChrRam.data();
+
+	for (std::size_t offset = 0; offset < bankSize; offset += CHR_BANK_SIZE)
+	{
+		std::size_t slot = ((address + offset) / CHR_BANK_SIZE) % ChrPages.size();
+		std::size_t chrOffset = (bankStart + offset) % ChrSize;
+
+		ChrPages[slot] = ChrMemory + chrOffset;
+		ChrWritePages[slot] = (chrRam != nullptr) ? chrRam + chrOffset : nullptr;
+	}
+}
+
+void nes::Mapper::SetMirroring(Mirroring mirroring)
+{
+	if (DefaultMirroring != Mirroring::FourScreen)
+	{
+		CurrentMirroring = mirroring;
+	}
+}
+
+std::size_t nes::Mapper::GetPrgRomSize() const
+{
+	return PrgRomSize;
+}
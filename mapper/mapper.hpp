@@ -0,0 +1,224 @@
+#ifndef NES_MAPPER_HPP
+#define NES_MAPPER_HPP
+
+#include "ram/memory_handler.hpp"
+#include "utility/bit_tools.hpp"
+#include "utility/literals.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace nes
+{
+	class RAM;
+	class RomFile;
+
+	/**
+	 * Base class of the cartridge boards that decide which parts of the ROM the
+	 * CPU and the PPU see
+	 *
+	 * A mapper never copies ROM data. Switching a PRG bank points pages of the
+	 * RAM page table at another part of the ROM file, switching a CHR bank
+	 * points a 1 KB slot of the pattern tables elsewhere. Writes to the PRG-ROM
+	 * pages land in Write, where the board decodes its registers.
+	 *
+	 * The ROM file has to outlive the mapper.
+	 */
+	class Mapper : public MemoryHandler
+	{
+	public:
+		/**
+		 * Nametable layouts a board can select
+		 */
+		enum class Mirroring
+		{
+			Horizontal,
+			Vertical,
+			SingleScreenLower,
+			SingleScreenUpper,
+			FourScreen
+		};
+
+		/** Smallest PRG bank any board switches, in bytes */
+		static constexpr std::size_t PRG_BANK_SIZE = 8_KB;
+
+		/** Smallest CHR bank any board switches, in bytes */
+		static constexpr std::size_t CHR_BANK_SIZE = 1_KB;
+
+		/** Size of the pattern tables seen by the PPU in bytes */
+		static constexpr std::size_t CHR_SIZE = 8_KB;
+
+	public:
+		/**
+		 * Create the mapper a ROM asks for, in its power-on state
+		 * @param	romFile		ROM to map, has to outlive the mapper
+		 * @param	ramRef		Memory whose PRG-ROM pages the mapper controls
+		 * @return	Mapper of the ROM, or nullptr when the board is not supported
+		 *			or the file is shorter than its header claims
+		 */
+		static std::unique_ptr<Mapper> Create(const RomFile& romFile, RAM& ramRef);
+
+		/**
+		 * Retrieve the name of a board
+		 * @param	mapperId	iNES mapper number
+		 * @return	Name of the board, "unknown" when it is not supported
+		 */
+		static std::string_view GetMapperName(std::uint8_t mapperId);
+
+		Mapper(const Mapper&)				= delete;
+		Mapper& operator=(const Mapper&)	= delete;
+		~Mapper() override					= default;
+
+		/**
+		 * Put the board back into its power-on state and map its initial banks
+		 */
+		void Reset();
+
+		/**
+		 * PRG-ROM pages are always readable, so nothing else ends up here
+		 * @param	address		Address on the bus
+		 * @return	Zero
+		 */
+		std::uint8_t Read(std::uint16_t address) override;
+
+		/**
+		 * Read a byte from the pattern tables
+		 * @param	address		Address in the pattern tables, 0x0000 - 0x1FFF
+		 * @return	Value of the byte
+		 */
+		Byte ReadChr(std::uint16_t address) const;
+
+		/**
+		 * Write a byte to the pattern tables, ignored unless the board has
+		 * CHR-RAM
+		 * @param	address		Address in the pattern tables, 0x0000 - 0x1FFF
+		 * @param	value		Value to write
+		 */
+		void WriteChr(std::uint16_t address, Byte value);
+
+		/**
+		 * Retrieve the nametable layout currently selected by the board
+		 * @return	Current mirroring
+		 */
+		Mirroring GetMirroring() const;
+
+		/**
+		 * Retrieve the iNES mapper number of the board
+		 * @return	Mapper number
+		 */
+		std::uint8_t GetMapperId() const;
+
+		/**
+		 * Retrieve the size of the state written by WriteState
+		 * @return	Size of the state in bytes
+		 */
+		std::size_t GetStateSize() const;
+
+		/**
+		 * Copy the registers and the CHR-RAM of the board into a buffer
+		 * @param	destination		Buffer of at least GetStateSize() bytes
+		 */
+		void WriteState(std::uint8_t* destination) const;
+
+		/**
+		 * Restore a state stored by WriteState and map the banks it selects
+		 * @param	source	Buffer of at least GetStateSize() bytes
+		 */
+		void ReadState(const std::uint8_t* source);
+
+	protected:
+		/**
+		 * Create a new mapper, Reset has to be called before it is used
+		 * @param	romFile			ROM to map
+		 * @param	ramRef			Memory whose PRG-ROM pages the mapper controls
+		 * @param	mapperId		iNES mapper number of the board
+		 * @param	registerCount	Number of bytes in Registers
+		 */
+		Mapper(const RomFile& romFile, RAM& ramRef, std::uint8_t mapperId, std::size_t registerCount);
+
+		/**
+		 * Set the registers of the board to their power-on values
+		 */
+		virtual void ResetRegisters() = 0;
+
+		/**
+		 * Map every PRG and CHR bank selected by the registers, pages that
+		 * already show the right bank are left alone
+		 */
+		virtual void UpdateBanks() = 0;
+
+		/**
+		 * Point a window of the CPU address space at a PRG-ROM bank
+		 * @param	address		Start of the window, 0x8000 - 0xFFFF
+		 * @param	bankSize	Size of the window and the bank in bytes
+		 * @param	bank		Index of the bank, wraps around the PRG-ROM size;
+		 *						negative values count from the last bank
+		 */
+		void MapPrgBank(std::uint16_t address, std::size_t bankSize, std::int32_t bank);
+
+		/**
+		 * Point a window of the pattern tables at a CHR bank
+		 * @param	address		Start of the window, 0x0000 - 0x1FFF
+		 * @param	bankSize	Size of the window and the bank in bytes
+		 * @param	bank		Index of the bank, wraps around the CHR size
+		 */
+		void MapChrBank(std::uint16_t address, std::size_t bankSize, std::int32_t bank);
+
+		/**
+		 * Select a nametable layout, ignored when the cartridge provides its
+		 * own four-screen VRAM
+		 * @param	mirroring	Layout to select
+		 */
+		void SetMirroring(Mirroring mirroring);
+
+		/**
+		 * Retrieve the size of the PRG-ROM
+		 * @return	Size in bytes
+		 */
+		std::size_t GetPrgRomSize() const;
+
+	protected:
+		// Raw register values, the only state of a board besides CHR-RAM
+		std::vector<std::uint8_t> Registers;
+
+	private:
+		RAM& RamRef;
+		std::uint8_t MapperId;
+
+		// PRG-ROM inside of the ROM file, always a multiple of PRG_BANK_SIZE
+		const Byte* PrgRom;
+		std::size_t PrgRomSize;
+
+		// CHR-ROM inside of the ROM file, or the CHR-RAM of the board
+		const Byte* ChrMemory;
+		std::size_t ChrSize;
+		std::vector<Byte> ChrRam;
+
+		// Every 1 KB slot of the pattern tables, writable ones only for CHR-RAM
+		std::array<const Byte*, CHR_SIZE / CHR_BANK_SIZE> ChrPages;
+		std::array<Byte*, CHR_SIZE / CHR_BANK_SIZE> ChrWritePages;
+
+		Mirroring DefaultMirroring;
+		Mirroring CurrentMirroring;
+	};
+
+	inline Byte Mapper::ReadChr(std::uint16_t address) const
+	{
+		return ChrPages[(address >> 10) & 0x07][address & 0x3FF];
+	}
+
+	inline void Mapper::WriteChr(std::uint16_t address, Byte value)
+	{
+		Byte* page = ChrWritePages[(address >> 10) & 0x07];
+		if (page != nullptr)
+		{
+			page[address & 0x3FF] = value;
+		}
+	}
+}
+
+#endif //! NES_MAPPER_HPP
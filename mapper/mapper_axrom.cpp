@@ -0,0 +1,31 @@
+#include "mapper_axrom.hpp"
+
+namespace
+{
+	// Index of the only register
+	constexpr std::size_t BANK_SELECT = 0;
+}
+
+nes::MapperAxRom::MapperAxRom(const RomFile& romFile, RAM& ramRef) :
+	Mapper(romFile, ramRef, ID, 1)
+{}
+
+void nes::MapperAxRom::Write(std::uint16_t, std::uint8_t value)
+{
+	Registers[BANK_SELECT] = value;
+	UpdateBanks();
+}
+
+void nes::MapperAxRom::ResetRegisters()
+{
+	Registers[BANK_SELECT] = 0;
+}
+
+void nes::MapperAxRom::UpdateBanks()
+{
+	std::uint8_t bankSelect = Registers[BANK_SELECT];
+
+	MapPrgBank(0x8000, 32_KB, bankSelect & 0x07);
+	MapChrBank(0x0000, 8_KB, 0);
+	SetMirroring(IsNthBitSet(bankSelect, 4) ? Mirroring::SingleScreenUpper : Mirroring::SingleScreenLower);
+}
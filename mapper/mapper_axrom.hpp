@@ -0,0 +1,40 @@
+#ifndef NES_MAPPER_AXROM_HPP
+#define NES_MAPPER_AXROM_HPP
+
+#include "mapper.hpp"
+
+namespace nes
+{
+	/**
+	 * AxROM (mapper 7), a switchable 32 KB PRG bank, 8 KB of CHR-RAM and
+	 * single-screen mirroring selected by software
+	 */
+	class MapperAxRom : public Mapper
+	{
+	public:
+		/** iNES mapper number of the board */
+		static constexpr std::uint8_t ID = 7;
+
+	public:
+		/**
+		 * Create a new AxROM board
+		 * @param	romFile		ROM to map
+		 * @param	ramRef		Memory whose PRG-ROM pages the mapper controls
+		 */
+		MapperAxRom(const RomFile& romFile, RAM& ramRef);
+
+		/**
+		 * Any write to 0x8000 - 0xFFFF selects the PRG bank (bits 0 - 2) and
+		 * the nametable (bit 4)
+		 * @param	address		Address on the bus
+		 * @param	value		Value of the bank register
+		 */
+		void Write(std::uint16_t address, std::uint8_t value) override;
+
+	protected:
+		void ResetRegisters() override;
+		void UpdateBanks() override;
+	};
+}
+
+#endif //! NES_MAPPER_AXROM_HPP
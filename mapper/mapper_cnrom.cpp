@@ -0,0 +1,29 @@
+#include "mapper_cnrom.hpp"
+
+namespace
+{
+	// Index of the only register
+	constexpr std::size_t CHR_BANK = 0;
+}
+
+nes::MapperCnRom::MapperCnRom(const RomFile& romFile, RAM& ramRef) :
+	Mapper(romFile, ramRef, ID, 1)
+{}
+
+void nes::MapperCnRom::Write(std::uint16_t, std::uint8_t value)
+{
+	Registers[CHR_BANK] = value;
+	UpdateBanks();
+}
+
+void nes::MapperCnRom::ResetRegisters()
+{
+	Registers[CHR_BANK] = 0;
+}
+
+void nes::MapperCnRom::UpdateBanks()
+{
+	MapPrgBank(0x8000, 16_KB, 0);
+	MapPrgBank(0xC000, 16_KB, -1);
+	MapChrBank(0x0000, 8_KB, Registers[CHR_BANK]);
+}
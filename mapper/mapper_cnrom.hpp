@@ -0,0 +1,39 @@
+#ifndef NES_MAPPER_CNROM_HPP
+#define NES_MAPPER_CNROM_HPP
+
+#include "mapper.hpp"
+
+namespace nes
+{
+	/**
+	 * CNROM (mapper 3), PRG-ROM laid out like NROM and a switchable 8 KB CHR
+	 * bank
+	 */
+	class MapperCnRom : public Mapper
+	{
+	public:
+		/** iNES mapper number of the board */
+		static constexpr std::uint8_t ID = 3;
+
+	public:
+		/**
+		 * Create a new CNROM board
+		 * @param	romFile		ROM to map
+		 * @param	ramRef		Memory whose PRG-ROM pages the mapper controls
+		 */
+		MapperCnRom(const RomFile& romFile, RAM& ramRef);
+
+		/**
+		 * Any write to 0x8000 - 0xFFFF selects the CHR bank
+		 * @param	address		Address on the bus
+		 * @param	value		Index of the bank
+		 */
+		void Write(std::uint16_t address, std::uint8_t value) override;
+
+	protected:
+		void ResetRegisters() override;
+		void UpdateBanks() override;
+	};
+}
+
+#endif //! NES_MAPPER_CNROM_HPP
@@ -0,0 +1,104 @@
+#include "mapper_mmc1.hpp"
+
+namespace
+{
+	// Indices into the registers of the board
+	constexpr std::size_t SHIFT = 0;
+	constexpr std::size_t SHIFT_COUNT = 1;
+	constexpr std::size_t CONTROL = 2;
+	constexpr std::size_t CHR_BANK_0 = 3;
+	constexpr std::size_t CHR_BANK_1 = 4;
+	constexpr std::size_t PRG_BANK = 5;
+	constexpr std::size_t REGISTER_COUNT = 6;
+
+	// Fixes the last PRG bank at 0xC000, the power-on state of the board
+	constexpr std::uint8_t CONTROL_PRG_MODE_FIX_LAST = 0x0C;
+}
+
+nes::MapperMmc1::MapperMmc1(const RomFile& romFile, RAM& ramRef) :
+	Mapper(romFile, ramRef, ID, REGISTER_COUNT)
+{}
+
+void nes::MapperMmc1::Write(std::uint16_t address, std::uint8_t value)
+{
+	if (IsNthBitSet(value, 7))
+	{
+		Registers[SHIFT] = 0;
+		Registers[SHIFT_COUNT] = 0;
+		Registers[CONTROL] |= CONTROL_PRG_MODE_FIX_LAST;
+		UpdateBanks();
+		return;
+	}
+
+	Registers[SHIFT] |= static_cast<std::uint8_t>((value & 0x01) << Registers[SHIFT_COUNT]);
+	if (++Registers[SHIFT_COUNT] < 5)
+	{
+		return;
+	}
+
+	// 0x8000 control, 0xA000 CHR bank 0, 0xC000 CHR bank 1, 0xE000 PRG bank
+	Registers[CONTROL + ((address >> 13) & 0x03)] = Registers[SHIFT];
+	Registers[SHIFT] = 0;
+	Registers[SHIFT_COUNT] = 0;
+	UpdateBanks();
+}
+
+void nes::MapperMmc1::ResetRegisters()
+{
+	Registers.assign(REGISTER_COUNT, 0);
+	Registers[CONTROL] = CONTROL_PRG_MODE_FIX_LAST;
+}
+
+void nes::MapperMmc1::UpdateBanks()
+{
+	std::uint8_t control = Registers[CONTROL];
+
+	switch (control & 0x03)
+	{
+	case 0:	SetMirroring(Mirroring::SingleScreenLower);	break;
+	case 1:	SetMirroring(Mirroring::SingleScreenUpper);	break;
+	case 2:	SetMirroring(Mirroring::Vertical);			break;
+	case 3:	SetMirroring(Mirroring::Horizontal);		break;
+	}
+
+	// Banks are counted in 16 KB, the upper 256 KB of a SUROM start at bank 16
+	std::int32_t outerBank = 0;
+	std::int32_t lastBank = -1;
+	if (GetPrgRomSize() > 256_KB)
+	{
+		outerBank = IsNthBitSet(Registers[CHR_BANK_0], 4) ? 16 : 0;
+		lastBank = outerBank + 15;
+	}
+
+	std::int32_t prgBank = outerBank + (Registers[PRG_BANK] & 0x0F);
+
+	switch ((control >> 2) & 0x03)
+	{
+	case 0:
+	case 1:
+		// Switch 32 KB at once, ignoring the lowest bit of the bank
+		MapPrgBank(0x8000, 16_KB, prgBank & ~1);
+		MapPrgBank(0xC000, 16_KB, prgBank | 1);
+		break;
+
+	case 2:
+		MapPrgBank(0x8000, 16_KB, outerBank);
+		MapPrgBank(0xC000, 16_KB, prgBank);
+		break;
+
+	case 3:
+		MapPrgBank(0x8000, 16_KB, prgBank);
+		MapPrgBank(0xC000, 16_KB, lastBank);
+		break;
+	}
+
+	if (IsNthBitSet(control, 4))
+	{
+		MapChrBank(0x0000, 4_KB, Registers[CHR_BANK_0]);
+		MapChrBank(0x1000, 4_KB, Registers[CHR_BANK_1]);
+	}
+	else
+	{
+		MapChrBank(0x0000, 8_KB, Registers[CHR_BANK_0] >> 1);
+	}
+}
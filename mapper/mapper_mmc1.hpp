@@ -0,0 +1,45 @@
+#ifndef NES_MAPPER_MMC1_HPP
+#define NES_MAPPER_MMC1_HPP
+
+#include "mapper.hpp"
+
+namespace nes
+{
+	/**
+	 * MMC1 (mapper 1), registers are loaded one bit at a time through a serial
+	 * port at 0x8000 - 0xFFFF and select 16 or 32 KB PRG banks, 4 or 8 KB CHR
+	 * banks and the mirroring
+	 *
+	 * PRG-ROMs of 512 KB (SUROM) use bit 4 of the CHR bank registers to pick
+	 * the 256 KB half the PRG banks come from.
+	 */
+	class MapperMmc1 : public Mapper
+	{
+	public:
+		/** iNES mapper number of the board */
+		static constexpr std::uint8_t ID = 1;
+
+	public:
+		/**
+		 * Create a new MMC1 board
+		 * @param	romFile		ROM to map
+		 * @param	ramRef		Memory whose PRG-ROM pages the mapper controls
+		 */
+		MapperMmc1(const RomFile& romFile, RAM& ramRef);
+
+		/**
+		 * Shift a bit into the serial port, the fifth write stores the value
+		 * in the register selected by bits 13 - 14 of the address
+		 * Setting bit 7 clears the shift register instead
+		 * @param	address		Address on the bus
+		 * @param	value		Value written by the CPU
+		 */
+		void Write(std::uint16_t address, std::uint8_t value) override;
+
+	protected:
+		void ResetRegisters() override;
+		void UpdateBanks() override;
+	};
+}
+
+#endif //! NES_MAPPER_MMC1_HPP
@@ -0,0 +1,138 @@
+#include "mapper_mmc3.hpp"
+
+namespace
+{
+	// Indices into the registers of the board, BANK_DATA is followed by the
+	// eight bank registers R0 - R7
+	constexpr std::size_t BANK_SELECT = 0;
+	constexpr std::size_t BANK_DATA = 1;
+	constexpr std::size_t MIRRORING = 9;
+	constexpr std::size_t IRQ_LATCH = 10;
+	constexpr std::size_t IRQ_COUNTER = 11;
+	constexpr std::size_t IRQ_RELOAD = 12;
+	constexpr std::size_t IRQ_ENABLED = 13;
+	constexpr std::size_t IRQ_ASSERTED = 14;
+	constexpr std::size_t REGISTER_COUNT = 15;
+
+	// Power-on values of R0 - R7, any values work as long as the game sets
+	// its banks before relying on them
+	constexpr std::uint8_t INITIAL_BANKS[8] = { 0, 2, 4, 5, 6, 7, 0, 1 };
+}
+
+nes::MapperMmc3::MapperMmc3(const RomFile& romFile, RAM& ramRef) :
+	Mapper(romFile, ramRef, ID, REGISTER_COUNT)
+{}
+
+void nes::MapperMmc3::Write(std::uint16_t address, std::uint8_t value)
+{
+	bool isOdd = (address & 0x0001) != 0;
+
+	switch (address & 0xE000)
+	{
+	case 0x8000:
+		if (isOdd)
+		{
+			Registers[BANK_DATA + (Registers[BANK_SELECT] & 0x07)] = value;
+		}
+		else
+		{
+			Registers[BANK_SELECT] = value;
+		}
+
+		UpdateBanks();
+		break;
+
+	case 0xA000:
+		// Odd addresses protect PRG-RAM, which is not emulated
+		if (!isOdd)
+		{
+			Registers[MIRRORING] = value & 0x01;
+			UpdateBanks();
+		}
+
+		break;
+
+	case 0xC000:
+		if (isOdd)
+		{
+			Registers[IRQ_COUNTER] = 0;
+			Registers[IRQ_RELOAD] = 1;
+		}
+		else
+		{
+			Registers[IRQ_LATCH] = value;
+		}
+
+		break;
+
+	case 0xE000:
+		Registers[IRQ_ENABLED] = isOdd ? 1 : 0;
+		if (!isOdd)
+		{
+			Registers[IRQ_ASSERTED] = 0;
+		}
+
+		break;
+	}
+}
+
+void nes::MapperMmc3::ClockScanline()
+{
+	if (Registers[IRQ_COUNTER] == 0 || Registers[IRQ_RELOAD] != 0)
+	{
+		Registers[IRQ_COUNTER] = Registers[IRQ_LATCH];
+		Registers[IRQ_RELOAD] = 0;
+	}
+	else
+	{
+		--Registers[IRQ_COUNTER];
+	}
+
+	if (Registers[IRQ_COUNTER] == 0 && Registers[IRQ_ENABLED] != 0)
+	{
+		Registers[IRQ_ASSERTED] = 1;
+	}
+}
+
+bool nes::MapperMmc3::IsIrqAsserted() const
+{
+	return Registers[IRQ_ASSERTED] != 0;
+}
+
+void nes::MapperMmc3::ResetRegisters()
+{
+	Registers.assign(REGISTER_COUNT, 0);
+
+	for (std::size_t i = 0; i < sizeof(INITIAL_BANKS); ++i)
+	{
+		Registers[BANK_DATA + i] = INITIAL_BANKS[i];
+	}
+}
+
+void nes::MapperMmc3::UpdateBanks()
+{
+	std::uint8_t bankSelect = Registers[BANK_SELECT];
+	const std::uint8_t* banks = &Registers[BANK_DATA];
+
+	// Bit 6 swaps the switchable window at 0x8000 with the fixed one at 0xC000
+	std::int32_t swappableBank = banks[6] & 0x3F;
+	bool isPrgSwapped = IsNthBitSet(bankSelect, 6);
+
+	MapPrgBank(0x8000, 8_KB, isPrgSwapped ? -2 : swappableBank);
+	MapPrgBank(0xA000, 8_KB, banks[7] & 0x3F);
+	MapPrgBank(0xC000, 8_KB, isPrgSwapped ? swappableBank : -2);
+	MapPrgBank(0xE000, 8_KB, -1);
+
+	// Bit 7 swaps the 2 KB windows with the 1 KB windows, R0 and R1 ignore
+	// their lowest bit
+	std::uint16_t chrInversion = IsNthBitSet(bankSelect, 7) ? 0x1000 : 0x0000;
+
+	MapChrBank(0x0000 ^ chrInversion, 2_KB, banks[0] >> 1);
+	MapChrBank(0x0800 ^ chrInversion, 2_KB, banks[1] >> 1);
+	MapChrBank(0x1000 ^ chrInversion, 1_KB, banks[2]);
+	MapChrBank(0x1400 ^ chrInversion, 1_KB, banks[3]);
+	MapChrBank(0x1800 ^ chrInversion, 1_KB, banks[4]);
+	MapChrBank(0x1C00 ^ chrInversion, 1_KB, banks[5]);
+
+	SetMirroring((Registers[MIRRORING] != 0) ? Mirroring::Horizontal : Mirroring::Vertical);
+}
@@ -0,0 +1,56 @@
+#ifndef NES_MAPPER_MMC3_HPP
+#define NES_MAPPER_MMC3_HPP
+
+#include "mapper.hpp"
+
+namespace nes
+{
+	/**
+	 * MMC3 (mapper 4), four 8 KB PRG windows of which two are switchable,
+	 * two 2 KB and four 1 KB CHR windows, switchable mirroring and a
+	 * scanline counter that raises IRQs
+	 *
+	 * The scanline counter is clocked through ClockScanline by whoever renders
+	 * the picture. PRG-RAM protection is not emulated, PRG-RAM is always
+	 * readable and writable.
+	 */
+	class MapperMmc3 : public Mapper
+	{
+	public:
+		/** iNES mapper number of the board */
+		static constexpr std::uint8_t ID = 4;
+
+	public:
+		/**
+		 * Create a new MMC3 board
+		 * @param	romFile		ROM to map
+		 * @param	ramRef		Memory whose PRG-ROM pages the mapper controls
+		 */
+		MapperMmc3(const RomFile& romFile, RAM& ramRef);
+
+		/**
+		 * Write one of the registers, selected by the 8 KB window and whether
+		 * the address is even or odd
+		 * @param	address		Address on the bus
+		 * @param	value		Value written by the CPU
+		 */
+		void Write(std::uint16_t address, std::uint8_t value) override;
+
+		/**
+		 * Clock the scanline counter, once per rendered scanline
+		 */
+		void ClockScanline();
+
+		/**
+		 * Check whether the scanline counter is asserting its IRQ
+		 * @return	True until the IRQ gets disabled
+		 */
+		bool IsIrqAsserted() const;
+
+	protected:
+		void ResetRegisters() override;
+		void UpdateBanks() override;
+	};
+}
+
+#endif //! NES_MAPPER_MMC3_HPP
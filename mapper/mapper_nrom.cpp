@@ -0,0 +1,18 @@
+#include "mapper_nrom.hpp"
+
+nes::MapperNrom::MapperNrom(const RomFile& romFile, RAM& ramRef) :
+	Mapper(romFile, ramRef, ID, 0)
+{}
+
+void nes::MapperNrom::Write(std::uint16_t, std::uint8_t)
+{}
+
+void nes::MapperNrom::ResetRegisters()
+{}
+
+void nes::MapperNrom::UpdateBanks()
+{
+	MapPrgBank(0x8000, 16_KB, 0);
+	MapPrgBank(0xC000, 16_KB, -1);
+	MapChrBank(0x0000, 8_KB, 0);
+}
@@ -0,0 +1,39 @@
+#ifndef NES_MAPPER_NROM_HPP
+#define NES_MAPPER_NROM_HPP
+
+#include "mapper.hpp"
+
+namespace nes
+{
+	/**
+	 * NROM (mapper 0), 16 or 32 KB of PRG-ROM and 8 KB of CHR without any
+	 * bank switching, a single 16 KB bank shows up at both 0x8000 and 0xC000
+	 */
+	class MapperNrom : public Mapper
+	{
+	public:
+		/** iNES mapper number of the board */
+		static constexpr std::uint8_t ID = 0;
+
+	public:
+		/**
+		 * Create a new NROM board
+		 * @param	romFile		ROM to map
+		 * @param	ramRef		Memory whose PRG-ROM pages the mapper controls
+		 */
+		MapperNrom(const RomFile& romFile, RAM& ramRef);
+
+		/**
+		 * The board has no registers, writes to ROM are ignored
+		 * @param	address		Address on the bus
+		 * @param	value		Value to write
+		 */
+		void Write(std::uint16_t address, std::uint8_t value) override;
+
+	protected:
+		void ResetRegisters() override;
+		void UpdateBanks() override;
+	};
+}
+
+#endif //! NES_MAPPER_NROM_HPP
@@ -0,0 +1,29 @@
+#include "mapper_uxrom.hpp"
+
+namespace
+{
+	// Index of the only register
+	constexpr std::size_t PRG_BANK = 0;
+}
+
+nes::MapperUxRom::MapperUxRom(const RomFile& romFile, RAM& ramRef) :
+	Mapper(romFile, ramRef, ID, 1)
+{}
+
+void nes::MapperUxRom::Write(std::uint16_t, std::uint8_t value)
+{
+	Registers[PRG_BANK] = value;
+	UpdateBanks();
+}
+
+void nes::MapperUxRom::ResetRegisters()
+{
+	Registers[PRG_BANK] = 0;
+}
+
+void nes::MapperUxRom::UpdateBanks()
+{
+	MapPrgBank(0x8000, 16_KB, Registers[PRG_BANK]);
+	MapPrgBank(0xC000, 16_KB, -1);
+	MapChrBank(0x0000, 8_KB, 0);
+}
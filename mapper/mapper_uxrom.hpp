@@ -0,0 +1,39 @@
+#ifndef NES_MAPPER_UXROM_HPP
+#define NES_MAPPER_UXROM_HPP
+
+#include "mapper.hpp"
+
+namespace nes
+{
+	/**
+	 * UxROM (mapper 2), a switchable 16 KB PRG bank at 0x8000 and the last
+	 * bank fixed at 0xC000, with 8 KB of CHR-RAM
+	 */
+	class MapperUxRom : public Mapper
+	{
+	public:
+		/** iNES mapper number of the board */
+		static constexpr std::uint8_t ID = 2;
+
+	public:
+		/**
+		 * Create a new UxROM board
+		 * @param	romFile		ROM to map
+		 * @param	ramRef		Memory whose PRG-ROM pages the mapper controls
+		 */
+		MapperUxRom(const RomFile& romFile, RAM& ramRef);
+
+		/**
+		 * Any write to 0x8000 - 0xFFFF selects the bank at 0x8000
+		 * @param	address		Address on the bus
+		 * @param	value		Index of the bank
+		 */
+		void Write(std::uint16_t address, std::uint8_t value) override;
+
+	protected:
+		void ResetRegisters() override;
+		void UpdateBanks() override;
+	};
+}
+
+#endif //! NES_MAPPER_UXROM_HPP
@@ -0,0 +1,37 @@
+#ifndef NES_MEMORY_HANDLER_HPP
+#define NES_MEMORY_HANDLER_HPP
+
+#include <cstdint>
+
+namespace nes
+{
+	/**
+	 * Interface for anything on the bus that is not plain memory, such as the
+	 * registers of the PPU, the APU or a mapper
+	 *
+	 * Handlers are attached to whole 256-byte pages of the RAM page table.
+	 * Only accesses to those pages go through a handler, every other page is
+	 * read and written directly.
+	 */
+	class MemoryHandler
+	{
+	public:
+		virtual ~MemoryHandler() = default;
+
+		/**
+		 * Read a byte from one of the pages of the handler
+		 * @param	address		Full address on the bus
+		 * @return	Value on the bus
+		 */
+		virtual std::uint8_t Read(std::uint16_t address) = 0;
+
+		/**
+		 * Write a byte to one of the pages of the handler
+		 * @param	address		Full address on the bus
+		 * @param	value		Value to write
+		 */
+		virtual void Write(std::uint16_t address, std::uint8_t value) = 0;
+	};
+}
+
+#endif //! NES_MEMORY_HANDLER_HPP
@@ -1,68 +1,276 @@
 #include "ram.hpp"
 #include "io/rom_file.hpp"
+#include "mapper/mapper.hpp"
 
-#include <algorithm>	// std::copy
+#include <algorithm>	// std::copy / std::max / std::min
 #include <cstring>
-#include <vector>
+#include <utility>		// std::move
 
-nes::RAM::RAM() :
+namespace
+{
+	// Work RAM is mirrored through the first 8 KB of the address space
+	constexpr std::uint8_t WORK_RAM_FIRST_PAGE = 0x00;
+	constexpr std::size_t WORK_RAM_MIRROR_PAGES = 0x20;
+
+	constexpr std::uint8_t PRG_RAM_FIRST_PAGE = 0x60;
+}
+
+nes::RAM::RAM(Layout layout) :
 	FIRST_ROM_BANK_ADDRESS(0x8000),
 	SECOND_ROM_BANK_ADDRESS(FIRST_ROM_BANK_ADDRESS + RomFile::ROM_BANK_SIZE),
-	STACK_START_ADDRESS(0x01FF)
+	STACK_START_ADDRESS(0x01FF),
+	MemoryLayout(layout),
+	WorkRam{},
+	PrgRam{},
+	RomGeneration(0)
 {
-	// Initialize the memory to a default known state of zero
-	for (std::size_t i = 0; i < Memory.size(); ++i)
+	ReadPages.fill(nullptr);
+	WritePages.fill(nullptr);
+	Handlers.fill(nullptr);
+
+	// Zero is reserved for "never decoded", so versions start at one
+	PageVersions.fill(1);
+
+	for (std::size_t page = 0; page < PAGE_COUNT; ++page)
 	{
-		Memory[i].value = 0;
+		VersionSlots[page] = static_cast<std::uint8_t>(page);
 	}
-}
 
-nes::Byte nes::RAM::ReadByte(std::uint16_t address) const
-{
-	return Memory[address];
+	if (MemoryLayout == Layout::Flat)
+	{
+		FlatMemory = std::make_unique<Byte[]>(ADDRESS_SPACE_SIZE);
+		MapMemory(0, PAGE_COUNT, FlatMemory.get());
+		return;
+	}
+
+	// Masking the page index with the size of the work RAM resolves the mirrors
+	constexpr std::size_t workRamPageMask = (WORK_RAM_SIZE / PAGE_SIZE) - 1;
+	for (std::size_t page = 0; page < WORK_RAM_MIRROR_PAGES; ++page)
+	{
+		MapMemory(static_cast<std::uint8_t>(WORK_RAM_FIRST_PAGE + page), 1, WorkRam.data() + (page & workRamPageMask) * PAGE_SIZE);
+	}
+
+	MapMemory(PRG_RAM_FIRST_PAGE, PRG_RAM_SIZE / PAGE_SIZE, PrgRam.data());
 }
 
-void nes::RAM::WriteByte(std::uint16_t address, Byte value)
+nes::RAM::~RAM() = default;
+
+bool nes::RAM::StoreRomData(const RomFile& romFile)
 {
-	Memory[address] = value;
+	if (MemoryLayout == Layout::Console)
+	{
+		// The mapper maps its initial banks as soon as it is created
+		std::unique_ptr<Mapper> mapper = Mapper::Create(romFile, *this);
+		if (mapper == nullptr)
+		{
+			return false;
+		}
+
+		ActiveMapper = std::move(mapper);
+		++RomGeneration;
+		return true;
+	}
+
+	RomFile::Span prgRom = romFile.GetPrgRom();
+	if (prgRom.Size < RomFile::ROM_BANK_SIZE)
+	{
+		return false;
+	}
+
+	Byte* memory = FlatMemory.get();
+
+	// Always copy the first ROM bank to the memory array
+	const Byte* firstBankBegin = prgRom.Data;
+	std::copy(firstBankBegin, firstBankBegin + RomFile::ROM_BANK_SIZE, memory + FIRST_ROM_BANK_ADDRESS);
+
+	// A game with a single ROM bank mirrors it, boards with more banks start
+	// out with the last one at 0xC000
+	const Byte* lastBankBegin = prgRom.Data + (prgRom.Size / RomFile::ROM_BANK_SIZE - 1) * RomFile::ROM_BANK_SIZE;
+	std::copy(lastBankBegin, lastBankBegin + RomFile::ROM_BANK_SIZE, memory + SECOND_ROM_BANK_ADDRESS);
+
+	// Any code decoded from the previous banks is no longer valid
+	MarkPagesAsModified(FIRST_ROM_BANK_ADDRESS, 2 * RomFile::ROM_BANK_SIZE);
+	++RomGeneration;
+	return true;
 }
 
-void nes::RAM::ClearByte(std::uint16_t address)
+nes::Mapper* nes::RAM::GetMapper() const
 {
-	Memory[address].value = 0;
+	return ActiveMapper.get();
 }
 
-void nes::RAM::StoreRomData(const RomFile& romFile)
+void nes::RAM::WriteState(std::uint8_t* destination) const
 {
-	std::uint8_t numRomBanks = romFile.GetNumberOfRomBanks();
+	static_assert(sizeof(Byte) == 1, "Memory is copied as raw bytes");
 
-	// Retrieve the entire ROM as a byte array
-	const std::vector<Byte>& romDataRef = romFile.GetRaw();
+	if (MemoryLayout == Layout::Flat)
+	{
+		std::memcpy(destination, FlatMemory.get(), ADDRESS_SPACE_SIZE);
+		return;
+	}
 
-	auto firstBankStart = romFile.GetFirstRomBankByteIndex();
-	auto firstBankStop = firstBankStart + RomFile::ROM_BANK_SIZE;
+	std::memcpy(destination, WorkRam.data(), WorkRam.size());
+	std::memcpy(destination + WorkRam.size(), PrgRam.data(), PrgRam.size());
 
-	// Always copy the first ROM bank to the memory array
-	auto firstBankBegin = romDataRef.begin() + firstBankStart;
-	auto firstBankEnd = romDataRef.begin() + firstBankStop;
-	std::copy(firstBankBegin, firstBankEnd, &Memory[0] + FIRST_ROM_BANK_ADDRESS);
+	if (ActiveMapper != nullptr)
+	{
+		ActiveMapper->WriteState(destination + WorkRam.size() + PrgRam.size());
+	}
+}
 
-	if (numRomBanks == 1)
+void nes::RAM::ReadState(const std::uint8_t* source)
+{
+	if (MemoryLayout == Layout::Flat)
 	{
-		// If the game only uses one ROM bank, mirror the existing bank
-		std::copy(firstBankBegin, firstBankEnd, &Memory[0] + SECOND_ROM_BANK_ADDRESS);
+		std::memcpy(FlatMemory.get(), source, ADDRESS_SPACE_SIZE);
 	}
 	else
 	{
-		auto secondBankStart = romFile.GetSecondRomBankByteIndex();
-		auto secondBankEnd = secondBankStart + RomFile::ROM_BANK_SIZE;
+		std::memcpy(WorkRam.data(), source, WorkRam.size());
+		std::memcpy(PrgRam.data(), source + WorkRam.size(), PrgRam.size());
 
-		// Copy the second ROM bank into memory
-		std::copy(romDataRef.begin() + secondBankStart, romDataRef.begin() + secondBankEnd, &Memory[0] + SECOND_ROM_BANK_ADDRESS);
+		if (ActiveMapper != nullptr)
+		{
+			ActiveMapper->ReadState(source + WorkRam.size() + PrgRam.size());
+		}
 	}
+
+	// Any code decoded from the previous contents is no longer valid
+	MarkPagesAsModified(0, ADDRESS_SPACE_SIZE);
 }
 
 std::size_t nes::RAM::GetSize() const
 {
-	return Memory.size();
+	if (MemoryLayout == Layout::Flat)
+	{
+		return ADDRESS_SPACE_SIZE;
+	}
+
+	return WorkRam.size() + PrgRam.size() + ((ActiveMapper != nullptr) ? ActiveMapper->GetStateSize() : 0);
+}
+
+nes::RAM::Layout nes::RAM::GetLayout() const
+{
+	return MemoryLayout;
+}
+
+void nes::RAM::MapMemory(std::uint8_t firstPage, std::size_t pageCount, Byte* memory)
+{
+	pageCount = ClampPageCount(firstPage, pageCount);
+
+	for (std::size_t i = 0; i < pageCount; ++i)
+	{
+		std::size_t page = firstPage + i;
+		Byte* pageMemory = memory + i * PAGE_SIZE;
+
+		ReadPages[page] = pageMemory;
+		WritePages[page] = pageMemory;
+		Handlers[page] = nullptr;
+
+		// Mirrors of writable memory have to share their version
+		std::size_t slot = page;
+		for (std::size_t other = 0; other < PAGE_COUNT; ++other)
+		{
+			if (other != page && WritePages[other] == pageMemory)
+			{
+				slot = VersionSlots[other];
+				break;
+			}
+		}
+
+		SetVersionSlot(page, slot);
+	}
+}
+
+void nes::RAM::MapReadOnlyMemory(std::uint8_t firstPage, std::size_t pageCount, const Byte* memory, MemoryHandler* writeHandler)
+{
+	pageCount = ClampPageCount(firstPage, pageCount);
+
+	for (std::size_t i = 0; i < pageCount; ++i)
+	{
+		std::size_t page = firstPage + i;
+		const Byte* pageMemory = memory + i * PAGE_SIZE;
+
+		if (ReadPages[page] == pageMemory && WritePages[page] == nullptr && Handlers[page] == writeHandler)
+		{
+			continue;
+		}
+
+		ReadPages[page] = pageMemory;
+		WritePages[page] = nullptr;
+		Handlers[page] = writeHandler;
+		SetVersionSlot(page, page);
+	}
+}
+
+void nes::RAM::MapHandler(std::uint8_t firstPage, std::size_t pageCount, MemoryHandler* handler)
+{
+	pageCount = ClampPageCount(firstPage, pageCount);
+
+	for (std::size_t i = 0; i < pageCount; ++i)
+	{
+		ReadPages[firstPage + i] = nullptr;
+		WritePages[firstPage + i] = nullptr;
+		Handlers[firstPage + i] = handler;
+		SetVersionSlot(firstPage + i, firstPage + i);
+	}
+}
+
+nes::Byte nes::RAM::ReadFromHandler(std::uint16_t address) const
+{
+	Byte value;
+	value.value = 0;
+
+	MemoryHandler* handler = Handlers[address >> 8];
+	if (handler != nullptr)
+	{
+		value.value = handler->Read(address);
+	}
+
+	return value;
+}
+
+void nes::RAM::WriteToHandler(std::uint16_t address, Byte value)
+{
+	MemoryHandler* handler = Handlers[address >> 8];
+	if (handler != nullptr)
+	{
+		handler->Write(address, value.value);
+	}
+
+	// Without memory behind the page, the handler may change what it reads
+	// back. Pages with memory are only changed by mapping them elsewhere.
+	if (ReadPages[address >> 8] == nullptr)
+	{
+		BumpPageVersion(address >> 8);
+	}
+}
+
+std::size_t nes::RAM::ClampPageCount(std::uint8_t firstPage, std::size_t pageCount)
+{
+	return std::min(pageCount, PAGE_COUNT - firstPage);
+}
+
+void nes::RAM::MarkPagesAsModified(std::uint16_t address, std::size_t size)
+{
+	if (size == 0)
+	{
+		return;
+	}
+
+	std::size_t firstPage = address >> 8;
+	std::size_t lastPage = (address + size - 1) >> 8;
+
+	for (std::size_t page = firstPage; page <= lastPage && page < PageVersions.size(); ++page)
+	{
+		BumpPageVersion(page);
+	}
+}
+
+void nes::RAM::SetVersionSlot(std::size_t page, std::size_t slot)
+{
+	std::uint32_t version = GetNextPageVersion(std::max(PageVersions[VersionSlots[page]], PageVersions[slot]));
+
+	VersionSlots[page] = static_cast<std::uint8_t>(slot);
+	PageVersions[slot] = version;
 }
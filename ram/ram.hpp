@@ -1,17 +1,63 @@
 #ifndef NES_RAM_HPP
 #define NES_RAM_HPP
 
+#include "memory_handler.hpp"
 #include "utility/bit_tools.hpp"
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
+#include <limits>	// std::numeric_limits
+#include <memory>
 
 namespace nes
 {
+	class Mapper;
 	class RomFile;
 
+	/**
+	 * CPU address space, split into 256 pages of 256 bytes
+	 *
+	 * Every page either points directly at backing memory or at a
+	 * MemoryHandler. Reads and writes to memory pages are a single table
+	 * lookup and pointer dereference, only handler pages pay for a virtual
+	 * call.
+	 *
+	 * The console layout follows the NES memory map: 2 KB of work RAM mirrored
+	 * through $0000-$1FFF, 8 KB of cartridge PRG-RAM at $6000-$7FFF and the
+	 * PRG-ROM of the cartridge at $8000-$FFFF, read straight from the ROM file
+	 * through the banks selected by its mapper.
+	 * Nothing is attached to the I/O registers in between, they read as zero
+	 * and ignore writes.
+	 */
 	class RAM
 	{
+	public:
+		/**
+		 * What the address space is backed by
+		 */
+		enum class Layout
+		{
+			Console,	// Work RAM, PRG-RAM and PRG-ROM as on the NES
+			Flat		// 64 KB of writable memory, for test programs that place
+						// code and vectors anywhere
+		};
+
+		/** Size of a page of the page table in bytes */
+		static constexpr std::size_t PAGE_SIZE = 0x100;
+
+		/** Number of pages in the address space */
+		static constexpr std::size_t PAGE_COUNT = 0x100;
+
+		/** Number of addresses the CPU can access */
+		static constexpr std::size_t ADDRESS_SPACE_SIZE = PAGE_SIZE * PAGE_COUNT;
+
+		/** Size of the internal work RAM of the console in bytes */
+		static constexpr std::size_t WORK_RAM_SIZE = 0x800;
+
+		/** Size of the cartridge PRG-RAM in bytes */
+		static constexpr std::size_t PRG_RAM_SIZE = 0x2000;
+
 	public:
 		/** Starting address of the first ROM bank */
 		const std::uint16_t FIRST_ROM_BANK_ADDRESS;
@@ -24,9 +70,15 @@ namespace nes
 
 	public:
 		/**
-		 * Create a new RAM object
+		 * Create a new RAM object, all memory starts out cleared
+		 * @param	layout	What the address space is backed by
 		 */
-		RAM();
+		explicit RAM(Layout layout = Layout::Console);
+
+		~RAM();
+
+		RAM(const RAM&)				= delete;
+		RAM& operator=(const RAM&)	= delete;
 
 		/**
 		 * Read a byte from memory
@@ -49,20 +101,265 @@ namespace nes
 		void ClearByte(std::uint16_t address);
 
 		/**
-		 * Store a ROM into memory
+		 * Attach a cartridge, its mapper takes control of $8000-$FFFF
+		 * The console layout reads the ROM in place, so the ROM file has to
+		 * outlive the RAM or the next call. The flat layout copies the first
+		 * and the last 16 KB bank and does not switch banks.
 		 * @param	romFile		ROM data to store
+		 * @return	False when the mapper of the ROM is not supported, memory is
+		 *			left untouched in that case
 		 */
-		void StoreRomData(const RomFile& romFile);
+		bool StoreRomData(const RomFile& romFile);
 
 		/**
-		 * Returns the size of the RAM in bytes
+		 * Retrieve the mapper of the attached cartridge
+		 * @return	Mapper, nullptr without a cartridge or in the flat layout
+		 */
+		Mapper* GetMapper() const;
+
+		/**
+		 * Copy all writable memory into a buffer, as used by save states
+		 * ROM is not part of the state, the registers of the mapper are
+		 * @param	destination		Buffer of at least GetSize() bytes
+		 */
+		void WriteState(std::uint8_t* destination) const;
+
+		/**
+		 * Overwrite all writable memory with a state stored by WriteState
+		 * Every page counts as modified afterwards
+		 * @param	source	Buffer of at least GetSize() bytes
+		 */
+		void ReadState(const std::uint8_t* source);
+
+		/**
+		 * Returns the size of the writable memory in bytes, work RAM followed
+		 * by PRG-RAM and the state of the mapper in the console layout, and the
+		 * entire address space in the flat layout
 		 * @return	Size of the RAM in bytes
 		 */
 		std::size_t GetSize() const;
 
+		/**
+		 * Retrieve what the address space is backed by
+		 * @return	Layout passed to the constructor
+		 */
+		Layout GetLayout() const;
+
+		/**
+		 * Retrieve the version of a 256-byte memory page, the version changes
+		 * every time a byte on that page is modified, through any of its
+		 * mirrors, or the page is mapped elsewhere
+		 * @param	page	Index of the page (high byte of the address)
+		 * @return	Current version of the page, never zero
+		 */
+		std::uint32_t GetPageVersion(std::uint8_t page) const;
+
+		/**
+		 * Retrieve the memory a page shows
+		 * @param	page	Index of the page (high byte of the address)
+		 * @return	Start of the memory of the page, nullptr for pages that are
+		 *			only backed by a handler
+		 */
+		const Byte* GetPageMemory(std::uint8_t page) const;
+
+		/**
+		 * Check whether a page can be written directly, pages that cannot are
+		 * either handler pages or show ROM, whose contents never change
+		 * @param	page	Index of the page (high byte of the address)
+		 * @return	True for pages mapped with MapMemory
+		 */
+		bool IsPageWritable(std::uint8_t page) const;
+
+		/**
+		 * Retrieve the number of times a ROM was stored
+		 * Memory of an earlier ROM may have been released since, so anything
+		 * that remembers memory by its address has to start over when this
+		 * changes
+		 * @return	Number of stored ROMs
+		 */
+		std::uint32_t GetRomGeneration() const;
+
+		/**
+		 * Map a range of pages to memory that can be read and written directly
+		 * @param	firstPage	Index of the first page (high byte of the address)
+		 * @param	pageCount	Number of consecutive pages to map
+		 * @param	memory		Start of the memory, at least pageCount * PAGE_SIZE
+		 *						bytes that must outlive the mapping
+		 */
+		void MapMemory(std::uint8_t firstPage, std::size_t pageCount, Byte* memory);
+
+		/**
+		 * Map a range of pages to memory that is read directly, such as ROM
+		 * The contents of the memory must not change while it is mapped. Pages
+		 * that already show the same memory keep their version, so switching
+		 * to the bank that is already selected costs nothing
+		 * @param	firstPage		Index of the first page (high byte of the address)
+		 * @param	pageCount		Number of consecutive pages to map
+		 * @param	memory			Start of the memory, at least pageCount * PAGE_SIZE
+		 *							bytes that must outlive the mapping
+		 * @param	writeHandler	Receives writes to the pages, such as mapper
+		 *							registers, writes are ignored when nullptr
+		 */
+		void MapReadOnlyMemory(std::uint8_t firstPage, std::size_t pageCount, const Byte* memory, MemoryHandler* writeHandler);
+
+		/**
+		 * Route every access to a range of pages through a handler
+		 * @param	firstPage	Index of the first page (high byte of the address)
+		 * @param	pageCount	Number of consecutive pages to map
+		 * @param	handler		Handler of the pages, must outlive the mapping
+		 */
+		void MapHandler(std::uint8_t firstPage, std::size_t pageCount, MemoryHandler* handler);
+
 	private:
-		std::array<Byte, 0x10000> Memory;
+		/**
+		 * Read a byte from a page without directly readable memory
+		 * @param	address		Address pointing to the byte to read
+		 * @return	Value returned by the handler, zero without one
+		 */
+		Byte ReadFromHandler(std::uint16_t address) const;
+
+		/**
+		 * Write a byte to a page without directly writable memory
+		 * @param	address		Address pointing to the byte to write
+		 * @param	value		Value passed to the handler, if any
+		 */
+		void WriteToHandler(std::uint16_t address, Byte value);
+
+		/**
+		 * Clamp a range of pages to the end of the address space
+		 * @param	firstPage	Index of the first page
+		 * @param	pageCount	Number of pages requested
+		 * @return	Number of pages that exist
+		 */
+		static std::size_t ClampPageCount(std::uint8_t firstPage, std::size_t pageCount);
+
+		/**
+		 * Bump the version of every page touched by a block of memory
+		 * @param	address		Start address of the block
+		 * @param	size		Size of the block in bytes
+		 */
+		void MarkPagesAsModified(std::uint16_t address, std::size_t size);
+
+		/**
+		 * Advance the version of a page after it was modified
+		 * @param	page	Index of the page
+		 */
+		void BumpPageVersion(std::size_t page);
+
+		/**
+		 * Retrieve the version that follows another one, skipping zero when
+		 * the counter wraps around since that means "never decoded"
+		 * @param	version		Current version
+		 * @return	Next version, never zero
+		 */
+		static constexpr std::uint32_t GetNextPageVersion(std::uint32_t version);
+
+		/**
+		 * Pick the version counter of a page that was just mapped, the new
+		 * version is higher than any version the page had before
+		 * @param	page	Index of the page
+		 * @param	slot	Page whose counter is shared, the page itself unless
+		 *					it mirrors the memory of another page
+		 */
+		void SetVersionSlot(std::size_t page, std::size_t slot);
+
+	private:
+		Layout MemoryLayout;
+
+		// Internal RAM of the console, mirrored four times
+		std::array<Byte, WORK_RAM_SIZE> WorkRam;
+
+		// Battery-backed or work RAM on the cartridge
+		std::array<Byte, PRG_RAM_SIZE> PrgRam;
+
+		// Only allocated for the flat layout
+		std::unique_ptr<Byte[]> FlatMemory;
+
+		// Board of the attached cartridge, console layout only
+		std::unique_ptr<Mapper> ActiveMapper;
+
+		// Start of every page that can be read directly, nullptr for handler pages
+		std::array<const Byte*, PAGE_COUNT> ReadPages;
+
+		// Start of every page that can be written directly, nullptr for handler
+		// and read-only pages
+		std::array<Byte*, PAGE_COUNT> WritePages;
+
+		// Handler of every page that is not backed by memory, not owned
+		std::array<MemoryHandler*, PAGE_COUNT> Handlers;
+
+		// Version of every 256-byte page, used to invalidate decoded instructions
+		std::array<std::uint32_t, PAGE_COUNT> PageVersions;
+
+		// Index into PageVersions of every page, mirrors of the same memory
+		// share a counter so a write through one invalidates all of them
+		std::array<std::uint8_t, PAGE_COUNT> VersionSlots;
+
+		// Number of times a ROM was stored
+		std::uint32_t RomGeneration;
 	};
+
+	inline Byte RAM::ReadByte(std::uint16_t address) const
+	{
+		const Byte* page = ReadPages[address >> 8];
+		if (page != nullptr)
+		{
+			return page[address & 0xFF];
+		}
+
+		return ReadFromHandler(address);
+	}
+
+	inline void RAM::WriteByte(std::uint16_t address, Byte value)
+	{
+		Byte* page = WritePages[address >> 8];
+		if (page != nullptr)
+		{
+			page[address & 0xFF] = value;
+			BumpPageVersion(address >> 8);
+			return;
+		}
+
+		WriteToHandler(address, value);
+	}
+
+	inline std::uint32_t RAM::GetPageVersion(std::uint8_t page) const
+	{
+		return PageVersions[VersionSlots[page]];
+	}
+
+	inline const Byte* RAM::GetPageMemory(std::uint8_t page) const
+	{
+		return ReadPages[page];
+	}
+
+	inline bool RAM::IsPageWritable(std::uint8_t page) const
+	{
+		return WritePages[page] != nullptr;
+	}
+
+	inline std::uint32_t RAM::GetRomGeneration() const
+	{
+		return RomGeneration;
+	}
+
+	inline void RAM::BumpPageVersion(std::size_t page)
+	{
+		std::uint32_t& version = PageVersions[VersionSlots[page]];
+		version = GetNextPageVersion(version);
+	}
+
+	constexpr std::uint32_t RAM::GetNextPageVersion(std::uint32_t version)
+	{
+		return (version == std::numeric_limits<std::uint32_t>::max()) ? 1 : version + 1;
+	}
+
+	inline void RAM::ClearByte(std::uint16_t address)
+	{
+		Byte zero;
+		zero.value = 0;
+		WriteByte(address, zero);
+	}
 }
 
 #endif //! NES_RAM_HPP
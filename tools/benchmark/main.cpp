@@ -0,0 +1,674 @@
+#include "cpu/cpu.hpp"
+#include "cpu/cpu_profiler.hpp"
+#include "io/rom_file.hpp"
+#include "io/rom_generator.hpp"
+#include "ram/ram.hpp"
+
+#include <algorithm>	// std::min / std::max
+#include <chrono>
+#include <cstdlib>	// std::strtoull
+#include <fstream>
+#include <iomanip>	// std::setprecision
+#include <iostream>
+#include <memory>
+#include <string>
+#include <utility>	// std::pair
+#include <vector>
+
+namespace
+{
+	/** Address the instruction mixes start at */
+	constexpr std::uint16_t MIX_ADDRESS = 0x8000;
+
+	/** Address the op-code loops start at */
+	constexpr std::uint16_t CODE_ADDRESS = 0x8080;
+
+	/** Subroutine that only returns, called by the RTS benchmark */
+	constexpr std::uint16_t RTS_ADDRESS = 0x9000;
+
+	/** Interrupt handler that only returns, used by the RTI benchmark */
+	constexpr std::uint16_t RTI_ADDRESS = 0x9100;
+
+	/** Pointers for JMP (indirect) */
+	constexpr std::uint16_t POINTER_TABLE_ADDRESS = 0x0300;
+
+	/** Number of copies of an op-code in its benchmark loop */
+	constexpr std::size_t REPEAT_COUNT = 64;
+
+	/** Size and seed of the generated workload programs */
+	constexpr std::size_t WORKLOAD_PROGRAM_SIZE = 4096;
+	constexpr std::uint64_t WORKLOAD_SEED = 1;
+
+	/** Every measurement is repeated and the fastest run is kept */
+	constexpr std::size_t RUN_COUNT = 3;
+
+	/** Sum of all bytes read by the RAM benchmark */
+	volatile std::uint8_t ReadChecksum = 0;
+
+	/**
+	 * Result of a single timed run
+	 */
+	struct Measurement
+	{
+		double Seconds;
+		std::uint64_t Cycles;
+		std::uint64_t Instructions;
+	};
+
+	/**
+	 * Throughput of a single op-code
+	 */
+	struct OpCodeResult
+	{
+		std::uint8_t OpCode;
+
+		// Op-code that has to run alongside it to keep the loop going, such as
+		// PHA for PLA, or the op-code itself when it runs on its own
+		std::uint8_t PairedWith;
+
+		Measurement Best;
+	};
+
+	/**
+	 * Throughput of an instruction mix
+	 */
+	struct MixResult
+	{
+		std::string Name;
+		bool UsesJit;
+		Measurement Best;
+	};
+
+	/**
+	 * Cost of a memory access pattern
+	 */
+	struct RamResult
+	{
+		std::string Name;
+		std::uint64_t Accesses;
+		double Seconds;
+	};
+
+	/**
+	 * Hand-assembled program that loops forever, starting at MIX_ADDRESS
+	 */
+	struct InstructionMix
+	{
+		const char* Name;
+		std::vector<std::pair<std::uint16_t, std::vector<std::uint8_t>>> Code;
+	};
+
+	/**
+	 * Instruction mixes that resemble common kinds of game code
+	 */
+	const std::vector<InstructionMix>& GetInstructionMixes()
+	{
+		static const std::vector<InstructionMix> mixes =
+		{
+			// Arithmetic on registers, counted down with X
+			{ "register_alu", {
+				{ 0x8000, { 0xA2, 0x20,				// LDX #$20
+							0x18,					// CLC
+							0x69, 0x07,				// ADC #$07
+							0x49, 0x5A,				// EOR #$5A
+							0x0A,					// ASL A
+							0xA8,					// TAY
+							0x88,					// DEY
+							0x98,					// TYA
+							0xCA,					// DEX
+							0xD0, 0xF4,				// BNE $8002
+							0x4C, 0x00, 0x80 } }	// JMP $8000
+			} },
+
+			// Copying and updating tables in memory
+			{ "memory", {
+				{ 0x8000, { 0xA0, 0x00,				// LDY #$00
+							0xB9, 0x00, 0x02,		// LDA $0200,Y
+							0x99, 0x00, 0x03,		// STA $0300,Y
+							0xB1, 0x10,				// LDA ($10),Y
+							0x91, 0x12,				// STA ($12),Y
+							0xE6, 0x20,				// INC $20
+							0xA5, 0x20,				// LDA $20
+							0x8D, 0x00, 0x04,		// STA $0400
+							0xC8,					// INY
+							0xD0, 0xEC,				// BNE $8002
+							0x4C, 0x00, 0x80 } }	// JMP $8000
+			} },
+
+			// Nested loops with a compare and a conditional update
+			{ "branches", {
+				{ 0x8000, { 0xA2, 0x10,				// LDX #$10
+							0xA0, 0x08,				// LDY #$08
+							0xC0, 0x04,				// CPY #$04
+							0x90, 0x02,				// BCC $800A
+							0xE6, 0x30,				// INC $30
+							0x88,					// DEY
+							0xD0, 0xF7,				// BNE $8004
+							0xCA,					// DEX
+							0x10, 0xF2,				// BPL $8002
+							0x4C, 0x00, 0x80 } }	// JMP $8000
+			} },
+
+			// Subroutine calls and stack traffic
+			{ "calls", {
+				{ 0x8000, { 0x20, 0x10, 0x80,		// JSR $8010
+							0x48,					// PHA
+							0x08,					// PHP
+							0x28,					// PLP
+							0x68,					// PLA
+							0x4C, 0x00, 0x80 } },	// JMP $8000
+				{ 0x8010, { 0xA9, 0x01,				// LDA #$01
+							0x20, 0x20, 0x80,		// JSR $8020
+							0x60 } },				// RTS
+				{ 0x8020, { 0xE8,					// INX
+							0x60 } }				// RTS
+			} },
+
+			// Blocks of one or two instructions, ended by calls and branches
+			{ "short_blocks", {
+				{ 0x8000, { 0x20, 0x10, 0x80,		// JSR $8010
+							0xC8,					// INY
+							0xD0, 0xFA,				// BNE $8000
+							0x4C, 0x00, 0x80 } },	// JMP $8000
+				{ 0x8010, { 0xE8,					// INX
+							0x60 } }				// RTS
+			} }
+		};
+
+		return mixes;
+	}
+
+	/**
+	 * Name of the CPU backend this benchmark was compiled with
+	 */
+	const char* GetBackendName()
+	{
+#if defined(NES_CPU_COMPUTED_GOTO)
+		return "ComputedGoto";
+#elif defined(NES_CPU_BACKEND_SWITCH)
+		return "Switch";
+#else
+		return "Virtual";
+#endif
+	}
+
+	/**
+	 * Name and version of the compiler this benchmark was compiled with
+	 */
+	std::string GetCompilerName()
+	{
+#if defined(__clang__)
+		return "Clang " __clang_version__;
+#elif defined(__GNUC__)
+		return "GCC " __VERSION__;
+#elif defined(_MSC_VER)
+		return "MSVC " + std::to_string(_MSC_VER);
+#else
+		return "unknown";
+#endif
+	}
+
+	void WriteByte(nes::RAM& ram, std::uint16_t address, std::uint8_t value)
+	{
+		nes::Byte byte;
+		byte.value = value;
+		ram.WriteByte(address, byte);
+	}
+
+	void WriteWord(nes::RAM& ram, std::uint16_t address, std::uint16_t value)
+	{
+		WriteByte(ram, address, static_cast<std::uint8_t>(value));
+		WriteByte(ram, static_cast<std::uint16_t>(address + 1), static_cast<std::uint8_t>(value >> 8));
+	}
+
+	/**
+	 * Fill the memory every benchmark program relies on
+	 * Every zero page pointer points at 0x0202, the subroutine at RTS_ADDRESS
+	 * and the interrupt handler at RTI_ADDRESS only return, and BRK enters
+	 * that handler
+	 */
+	void PrepareMemory(nes::RAM& ram)
+	{
+		for (std::uint16_t address = 0x0000; address < 0x0100; ++address)
+		{
+			WriteByte(ram, address, 0x02);
+		}
+
+		WriteByte(ram, RTS_ADDRESS, 0x60);
+		WriteByte(ram, RTI_ADDRESS, 0x40);
+		WriteWord(ram, 0xFFFE, RTI_ADDRESS);
+	}
+
+	/**
+	 * Write a loop that keeps executing a single op-code
+	 * Most op-codes are repeated REPEAT_COUNT times followed by a jump back.
+	 * Control flow that cannot fall through to the next copy loops on itself,
+	 * and instructions that pull from the stack are paired with the
+	 * instruction that pushes what they pull
+	 * @param	ram			RAM to write the loop to
+	 * @param	cpu			CPU used to look up the size of the op-code
+	 * @param	opCode		Op-code to benchmark
+	 * @return	Op-code the benchmarked op-code is paired with, or the op-code
+	 *			itself
+	 */
+	std::uint8_t WriteOpCodeLoop(nes::RAM& ram, const nes::CPU& cpu, std::uint8_t opCode)
+	{
+		std::uint16_t address = CODE_ADDRESS;
+
+		switch (opCode)
+		{
+			// BRK, JSR and both JMPs loop on themselves
+			case 0x00:
+				WriteByte(ram, address, opCode);
+				WriteWord(ram, 0xFFFE, CODE_ADDRESS);
+				return opCode;
+
+			case 0x20:
+			case 0x4C:
+				WriteByte(ram, address, opCode);
+				WriteWord(ram, address + 1, CODE_ADDRESS);
+				return opCode;
+
+			case 0x6C:
+				WriteByte(ram, address, opCode);
+				WriteWord(ram, address + 1, POINTER_TABLE_ADDRESS);
+				WriteWord(ram, POINTER_TABLE_ADDRESS, CODE_ADDRESS);
+				return opCode;
+
+			default:
+				break;
+		}
+
+		// RTS returns to the instruction after the JSR, RTI to the one after the
+		// padding byte of the BRK
+		std::uint8_t pairedWith = opCode;
+		switch (opCode)
+		{
+			case 0x40: pairedWith = 0x00; break;	// BRK, which enters the RTI at RTI_ADDRESS
+			case 0x60: pairedWith = 0x20; break;	// JSR RTS_ADDRESS
+			case 0x68: pairedWith = 0x48; break;	// PHA before PLA
+			case 0x28: pairedWith = 0x08; break;	// PHP before PLP
+			default: break;
+		}
+
+		for (std::size_t i = 0; i < REPEAT_COUNT; ++i)
+		{
+			if (opCode == 0x60)
+			{
+				WriteByte(ram, address, 0x20);
+				WriteWord(ram, address + 1, RTS_ADDRESS);
+				address += 3;
+				continue;
+			}
+
+			if (opCode == 0x40)
+			{
+				WriteByte(ram, address, 0x00);
+				WriteByte(ram, address + 1, 0xEA);
+				address += 2;
+				continue;
+			}
+
+			if (pairedWith != opCode)
+			{
+				WriteByte(ram, address++, pairedWith);
+			}
+
+			WriteByte(ram, address, opCode);
+
+			// Branches skip nothing, whether they are taken or not
+			bool isBranch = ((opCode & 0x1F) == 0x10);
+			std::uint8_t size = cpu.GetOpCodeSize(opCode);
+
+			if (size == 2)
+			{
+				WriteByte(ram, address + 1, isBranch ? 0x00 : 0x10);
+			}
+			else if (size == 3)
+			{
+				WriteWord(ram, address + 1, 0x0200);
+			}
+
+			address += size;
+		}
+
+		// JMP CODE_ADDRESS
+		WriteByte(ram, address, 0x4C);
+		WriteWord(ram, address + 1, CODE_ADDRESS);
+
+		return pairedWith;
+	}
+
+	/**
+	 * Run the program in memory a few times and keep the fastest run
+	 * The number of instructions is counted in a profiled run first, profiling
+	 * is disabled while timing
+	 * @param	ram				RAM holding the program
+	 * @param	startAddress	Address the program starts at
+	 * @param	cycleCount		Number of cycles to run for
+	 * @param	useJit			True to run the program on the JIT
+	 * @return	Fastest run
+	 */
+	Measurement MeasureProgram(nes::RAM& ram, std::uint16_t startAddress, std::uint64_t cycleCount, bool useJit)
+	{
+		// Every run starts from the same state, memory only changes in places
+		// that do not affect the instruction count
+		auto cpu = std::make_unique<nes::CPU>(ram);
+		cpu->SetProgramCounterToAddress(startAddress);
+
+		std::uint8_t initialState[nes::CPU::STATE_SIZE];
+		cpu->WriteState(initialState);
+
+		cpu->EnableProfiling();
+		cpu->RunCycles(cycleCount);
+		std::uint64_t instructionCount = cpu->GetProfiler()->GetTotalExecutions();
+		cpu->DisableProfiling();
+
+		cpu->SetJitEnabled(useJit);
+
+		Measurement best { 0.0, 0, instructionCount };
+		for (std::size_t run = 0; run < RUN_COUNT; ++run)
+		{
+			cpu->ReadState(initialState);
+			std::uint64_t startCycle = cpu->GetCurrentCycle();
+
+			auto startTime = std::chrono::steady_clock::now();
+			cpu->RunCycles(cycleCount);
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+			if (run == 0 || seconds < best.Seconds)
+			{
+				best.Seconds = seconds;
+				best.Cycles = cpu->GetCurrentCycle() - startCycle;
+			}
+		}
+
+		return best;
+	}
+
+	std::vector<OpCodeResult> BenchmarkOpCodes(std::uint64_t cycleCount)
+	{
+		std::vector<OpCodeResult> results;
+
+		auto ram = std::make_unique<nes::RAM>();
+		auto lookup = std::make_unique<nes::CPU>(*ram);
+
+		for (std::size_t opCode = 0; opCode < 256; ++opCode)
+		{
+			if (lookup->GetOpCodeName(static_cast<std::uint8_t>(opCode)) == "???")
+			{
+				continue;
+			}
+
+			auto programRam = std::make_unique<nes::RAM>(nes::RAM::Layout::Flat);
+			PrepareMemory(*programRam);
+
+			OpCodeResult result;
+			result.OpCode = static_cast<std::uint8_t>(opCode);
+			result.PairedWith = WriteOpCodeLoop(*programRam, *lookup, result.OpCode);
+			result.Best = MeasureProgram(*programRam, CODE_ADDRESS, cycleCount, false);
+
+			results.push_back(result);
+		}
+
+		return results;
+	}
+
+	std::vector<MixResult> BenchmarkMixes(std::uint64_t cycleCount)
+	{
+		std::vector<MixResult> results;
+
+		auto ram = std::make_unique<nes::RAM>();
+		bool isJitAvailable = nes::CPU(*ram).SetJitEnabled(true);
+
+		for (const InstructionMix& mix : GetInstructionMixes())
+		{
+			for (bool useJit : { false, true })
+			{
+				if (useJit && !isJitAvailable)
+				{
+					continue;
+				}
+
+				auto programRam = std::make_unique<nes::RAM>(nes::RAM::Layout::Flat);
+				PrepareMemory(*programRam);
+
+				for (const auto& block : mix.Code)
+				{
+					for (std::size_t i = 0; i < block.second.size(); ++i)
+					{
+						WriteByte(*programRam, static_cast<std::uint16_t>(block.first + i), block.second[i]);
+					}
+				}
+
+				results.push_back({ mix.Name, useJit, MeasureProgram(*programRam, MIX_ADDRESS, cycleCount, useJit) });
+			}
+		}
+
+		return results;
+	}
+
+	std::vector<MixResult> BenchmarkWorkloads(std::uint64_t cycleCount)
+	{
+		std::vector<MixResult> results;
+
+		auto ram = std::make_unique<nes::RAM>();
+		bool isJitAvailable = nes::CPU(*ram).SetJitEnabled(true);
+
+		for (nes::RomGenerator::Workload workload : nes::RomGenerator::WORKLOADS)
+		{
+			nes::RomGenerator generator(WORKLOAD_SEED);
+			std::vector<std::uint8_t> image = generator.Generate(workload, WORKLOAD_PROGRAM_SIZE);
+
+			nes::RomFile rom;
+			rom.LoadFromMemory(image.data(), image.size());
+
+			for (bool useJit : { false, true })
+			{
+				if (useJit && !isJitAvailable)
+				{
+					continue;
+				}
+
+				auto programRam = std::make_unique<nes::RAM>();
+				programRam->StoreRomData(rom);
+
+				// Generated programs start at the reset vector
+				std::uint16_t startAddress = static_cast<std::uint16_t>(programRam->ReadByte(0xFFFC).value | (programRam->ReadByte(0xFFFD).value << 8));
+
+				std::string name(nes::RomGenerator::GetWorkloadName(workload));
+				results.push_back({ name, useJit, MeasureProgram(*programRam, startAddress, cycleCount, useJit) });
+			}
+		}
+
+		return results;
+	}
+
+	std::vector<RamResult> BenchmarkRam(std::uint64_t accessCount)
+	{
+		std::vector<RamResult> results;
+		auto ram = std::make_unique<nes::RAM>();
+
+		// Addresses are generated up front, so only the accesses are timed
+		std::vector<std::uint16_t> randomAddresses(0x10000);
+		std::uint32_t seed = 0x12345678;
+		for (std::uint16_t& address : randomAddresses)
+		{
+			seed = seed * 1664525 + 1013904223;
+			address = static_cast<std::uint16_t>(seed >> 16);
+		}
+
+		// Summing up everything that was read keeps the reads from being
+		// optimized away
+		std::uint8_t checksum = 0;
+
+		auto measure = [&results, accessCount](const char* name, auto access)
+		{
+			double best = 0.0;
+			for (std::size_t run = 0; run < RUN_COUNT; ++run)
+			{
+				auto startTime = std::chrono::steady_clock::now();
+				for (std::uint64_t i = 0; i < accessCount; ++i)
+				{
+					access(i);
+				}
+
+				double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+				best = (run == 0) ? seconds : std::min(best, seconds);
+			}
+
+			results.push_back({ name, accessCount, best });
+		};
+
+		measure("read_sequential", [&](std::uint64_t i)
+		{
+			checksum += ram->ReadByte(static_cast<std::uint16_t>(i)).value;
+		});
+
+		measure("read_random", [&](std::uint64_t i)
+		{
+			checksum += ram->ReadByte(randomAddresses[i & 0xFFFF]).value;
+		});
+
+		measure("write_sequential", [&](std::uint64_t i)
+		{
+			nes::Byte value;
+			value.value = static_cast<std::uint8_t>(i);
+			ram->WriteByte(static_cast<std::uint16_t>(i), value);
+		});
+
+		measure("write_random", [&](std::uint64_t i)
+		{
+			nes::Byte value;
+			value.value = static_cast<std::uint8_t>(i);
+			ram->WriteByte(randomAddresses[i & 0xFFFF], value);
+		});
+
+		ReadChecksum = checksum;
+		return results;
+	}
+
+	void WriteMeasurement(std::ostream& stream, const Measurement& measurement)
+	{
+		double seconds = std::max(measurement.Seconds, 1e-9);
+
+		stream << "\"cycles\": " << measurement.Cycles << ", \"instructions\": " << measurement.Instructions;
+		stream << ", \"seconds\": " << std::setprecision(6) << measurement.Seconds;
+		stream << ", \"emulated_mhz\": " << std::setprecision(6) << (measurement.Cycles / seconds / 1000000.0);
+		stream << ", \"mips\": " << std::setprecision(6) << (measurement.Instructions / seconds / 1000000.0);
+	}
+
+	void WriteMixes(std::ostream& stream, const std::vector<MixResult>& mixes)
+	{
+		for (std::size_t i = 0; i < mixes.size(); ++i)
+		{
+			const MixResult& result = mixes[i];
+
+			stream << "    {\"name\": \"" << result.Name << "\", \"engine\": \"" << (result.UsesJit ? "jit" : "interpreter") << "\", ";
+			WriteMeasurement(stream, result.Best);
+			stream << ((i + 1 < mixes.size()) ? "},\n" : "}\n");
+		}
+	}
+
+	void WriteResults(std::ostream& stream, std::uint64_t cycleCount, const std::vector<OpCodeResult>& opCodes,
+					  const std::vector<MixResult>& mixes, const std::vector<MixResult>& workloads,
+					  const std::vector<RamResult>& ramAccesses)
+	{
+		auto ram = std::make_unique<nes::RAM>();
+		auto lookup = std::make_unique<nes::CPU>(*ram);
+
+		stream << "{\n";
+		stream << "  \"backend\": \"" << GetBackendName() << "\",\n";
+		stream << "  \"compiler\": \"" << GetCompilerName() << "\",\n";
+		stream << "  \"jit_available\": " << (lookup->SetJitEnabled(true) ? "true" : "false") << ",\n";
+		stream << "  \"cycles_per_run\": " << cycleCount << ",\n";
+
+		stream << "  \"opcodes\": [\n";
+		for (std::size_t i = 0; i < opCodes.size(); ++i)
+		{
+			const OpCodeResult& result = opCodes[i];
+
+			stream << "    {\"opcode\": " << +result.OpCode << ", \"name\": \"" << lookup->GetOpCodeName(result.OpCode) << '"';
+			stream << ", \"size\": " << +lookup->GetOpCodeSize(result.OpCode);
+
+			if (result.PairedWith != result.OpCode)
+			{
+				stream << ", \"paired_with\": \"" << lookup->GetOpCodeName(result.PairedWith) << '"';
+			}
+
+			stream << ", ";
+			WriteMeasurement(stream, result.Best);
+			stream << ((i + 1 < opCodes.size()) ? "},\n" : "}\n");
+		}
+
+		stream << "  ],\n";
+
+		stream << "  \"mixes\": [\n";
+		WriteMixes(stream, mixes);
+		stream << "  ],\n";
+
+		stream << "  \"workload_program_size\": " << WORKLOAD_PROGRAM_SIZE << ",\n";
+		stream << "  \"workload_seed\": " << WORKLOAD_SEED << ",\n";
+		stream << "  \"workloads\": [\n";
+		WriteMixes(stream, workloads);
+		stream << "  ],\n";
+
+		stream << "  \"ram\": [\n";
+		for (std::size_t i = 0; i < ramAccesses.size(); ++i)
+		{
+			const RamResult& result = ramAccesses[i];
+			double nanoseconds = result.Seconds * 1000000000.0 / std::max<std::uint64_t>(result.Accesses, 1);
+
+			stream << "    {\"name\": \"" << result.Name << "\", \"accesses\": " << result.Accesses;
+			stream << ", \"seconds\": " << std::setprecision(6) << result.Seconds;
+			stream << ", \"ns_per_access\": " << std::setprecision(6) << nanoseconds;
+			stream << ((i + 1 < ramAccesses.size()) ? "},\n" : "}\n");
+		}
+
+		stream << "  ]\n";
+		stream << "}\n";
+	}
+}
+
+/**
+ * Measures the throughput of the CPU core without the editor
+ *
+ * Usage: nes_benchmark [result file] [cycle count]
+ * Every op-code in the instruction table runs in a loop of its own, a few
+ * instruction mixes and the programs of RomGenerator run on the interpreter
+ * and on the JIT, and the RAM is read and written in sequential and random
+ * order. Every measurement is repeated and the fastest run is kept. Op-codes
+ * run for the given number of cycles each (2000000 by default), the
+ * instruction mixes and generated programs for ten times as long.
+ * The results are written as JSON to the result file, or to the standard
+ * output when no result file is given, so runs with different backends,
+ * compilers and flags can be compared.
+ */
+int main(int argc, char* argv[])
+{
+	std::uint64_t cycleCount = (argc > 2) ? std::strtoull(argv[2], nullptr, 10) : 2000000;
+	if (cycleCount == 0)
+	{
+		std::cerr << "Usage: " << argv[0] << " [result file] [cycle count]" << std::endl;
+		return 1;
+	}
+
+	std::ofstream resultFile;
+	if (argc > 1)
+	{
+		resultFile.open(argv[1], std::ios_base::out | std::ios_base::trunc);
+		if (!resultFile.is_open())
+		{
+			std::cerr << "Unable to create result file: " << argv[1] << std::endl;
+			return 1;
+		}
+	}
+
+	std::vector<OpCodeResult> opCodes = BenchmarkOpCodes(cycleCount);
+	std::vector<MixResult> mixes = BenchmarkMixes(cycleCount * 10);
+	std::vector<MixResult> workloads = BenchmarkWorkloads(cycleCount * 10);
+	std::vector<RamResult> ramAccesses = BenchmarkRam(cycleCount * 8);
+
+	WriteResults(resultFile.is_open() ? resultFile : std::cout, cycleCount, opCodes, mixes, workloads, ramAccesses);
+	return 0;
+}
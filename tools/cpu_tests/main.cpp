@@ -0,0 +1,653 @@
+#include "cpu/cpu.hpp"
+#include "cpu/cpu_bus_device.hpp"
+#include "cpu/cpu_differential.hpp"
+#include "io/rom_file.hpp"
+#include "ram/ram.hpp"
+
+#include <algorithm>	// std::copy / std::fill
+#include <cstdint>
+#include <initializer_list>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	// Every test program starts here
+	constexpr std::uint16_t PROGRAM_ADDRESS = 0x0200;
+
+	// Memory operand of the read-modify-write tests
+	constexpr std::uint16_t OPERAND_ADDRESS = 0x0010;
+
+	// Value of X while the instruction under test runs, indexed modes add it
+	// to a base address below OPERAND_ADDRESS
+	constexpr std::uint8_t INDEX = 0x04;
+
+	// Unknown op-code that ends every test program
+	constexpr std::uint8_t JAM_OPCODE = 0x02;
+
+	// NMI, IRQ and BRK all enter the handler here, it increments the value at
+	// OPERAND_ADDRESS and returns with interrupts disabled, so an IRQ that is
+	// still raised does not enter it again
+	constexpr std::uint16_t HANDLER_ADDRESS = 0x0400;
+	constexpr std::uint16_t NMI_VECTOR_ADDRESS = 0xFFFA;
+	constexpr std::uint16_t IRQ_VECTOR_ADDRESS = 0xFFFE;
+
+	// Every program runs this many times on the same CPU, which is enough for
+	// the JIT to translate it
+	constexpr std::size_t RUN_COUNT = 40;
+
+	// Programs only change the zero page and the stack, which are restored
+	// before every run. Restoring the program as well would change the version
+	// of its page and throw away what the JIT translated
+	constexpr std::uint16_t RESTORED_SIZE = 0x0200;
+
+	// A program that runs longer than this never reached its end
+	constexpr std::uint64_t CYCLE_LIMIT = 10000;
+
+	constexpr std::uint8_t FLAG_CARRY = static_cast<std::uint8_t>(nes::StatusFlags::Carry);
+	constexpr std::uint8_t FLAG_ZERO = static_cast<std::uint8_t>(nes::StatusFlags::Zero);
+	constexpr std::uint8_t FLAG_INTERRUPT_DISABLE = static_cast<std::uint8_t>(nes::StatusFlags::InterruptDisable);
+	constexpr std::uint8_t FLAG_NEGATIVE = static_cast<std::uint8_t>(nes::StatusFlags::Negative);
+
+	/**
+	 * Bus device that never lets the CPU run ahead, so every instruction goes
+	 * through the cycle-stepped core
+	 */
+	class StepEveryCycle : public nes::CpuBusDevice
+	{
+	public:
+		std::uint64_t GetCyclesUntilSync() const override
+		{
+			return 0;
+		}
+
+		void Tick(std::uint64_t /*cycleCount*/) override
+		{
+		}
+
+		void OnBusAccess(std::uint64_t /*cycle*/, std::uint16_t /*address*/, std::uint8_t /*value*/, bool /*isWrite*/) override
+		{
+		}
+	};
+
+	/**
+	 * Interrupt line raised before a test program starts
+	 */
+	enum class RaisedInterrupt
+	{
+		None,
+		Nmi,
+		Irq
+	};
+
+	/**
+	 * Program and the state it has to leave behind once it reaches the
+	 * JAM_OPCODE at its end
+	 */
+	struct TestCase
+	{
+		std::string Name;
+
+		// Loaded at PROGRAM_ADDRESS of the flat layout
+		std::vector<std::uint8_t> Program;
+
+		// iNES image to run from the reset vector of the console layout
+		// instead, when not empty
+		std::vector<std::uint8_t> Rom;
+
+		RaisedInterrupt Interrupt;
+
+		std::uint8_t A;
+		std::uint8_t Operand;		// Value at OPERAND_ADDRESS
+		std::uint8_t Status;
+		std::uint8_t StatusMask;	// Bits of P that are compared
+
+		// Cycles from the start of the program up to JAM_OPCODE, not compared
+		// when 0
+		std::uint64_t Cycles;
+	};
+
+	/**
+	 * Input and output of a read-modify-write instruction, the same for all of
+	 * its addressing modes
+	 */
+	struct ReadModifyWriteCase
+	{
+		std::uint8_t Value;
+		bool CarryIn;
+		std::uint8_t Result;
+		std::uint8_t Status;	// Carry, zero and negative flags afterwards
+	};
+
+	/**
+	 * Op-code of one addressing mode of a read-modify-write instruction
+	 */
+	struct ReadModifyWriteOpCode
+	{
+		std::uint8_t OpCode;
+		nes::AddressingMode Mode;
+	};
+
+	/**
+	 * Format a byte as two hexadecimal digits
+	 * @param	value	Byte to format
+	 * @return	Formatted byte
+	 */
+	std::string ToHex(std::uint8_t value)
+	{
+		std::ostringstream stream;
+		stream << std::uppercase << std::hex << std::setw(2) << std::setfill('0') << static_cast<unsigned>(value);
+		return stream.str();
+	}
+
+	/**
+	 * Copy code into a program
+	 * @param	program		Program to copy into, has to be large enough
+	 * @param	offset		Offset from PROGRAM_ADDRESS
+	 * @param	code		Bytes to copy
+	 */
+	void PlaceCode(std::vector<std::uint8_t>& program, std::size_t offset, std::initializer_list<std::uint8_t> code)
+	{
+		std::copy(code.begin(), code.end(), program.begin() + offset);
+	}
+
+	/**
+	 * Create a test for every addressing mode of a read-modify-write
+	 * instruction and every case
+	 * The program loads the value into A and OPERAND_ADDRESS, sets up the
+	 * carry and runs the op-code on A or on OPERAND_ADDRESS
+	 * @param	name		Mnemonic of the instruction
+	 * @param	opCodes		Op-codes of all its addressing modes
+	 * @param	cases		Inputs and the expected outputs
+	 * @param	tests		Tests to add to
+	 */
+	void AddReadModifyWriteTests(const std::string& name, const std::vector<ReadModifyWriteOpCode>& opCodes,
+		const std::vector<ReadModifyWriteCase>& cases, std::vector<TestCase>& tests)
+	{
+		constexpr std::uint8_t INDEXED_ADDRESS = OPERAND_ADDRESS - INDEX;
+
+		for (const ReadModifyWriteOpCode& opCode : opCodes)
+		{
+			for (const ReadModifyWriteCase& entry : cases)
+			{
+				// LDX #INDEX, LDA #value, STA OPERAND_ADDRESS, CLC or SEC
+				std::vector<std::uint8_t> program = {
+					0xA2, INDEX,
+					0xA9, entry.Value,
+					0x85, OPERAND_ADDRESS,
+					static_cast<std::uint8_t>(entry.CarryIn ? 0x38 : 0x18),
+					opCode.OpCode
+				};
+
+				switch (opCode.Mode)
+				{
+					case nes::AddressingMode::ZeroPage:		program.insert(program.end(), { OPERAND_ADDRESS }); break;
+					case nes::AddressingMode::ZeroPageX:	program.insert(program.end(), { INDEXED_ADDRESS }); break;
+					case nes::AddressingMode::Absolute:		program.insert(program.end(), { OPERAND_ADDRESS, 0x00 }); break;
+					case nes::AddressingMode::AbsoluteX:	program.insert(program.end(), { INDEXED_ADDRESS, 0x00 }); break;
+					default:								break;
+				}
+
+				program.push_back(JAM_OPCODE);
+
+				bool isAccumulator = (opCode.Mode == nes::AddressingMode::Accumulator);
+
+				TestCase test;
+				test.Name = name + " $" + ToHex(opCode.OpCode) + " value $" + ToHex(entry.Value) + (entry.CarryIn ? " carry set" : " carry clear");
+				test.Program = program;
+				test.Interrupt = RaisedInterrupt::None;
+				test.A = isAccumulator ? entry.Result : entry.Value;
+				test.Operand = isAccumulator ? entry.Value : entry.Result;
+				test.Status = entry.Status;
+				test.StatusMask = FLAG_CARRY | FLAG_ZERO | FLAG_NEGATIVE;
+				test.Cycles = 0;
+				tests.push_back(test);
+			}
+		}
+	}
+
+	/**
+	 * Create a test that switches the bank of $8000-$BFFF on a UxROM board
+	 * from code inside that bank, through an address outside of the page the
+	 * code runs from. Execution has to continue in the new bank right after
+	 * the write
+	 * @param	tests	Tests to add to
+	 */
+	void AddBankSwitchTest(std::vector<TestCase>& tests)
+	{
+		constexpr std::size_t BANK_SIZE = 0x4000;
+		constexpr std::size_t BANK_COUNT = 4;
+		constexpr std::uint8_t LOOP_COUNT = 0x40;
+
+		std::vector<std::uint8_t> rom(nes::RomFile::HEADER_SIZE + BANK_COUNT * BANK_SIZE, 0xEA);
+		std::fill(rom.begin(), rom.begin() + nes::RomFile::HEADER_SIZE, 0);
+
+		// 4 x 16 KB PRG-ROM, CHR-RAM, mapper 2
+		const std::uint8_t header[] = { 'N', 'E', 'S', 0x1A, BANK_COUNT, 0x00, 0x20 };
+		std::copy(std::begin(header), std::end(header), rom.begin());
+
+		auto write = [&rom](std::size_t bank, std::uint16_t offset, std::initializer_list<std::uint8_t> code)
+		{
+			std::copy(code.begin(), code.end(), rom.begin() + nes::RomFile::HEADER_SIZE + bank * BANK_SIZE + offset);
+		};
+
+		// Last bank, fixed at $C000
+		write(BANK_COUNT - 1, 0x0000, {
+			0xA2, LOOP_COUNT,		// LDX #LOOP_COUNT
+			0xA9, 0x00,				// LDA #$00
+			0x8D, 0x00, 0xC0,		// STA $C000, select bank 0
+			0x4C, 0x00, 0x80,		// JMP $8000
+			0xCA,					// DEX
+			0xD0, 0xF5,				// BNE $C002
+			JAM_OPCODE
+		});
+		write(BANK_COUNT - 1, 0x3FFC, { 0x00, 0xC0 });
+
+		// Bank 0 selects bank 1, its own last instruction must never run
+		write(0, 0x0000, {
+			0xA9, 0x01,				// LDA #$01
+			0x8D, 0x00, 0xC0,		// STA $C000, select bank 1
+			0xE6, OPERAND_ADDRESS + 1,	// INC OPERAND_ADDRESS + 1
+			0x4C, 0x0A, 0xC0		// JMP $C00A
+		});
+
+		write(1, 0x0005, {
+			0xE6, OPERAND_ADDRESS,	// INC OPERAND_ADDRESS
+			0x4C, 0x0A, 0xC0		// JMP $C00A
+		});
+
+		TestCase test;
+		test.Name = "UxROM bank switch from the switched bank";
+		test.Rom = rom;
+		test.Interrupt = RaisedInterrupt::None;
+		test.A = 0x01;
+		test.Operand = LOOP_COUNT;
+		test.Status = 0;
+		test.StatusMask = 0;
+		test.Cycles = 0;
+		tests.push_back(test);
+	}
+
+	/**
+	 * Create tests that enter the handler at HANDLER_ADDRESS through an NMI,
+	 * an IRQ and BRK. The programs count the INX instructions they execute, so
+	 * returning anywhere but right after the interrupted instruction, or after
+	 * the padding byte of BRK, changes the count
+	 * @param	tests	Tests to add to
+	 */
+	void AddInterruptReturnTests(std::vector<TestCase>& tests)
+	{
+		constexpr std::uint8_t INX = 0xE8;
+		constexpr std::uint8_t COUNT = 6;
+
+		struct InterruptCase
+		{
+			const char* Name;
+			RaisedInterrupt Interrupt;
+			std::vector<std::uint8_t> Program;
+		};
+
+		const InterruptCase cases[] = {
+			// Taken before the first instruction
+			{ "NMI returns to the interrupted instruction", RaisedInterrupt::Nmi,
+				{ 0xA2, 0x00, INX, INX, INX, INX, INX, INX } },
+
+			// Taken once CLI enables interrupts
+			{ "IRQ returns to the interrupted instruction", RaisedInterrupt::Irq,
+				{ 0xA2, 0x00, 0x58, INX, INX, INX, INX, INX, INX } },
+
+			// The padding byte after BRK is an INX that must be skipped
+			{ "BRK returns past its padding byte", RaisedInterrupt::None,
+				{ 0xA2, 0x00, INX, 0x00, INX, INX, INX, INX, INX, INX } }
+		};
+
+		for (const InterruptCase& entry : cases)
+		{
+			TestCase test;
+			test.Name = entry.Name;
+			test.Program = entry.Program;
+			test.Program.insert(test.Program.end(), { 0x8A, JAM_OPCODE });	// TXA
+			test.Interrupt = entry.Interrupt;
+			test.A = COUNT;
+			test.Operand = 1;
+			test.Status = FLAG_INTERRUPT_DISABLE;
+			test.StatusMask = FLAG_INTERRUPT_DISABLE;
+			test.Cycles = 0;
+			tests.push_back(test);
+		}
+	}
+
+	/**
+	 * Create tests that time taken branches. The displacement is relative to
+	 * the instruction after the branch, and only a target on another page than
+	 * that instruction costs the extra cycle. The INY instructions make the
+	 * blocks ending in the branches long enough for the JIT to translate
+	 * @param	tests	Tests to add to
+	 */
+	void AddBranchTimingTests(std::vector<TestCase>& tests)
+	{
+		TestCase test;
+		test.Interrupt = RaisedInterrupt::None;
+		test.A = 0x00;
+		test.Operand = 0x00;
+		test.Status = 0;
+		test.StatusMask = 0;
+
+		// LDX #$05, INY, INY, DEX, BNE back to the first INY:
+		// 2 + 5 * (3 * 2) + 4 * 3 + 2 cycles
+		test.Name = "Taken backward branch on the same page";
+		test.Program = { 0xA2, 0x05, 0xC8, 0xC8, 0xCA, 0xD0, 0xFB, JAM_OPCODE };
+		test.Cycles = 46;
+		tests.push_back(test);
+
+		// JMP to a BCC at the end of the page, which skips forward onto the
+		// next page: 3 + 3 * 2 + 4 cycles
+		constexpr std::uint8_t BRANCH_OFFSET = 0xFA;
+		constexpr std::uint8_t DISPLACEMENT = 0x10;
+
+		test.Name = "Taken forward branch onto the next page";
+		test.Program.assign(0x100 + DISPLACEMENT + 1, JAM_OPCODE);
+		PlaceCode(test.Program, 0x0000, { 0x4C, BRANCH_OFFSET, PROGRAM_ADDRESS >> 8 });	// JMP to the CLC
+		PlaceCode(test.Program, BRANCH_OFFSET, { 0x18, 0xC8, 0xC8, 0x90, DISPLACEMENT });	// CLC, INY, INY, BCC
+		test.Cycles = 13;
+		tests.push_back(test);
+	}
+
+	/**
+	 * Create a test for JMP through a pointer at the end of a page, whose high
+	 * byte is read from the start of the same page
+	 * @param	tests	Tests to add to
+	 */
+	void AddIndirectJumpTest(std::vector<TestCase>& tests)
+	{
+		constexpr std::uint8_t TARGET_OFFSET = 0x50;
+		constexpr std::uint8_t WRONG_PAGE = (PROGRAM_ADDRESS >> 8) + 1;
+
+		TestCase test;
+		test.Name = "JMP indirect wraps within the page of the pointer";
+		test.Program.assign(0x100 + TARGET_OFFSET + 3, JAM_OPCODE);
+
+		PlaceCode(test.Program, 0x0000, {
+			0xA9, TARGET_OFFSET,		// LDA #TARGET_OFFSET
+			0x85, 0xFF,					// STA $FF
+			0xA9, PROGRAM_ADDRESS >> 8,	// LDA #>PROGRAM_ADDRESS
+			0x85, 0x00,					// STA $00
+			0xA9, WRONG_PAGE,			// LDA #WRONG_PAGE
+			0x8D, 0x00, 0x01,			// STA $0100
+			0x6C, 0xFF, 0x00			// JMP ($00FF)
+		});
+
+		// LDA #$01 on the right page, LDA #$02 on the wrong one
+		PlaceCode(test.Program, TARGET_OFFSET, { 0xA9, 0x01 });
+		PlaceCode(test.Program, 0x100 + TARGET_OFFSET, { 0xA9, 0x02 });
+
+		test.Interrupt = RaisedInterrupt::None;
+		test.A = 0x01;
+		test.Operand = 0x00;
+		test.Status = 0;
+		test.StatusMask = 0;
+		test.Cycles = 0;
+		tests.push_back(test);
+	}
+
+	/**
+	 * Create all tests
+	 * @return	List of tests
+	 */
+	std::vector<TestCase> CreateTests()
+	{
+		using Mode = nes::AddressingMode;
+
+		std::vector<TestCase> tests;
+
+		const std::vector<ReadModifyWriteOpCode> shiftOpCodes[] = {
+			{ { 0x2A, Mode::Accumulator }, { 0x26, Mode::ZeroPage }, { 0x36, Mode::ZeroPageX }, { 0x2E, Mode::Absolute }, { 0x3E, Mode::AbsoluteX } },
+			{ { 0x6A, Mode::Accumulator }, { 0x66, Mode::ZeroPage }, { 0x76, Mode::ZeroPageX }, { 0x6E, Mode::Absolute }, { 0x7E, Mode::AbsoluteX } }
+		};
+
+		// Carry moves into the freed bit, the bit shifted out becomes the carry
+		AddReadModifyWriteTests("ROL", shiftOpCodes[0], {
+			{ 0x01, false, 0x02, 0 },
+			{ 0x01, true, 0x03, 0 },
+			{ 0x80, false, 0x00, FLAG_CARRY | FLAG_ZERO },
+			{ 0x80, true, 0x01, FLAG_CARRY },
+			{ 0x40, false, 0x80, FLAG_NEGATIVE },
+			{ 0xFF, true, 0xFF, FLAG_CARRY | FLAG_NEGATIVE }
+		}, tests);
+
+		AddReadModifyWriteTests("ROR", shiftOpCodes[1], {
+			{ 0x02, false, 0x01, 0 },
+			{ 0x02, true, 0x81, FLAG_NEGATIVE },
+			{ 0x01, false, 0x00, FLAG_CARRY | FLAG_ZERO },
+			{ 0x01, true, 0x80, FLAG_CARRY | FLAG_NEGATIVE },
+			{ 0xFF, false, 0x7F, FLAG_CARRY }
+		}, tests);
+
+		// Carry is left alone, LDA of the value sets zero and negative from the
+		// value, so they only end up right if DEC updates them
+		AddReadModifyWriteTests("DEC", { { 0xC6, Mode::ZeroPage }, { 0xD6, Mode::ZeroPageX }, { 0xCE, Mode::Absolute }, { 0xDE, Mode::AbsoluteX } }, {
+			{ 0x01, false, 0x00, FLAG_ZERO },
+			{ 0x01, true, 0x00, FLAG_CARRY | FLAG_ZERO },
+			{ 0x00, false, 0xFF, FLAG_NEGATIVE },
+			{ 0x81, false, 0x80, FLAG_NEGATIVE },
+			{ 0x80, true, 0x7F, FLAG_CARRY }
+		}, tests);
+
+		AddBankSwitchTest(tests);
+		AddInterruptReturnTests(tests);
+		AddBranchTimingTests(tests);
+		AddIndirectJumpTest(tests);
+
+		return tests;
+	}
+
+	/**
+	 * Run a program on an engine until it reaches the unknown op-code at its end
+	 * @param	cpu		CPU to run
+	 * @param	engine	Engine to run it on
+	 * @return	True if the program reached its end
+	 */
+	bool RunProgram(nes::CPU& cpu, nes::CpuDifferential::Engine engine)
+	{
+		if (engine != nes::CpuDifferential::Engine::InstructionTable)
+		{
+			return cpu.RunCycles(CYCLE_LIMIT) == nes::CPU::StopReason::Jammed;
+		}
+
+		std::uint64_t targetCycle = cpu.GetCurrentCycle() + CYCLE_LIMIT;
+		while (cpu.GetCurrentCycle() < targetCycle)
+		{
+			if (cpu.ExecuteTableInstruction() == nes::CPU::StopReason::Jammed)
+			{
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	/**
+	 * Run a test repeatedly on a single CPU using an engine
+	 * @param	test	Test to run
+	 * @param	engine	Engine to run it on
+	 * @param	error	Set to a description of the first mismatch
+	 * @return	True if every run passed
+	 */
+	bool RunTest(const TestCase& test, nes::CpuDifferential::Engine engine, std::string& error)
+	{
+		nes::RAM ram(test.Rom.empty() ? nes::RAM::Layout::Flat : nes::RAM::Layout::Console);
+		nes::CPU cpu(ram);
+		nes::RomFile rom;
+		StepEveryCycle steppingDevice;
+
+		if (engine == nes::CpuDifferential::Engine::CycleStepped)
+		{
+			cpu.SetBusDevice(&steppingDevice);
+		}
+		else if (engine == nes::CpuDifferential::Engine::Jit)
+		{
+			cpu.SetJitEnabled(true);
+		}
+
+		std::uint16_t startAddress = PROGRAM_ADDRESS;
+
+		if (!test.Rom.empty())
+		{
+			rom.LoadFromMemory(test.Rom.data(), test.Rom.size());
+			if (!ram.StoreRomData(rom))
+			{
+				error = "ROM could not be attached";
+				return false;
+			}
+
+			cpu.SetProgramCounterToResetVector();
+			startAddress = cpu.GetProgramCounter();
+		}
+
+		auto writeBytes = [&ram](std::uint16_t address, const std::vector<std::uint8_t>& bytes)
+		{
+			for (std::size_t i = 0; i < bytes.size(); ++i)
+			{
+				nes::Byte value;
+				value.value = bytes[i];
+				ram.WriteByte(static_cast<std::uint16_t>(address + i), value);
+			}
+		};
+
+		if (test.Rom.empty())
+		{
+			// PLA, ORA #I, PHA sets the interrupt disable flag RTI restores
+			writeBytes(HANDLER_ADDRESS, {
+				0x68,
+				0x09, FLAG_INTERRUPT_DISABLE,
+				0x48,
+				0xE6, OPERAND_ADDRESS,	// INC OPERAND_ADDRESS
+				0x40					// RTI
+			});
+
+			const std::vector<std::uint8_t> vector = { HANDLER_ADDRESS & 0xFF, HANDLER_ADDRESS >> 8 };
+			writeBytes(NMI_VECTOR_ADDRESS, vector);
+			writeBytes(IRQ_VECTOR_ADDRESS, vector);
+		}
+
+		writeBytes(PROGRAM_ADDRESS, test.Program);
+
+		if (test.Interrupt == RaisedInterrupt::Nmi)
+		{
+			cpu.SetNmiLine(true);
+		}
+		else if (test.Interrupt == RaisedInterrupt::Irq)
+		{
+			cpu.SetIrqLine(nes::CPU::IrqSource::External, true);
+		}
+
+		std::uint8_t initialState[nes::CPU::STATE_SIZE];
+		cpu.WriteState(initialState);
+
+		std::vector<nes::Byte> initialMemory(RESTORED_SIZE);
+		for (std::uint16_t address = 0; address < RESTORED_SIZE; ++address)
+		{
+			initialMemory[address] = ram.ReadByte(address);
+		}
+
+		for (std::size_t run = 0; run < RUN_COUNT; ++run)
+		{
+			cpu.ReadState(initialState);
+
+			for (std::uint16_t address = 0; address < RESTORED_SIZE; ++address)
+			{
+				ram.WriteByte(address, initialMemory[address]);
+			}
+
+			cpu.SetProgramCounterToAddress(startAddress);
+
+			std::uint64_t startCycle = cpu.GetCurrentCycle();
+
+			if (!RunProgram(cpu, engine))
+			{
+				error = "did not reach the end of the program";
+				return false;
+			}
+
+			std::uint8_t state[nes::CPU::STATE_SIZE];
+			cpu.WriteState(state);
+
+			std::uint8_t operand = ram.ReadByte(OPERAND_ADDRESS).value;
+			std::uint8_t status = state[3] & test.StatusMask;
+
+			if (state[0] != test.A)
+			{
+				error = "A is $" + ToHex(state[0]) + ", expected $" + ToHex(test.A);
+			}
+			else if (operand != test.Operand)
+			{
+				error = "operand is $" + ToHex(operand) + ", expected $" + ToHex(test.Operand);
+			}
+			else if (status != test.Status)
+			{
+				error = "P is $" + ToHex(status) + ", expected $" + ToHex(test.Status) + " (mask $" + ToHex(test.StatusMask) + ")";
+			}
+			else if (test.Cycles != 0 && cpu.GetCurrentCycle() - startCycle != test.Cycles)
+			{
+				error = "took " + std::to_string(cpu.GetCurrentCycle() - startCycle) + " cycles, expected " + std::to_string(test.Cycles);
+			}
+
+			if (!error.empty())
+			{
+				error += " on run " + std::to_string(run + 1);
+				return false;
+			}
+		}
+
+		return true;
+	}
+}
+
+/**
+ * Runs small programs that check the results and flags of single instructions,
+ * a few interactions with the memory map and returning from interrupts, on
+ * every CPU engine
+ *
+ * Usage: nes_cpu_tests
+ * Every program runs several times on the same CPU, starting from the same
+ * zero page and stack, so the JIT translates it as well. The JIT is skipped where it is not
+ * available.
+ * The exit code is 0 when every test passed on every engine.
+ */
+int main()
+{
+	using Engine = nes::CpuDifferential::Engine;
+
+	std::vector<Engine> engines = { Engine::InstructionTable, Engine::Interpreter, Engine::CycleStepped };
+
+	nes::RAM probeRam(nes::RAM::Layout::Flat);
+	nes::CPU probeCpu(probeRam);
+	if (probeCpu.SetJitEnabled(true))
+	{
+		engines.push_back(Engine::Jit);
+	}
+
+	std::vector<TestCase> tests = CreateTests();
+	std::size_t failureCount = 0;
+
+	for (Engine engine : engines)
+	{
+		for (const TestCase& test : tests)
+		{
+			std::string error;
+			if (!RunTest(test, engine, error))
+			{
+				std::cerr << "FAIL [" << nes::CpuDifferential::GetEngineName(engine) << "] " << test.Name << ": " << error << std::endl;
+				++failureCount;
+			}
+		}
+	}
+
+	std::cout << (tests.size() * engines.size() - failureCount) << " of " << (tests.size() * engines.size()) << " tests passed on "
+		<< engines.size() << " engines" << std::endl;
+
+	return (failureCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,45 @@
+#include "cpu/cpu_differential.hpp"
+
+#include <cstdlib>	// std::abort
+#include <iostream>
+#include <memory>
+
+namespace
+{
+	// Cycles every input runs for
+	constexpr std::uint64_t FUZZ_CYCLE_COUNT = 20000;
+
+	// Instructions shown leading up to a divergence
+	constexpr std::size_t TRACE_LENGTH = 24;
+}
+
+/**
+ * libFuzzer entry point, checks every engine against the op-code handler
+ * objects on a program built from the input, see CpuDifferential::LoadFuzzInput
+ * A divergence is reported and aborts, so the fuzzer keeps the input
+ */
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+	using Engine = nes::CpuDifferential::Engine;
+
+	// Creating the CPUs is far more expensive than a short run
+	static std::unique_ptr<nes::CpuDifferential> differentials[] =
+	{
+		std::make_unique<nes::CpuDifferential>(Engine::InstructionTable, Engine::Interpreter, TRACE_LENGTH),
+		std::make_unique<nes::CpuDifferential>(Engine::InstructionTable, Engine::CycleStepped, TRACE_LENGTH),
+		std::make_unique<nes::CpuDifferential>(Engine::InstructionTable, Engine::Jit, TRACE_LENGTH)
+	};
+
+	for (std::unique_ptr<nes::CpuDifferential>& differential : differentials)
+	{
+		differential->LoadFuzzInput(data, size);
+
+		if (differential->Run(FUZZ_CYCLE_COUNT) == nes::CpuDifferential::Result::Diverged)
+		{
+			differential->WriteReport(std::cerr);
+			std::abort();
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,145 @@
+#include "cpu/cpu.hpp"
+#include "cpu/cpu_differential.hpp"
+#include "io/rom_file.hpp"
+#include "ram/ram.hpp"
+
+#include <cstdlib>	// std::strtoul / std::strtoull
+#include <iostream>
+#include <random>
+#include <string_view>
+#include <vector>
+
+namespace
+{
+	// Instructions shown leading up to a divergence
+	constexpr std::size_t TRACE_LENGTH = 24;
+
+	// Size of every randomized program, repeated over the entire memory
+	constexpr std::size_t RANDOM_PROGRAM_SIZE = 0x1000;
+
+	// Interrupt lines of randomized programs change between slices of this many cycles
+	constexpr std::uint64_t RANDOM_SLICE_CYCLES = 1000;
+
+	/**
+	 * Compare both engines on a ROM
+	 * @param	differential	Differential with the engines to compare
+	 * @param	romPath			Path to the ROM file
+	 * @param	cycleCount		Number of cycles to run for
+	 * @param	startAddress	Address to start at, or -1 for the reset vector
+	 * @return	Exit code
+	 */
+	int CompareRom(nes::CpuDifferential& differential, const char* romPath, std::uint64_t cycleCount, long startAddress)
+	{
+		nes::RomFile rom;
+		if (!rom.LoadFromDisk(romPath) || !rom.IsValidRom())
+		{
+			std::cerr << "Unable to load ROM file: " << romPath << std::endl;
+			return 1;
+		}
+
+		differential.GetReferenceRam().StoreRomData(rom);
+
+		if (startAddress < 0)
+		{
+			differential.GetReferenceCpu().SetProgramCounterToResetVector();
+		}
+		else
+		{
+			differential.GetReferenceCpu().SetProgramCounterToAddress(static_cast<std::uint16_t>(startAddress));
+		}
+
+		differential.SynchronizeCandidate();
+
+		nes::CpuDifferential::Result result = differential.Run(cycleCount);
+		differential.WriteReport((result == nes::CpuDifferential::Result::Diverged) ? std::cerr : std::cout);
+
+		return (result == nes::CpuDifferential::Result::Match || result == nes::CpuDifferential::Result::Jammed) ? 0 : 1;
+	}
+
+	/**
+	 * Compare both engines on randomized programs, one per seed
+	 * The IRQ and NMI lines are driven randomly along the way
+	 * @param	differential	Differential with the engines to compare
+	 * @param	firstSeed		Seed of the first program
+	 * @param	seedCount		Number of programs to run
+	 * @param	cycleCount		Number of cycles to run every program for
+	 * @return	Exit code
+	 */
+	int CompareRandomPrograms(nes::CpuDifferential& differential, std::uint64_t firstSeed, std::uint64_t seedCount, std::uint64_t cycleCount)
+	{
+		std::vector<std::uint8_t> program(nes::CpuDifferential::FUZZ_HEADER_SIZE + RANDOM_PROGRAM_SIZE);
+		std::uint64_t stepCount = 0;
+
+		for (std::uint64_t seed = firstSeed; seed < firstSeed + seedCount; ++seed)
+		{
+			std::mt19937_64 random(seed);
+			for (std::uint8_t& value : program)
+			{
+				value = static_cast<std::uint8_t>(random());
+			}
+
+			differential.LoadFuzzInput(program.data(), program.size());
+
+			nes::CpuDifferential::Result result = nes::CpuDifferential::Result::Match;
+			for (std::uint64_t cycle = 0; cycle < cycleCount && result == nes::CpuDifferential::Result::Match; cycle += RANDOM_SLICE_CYCLES)
+			{
+				std::uint64_t lines = random();
+				differential.SetIrqLine(nes::CPU::IrqSource::External, (lines & 0x03) == 0);
+				differential.SetNmiLine((lines & 0x1C) == 0);
+
+				result = differential.Run(RANDOM_SLICE_CYCLES);
+			}
+
+			if (result == nes::CpuDifferential::Result::Diverged || result == nes::CpuDifferential::Result::Unavailable)
+			{
+				std::cerr << "Seed " << seed << ": ";
+				differential.WriteReport(std::cerr);
+				return 1;
+			}
+
+			stepCount += differential.GetMatchedStepCount();
+		}
+
+		std::cout << seedCount << " programs matched, " << stepCount << " steps compared" << std::endl;
+		return 0;
+	}
+}
+
+/**
+ * Runs two CPU engines side by side and reports the first step where their
+ * registers, cycle counter, interrupt lines or memory differ, along with the
+ * last instructions leading up to it
+ *
+ * Usage: nes_differential <reference> <candidate> rom <ROM file> <cycle count> [start address]
+ *        nes_differential <reference> <candidate> random <first seed> <seed count> <cycle count>
+ * Engines are "table", "interpreter", "cycle" and "jit". The start address is
+ * hexadecimal and defaults to the reset vector. Random programs are built from
+ * their seed the same way the fuzz target builds them from its input.
+ * The exit code is 0 when both engines agreed.
+ */
+int main(int argc, char* argv[])
+{
+	nes::CpuDifferential::Engine reference;
+	nes::CpuDifferential::Engine candidate;
+
+	bool isValid = (argc >= 6 && nes::CpuDifferential::ParseEngineName(argv[1], reference) && nes::CpuDifferential::ParseEngineName(argv[2], candidate));
+	std::string_view mode = isValid ? argv[3] : "";
+
+	if (!(mode == "rom" || (mode == "random" && argc >= 7)))
+	{
+		std::cerr << "Usage: " << argv[0] << " <reference> <candidate> rom <ROM file> <cycle count> [start address]" << std::endl;
+		std::cerr << "       " << argv[0] << " <reference> <candidate> random <first seed> <seed count> <cycle count>" << std::endl;
+		std::cerr << "Engines: table, interpreter, cycle, jit" << std::endl;
+		return 1;
+	}
+
+	nes::CpuDifferential differential(reference, candidate, TRACE_LENGTH);
+
+	if (mode == "rom")
+	{
+		long startAddress = (argc > 6) ? static_cast<long>(std::strtoul(argv[6], nullptr, 16) & 0xFFFF) : -1;
+		return CompareRom(differential, argv[4], std::strtoull(argv[5], nullptr, 10), startAddress);
+	}
+
+	return CompareRandomPrograms(differential, std::strtoull(argv[4], nullptr, 10), std::strtoull(argv[5], nullptr, 10), std::strtoull(argv[6], nullptr, 10));
+}
@@ -0,0 +1,67 @@
+#include "cpu/cpu.hpp"
+#include "cpu/cpu_golden_log.hpp"
+#include "io/rom_file.hpp"
+#include "ram/ram.hpp"
+
+#include <cstdlib>	// std::strtoul
+#include <iostream>
+
+/**
+ * Runs a ROM without the editor and compares every executed instruction against
+ * a reference log, stopping at the first difference
+ *
+ * Usage: nes_golden_log <ROM file> <reference log> [start address] [line limit]
+ * The start address is hexadecimal and defaults to the reset vector. For nestest,
+ * use C000 to run the automated tests. A line limit of 0 compares the whole log.
+ * The exit code is 0 when every line matched, which makes it easy to run the
+ * comparison after every build.
+ */
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		std::cerr << "Usage: " << argv[0] << " <ROM file> <reference log> [start address] [line limit]" << std::endl;
+		return 1;
+	}
+
+	nes::RomFile rom;
+	if (!rom.LoadFromDisk(argv[1]) || !rom.IsValidRom())
+	{
+		std::cerr << "Unable to load ROM file: " << argv[1] << std::endl;
+		return 1;
+	}
+
+	// Number of matching lines printed before the first difference
+	constexpr std::size_t CONTEXT_LINE_COUNT = 16;
+
+	nes::CpuGoldenLog goldenLog(CONTEXT_LINE_COUNT);
+	if (!goldenLog.Open(argv[2]))
+	{
+		std::cerr << "Unable to read reference log: " << argv[2] << std::endl;
+		return 1;
+	}
+
+	nes::RAM ram;
+	if (!ram.StoreRomData(rom))
+	{
+		std::cerr << "Unsupported mapper: " << static_cast<int>(rom.GetRomMapperTypeId()) << std::endl;
+		return 1;
+	}
+
+	nes::CPU cpu(ram);
+	if (argc > 3)
+	{
+		cpu.SetProgramCounterToAddress(static_cast<std::uint16_t>(std::strtoul(argv[3], nullptr, 16)));
+	}
+	else
+	{
+		cpu.SetProgramCounterToResetVector();
+	}
+
+	std::size_t lineLimit = (argc > 4) ? static_cast<std::size_t>(std::strtoul(argv[4], nullptr, 10)) : 0;
+
+	nes::CpuGoldenLog::Result result = goldenLog.Compare(cpu, lineLimit);
+	goldenLog.WriteReport((result == nes::CpuGoldenLog::Result::Match) ? std::cout : std::cerr, cpu);
+
+	return (result == nes::CpuGoldenLog::Result::Match) ? 0 : 1;
+}
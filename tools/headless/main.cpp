@@ -0,0 +1,581 @@
+#include "cpu/cpu.hpp"
+#include "cpu/cpu_profiler.hpp"
+#include "cpu/cpu_trace_file.hpp"
+#include "cpu/cpu_watchpoints.hpp"
+#include "io/rom_file.hpp"
+#include "io/save_state.hpp"
+#include "ram/ram.hpp"
+#include "utility/thread_pool.hpp"
+
+#include <chrono>
+#include <cstdlib>	// std::strtoul / std::strtoull
+#include <fstream>
+#include <iomanip>	// std::setprecision
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+	/**
+	 * Single line of the job list
+	 */
+	struct Job
+	{
+		std::string RomPath;
+
+		// Start at the reset vector when false
+		bool HasStartAddress;
+		std::uint16_t StartAddress;
+
+		std::uint64_t CycleCount;
+
+		// Output options, empty paths are not written
+		std::string TracePath;
+		std::string StatePath;
+		bool Profile;
+
+		// Runs stop on the first access that matches any of these
+		std::vector<nes::CpuWatchpoints::Watchpoint> Watchpoints;
+	};
+
+	/**
+	 * Outcome of a job, every job only ever writes to its own result
+	 */
+	struct JobResult
+	{
+		// Empty when the job ran
+		std::string Error;
+
+		nes::CPU::StopReason Reason;
+		std::uint64_t CyclesRun;
+		double Seconds;
+
+		// CPU state once the run stopped
+		std::uint16_t PC;
+		std::uint8_t A;
+		std::uint8_t X;
+		std::uint8_t Y;
+		std::uint8_t P;
+		std::uint8_t SP;
+
+		// Only filled in for jobs that stopped on a watchpoint
+		nes::CpuWatchpoints::Hit WatchpointHit;
+
+		// Only filled in for jobs that were profiled
+		std::vector<nes::CpuProfiler::Entry> TopOpCodes;
+		std::vector<std::string> TopOpCodeNames;
+	};
+
+	/** Number of op-codes listed for a profiled job */
+	constexpr std::size_t PROFILE_OP_CODE_COUNT = 8;
+
+	/**
+	 * Parse a watchpoint option of the job list
+	 *	<read|write|exec>:<first address>[-<last address>][:<value>]
+	 * Addresses and the value are hexadecimal.
+	 * @param	text		Option without the "watch=" prefix
+	 * @param	watchpoint	Parsed watchpoint
+	 * @return	True if the option was valid
+	 */
+	bool ParseWatchpoint(const std::string& text, nes::CpuWatchpoints::Watchpoint& watchpoint)
+	{
+		std::size_t typeEnd = text.find(':');
+		std::string type = text.substr(0, typeEnd);
+
+		if (type == "read")
+		{
+			watchpoint.Type = nes::CpuWatchpoints::Access::Read;
+		}
+		else if (type == "write")
+		{
+			watchpoint.Type = nes::CpuWatchpoints::Access::Write;
+		}
+		else if (type == "exec")
+		{
+			watchpoint.Type = nes::CpuWatchpoints::Access::Execute;
+		}
+		else
+		{
+			return false;
+		}
+
+		if (typeEnd == std::string::npos)
+		{
+			return false;
+		}
+
+		const char* start = text.c_str() + typeEnd + 1;
+		char* end = nullptr;
+
+		unsigned long firstAddress = std::strtoul(start, &end, 16);
+		unsigned long lastAddress = firstAddress;
+		if (end == start || firstAddress > 0xFFFF)
+		{
+			return false;
+		}
+
+		if (*end == '-')
+		{
+			start = end + 1;
+			lastAddress = std::strtoul(start, &end, 16);
+			if (end == start || lastAddress > 0xFFFF || lastAddress < firstAddress)
+			{
+				return false;
+			}
+		}
+
+		watchpoint.FirstAddress = static_cast<std::uint16_t>(firstAddress);
+		watchpoint.LastAddress = static_cast<std::uint16_t>(lastAddress);
+		watchpoint.HasValue = (*end == ':');
+		watchpoint.Value = 0;
+
+		if (watchpoint.HasValue)
+		{
+			start = end + 1;
+			unsigned long value = std::strtoul(start, &end, 16);
+			if (end == start || value > 0xFF)
+			{
+				return false;
+			}
+
+			watchpoint.Value = static_cast<std::uint8_t>(value);
+		}
+
+		return (*end == '\0');
+	}
+
+	/**
+	 * Parse the job list
+	 * Every non-empty line that does not start with '#' describes a job:
+	 *	<ROM path> <start address> <cycle count> [trace=<path>] [state=<path>] [profile] [watch=<watchpoint>...]
+	 * The start address is hexadecimal, or "reset" to use the reset vector.
+	 * See ParseWatchpoint for the format of a watchpoint.
+	 * @param	stream	Stream to read the job list from
+	 * @param	jobs	Parsed jobs are appended to this list
+	 * @param	error	Description of the first invalid line
+	 * @return	True when every line was valid
+	 */
+	bool ParseJobList(std::istream& stream, std::vector<Job>& jobs, std::string& error)
+	{
+		std::string line;
+		std::size_t lineNumber = 0;
+
+		while (std::getline(stream, line))
+		{
+			++lineNumber;
+
+			std::istringstream fields(line);
+			Job job {};
+
+			std::string startAddress, cycleCount;
+			if (!(fields >> job.RomPath) || job.RomPath[0] == '#')
+			{
+				continue;
+			}
+
+			if (!(fields >> startAddress >> cycleCount))
+			{
+				error = "line " + std::to_string(lineNumber) + ": expected <ROM path> <start address> <cycle count>";
+				return false;
+			}
+
+			char* end = nullptr;
+			job.HasStartAddress = (startAddress != "reset");
+			if (job.HasStartAddress)
+			{
+				unsigned long address = std::strtoul(startAddress.c_str(), &end, 16);
+				if (*end != '\0' || address > 0xFFFF)
+				{
+					error = "line " + std::to_string(lineNumber) + ": invalid start address " + startAddress;
+					return false;
+				}
+
+				job.StartAddress = static_cast<std::uint16_t>(address);
+			}
+
+			job.CycleCount = std::strtoull(cycleCount.c_str(), &end, 10);
+			if (*end != '\0')
+			{
+				error = "line " + std::to_string(lineNumber) + ": invalid cycle count " + cycleCount;
+				return false;
+			}
+
+			std::string option;
+			while (fields >> option)
+			{
+				if (option.rfind("trace=", 0) == 0)
+				{
+					job.TracePath = option.substr(6);
+				}
+				else if (option.rfind("state=", 0) == 0)
+				{
+					job.StatePath = option.substr(6);
+				}
+				else if (option == "profile")
+				{
+					job.Profile = true;
+				}
+				else if (option.rfind("watch=", 0) == 0)
+				{
+					nes::CpuWatchpoints::Watchpoint watchpoint {};
+					if (!ParseWatchpoint(option.substr(6), watchpoint))
+					{
+						error = "line " + std::to_string(lineNumber) + ": invalid watchpoint " + option;
+						return false;
+					}
+
+					job.Watchpoints.push_back(watchpoint);
+				}
+				else
+				{
+					error = "line " + std::to_string(lineNumber) + ": unknown option " + option;
+					return false;
+				}
+			}
+
+			jobs.push_back(job);
+		}
+
+		return true;
+	}
+
+	/**
+	 * Run a job on its own RAM and CPU, nothing is shared with other jobs
+	 * @param	job		Job to run
+	 * @return	Outcome of the job
+	 */
+	JobResult RunJob(const Job& job)
+	{
+		JobResult result {};
+
+		nes::RomFile rom;
+		if (!rom.LoadFromDisk(job.RomPath) || !rom.IsValidRom())
+		{
+			result.Error = "unable to load ROM file";
+			return result;
+		}
+
+		// Both are too large to comfortably live on a worker's stack
+		auto ram = std::make_unique<nes::RAM>();
+		if (!ram->StoreRomData(rom))
+		{
+			result.Error = "unsupported mapper";
+			return result;
+		}
+
+		auto cpu = std::make_unique<nes::CPU>(*ram);
+		if (job.HasStartAddress)
+		{
+			cpu->SetProgramCounterToAddress(job.StartAddress);
+		}
+		else
+		{
+			cpu->SetProgramCounterToResetVector();
+		}
+
+		nes::CpuTraceWriter traceWriter;
+		if (!job.TracePath.empty())
+		{
+			if (!traceWriter.Open(job.TracePath))
+			{
+				result.Error = "unable to create trace file";
+				return result;
+			}
+
+			cpu->SetTraceWriter(&traceWriter);
+		}
+
+		if (job.Profile)
+		{
+			cpu->EnableProfiling();
+		}
+
+		for (const nes::CpuWatchpoints::Watchpoint& watchpoint : job.Watchpoints)
+		{
+			if (watchpoint.HasValue)
+			{
+				cpu->SetWatchpoint(watchpoint.Type, watchpoint.FirstAddress, watchpoint.LastAddress, watchpoint.Value);
+			}
+			else
+			{
+				cpu->SetWatchpoint(watchpoint.Type, watchpoint.FirstAddress, watchpoint.LastAddress);
+			}
+		}
+
+		std::uint64_t startCycle = cpu->GetCurrentCycle();
+		auto startTime = std::chrono::steady_clock::now();
+
+		result.Reason = cpu->RunCycles(job.CycleCount);
+
+		result.Seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+		result.CyclesRun = cpu->GetCurrentCycle() - startCycle;
+
+		cpu->SetTraceWriter(nullptr);
+		traceWriter.Close();
+
+		result.PC = cpu->GetProgramCounter();
+		result.A = cpu->GetRegister(nes::CPU::RegisterType::A).value;
+		result.X = cpu->GetRegister(nes::CPU::RegisterType::X).value;
+		result.Y = cpu->GetRegister(nes::CPU::RegisterType::Y).value;
+		result.P = cpu->GetRegister(nes::CPU::RegisterType::P).value;
+		result.SP = cpu->GetRegister(nes::CPU::RegisterType::SP).value;
+
+		if (result.Reason == nes::CPU::StopReason::Watchpoint)
+		{
+			result.WatchpointHit = cpu->GetLastWatchpointHit();
+		}
+
+		if (job.Profile)
+		{
+			result.TopOpCodes = cpu->GetProfiler()->GetTopOpCodes(PROFILE_OP_CODE_COUNT);
+			for (const nes::CpuProfiler::Entry& entry : result.TopOpCodes)
+			{
+				result.TopOpCodeNames.emplace_back(cpu->GetOpCodeName(static_cast<std::uint8_t>(entry.Key)));
+			}
+		}
+
+		if (!job.StatePath.empty() && !nes::SaveState::WriteToDisk(job.StatePath, *cpu, *ram))
+		{
+			result.Error = "unable to write save state";
+		}
+
+		return result;
+	}
+
+	/**
+	 * Convert a stop reason into the name used in the result file
+	 */
+	const char* GetStopReasonName(nes::CPU::StopReason reason)
+	{
+		switch (reason)
+		{
+			case nes::CPU::StopReason::CycleBudget:
+				return "cycle_budget";
+			case nes::CPU::StopReason::Breakpoint:
+				return "breakpoint";
+			case nes::CPU::StopReason::Watchpoint:
+				return "watchpoint";
+			case nes::CPU::StopReason::Jammed:
+				return "jammed";
+			case nes::CPU::StopReason::Condition:
+				return "condition";
+			default:
+				return "unknown";
+		}
+	}
+
+	/**
+	 * Convert a watchpoint access type into the name used in the job list and
+	 * the result file
+	 */
+	const char* GetAccessName(nes::CpuWatchpoints::Access type)
+	{
+		switch (type)
+		{
+			case nes::CpuWatchpoints::Access::Read:
+				return "read";
+			case nes::CpuWatchpoints::Access::Write:
+				return "write";
+			case nes::CpuWatchpoints::Access::Execute:
+				return "exec";
+			default:
+				return "unknown";
+		}
+	}
+
+	/**
+	 * Write a string as a quoted JSON string
+	 */
+	void WriteJsonString(std::ostream& stream, const std::string& value)
+	{
+		stream << '"';
+
+		for (char character : value)
+		{
+			if (character == '"' || character == '\\')
+			{
+				stream << '\\' << character;
+			}
+			else if (static_cast<unsigned char>(character) < 0x20)
+			{
+				stream << "\\u" << std::hex << std::setfill('0') << std::setw(4) << static_cast<int>(character) << std::dec;
+			}
+			else
+			{
+				stream << character;
+			}
+		}
+
+		stream << '"';
+	}
+
+	/**
+	 * Write all results as a JSON array, in the same order as the job list
+	 */
+	void WriteResults(std::ostream& stream, const std::vector<Job>& jobs, const std::vector<JobResult>& results)
+	{
+		stream << "[\n";
+
+		for (std::size_t i = 0; i < jobs.size(); ++i)
+		{
+			const Job& job = jobs[i];
+			const JobResult& result = results[i];
+
+			stream << "  {\"job\": " << i << ", \"rom\": ";
+			WriteJsonString(stream, job.RomPath);
+
+			if (!result.Error.empty())
+			{
+				stream << ", \"error\": ";
+				WriteJsonString(stream, result.Error);
+			}
+
+			if (result.Error.empty() || result.CyclesRun != 0)
+			{
+				double megahertz = (result.Seconds > 0.0) ? (result.CyclesRun / result.Seconds / 1000000.0) : 0.0;
+
+				stream << ", \"stop_reason\": \"" << GetStopReasonName(result.Reason) << '"';
+				stream << ", \"cycles\": " << result.CyclesRun;
+				stream << ", \"seconds\": " << std::setprecision(6) << result.Seconds;
+				stream << ", \"mhz\": " << std::setprecision(6) << megahertz;
+				stream << ", \"pc\": " << result.PC << ", \"a\": " << +result.A << ", \"x\": " << +result.X;
+				stream << ", \"y\": " << +result.Y << ", \"p\": " << +result.P << ", \"sp\": " << +result.SP;
+			}
+
+			if (result.Error.empty() && result.Reason == nes::CPU::StopReason::Watchpoint)
+			{
+				const nes::CpuWatchpoints::Hit& hit = result.WatchpointHit;
+
+				stream << ", \"watchpoint\": {\"access\": \"" << GetAccessName(hit.Type) << '"';
+				stream << ", \"address\": " << hit.Address << ", \"value\": " << +hit.Value;
+				stream << ", \"pc\": " << hit.ProgramCounter << ", \"cycle\": " << hit.Cycle << '}';
+			}
+
+			if (!result.TopOpCodes.empty())
+			{
+				stream << ", \"top_opcodes\": [";
+
+				for (std::size_t j = 0; j < result.TopOpCodes.size(); ++j)
+				{
+					const nes::CpuProfiler::Entry& entry = result.TopOpCodes[j];
+
+					stream << ((j == 0) ? "" : ", ") << "{\"opcode\": " << entry.Key << ", \"name\": ";
+					WriteJsonString(stream, result.TopOpCodeNames[j]);
+					stream << ", \"executions\": " << entry.Executions << ", \"cycles\": " << entry.Cycles << '}';
+				}
+
+				stream << ']';
+			}
+
+			stream << ((i + 1 < jobs.size()) ? "},\n" : "}\n");
+		}
+
+		stream << "]\n";
+	}
+}
+
+/**
+ * Runs ROMs without the editor, either a single ROM or a list of independent
+ * jobs in parallel, every job on its own RAM and CPU
+ *
+ * Usage: nes_headless <ROM file> <cycle count> [start address]
+ *        nes_headless <job list> <result file> [thread count]
+ * A single ROM runs for the given number of cycles, starting at the start
+ * address (hexadecimal) or at the reset vector, and its result is written to
+ * the standard output. Any first argument that is not an iNES file is read as
+ * a job list, see ParseJobList for its format. The results are written as a
+ * JSON array with one object per job, in the order of the job list. The
+ * thread count defaults to one thread per hardware thread.
+ * The exit code is 0 when every job ran without errors.
+ */
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		std::cerr << "Usage: " << argv[0] << " <ROM file> <cycle count> [start address]" << std::endl;
+		std::cerr << "       " << argv[0] << " <job list> <result file> [thread count]" << std::endl;
+		return 1;
+	}
+
+	// A single ROM is simply a job list of one job
+	nes::RomFile rom;
+	if (rom.LoadFromDisk(argv[1]) && rom.IsValidRom())
+	{
+		Job job {};
+		job.RomPath = argv[1];
+		job.CycleCount = std::strtoull(argv[2], nullptr, 10);
+		job.HasStartAddress = (argc > 3);
+		job.StartAddress = job.HasStartAddress ? static_cast<std::uint16_t>(std::strtoul(argv[3], nullptr, 16)) : 0;
+
+		std::vector<Job> jobs { job };
+		std::vector<JobResult> results { RunJob(jobs[0]) };
+		WriteResults(std::cout, jobs, results);
+
+		return results[0].Error.empty() ? 0 : 1;
+	}
+
+	std::ifstream jobListFile(argv[1]);
+	if (!jobListFile.is_open())
+	{
+		std::cerr << "Unable to read job list: " << argv[1] << std::endl;
+		return 1;
+	}
+
+	std::vector<Job> jobs;
+	std::string error;
+	if (!ParseJobList(jobListFile, jobs, error))
+	{
+		std::cerr << "Invalid job list: " << error << std::endl;
+		return 1;
+	}
+
+	std::ofstream resultFile(argv[2], std::ios_base::out | std::ios_base::trunc);
+	if (!resultFile.is_open())
+	{
+		std::cerr << "Unable to create result file: " << argv[2] << std::endl;
+		return 1;
+	}
+
+	std::size_t threadCount = (argc > 3) ? static_cast<std::size_t>(std::strtoul(argv[3], nullptr, 10)) : 0;
+
+	// Every job writes to its own slot, so the results need no locking
+	std::vector<JobResult> results(jobs.size());
+	auto startTime = std::chrono::steady_clock::now();
+
+	{
+		nes::ThreadPool threadPool(threadCount);
+		threadCount = threadPool.GetThreadCount();
+
+		for (std::size_t i = 0; i < jobs.size(); ++i)
+		{
+			threadPool.Submit([&jobs, &results, i]()
+			{
+				results[i] = RunJob(jobs[i]);
+			});
+		}
+
+		threadPool.Wait();
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	WriteResults(resultFile, jobs, results);
+
+	std::uint64_t totalCycles = 0;
+	std::size_t failedJobCount = 0;
+
+	for (const JobResult& result : results)
+	{
+		totalCycles += result.CyclesRun;
+		failedJobCount += result.Error.empty() ? 0 : 1;
+	}
+
+	std::cout << jobs.size() << " jobs on " << threadCount << " threads in " << seconds << " s, ";
+	std::cout << (seconds > 0.0 ? totalCycles / seconds / 1000000.0 : 0.0) << " emulated MHz in total, ";
+	std::cout << failedJobCount << " failed" << std::endl;
+
+	return (failedJobCount == 0) ? 0 : 1;
+}
@@ -0,0 +1,49 @@
+#include "io/rom_generator.hpp"
+
+#include <cstdlib>	// std::strtoull
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+/**
+ * Writes a synthetic iNES image that stresses a single kind of 6502 code
+ *
+ * Usage: nes_rom_generator <workload> <program size> <seed> <output file>
+ * Workloads are "alu", "memcpy", "branches", "calls" and "stack". The program
+ * size is the approximate number of bytes of workload code, up to 28672. The
+ * same arguments always produce the exact same file.
+ */
+int main(int argc, char* argv[])
+{
+	nes::RomGenerator::Workload workload;
+
+	if (argc < 5 || !nes::RomGenerator::ParseWorkloadName(argv[1], workload))
+	{
+		std::cerr << "Usage: " << argv[0] << " <workload> <program size> <seed> <output file>" << std::endl;
+		std::cerr << "Workloads:";
+
+		for (nes::RomGenerator::Workload entry : nes::RomGenerator::WORKLOADS)
+		{
+			std::cerr << ' ' << nes::RomGenerator::GetWorkloadName(entry);
+		}
+
+		std::cerr << std::endl;
+		return 1;
+	}
+
+	std::size_t programSize = static_cast<std::size_t>(std::strtoull(argv[2], nullptr, 10));
+	std::uint64_t seed = std::strtoull(argv[3], nullptr, 10);
+
+	nes::RomGenerator generator(seed);
+	std::vector<std::uint8_t> image = generator.Generate(workload, programSize);
+
+	std::ofstream output(argv[4], std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+	if (!output.is_open())
+	{
+		std::cerr << "Unable to create output file: " << argv[4] << std::endl;
+		return 1;
+	}
+
+	output.write(reinterpret_cast<const char*>(image.data()), static_cast<std::streamsize>(image.size()));
+	return output.good() ? 0 : 1;
+}
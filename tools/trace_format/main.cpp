@@ -0,0 +1,57 @@
+#include "cpu/cpu.hpp"
+#include "cpu/cpu_logger.hpp"
+#include "cpu/cpu_trace_file.hpp"
+#include "ram/ram.hpp"
+
+#include <fstream>
+#include <iostream>
+
+/**
+ * Renders a binary CPU trace as text, one line per instruction in exactly the
+ * same format as CpuLogger
+ *
+ * Usage: nes_trace_format <trace file> [output file]
+ * The text is written to the standard output when no output file is given.
+ */
+int main(int argc, char* argv[])
+{
+	if (argc < 2)
+	{
+		std::cerr << "Usage: " << argv[0] << " <trace file> [output file]" << std::endl;
+		return 1;
+	}
+
+	nes::CpuTraceReader reader;
+	if (!reader.Open(argv[1]))
+	{
+		std::cerr << "Unable to read trace file: " << argv[1] << std::endl;
+		return 1;
+	}
+
+	std::ofstream outputFile;
+	if (argc > 2)
+	{
+		outputFile.open(argv[2], std::ios_base::out | std::ios_base::trunc);
+		if (!outputFile.is_open())
+		{
+			std::cerr << "Unable to create output file: " << argv[2] << std::endl;
+			return 1;
+		}
+	}
+
+	std::ostream& output = outputFile.is_open() ? outputFile : std::cout;
+
+	// Only used to look up instruction names and sizes
+	nes::RAM ram;
+	nes::CPU cpu(ram);
+
+	nes::CpuTraceRecord record;
+	while (reader.Read(record))
+	{
+		std::uint8_t opCodeSize = cpu.GetOpCodeSize(record.OpCode);
+		output << nes::CpuLogger::ConstructStreamFromRecord(record, cpu.GetOpCodeName(record.OpCode), opCodeSize).str() << '\n';
+	}
+
+	output.flush();
+	return 0;
+}
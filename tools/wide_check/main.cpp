@@ -0,0 +1,152 @@
+#include "cpu/cpu.hpp"
+#include "cpu/wide/cpu_wide.hpp"
+#include "io/rom_file.hpp"
+#include "ram/ram.hpp"
+
+#include <algorithm>	// std::equal
+#include <chrono>
+#include <cstdlib>	// std::strtoul / std::strtoull
+#include <iostream>
+#include <memory>
+#include <vector>
+
+namespace
+{
+	/**
+	 * Load the ROM and the input of a lane, every lane gets its index as a
+	 * 16-bit little-endian input
+	 * @param	cpu				CPU of the lane
+	 * @param	ram				RAM of the lane
+	 * @param	rom				ROM to run
+	 * @param	lane			Index of the lane
+	 * @param	inputAddress	Address the input is written to
+	 * @param	startAddress	Address to start at, or -1 for the reset vector
+	 */
+	void SetUpLane(nes::CPU& cpu, nes::RAM& ram, const nes::RomFile& rom, std::size_t lane, std::uint16_t inputAddress, long startAddress)
+	{
+		ram.StoreRomData(rom);
+
+		nes::Byte input;
+		input.value = static_cast<std::uint8_t>(lane);
+		ram.WriteByte(inputAddress, input);
+		input.value = static_cast<std::uint8_t>(lane >> 8);
+		ram.WriteByte(static_cast<std::uint16_t>(inputAddress + 1), input);
+
+		if (startAddress < 0)
+		{
+			cpu.SetProgramCounterToResetVector();
+		}
+		else
+		{
+			cpu.SetProgramCounterToAddress(static_cast<std::uint16_t>(startAddress));
+		}
+	}
+
+	/**
+	 * Compare the CPU state and the entire memory of two lanes
+	 * @return	True if both are identical
+	 */
+	bool IsSameState(const nes::CPU& cpuA, const nes::RAM& ramA, const nes::CPU& cpuB, const nes::RAM& ramB)
+	{
+		std::uint8_t stateA[nes::CPU::STATE_SIZE];
+		std::uint8_t stateB[nes::CPU::STATE_SIZE];
+		cpuA.WriteState(stateA);
+		cpuB.WriteState(stateB);
+
+		std::vector<std::uint8_t> memoryA(ramA.GetSize());
+		std::vector<std::uint8_t> memoryB(ramB.GetSize());
+		ramA.WriteState(memoryA.data());
+		ramB.WriteState(memoryB.data());
+
+		return std::equal(stateA, stateA + nes::CPU::STATE_SIZE, stateB) && (memoryA == memoryB);
+	}
+}
+
+/**
+ * Runs many instances of a ROM on the wide core and on separate scalar CPUs,
+ * and checks that every lane ends up in exactly the same state
+ *
+ * Usage: nes_wide_check <ROM file> <lane count> <cycle count> [start address] [input address]
+ * Every lane receives its index as a 16-bit input at the input address, which
+ * is hexadecimal and defaults to 0000. The start address is hexadecimal and
+ * defaults to the reset vector.
+ * The exit code is 0 when every lane matched.
+ */
+int main(int argc, char* argv[])
+{
+	if (argc < 4)
+	{
+		std::cerr << "Usage: " << argv[0] << " <ROM file> <lane count> <cycle count> [start address] [input address]" << std::endl;
+		return 1;
+	}
+
+	nes::RomFile rom;
+	if (!rom.LoadFromDisk(argv[1]) || !rom.IsValidRom())
+	{
+		std::cerr << "Unable to load ROM file: " << argv[1] << std::endl;
+		return 1;
+	}
+
+	std::size_t laneCount = static_cast<std::size_t>(std::strtoul(argv[2], nullptr, 10));
+	std::uint64_t cycleCount = std::strtoull(argv[3], nullptr, 10);
+	long startAddress = (argc > 4) ? static_cast<long>(std::strtoul(argv[4], nullptr, 16) & 0xFFFF) : -1;
+	std::uint16_t inputAddress = (argc > 5) ? static_cast<std::uint16_t>(std::strtoul(argv[5], nullptr, 16)) : 0x0000;
+
+	// Reference run, every lane on its own
+	std::vector<std::unique_ptr<nes::RAM>> rams;
+	std::vector<std::unique_ptr<nes::CPU>> cpus;
+	std::vector<nes::CPU::StopReason> reasons;
+
+	for (std::size_t lane = 0; lane < laneCount; ++lane)
+	{
+		rams.push_back(std::make_unique<nes::RAM>());
+		cpus.push_back(std::make_unique<nes::CPU>(*rams.back()));
+		SetUpLane(*cpus.back(), *rams.back(), rom, lane, inputAddress, startAddress);
+	}
+
+	auto startTime = std::chrono::steady_clock::now();
+
+	for (std::size_t lane = 0; lane < laneCount; ++lane)
+	{
+		reasons.push_back(cpus[lane]->RunCycles(cycleCount));
+	}
+
+	double scalarSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	// Same lanes on the wide core
+	nes::CpuWide wide(laneCount);
+	for (std::size_t lane = 0; lane < laneCount; ++lane)
+	{
+		SetUpLane(wide.GetLaneCpu(lane), wide.GetLaneRam(lane), rom, lane, inputAddress, startAddress);
+	}
+
+	startTime = std::chrono::steady_clock::now();
+	wide.RunCycles(cycleCount);
+	double wideSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+	std::size_t mismatchCount = 0;
+	for (std::size_t lane = 0; lane < laneCount; ++lane)
+	{
+		bool isSameReason = (wide.GetLaneStopReason(lane) == reasons[lane]);
+		if (!isSameReason || !IsSameState(*cpus[lane], *rams[lane], wide.GetLaneCpu(lane), wide.GetLaneRam(lane)))
+		{
+			if (mismatchCount == 0)
+			{
+				std::cerr << "Lane " << lane << " differs, PC " << std::hex << cpus[lane]->GetProgramCounter();
+				std::cerr << " on its own, PC " << wide.GetLaneCpu(lane).GetProgramCounter() << " on the wide core" << std::dec << std::endl;
+			}
+
+			++mismatchCount;
+		}
+	}
+
+	const nes::CpuWide::Statistics& statistics = wide.GetStatistics();
+	std::uint64_t instructionCount = statistics.VectorInstructions + statistics.ScalarInstructions;
+
+	std::cout << laneCount << " lanes, " << (laneCount - mismatchCount) << " matched" << std::endl;
+	std::cout << "Vector kernels (" << nes::CpuWide::GetInstructionSetName() << "): " << statistics.VectorInstructions << " of ";
+	std::cout << instructionCount << " instructions in " << statistics.VectorGroups << " groups" << std::endl;
+	std::cout << "Scalar CPUs: " << scalarSeconds << " s, wide core: " << wideSeconds << " s" << std::endl;
+
+	return (mismatchCount == 0) ? 0 : 1;
+}
@@ -1,6 +1,7 @@
 #ifndef NES_BIT_TOOLS_HPP
 #define NES_BIT_TOOLS_HPP
 
+#include <cstddef>
 #include <cstdint>
 
 /**
@@ -132,6 +133,38 @@ namespace nes
 	{
 		return ((msb.value << 8) | lsb.value);
 	}
+
+	/**
+	 * Store the lowest bytes of a value, least significant byte first
+	 * @param	destination		Buffer to write the bytes to
+	 * @param	value			Value to store
+	 * @param	size			Number of bytes to store
+	 */
+	inline void WriteLittleEndian(std::uint8_t* destination, std::uint64_t value, std::size_t size)
+	{
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			destination[i] = static_cast<std::uint8_t>(value >> (8 * i));
+		}
+	}
+
+	/**
+	 * Load a value that was stored least significant byte first
+	 * @param	source	Buffer to read the bytes from
+	 * @param	size	Number of bytes to read
+	 * @return	Value stored in the bytes
+	 */
+	inline std::uint64_t ReadLittleEndian(const std::uint8_t* source, std::size_t size)
+	{
+		std::uint64_t value = 0;
+
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			value |= static_cast<std::uint64_t>(source[i]) << (8 * i);
+		}
+
+		return value;
+	}
 }
 
 #endif //! NES_BIT_TOOLS_HPP
@@ -0,0 +1,146 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>	// std::max
+#include <utility>		// std::move
+
+nes::ThreadPool::ThreadPool(std::size_t threadCount) :
+	QueuedTaskCount(0),
+	UnfinishedTaskCount(0),
+	NextQueue(0),
+	Stopping(false)
+{
+	if (threadCount == 0)
+	{
+		// May report 0 when the number of hardware threads is unknown
+		threadCount = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+	}
+
+	for (std::size_t i = 0; i < threadCount; ++i)
+	{
+		Queues.push_back(std::make_unique<WorkerQueue>());
+	}
+
+	// Queues have to exist before any worker starts stealing from them
+	for (std::size_t i = 0; i < threadCount; ++i)
+	{
+		Workers.emplace_back(&ThreadPool::RunWorker, this, i);
+	}
+}
+
+nes::ThreadPool::~ThreadPool()
+{
+	Wait();
+
+	{
+		std::lock_guard<std::mutex> lock(StateMutex);
+		Stopping = true;
+	}
+
+	TaskAvailable.notify_all();
+
+	for (std::thread& worker : Workers)
+	{
+		worker.join();
+	}
+}
+
+void nes::ThreadPool::Submit(Task task)
+{
+	{
+		std::lock_guard<std::mutex> lock(StateMutex);
+
+		// Counted while the lock is held, so a worker that takes the task right
+		// away can never see the count drop below zero
+		WorkerQueue& queue = *Queues[NextQueue];
+		NextQueue = (NextQueue + 1) % Queues.size();
+
+		{
+			std::lock_guard<std::mutex> queueLock(queue.Mutex);
+			queue.Tasks.push_back(std::move(task));
+		}
+
+		++QueuedTaskCount;
+		++UnfinishedTaskCount;
+	}
+
+	TaskAvailable.notify_one();
+}
+
+void nes::ThreadPool::Wait()
+{
+	std::unique_lock<std::mutex> lock(StateMutex);
+	AllTasksFinished.wait(lock, [this]() { return (UnfinishedTaskCount == 0); });
+}
+
+std::size_t nes::ThreadPool::GetThreadCount() const
+{
+	return Workers.size();
+}
+
+void nes::ThreadPool::RunWorker(std::size_t index)
+{
+	for (;;)
+	{
+		Task task;
+
+		if (TakeTask(index, task))
+		{
+			task();
+
+			std::lock_guard<std::mutex> lock(StateMutex);
+			if (--UnfinishedTaskCount == 0)
+			{
+				AllTasksFinished.notify_all();
+			}
+
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(StateMutex);
+		TaskAvailable.wait(lock, [this]() { return (Stopping || QueuedTaskCount != 0); });
+
+		if (QueuedTaskCount == 0)
+		{
+			return;
+		}
+	}
+}
+
+bool nes::ThreadPool::TakeTask(std::size_t index, Task& task)
+{
+	bool found = false;
+
+	// Newest task of our own queue first, it is the most likely to be warm in
+	// the cache, then the oldest task of every other queue
+	for (std::size_t i = 0; i < Queues.size() && !found; ++i)
+	{
+		WorkerQueue& queue = *Queues[(index + i) % Queues.size()];
+		std::lock_guard<std::mutex> queueLock(queue.Mutex);
+
+		if (queue.Tasks.empty())
+		{
+			continue;
+		}
+
+		if (i == 0)
+		{
+			task = std::move(queue.Tasks.back());
+			queue.Tasks.pop_back();
+		}
+		else
+		{
+			task = std::move(queue.Tasks.front());
+			queue.Tasks.pop_front();
+		}
+
+		found = true;
+	}
+
+	if (found)
+	{
+		std::lock_guard<std::mutex> lock(StateMutex);
+		--QueuedTaskCount;
+	}
+
+	return found;
+}
@@ -0,0 +1,106 @@
+#ifndef NES_THREAD_POOL_HPP
+#define NES_THREAD_POOL_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nes
+{
+	/**
+	 * Fixed set of worker threads that execute tasks until the pool is destroyed
+	 *
+	 * Every worker owns a queue. Submitted tasks are spread over the queues, a
+	 * worker takes tasks from the back of its own queue, and once that runs dry
+	 * it steals from the front of the other queues. Workers only block when all
+	 * queues are empty, so long and short tasks balance out without a single
+	 * shared queue every thread has to fight over.
+	 */
+	class ThreadPool
+	{
+	public:
+		using Task = std::function<void()>;
+
+	public:
+		/**
+		 * Start the worker threads
+		 * @param	threadCount		Number of workers, 0 to use one per hardware thread
+		 */
+		explicit ThreadPool(std::size_t threadCount);
+
+		ThreadPool(const ThreadPool& other)				= delete;
+		ThreadPool& operator=(const ThreadPool& other)	= delete;
+
+		/**
+		 * Finish all submitted tasks and stop the worker threads
+		 */
+		~ThreadPool();
+
+		/**
+		 * Queue a task, it runs on whichever worker gets to it first
+		 * @param	task	Task to execute
+		 */
+		void Submit(Task task);
+
+		/**
+		 * Block until every submitted task has finished
+		 */
+		void Wait();
+
+		/**
+		 * Retrieve the number of worker threads
+		 * @return	Number of workers
+		 */
+		std::size_t GetThreadCount() const;
+
+	private:
+		/**
+		 * Tasks waiting to be picked up, owned by a single worker
+		 */
+		struct WorkerQueue
+		{
+			std::mutex Mutex;
+			std::deque<Task> Tasks;
+		};
+
+	private:
+		/**
+		 * Execute tasks until the pool stops
+		 * @param	index	Index of the worker and its queue
+		 */
+		void RunWorker(std::size_t index);
+
+		/**
+		 * Take a task from the worker's own queue, or steal one from another
+		 * @param	index	Index of the worker looking for work
+		 * @param	task	Task to store the result in
+		 * @return	True when a task was found
+		 */
+		bool TakeTask(std::size_t index, Task& task);
+
+	private:
+		std::vector<std::unique_ptr<WorkerQueue>> Queues;
+		std::vector<std::thread> Workers;
+
+		// Everything below is guarded by StateMutex
+		std::mutex StateMutex;
+		std::condition_variable TaskAvailable;
+		std::condition_variable AllTasksFinished;
+
+		// Tasks sitting in a queue, and tasks that have not finished yet
+		std::size_t QueuedTaskCount;
+		std::size_t UnfinishedTaskCount;
+
+		// Queue the next task is pushed to
+		std::size_t NextQueue;
+
+		bool Stopping;
+	};
+}
+
+#endif //! NES_THREAD_POOL_HPP